@@ -64,6 +64,13 @@ Collocated::Collocated(size_t dim,
     num_x[i] = std::pow((float)3, (int)i);
   }
 
+  // Repeat the points on each of the multiplier cells along a side.
+  for (size_t a = 0; a < d_number_azimuths_octant; a++)
+  {
+    num_x[a] *= multiplier;
+    num_y[a] *= multiplier;
+  }
+
   //-------------------------------------------------------------------------//
   // DEFINE QUADRATURE POINTS
   //-------------------------------------------------------------------------//
@@ -205,7 +212,8 @@ Collocated::Collocated(size_t dim,
       d_mu[angle]     = std::cos(phi[a]) * d_polar->sin_theta(p);
       d_eta[angle]    = std::sin(phi[a]) * d_polar->sin_theta(p);
       d_xi[angle]     = d_polar->cos_theta(p);
-      d_weight[angle] = 2.0 * d_polar->weight(p) * d_azimuth_weight[a];
+      d_weight[angle] = (d_dimension == 2 ? 2.0 : 1.0) *
+                        d_polar->weight(p) * d_azimuth_weight[a];
 
     } // end polar
   } // azimuth
@@ -171,7 +171,13 @@ build(SP_quadrature &q, SP_input input, const int dimension)
   else if (quad_type == "collocated")
   {
     Insist(dimension > 1, "Collocated only for 2D or 3D.");
-    q = new Collocated(dimension, azimuths_octant, 1, polar_octant, polar_type);
+    // Repeating the points over a lattice makes the tracks cyclic on
+    // each lattice cell, as modular tracking needs.
+    int multiplier = 1;
+    if (input->check("quad_collocated_multiplier"))
+      multiplier = input->get<int>("quad_collocated_multiplier");
+    q = new Collocated(dimension, azimuths_octant, multiplier, polar_octant,
+                       polar_type);
   }
   else if (quad_type == "uniform")
   {
@@ -30,8 +30,8 @@ QuadratureMOC::QuadratureMOC(size_t dim,
   , d_number_polar(num_polar)
 {
 
-  // Support for 2D right now
-  Require(dim == 2);
+  // Tracks are 2D; in 3D, they are stacked axially (see TrackStack).
+  Require(dim == 2 || dim == 3);
 
   // Construct the polar quadrature.
   if (polar == "TY")
@@ -101,8 +101,10 @@ Uniform::Uniform(size_t dim,
       d_eta[angle]    = sin(phi[a]) * d_polar->sin_theta(p);
       d_xi[angle]     = d_polar->cos_theta(p);
       // Approximation for now.  It would be better to adjust
-      // weights based on adjusted azimuths.
-      d_weight[angle] = 2.0 * d_polar->weight(p) * delta;
+      // weights based on adjusted azimuths.  In 2D, the weight
+      // accounts for the lower hemisphere, too.
+      d_weight[angle] = (d_dimension == 2 ? 2.0 : 1.0) *
+                        d_polar->weight(p) * delta;
 
     } // end polar
 
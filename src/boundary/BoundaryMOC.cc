@@ -28,7 +28,12 @@ BoundaryMOC<D>::BoundaryMOC(SP_input        input,
   , d_bc(2*D::dimension)
 {
   Require(d_quadrature);
-  Insist(D::dimension == 2, "MOC is for 2D only.");
+  Insist(D::dimension > 1, "MOC is for 2D and 3D only.");
+  if (D::dimension == 3)
+  {
+    d_stack = mesh->stack();
+    Insist(d_stack, "3D MOC requires axially stacked tracks.");
+  }
 
   // Allocated the flux container.
   initialize();
@@ -36,6 +41,7 @@ BoundaryMOC<D>::BoundaryMOC(SP_input        input,
   // Setup indexing.
   setup_indices();
   setup_side_indices();
+  if (D::dimension == 3) setup_stack_indices();
 
   // Create boundary conditions.
   std::vector<std::string> names(6);
@@ -107,14 +113,13 @@ void BoundaryMOC<D>::initialize()
 
   for (int g = 0; g < d_number_groups; g++)
   {
-    for (int o = 0; o < 4; o++)
+    for (int o = 0; o < q->number_octants(); o++)
     {
       for (int a = 0; a < q->number_angles_octant(); a++)
       {
-        int azimuth = q->azimuth(a);
         int angle = q->index(o, a);
-        d_boundary_flux[g][angle][IN].resize(q->number_tracks(azimuth), 0.0);
-        d_boundary_flux[g][angle][OUT].resize(q->number_tracks(azimuth), 0.0);
+        d_boundary_flux[g][angle][IN].resize(number_tracks(o, a), 0.0);
+        d_boundary_flux[g][angle][OUT].resize(number_tracks(o, a), 0.0);
       }
     }
   }
@@ -130,9 +135,10 @@ void BoundaryMOC<D>::setup_indices()
   using std::endl;
 
   // Each octant-angle-track is matched individually.  The indexing
-  // is used as [angle, track]->(angle, track).
+  // is used as [angle, track]->(angle, track).  In 3D, these are the
+  // indices of the 2D tracks, which setup_stack_indices extends.
 
-  int number_octants        = d_quadrature->number_octants();
+  int number_octants        = 4;
   int number_angles_octant  = d_quadrature->number_angles_octant();
 
   d_feed_into.resize(number_octants, vec3_int(number_angles_octant));
@@ -246,7 +252,7 @@ void BoundaryMOC<D>::setup_side_indices()
                    {0, 1},
                    {3, 2}};
 
-  d_side_index.resize(4);
+  d_side_index.resize(2*D::dimension);
 
   vec_int triplet(3, 0);
 
@@ -376,6 +382,133 @@ void BoundaryMOC<D>::setup_side_indices()
 
 }
 
+//---------------------------------------------------------------------------//
+template<class D>
+void BoundaryMOC<D>::setup_stack_indices()
+{
+  Require(d_stack);
+
+  int number_octants        = d_quadrature->number_octants();
+  int number_angles_octant  = d_quadrature->number_angles_octant();
+  int number_azimuths       = d_quadrature->number_azimuths_octant();
+  int nz                    = d_stack->number_z();
+
+  std::vector<vec3_int> feed_into(number_octants, vec3_int(number_angles_octant));
+  std::vector<vec3_int> feed_from(number_octants, vec3_int(number_angles_octant));
+  for (int o = 0; o < number_octants; o++)
+  {
+    for (int a = 0; a < number_angles_octant; a++)
+    {
+      feed_into[o][a].resize(number_tracks(o, a), vec_int(3, 0));
+      feed_from[o][a].resize(number_tracks(o, a), vec_int(3, 0));
+    }
+  }
+
+  // A track leaving a side feeds the reflected 2D track in the same
+  // axial bin and direction, while one leaving the top or bottom feeds
+  // the other family, whose track j + nz starts at the same point.
+  for (int o = 0; o < number_octants; o++)
+  {
+    int o2D  = o % 4;
+    int down = o / 4;
+    for (int a = 0; a < number_angles_octant; a++)
+    {
+      int p  = d_quadrature->polar(a);
+      int az = d_quadrature->azimuth(a) + (o % 2) * number_azimuths;
+      for (int t = 0; t < d_quadrature->number_tracks(az); t++)
+      {
+        for (int j = 0; j < d_stack->number_stacked(az, t, p); j++)
+        {
+          int i   = d_stack->offset(az, p, t) + j;
+          int bin = d_stack->exit_bin(az, t, p, j);
+          vec_int &into = feed_into[o][a][i];
+          if (bin >= 0)
+          {
+            int oo  = d_feed_into[o2D][a][t][0];
+            int aa  = d_feed_into[o2D][a][t][1];
+            int tt  = d_feed_into[o2D][a][t][2];
+            int azz = d_quadrature->azimuth(aa) + (oo % 2) * number_azimuths;
+            int pp  = d_quadrature->polar(aa);
+            into[0] = oo + 4 * down;
+            into[1] = aa;
+            into[2] = d_stack->offset(azz, pp, tt) + nz - 1 - bin;
+          }
+          else
+          {
+            into[0] = o2D + 4 * (1 - down);
+            into[1] = a;
+            into[2] = i + nz;
+          }
+          vec_int &from = feed_from[into[0]][into[1]][into[2]];
+          from[0] = o;
+          from[1] = a;
+          from[2] = i;
+        }
+      }
+    }
+  }
+  d_feed_into = feed_into;
+  d_feed_from = feed_from;
+
+  // Tracks j < nz of both families enter each side of their 2D track.
+  vec3_int side_index(6);
+  vec_int triplet(3, 0);
+  for (int side = 0; side < 4; side++)
+  {
+    for (size_t i = 0; i < d_side_index[side].size(); i++)
+    {
+      int o2D = d_side_index[side][i][0];
+      int a   = d_side_index[side][i][1];
+      int t   = d_side_index[side][i][2];
+      int p   = d_quadrature->polar(a);
+      int az  = d_quadrature->azimuth(a) + (o2D % 2) * number_azimuths;
+      for (int down = 0; down < 2; down++)
+      {
+        for (int j = 0; j < nz; j++)
+        {
+          triplet[0] = o2D + 4 * down;
+          triplet[1] = a;
+          triplet[2] = d_stack->offset(az, p, t) + j;
+          side_index[side].push_back(triplet);
+        }
+      }
+    }
+  }
+
+  // The remaining tracks enter the bottom (upward) or top (downward).
+  for (int o = 0; o < number_octants; o++)
+  {
+    int side = o < 4 ? Mesh::BOTTOM : Mesh::TOP;
+    for (int a = 0; a < number_angles_octant; a++)
+    {
+      int p  = d_quadrature->polar(a);
+      int az = d_quadrature->azimuth(a) + (o % 2) * number_azimuths;
+      for (int t = 0; t < d_quadrature->number_tracks(az); t++)
+      {
+        for (int j = nz; j < d_stack->number_stacked(az, t, p); j++)
+        {
+          triplet[0] = o;
+          triplet[1] = a;
+          triplet[2] = d_stack->offset(az, p, t) + j;
+          side_index[side].push_back(triplet);
+        }
+      }
+    }
+  }
+  d_side_index = side_index;
+}
+
+//---------------------------------------------------------------------------//
+template<class D>
+typename BoundaryMOC<D>::size_t
+BoundaryMOC<D>::number_tracks(const size_t o, const size_t a) const
+{
+  int azimuth = d_quadrature->azimuth(a);
+  if (D::dimension == 2) return d_quadrature->number_tracks(azimuth);
+  azimuth += (o % 2) * d_quadrature->number_azimuths_octant();
+  return d_stack->number_tracks(azimuth, d_quadrature->polar(a));
+}
+
 //---------------------------------------------------------------------------//
 // EXPLICIT INSTANTIATIONS
 //---------------------------------------------------------------------------//
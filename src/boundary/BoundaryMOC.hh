@@ -26,6 +26,15 @@ namespace detran
  *  by sweeping along fixed tracks crossing the domain.  Tracks
  *  begin and end at a global boundary.  This class stores the
  *  angular flux for each track.
+ *
+ *  In 3D, the tracks are those stacked axially over the 2D tracks
+ *  (see TrackStack), and the track index of an angle is the flattened
+ *  index of a 3D track.  Octants 0-3 hold the upward tracks and
+ *  octants 4-7 the downward tracks, each with the same xy direction
+ *  as the 2D octant o % 4.  A track leaving a side feeds the track of
+ *  the reflected 2D track entering the same axial bin, while one
+ *  leaving the top or bottom feeds the track of the other family
+ *  starting at the same point.
  */
 
 template <class D>
@@ -47,6 +56,7 @@ public:
   typedef detran_utilities::SP<MeshMOC>         SP_mesh;
   typedef detran_angle::QuadratureMOC           QuadratureMOC;
   typedef detran_utilities::SP<QuadratureMOC>   SP_quadrature;
+  typedef MeshMOC::SP_trackstack                SP_trackstack;
   typedef BoundaryConditionMOC<D>               BC_T;
   typedef typename BC_T::SP_bc                  SP_bc;
   typedef detran_utilities::size_t              size_t;
@@ -183,6 +193,8 @@ private:
 
   /// MOC Quadrature
   SP_quadrature d_quadrature;
+  /// Axially stacked tracks (3D only)
+  SP_trackstack d_stack;
   /// Boundary flux [energy, angle, inout, track]
   bf_type d_boundary_flux;
   /// Vector of boundary conditions.
@@ -207,6 +219,12 @@ private:
   /// Setup indices for an incident side.
   void setup_side_indices();
 
+  /// Extend the indices to the axially stacked tracks.
+  void setup_stack_indices();
+
+  /// Number of tracks of an octant and angle
+  size_t number_tracks(const size_t o, const size_t a) const;
+
 };
 
 } // end namespace detran
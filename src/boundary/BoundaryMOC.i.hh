@@ -97,8 +97,7 @@ BoundaryMOC<D>::feed_into(const size_t  o1, const size_t  a1, const size_t  t1,
 {
   Require(o1 < d_quadrature->number_octants());
   Require(a1 < d_quadrature->number_angles_octant());
-  int azimuth = d_quadrature->azimuth(a1);
-  Require(t1 < d_quadrature->number_tracks(azimuth));
+  Require(t1 < d_feed_into[o1][a1].size());
   o2 = d_feed_into[o1][a1][t1][0];
   a2 = d_feed_into[o1][a1][t1][1];
   t2 = d_feed_into[o1][a1][t1][2];
@@ -112,8 +111,7 @@ BoundaryMOC<D>::feed_from(const size_t  o1, const size_t  a1, const size_t  t1,
 {
   Require(o1 < d_quadrature->number_octants());
   Require(a1 < d_quadrature->number_angles_octant());
-  int azimuth = d_quadrature->azimuth(a1);
-  Require(t1 < d_quadrature->number_tracks(azimuth));
+  Require(t1 < d_feed_from[o1][a1].size());
   o2 = d_feed_from[o1][a1][t1][0];
   a2 = d_feed_from[o1][a1][t1][1];
   t2 = d_feed_from[o1][a1][t1][2];
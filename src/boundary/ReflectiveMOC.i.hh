@@ -75,6 +75,7 @@ void ReflectiveMOC<D>::update(const size_t g, const size_t o, const size_t a)
 //---------------------------------------------------------------------------//
 
 template class ReflectiveMOC<_2D>;
+template class ReflectiveMOC<_3D>;
 
 } // end namespace detran
 
@@ -142,6 +142,15 @@ public:
    */
   void set_tolerances(const double atol, const double rtol, const int maxit);
 
+  /// Get the absolute tolerance
+  double absolute_tolerance() const { return d_absolute_tolerance; }
+
+  /// Get the relative tolerance
+  double relative_tolerance() const { return d_relative_tolerance; }
+
+  /// Get the maximum iterations
+  int maximum_iterations() const { return d_maximum_iterations; }
+
   /**
    *  Print residual norms and other diagonostic information.
    *
@@ -91,6 +91,26 @@ public:
     return d_source_spectra[d_source_map[cell]][group] * d_norm;
   }
 
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Reset the source spectra while keeping the map
+   *
+   *  This allows a source to be updated between solves (e.g. for
+   *  a low order correction problem) without rebuilding the solver
+   *  that holds it.
+   *
+   *  @param spectra    Vector of spectra, size = [#spectra][#groups]
+   */
+  void set_spectra(const spectra_type &spectra)
+  {
+    Require(spectra.size() == d_source_spectra.size());
+    Require(spectra[0].size() == d_number_groups);
+    d_source_spectra = spectra;
+  }
+
 private:
 
   //-------------------------------------------------------------------------//
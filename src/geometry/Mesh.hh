@@ -185,6 +185,9 @@ public:
   /// Get the cell volume
   double volume(size_t cell) const;
 
+  /// Get the first edge of the domain in a specified dimension
+  double origin(size_t dim) const;
+
   /// Get domain width along x axis
   double total_width_x() const;
   /// Get domain width along y axis
@@ -195,6 +198,15 @@ public:
   /// Get the mesh dimension
   size_t dimension() const;
 
+  /**
+   *  @brief  Are the cells the Cartesian grid given by the widths?
+   *
+   *  Meshes that expose other cells as a single row (e.g. MeshCSG and
+   *  MeshUnstructured) return false, and their cells must not be
+   *  indexed or coarsened as a grid.
+   */
+  virtual bool is_cartesian() const { return true; }
+
   /**
    * @brief   Returns the cardinal index for i, j, and k
    * @param   i  Index along x axis.
@@ -98,6 +98,16 @@ inline double Mesh::volume(size_t cell) const
 }
 
 //---------------------------------------------------------------------------//
+inline double Mesh::origin(size_t dim) const
+{
+  Require(dim < 3);
+  if (dim == 0)
+    return d_xcme[0];
+  else if (dim == 1)
+    return d_ycme[0];
+  else
+    return d_zcme[0];
+}
 inline double Mesh::total_width_x() const
 {
   return d_total_width_x;
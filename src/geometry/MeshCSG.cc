@@ -0,0 +1,116 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  MeshCSG.cc
+ *  @brief MeshCSG class member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "MeshCSG.hh"
+#include "utilities/SoftEquivalence.hh"
+
+namespace detran_geometry
+{
+
+//---------------------------------------------------------------------------//
+MeshCSG::MeshCSG(SP_mesh base, vec_pincell pins, std::string key)
+  : Mesh(2)
+  , d_base(base)
+  , d_pins(pins)
+{
+  Require(d_base);
+  Insist(d_base->dimension() == 2, "Pin cells require a 2D base mesh.");
+  Insist(d_base->mesh_map_exists(key), "Missing pin cell mesh map " + key);
+  d_pin_map = d_base->mesh_map(key);
+
+  //-------------------------------------------------------------------------//
+  // NUMBER THE REGIONS
+  //-------------------------------------------------------------------------//
+
+  size_t number_base = d_base->number_cells();
+  d_region_offset.resize(number_base + 1, 0);
+  for (size_t c = 0; c < number_base; ++c)
+  {
+    int n = 1;
+    if (d_pin_map[c] >= 0)
+    {
+      Insist(d_pin_map[c] < (int) d_pins.size(), "Pin cell index too large.");
+      SP_pincell pin = d_pins[d_pin_map[c]];
+      size_t i = d_base->cell_to_i(c);
+      size_t j = d_base->cell_to_j(c);
+      Insist(detran_utilities::soft_equiv(pin->pitch(), d_base->dx(i)) &&
+             detran_utilities::soft_equiv(pin->pitch(), d_base->dy(j)),
+             "A pin cell's pitch must match its mesh cell.");
+      n = pin->number_regions();
+    }
+    d_region_offset[c + 1] = d_region_offset[c] + n;
+  }
+  size_t number_regions = d_region_offset[number_base];
+
+  //-------------------------------------------------------------------------//
+  // EXPOSE THE REGIONS AS A ROW OF CELLS WITH WIDTHS EQUAL TO THEIR AREAS
+  //-------------------------------------------------------------------------//
+
+  d_cell.resize(number_regions, 0);
+  vec_int pin_region(number_regions, 0);
+  d_dx.resize(number_regions, 0.0);
+  for (size_t c = 0; c < number_base; ++c)
+  {
+    SP_pincell pin = pincell(c);
+    for (int r = d_region_offset[c]; r < d_region_offset[c + 1]; ++r)
+    {
+      int local = r - d_region_offset[c];
+      d_cell[r]     = c;
+      pin_region[r] = local;
+      d_dx[r] = pin ? pin->region_volume(local) : d_base->volume(c);
+    }
+  }
+  d_dy.assign(1, 1.0);
+  d_dz.assign(1, 1.0);
+  d_xfm.assign(number_regions, 1);
+  d_yfm.assign(1, 1);
+  d_zfm.assign(1, 1);
+  d_xcme.assign(number_regions + 1, 0.0);
+  for (size_t r = 0; r < number_regions; ++r)
+    d_xcme[r + 1] = d_xcme[r] + d_dx[r];
+  d_ycme.assign(2, 0.0);
+  d_ycme[1] = 1.0;
+  d_zcme = d_ycme;
+  d_total_width_x   = d_base->total_width_x();
+  d_total_width_y   = d_base->total_width_y();
+  d_total_width_z   = 1.0;
+  d_number_cells    = number_regions;
+  d_number_cells_x  = number_regions;
+  d_number_cells_y  = 1;
+  d_number_cells_z  = 1;
+
+  //-------------------------------------------------------------------------//
+  // INHERIT THE BASE MESH MAPS
+  //-------------------------------------------------------------------------//
+
+  const mesh_map_type &maps = d_base->get_mesh_map();
+  for (mesh_map_type::const_iterator it = maps.begin(); it != maps.end(); ++it)
+  {
+    vec_int m(number_regions, 0);
+    for (size_t r = 0; r < number_regions; ++r)
+      m[r] = it->second[d_cell[r]];
+    add_mesh_map(it->first, m);
+  }
+  vec_int mat_map(number_regions, 0);
+  if (d_base->mesh_map_exists("MATERIAL"))
+    mat_map = mesh_map("MATERIAL");
+  for (size_t r = 0; r < number_regions; ++r)
+  {
+    SP_pincell pin = pincell(d_cell[r]);
+    if (pin) mat_map[r] = pin->region_material(pin_region[r]);
+  }
+  add_mesh_map("MATERIAL", mat_map);
+  add_mesh_map("CELL", d_cell);
+  add_mesh_map("REGION", pin_region);
+}
+
+} // end namespace detran_geometry
+
+//---------------------------------------------------------------------------//
+//              end of MeshCSG.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,139 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  MeshCSG.hh
+ *  @brief MeshCSG class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_geometry_MESHCSG_HH_
+#define detran_geometry_MESHCSG_HH_
+
+#include "PinCell.hh"
+#include <string>
+#include <vector>
+
+namespace detran_geometry
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class MeshCSG
+ *  @brief Flat source regions of pin cells placed on a Cartesian mesh.
+ *
+ *  Each cell of a two-dimensional base mesh either holds a pin cell,
+ *  treated as exact constructive solid geometry (see PinCell), or is a
+ *  single homogeneous region.  The pin cells are assigned by a base
+ *  mesh map (by default "PINCELL") giving, for each cell, an index into
+ *  the vector of pin cells, or -1 for no pin.  A pin cell's pitch must
+ *  match the widths of the cells it occupies.
+ *
+ *  The flat source regions are numbered cell by cell and are exposed
+ *  as the cells of this mesh, so that the transport operators, which
+ *  need only the number of cells, their volumes, and the mesh maps,
+ *  are unchanged.  To that end, the regions are stored as a single row
+ *  of "cells" whose widths are the region areas.  Hence, the geometric
+ *  queries (e.g. cell_to_i or find_cell) do not apply; use base() and
+ *  cell() instead.  The base mesh maps are inherited by each region of
+ *  a cell, except that "MATERIAL" is set by the pin cells.  The map
+ *  "CELL" gives the base cell of each region, and "REGION" gives the
+ *  region within the pin cell (zero outside pins).
+ *
+ *  Tracker ray traces the base mesh and then cuts each segment within
+ *  a pin cell at the circles and sector planes.  Only the MOC equations
+ *  may be used, and coarse mesh acceleration, which needs Cartesian
+ *  cells, is rejected (see is_cartesian).
+ */
+//---------------------------------------------------------------------------//
+class GEOMETRY_EXPORT MeshCSG: public Mesh
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<MeshCSG>       SP_meshcsg;
+  typedef Mesh::SP_mesh                       SP_mesh;
+  typedef PinCell::SP_pincell                 SP_pincell;
+  typedef std::vector<SP_pincell>             vec_pincell;
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC INTERFACE
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor.
+   *  @param base   Two-dimensional Cartesian mesh
+   *  @param pins   Pin cells
+   *  @param key    Base mesh map assigning the pin cells
+   */
+  MeshCSG(SP_mesh base, vec_pincell pins, std::string key = "PINCELL");
+
+  /// SP constructor
+  static SP_mesh
+  Create(SP_mesh base, vec_pincell pins, std::string key = "PINCELL")
+  {
+    SP_mesh p(new MeshCSG(base, pins, key));
+    return p;
+  }
+
+  /// The regions are not a Cartesian grid.
+  bool is_cartesian() const { return false; }
+
+  /// Cartesian mesh on which the pin cells are placed
+  SP_mesh base() const
+  {
+    return d_base;
+  }
+
+  /// Base cell containing a region
+  size_t cell(size_t region) const
+  {
+    Require(region < d_number_cells);
+    return d_cell[region];
+  }
+
+  /// First region of a base cell
+  size_t region_offset(size_t cell) const
+  {
+    Require(cell < d_region_offset.size());
+    return d_region_offset[cell];
+  }
+
+  /// Pin cell in a base cell, if any
+  SP_pincell pincell(size_t cell) const
+  {
+    Require(cell < d_pin_map.size());
+    return d_pin_map[cell] < 0 ? SP_pincell() : d_pins[d_pin_map[cell]];
+  }
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Cartesian base mesh
+  SP_mesh d_base;
+  /// Pin cells
+  vec_pincell d_pins;
+  /// Pin cell index of each base cell
+  vec_int d_pin_map;
+  /// First region of each base cell
+  vec_int d_region_offset;
+  /// Base cell of each region
+  vec_int d_cell;
+
+};
+
+GEOMETRY_TEMPLATE_EXPORT(detran_utilities::SP<MeshCSG>)
+
+} // end namespace detran_geometry
+
+#endif /* detran_geometry_MESHCSG_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of MeshCSG.hh
+//---------------------------------------------------------------------------//
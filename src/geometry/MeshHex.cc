@@ -0,0 +1,209 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  MeshHex.cc
+ *  @brief MeshHex class member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "MeshHex.hh"
+#include "utilities/Constants.hh"
+#include <cmath>
+#include <map>
+
+namespace detran_geometry
+{
+
+//---------------------------------------------------------------------------//
+MeshHex::MeshHex(const double pitch,
+                 const size_t number_rings,
+                 vec_int      mat_map,
+                 const size_t sector,
+                 const size_t subdivisions,
+                 const bool   rotational,
+                 vec_dbl      z)
+  : d_pitch(pitch)
+  , d_number_rings(number_rings)
+  , d_sector(sector)
+{
+  using detran_utilities::pi;
+
+  Insist(pitch > 0.0, "The hexagon pitch must be positive.");
+  Insist(number_rings > 0, "A hexagonal core needs at least one ring.");
+  Insist(sector == 1 || sector == 3 || sector == 6,
+         "The hexagonal sector must be 1, 3, or 6.");
+  Insist(subdivisions > 0, "The number of subdivisions must be positive.");
+  Insist(!rotational || sector > 1, "Rotational symmetry needs a sector.");
+  size_t number_hex = number_hexagons(number_rings);
+  size_t number_layers = z.size() ? z.size() - 1 : 1;
+  Insist(mat_map.size() == number_hex ||
+         mat_map.size() == number_hex * number_layers,
+         "The material map must be given for each hexagon.");
+
+  //-------------------------------------------------------------------------//
+  // TRIANGLES WITHIN THE SECTOR
+  //-------------------------------------------------------------------------//
+
+  // All nodes lie on a triangular lattice with spacing R/m, where R is
+  // the hexagon circumradius, so they are matched by lattice indices.
+  double R = pitch / std::sqrt(3.0);
+  double h = R / subdivisions;
+  double s60 = std::sin(pi / 3.0);
+  double sector_angle = 2.0 * pi / sector;
+  typedef std::map<std::pair<long, long>, int> node_map_type;
+  node_map_type node_map;
+  vec_dbl x, y;
+  vec2_int cells;
+  vec_int hexagon;
+
+  int m = subdivisions;
+  for (size_t hex = 0; hex < number_hex; ++hex)
+  {
+    Point C = hexagon_center(hex);
+    for (int k = 0; k < 6; ++k)
+    {
+      Point a = R * Point(std::cos(k * pi / 3.0), std::sin(k * pi / 3.0));
+      Point b = R * Point(std::cos((k + 1) * pi / 3.0),
+                          std::sin((k + 1) * pi / 3.0));
+      for (int i = 0; i < m; ++i)
+      {
+        for (int j = 0; i + j < m; ++j)
+        {
+          // Upward triangle, and downward triangle if it fits
+          for (int t = 0; t < 2; ++t)
+          {
+            if (t == 1 && i + j > m - 2) continue;
+            int ij[3][2] = {{i, j}, {i + 1, j}, {i, j + 1}};
+            if (t == 1)
+            {
+              ij[0][0] = i + 1; ij[0][1] = j;
+              ij[1][0] = i + 1; ij[1][1] = j + 1;
+              ij[2][0] = i;     ij[2][1] = j + 1;
+            }
+            Point p[3];
+            for (int v = 0; v < 3; ++v)
+            {
+              p[v] = C + (double(ij[v][0]) / m) * a
+                       + (double(ij[v][1]) / m) * b;
+            }
+
+            // Keep the triangle if its centroid is in the sector.
+            Point c = (1.0 / 3.0) * (p[0] + p[1] + p[2]);
+            double theta = std::atan2(c.y(), c.x());
+            if (theta < 0.0) theta += 2.0 * pi;
+            if (theta >= sector_angle) continue;
+
+            vec_int cell(3, 0);
+            for (int v = 0; v < 3; ++v)
+            {
+              long lv = std::floor(p[v].y() / (h * s60) + 0.5);
+              long lu = std::floor(p[v].x() / h - 0.5 * lv + 0.5);
+              std::pair<long, long> key(lu, lv);
+              node_map_type::iterator it = node_map.find(key);
+              if (it == node_map.end())
+              {
+                cell[v] = x.size();
+                node_map[key] = x.size();
+                x.push_back(p[v].x());
+                y.push_back(p[v].y());
+              }
+              else
+              {
+                cell[v] = it->second;
+              }
+            }
+            cells.push_back(cell);
+            hexagon.push_back(hex);
+          }
+        }
+      }
+    }
+  }
+
+  // Materials and hexagons of the cells
+  size_t number_tri = cells.size();
+  size_t mat_layers = mat_map.size() / number_hex;
+  vec_int cell_mat(number_tri * mat_layers, 0);
+  vec_int cell_hex(number_tri * number_layers, 0);
+  for (size_t c = 0; c < number_tri; ++c)
+  {
+    for (size_t k = 0; k < mat_layers; ++k)
+      cell_mat[c + k * number_tri] = mat_map[hexagon[c] + k * number_hex];
+    for (size_t k = 0; k < number_layers; ++k)
+      cell_hex[c + k * number_tri] = hexagon[c];
+  }
+  build(x, y, cells, cell_mat, z);
+  add_mesh_map("HEXAGON", cell_hex);
+
+  //-------------------------------------------------------------------------//
+  // BOUNDARY SIDES
+  //-------------------------------------------------------------------------//
+
+  // The outer boundary is vacuum.  Faces on the ray at 0 degrees are
+  // SOUTH, and those on the ray at the sector angle are WEST.
+  Point upper(std::cos(sector_angle), std::sin(sector_angle));
+  vec_int lower_faces, upper_faces;
+  for (size_t f = 0; f < number_faces(); ++f)
+  {
+    if (!is_boundary(f)) continue;
+    set_face_side(f, -1);
+    if (sector == 1) continue;
+    const Point &c = face_center(f);
+    const Point &n = face_normal(f);
+    double tol = 1.0e-9 * pitch;
+    if (std::abs(c.y()) < tol && c.x() > 0.0 && n.y() < -0.5)
+    {
+      set_face_side(f, Mesh::SOUTH);
+      lower_faces.push_back(f);
+    }
+    else if (std::abs(upper.x() * c.y() - upper.y() * c.x()) < tol &&
+             upper.x() * c.x() + upper.y() * c.y() > 0.0 &&
+             upper.y() * n.x() - upper.x() * n.y() < -0.5)
+    {
+      set_face_side(f, Mesh::WEST);
+      upper_faces.push_back(f);
+    }
+  }
+  Assert(lower_faces.size() == upper_faces.size());
+
+  // Rotating a lower face by the sector angle gives its partner.
+  if (!rotational) return;
+  for (size_t i = 0; i < lower_faces.size(); ++i)
+  {
+    double r = face_center(lower_faces[i]).x();
+    Point c = r * upper;
+    size_t j = 0;
+    for (; j < upper_faces.size(); ++j)
+      if (distance(c, face_center(upper_faces[j])) < 1.0e-9 * pitch) break;
+    Assert(j < upper_faces.size());
+    set_face_partner(lower_faces[i], upper_faces[j]);
+  }
+}
+
+//---------------------------------------------------------------------------//
+MeshHex::Point MeshHex::hexagon_center(const size_t h) const
+{
+  using detran_utilities::pi;
+  Require(h < number_hexagons(d_number_rings));
+  if (h == 0) return Point(0.0, 0.0);
+
+  // Ring r starts at r steps at 30 degrees and walks r steps in each of
+  // the six directions starting at 150 degrees.
+  size_t r = 1;
+  while (number_hexagons(r + 1) <= h) ++r;
+  size_t i = h - number_hexagons(r);
+  Point C = (r * d_pitch) * Point(std::cos(pi / 6.0), std::sin(pi / 6.0));
+  for (size_t d = 0; d < i / r + 1; ++d)
+  {
+    double phi = pi / 6.0 + (d + 2) * pi / 3.0;
+    size_t steps = d < i / r ? r : i % r;
+    C = C + (steps * d_pitch) * Point(std::cos(phi), std::sin(phi));
+  }
+  return C;
+}
+
+} // end namespace detran_geometry
+
+//---------------------------------------------------------------------------//
+//              end of MeshHex.cc
+//---------------------------------------------------------------------------//
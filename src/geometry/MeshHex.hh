@@ -0,0 +1,137 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  MeshHex.hh
+ *  @brief MeshHex class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_geometry_MESHHEX_HH_
+#define detran_geometry_MESHHEX_HH_
+
+#include "MeshUnstructured.hh"
+
+namespace detran_geometry
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class MeshHex
+ *  @brief Hexagonal (or hexagonal-Z) core mesh of triangles.
+ *
+ *  The core is a lattice of flat-topped hexagons of a given pitch (the
+ *  distance between parallel sides), centered on one hexagon and with
+ *  a number of rings (the center hexagon being the first).  The
+ *  hexagons are numbered from the center outward, counterclockwise
+ *  around each ring starting with the hexagon at 30 degrees, which is
+ *  the numbering of the material map.
+ *
+ *  Each hexagon is split into six triangles between its center and its
+ *  sides, and each of these is subdivided into \f$ m^2 \f$ congruent
+ *  triangles.  The edges of the triangles include the rays from the
+ *  core center at every multiple of 60 degrees, so that the mesh can be
+ *  limited to a 1/6 (60 degree) or 1/3 (120 degree) sector of the core.
+ *  For a sector, the edge along the x axis is the SOUTH side and the
+ *  other edge is the WEST side, with the boundary conditions given by
+ *  bc_south and bc_west.  Reflection at a sector edge, which is not
+ *  Cartesian for the WEST side, needs a quadrature symmetric about it.
+ *  Alternatively, the two edges can be paired for rotational symmetry
+ *  (see MeshUnstructured::face_partner), in which case their boundary
+ *  conditions are ignored.  The outer boundary is vacuum.
+ *
+ *  Optionally, the mesh is extruded over an axial mesh for hexagonal-Z
+ *  problems.  Besides the material map, the mesh map "HEXAGON" gives
+ *  the hexagon of each cell.
+ */
+//---------------------------------------------------------------------------//
+class GEOMETRY_EXPORT MeshHex: public MeshUnstructured
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<MeshHex>     SP_mesh;
+  typedef MeshUnstructured::SP_base         SP_base;
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC INTERFACE
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor.
+   *  @param pitch          Distance between parallel hexagon sides
+   *  @param number_rings   Number of rings, including the center hexagon
+   *  @param mat_map        Material of each hexagon of the full core, or
+   *                        of each hexagon in each layer if extruded
+   *  @param sector         Core fraction 1/sector meshed (1, 3, or 6)
+   *  @param subdivisions   Subdivisions m of each hexagon's triangles
+   *  @param rotational     Pair the sector edges for rotational symmetry
+   *  @param z              Axial mesh edges for hexagonal-Z (optional)
+   */
+  MeshHex(const double pitch,
+          const size_t number_rings,
+          vec_int      mat_map,
+          const size_t sector       = 1,
+          const size_t subdivisions = 1,
+          const bool   rotational   = false,
+          vec_dbl      z            = vec_dbl(0));
+
+  /// SP constructor
+  static SP_base Create(const double pitch,
+                        const size_t number_rings,
+                        vec_int      mat_map,
+                        const size_t sector       = 1,
+                        const size_t subdivisions = 1,
+                        const bool   rotational   = false,
+                        vec_dbl      z            = vec_dbl(0))
+  {
+    SP_base p(new MeshHex(pitch, number_rings, mat_map, sector,
+                          subdivisions, rotational, z));
+    return p;
+  }
+
+  /// Number of hexagons in the full core
+  static size_t number_hexagons(const size_t number_rings)
+  {
+    return 1 + 3 * number_rings * (number_rings - 1);
+  }
+
+  /// Center of a hexagon
+  Point hexagon_center(const size_t h) const;
+
+  /// Hexagon pitch
+  double pitch() const { return d_pitch; }
+
+  /// Number of rings
+  size_t number_rings() const { return d_number_rings; }
+
+  /// Core fraction 1/sector meshed
+  size_t sector() const { return d_sector; }
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Hexagon pitch
+  double d_pitch;
+  /// Number of rings
+  size_t d_number_rings;
+  /// Core fraction 1/sector meshed
+  size_t d_sector;
+
+};
+
+GEOMETRY_TEMPLATE_EXPORT(detran_utilities::SP<MeshHex>)
+
+} // end namespace detran_geometry
+
+#endif /* detran_geometry_MESHHEX_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of MeshHex.hh
+//---------------------------------------------------------------------------//
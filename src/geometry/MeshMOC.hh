@@ -13,6 +13,7 @@
 #include "geometry/geometry_export.hh"
 #include "Mesh.hh"
 #include "TrackDB.hh"
+#include "TrackStack.hh"
 
 namespace detran_geometry
 {
@@ -36,16 +37,20 @@ public:
   typedef Mesh                              Base;
   typedef Base::SP_mesh                     SP_base;
   typedef TrackDB::SP_trackdb               SP_trackdb;
+  typedef TrackStack::SP_trackstack         SP_trackstack;
 
   //-------------------------------------------------------------------------//
   // PUBLIC INTERFACE
   //-------------------------------------------------------------------------//
 
-  MeshMOC(SP_base mesh, SP_trackdb tracks)
+  MeshMOC(SP_base mesh, SP_trackdb tracks, SP_trackstack stack = SP_trackstack())
     : Mesh(*mesh)
     , d_tracks(tracks)
+    , d_stack(stack)
+    , d_cartesian(mesh->is_cartesian())
   {
     Require(d_tracks);
+    Require(d_dimension < 3 || d_stack);
   }
 
   SP_trackdb tracks() const
@@ -53,6 +58,18 @@ public:
     return d_tracks;
   }
 
+  /// Axially stacked tracks (3D only)
+  SP_trackstack stack() const
+  {
+    return d_stack;
+  }
+
+  /// Is the tracked mesh a Cartesian grid?
+  bool is_cartesian() const
+  {
+    return d_cartesian;
+  }
+
 private:
 
   //-------------------------------------------------------------------------//
@@ -61,6 +78,10 @@ private:
 
   /// Track database
   SP_trackdb d_tracks;
+  /// Axially stacked tracks
+  SP_trackstack d_stack;
+  /// Whether the tracked mesh is a Cartesian grid
+  bool d_cartesian;
 
 };
 
@@ -0,0 +1,212 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  MeshUnstructured.cc
+ *  @brief MeshUnstructured class member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "MeshUnstructured.hh"
+#include "utilities/SoftEquivalence.hh"
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+namespace detran_geometry
+{
+
+//---------------------------------------------------------------------------//
+MeshUnstructured::MeshUnstructured(vec_dbl  x,
+                                   vec_dbl  y,
+                                   vec2_int cells,
+                                   vec_int  mat_map,
+                                   vec_dbl  z)
+  : Mesh(2)
+{
+  build(x, y, cells, mat_map, z);
+}
+
+//---------------------------------------------------------------------------//
+void MeshUnstructured::build(vec_dbl  x,
+                             vec_dbl  y,
+                             vec2_int cells,
+                             vec_int  mat_map,
+                             vec_dbl  z)
+{
+  using detran_utilities::soft_equiv;
+
+  Insist(x.size() == y.size(), "Node x and y coordinates must match.");
+  Insist(cells.size() > 0, "An unstructured mesh needs at least one cell.");
+  Insist(z.size() != 1, "An axial mesh needs at least one layer.");
+  size_t number_layers = z.size() ? z.size() - 1 : 1;
+  Insist(mat_map.size() == cells.size() ||
+         mat_map.size() == cells.size() * number_layers,
+         "Material map size mismatch.");
+  d_face_cell.assign(2, vec_int(0));
+
+  for (size_t n = 0; n < x.size(); ++n)
+    d_node.push_back(Point(x[n], y[n]));
+  double x_min = *std::min_element(x.begin(), x.end());
+  double x_max = *std::max_element(x.begin(), x.end());
+  double y_min = *std::min_element(y.begin(), y.end());
+  double y_max = *std::max_element(y.begin(), y.end());
+
+  //-------------------------------------------------------------------------//
+  // CELL AREAS AND CENTROIDS, WITH VERTICES ORDERED COUNTERCLOCKWISE
+  //-------------------------------------------------------------------------//
+
+  size_t number_cells = cells.size();
+  vec_dbl area(number_cells, 0.0);
+  d_centroid.resize(number_cells);
+  for (size_t c = 0; c < number_cells; ++c)
+  {
+    vec_int &v = cells[c];
+    Insist(v.size() > 2, "A cell needs at least three vertices.");
+    double a = 0.0, cx = 0.0, cy = 0.0;
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+      Insist(v[i] >= 0 && v[i] < (int) d_node.size(), "Bad node index.");
+      const Point &p0 = d_node[v[i]];
+      const Point &p1 = d_node[v[(i + 1) % v.size()]];
+      double cross = p0.x() * p1.y() - p1.x() * p0.y();
+      a  += cross;
+      cx += (p0.x() + p1.x()) * cross;
+      cy += (p0.y() + p1.y()) * cross;
+    }
+    Insist(a != 0.0, "Degenerate cell.");
+    d_centroid[c] = Point(cx / (3.0 * a), cy / (3.0 * a));
+    if (a < 0.0) std::reverse(v.begin(), v.end());
+    area[c] = 0.5 * std::abs(a);
+  }
+
+  //-------------------------------------------------------------------------//
+  // FACES, BY MATCHING NODE PAIRS
+  //-------------------------------------------------------------------------//
+
+  typedef std::map<std::pair<int, int>, int> face_map_type;
+  face_map_type face_map;
+  d_cell_face.resize(number_cells);
+  d_cell_face_sign.resize(number_cells);
+  for (size_t c = 0; c < number_cells; ++c)
+  {
+    const vec_int &v = cells[c];
+    for (size_t i = 0; i < v.size(); ++i)
+    {
+      int n0 = v[i];
+      int n1 = v[(i + 1) % v.size()];
+      std::pair<int, int> key(std::min(n0, n1), std::max(n0, n1));
+      face_map_type::iterator it = face_map.find(key);
+      if (it == face_map.end())
+      {
+        // A new face owned by this cell.  With counterclockwise vertices,
+        // the outward normal is the edge rotated clockwise.
+        int f = d_face_length.size();
+        face_map[key] = f;
+        Point e = d_node[n1] - d_node[n0];
+        double L = distance(d_node[n0], d_node[n1]);
+        Insist(L > 0.0, "Degenerate face.");
+        d_face_cell[0].push_back(c);
+        d_face_cell[1].push_back(-1);
+        d_face_length.push_back(L);
+        d_face_normal.push_back(Point(e.y() / L, -e.x() / L));
+        d_face_center.push_back(0.5 * (d_node[n0] + d_node[n1]));
+        d_cell_face[c].push_back(f);
+        d_cell_face_sign[c].push_back(1);
+      }
+      else
+      {
+        int f = it->second;
+        Insist(d_face_cell[1][f] < 0, "A face is shared by too many cells.");
+        d_face_cell[1][f] = c;
+        d_cell_face[c].push_back(f);
+        d_cell_face_sign[c].push_back(-1);
+      }
+    }
+  }
+
+  // Boundary faces on the sides of the bounding box
+  d_face_side.assign(number_faces(), -1);
+  d_face_partner.assign(number_faces(), -1);
+  for (size_t f = 0; f < number_faces(); ++f)
+  {
+    if (!is_boundary(f)) continue;
+    const Point &n = d_face_normal[f];
+    const Point &m = d_face_center[f];
+    if (soft_equiv(n.x(), -1.0) && soft_equiv(m.x(), x_min))
+      d_face_side[f] = WEST;
+    else if (soft_equiv(n.x(), 1.0) && soft_equiv(m.x(), x_max))
+      d_face_side[f] = EAST;
+    else if (soft_equiv(n.y(), -1.0) && soft_equiv(m.y(), y_min))
+      d_face_side[f] = SOUTH;
+    else if (soft_equiv(n.y(), 1.0) && soft_equiv(m.y(), y_max))
+      d_face_side[f] = NORTH;
+  }
+
+  //-------------------------------------------------------------------------//
+  // EXPOSE THE CELLS AS A ROW WITH WIDTHS EQUAL TO THEIR AREAS
+  //-------------------------------------------------------------------------//
+
+  d_dimension = z.size() ? 3 : 2;
+  d_dx = area;
+  d_dy.assign(1, 1.0);
+  d_xfm.assign(number_cells, 1);
+  d_yfm.assign(1, 1);
+  d_xcme.assign(number_cells + 1, 0.0);
+  for (size_t c = 0; c < number_cells; ++c)
+    d_xcme[c + 1] = d_xcme[c] + d_dx[c];
+  d_ycme.assign(2, 0.0);
+  d_ycme[1] = 1.0;
+  if (z.size())
+  {
+    d_zcme = z;
+    d_zfm.assign(number_layers, 1);
+    d_dz.resize(number_layers);
+    for (size_t k = 0; k < number_layers; ++k)
+    {
+      d_dz[k] = z[k + 1] - z[k];
+      Insist(d_dz[k] > 0.0, "Axial mesh edges must increase.");
+    }
+  }
+  else
+  {
+    d_zcme = d_ycme;
+    d_zfm.assign(1, 1);
+    d_dz.assign(1, 1.0);
+  }
+  d_total_width_x   = x_max - x_min;
+  d_total_width_y   = y_max - y_min;
+  d_total_width_z   = d_zcme.back() - d_zcme[0];
+  d_number_cells_x  = number_cells;
+  d_number_cells_y  = 1;
+  d_number_cells_z  = number_layers;
+  d_number_cells    = number_cells * number_layers;
+
+  // Extrude the material map if needed.
+  vec_int m(d_number_cells, 0);
+  for (size_t i = 0; i < d_number_cells; ++i)
+    m[i] = mat_map[i % mat_map.size()];
+  add_mesh_map("MATERIAL", m);
+}
+
+//---------------------------------------------------------------------------//
+void MeshUnstructured::set_face_side(const size_t f, const int side)
+{
+  Require(is_boundary(f));
+  Require(side >= -1 && side < 4);
+  d_face_side[f] = side;
+}
+
+//---------------------------------------------------------------------------//
+void MeshUnstructured::set_face_partner(const size_t f, const size_t g)
+{
+  Require(is_boundary(f));
+  Require(is_boundary(g));
+  d_face_partner[f] = g;
+  d_face_partner[g] = f;
+}
+
+} // end namespace detran_geometry
+
+//---------------------------------------------------------------------------//
+//              end of MeshUnstructured.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,297 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  MeshUnstructured.hh
+ *  @brief MeshUnstructured class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_geometry_MESHUNSTRUCTURED_HH_
+#define detran_geometry_MESHUNSTRUCTURED_HH_
+
+#include "Mesh.hh"
+#include "utilities/Point.hh"
+#include <vector>
+
+namespace detran_geometry
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class MeshUnstructured
+ *  @brief Mesh of arbitrary polygonal cells, optionally extruded axially.
+ *
+ *  The mesh is defined by a list of nodes and, for each cell, the nodes
+ *  of its vertices in order around the cell (in either direction).  The
+ *  cells must be simple polygons and the mesh must be conforming, i.e.
+ *  two neighboring cells share whole edges.  Cells need not be convex.
+ *
+ *  The edges ("faces") are found by matching node pairs.  Each face has
+ *  an owner cell, across which its unit normal points outward, and a
+ *  neighbor cell, which is -1 on the boundary.  Boundary faces normal
+ *  to the x or y axis are assigned the Cartesian side (WEST, EAST,
+ *  SOUTH, NORTH) they face, so that the usual boundary conditions
+ *  apply; any other boundary face is vacuum.
+ *
+ *  Subclasses building special meshes (e.g. MeshHex) may reassign the
+ *  boundary sides and may pair boundary faces for rotational symmetry:
+ *  the partner of a face is the face onto which a rotation of the whole
+ *  problem carries it.
+ *
+ *  Optionally, the polygons are extruded over an axial mesh to give a
+ *  three-dimensional mesh of prisms.  The lateral faces are then those
+ *  of the polygons in each layer, while the axial faces are the polygons
+ *  at each axial plane, the outer of which are the BOTTOM and TOP sides.
+ *  Cells, lateral faces, and axial faces are numbered layer by layer,
+ *  with the polygon (or polygon face) index fastest.
+ *
+ *  As for MeshCSG, the cells are exposed to the transport operators,
+ *  which need only the number of cells, their volumes, and the mesh
+ *  maps, as a single row of "cells" whose widths are the polygon areas
+ *  (stacked over the axial mesh, if any).  The geometric queries of
+ *  Mesh (e.g. find_cell) do not apply; use the face connectivity below
+ *  instead.  The connectivity is that of the polygons, with cells and
+ *  faces indexed within a layer.  Only the "usd" equation may be used,
+ *  and coarse mesh acceleration is rejected (see is_cartesian).
+ */
+//---------------------------------------------------------------------------//
+class GEOMETRY_EXPORT MeshUnstructured: public Mesh
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<MeshUnstructured>    SP_mesh;
+  typedef Mesh                                      Base;
+  typedef Base::SP_mesh                             SP_base;
+  typedef detran_utilities::vec2_int                vec2_int;
+  typedef detran_utilities::Point                   Point;
+  typedef std::vector<Point>                        vec_point;
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC INTERFACE
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor.
+   *  @param x          Node x coordinates
+   *  @param y          Node y coordinates
+   *  @param cells      Nodes of each cell, in order around the cell
+   *  @param mat_map    Material of each polygon, or of each cell if
+   *                    extruded and the materials vary axially
+   *  @param z          Axial mesh edges for an extruded mesh (optional)
+   */
+  MeshUnstructured(vec_dbl  x,
+                   vec_dbl  y,
+                   vec2_int cells,
+                   vec_int  mat_map,
+                   vec_dbl  z = vec_dbl(0));
+
+  /// SP constructor
+  static SP_base Create(vec_dbl  x,
+                        vec_dbl  y,
+                        vec2_int cells,
+                        vec_int  mat_map,
+                        vec_dbl  z = vec_dbl(0))
+  {
+    SP_base p(new MeshUnstructured(x, y, cells, mat_map, z));
+    return p;
+  }
+
+  /// The polygons are not a Cartesian grid.
+  bool is_cartesian() const { return false; }
+
+  /// Number of polygons (the cells of a layer)
+  size_t number_cells_2d() const { return d_cell_face.size(); }
+
+  /// Number of axial layers (one if not extruded)
+  size_t number_layers() const { return d_number_cells_z; }
+
+  /// Number of face flux unknowns, lateral and then axial, for an angle
+  size_t number_face_fluxes() const
+  {
+    if (d_dimension == 2) return number_faces();
+    return number_layers() * number_faces() +
+           (number_layers() + 1) * number_cells_2d();
+  }
+
+  /// Index of a lateral face flux
+  size_t lateral_face(const size_t f, const size_t k) const
+  {
+    Require(f < number_faces());
+    Require(k < number_layers());
+    return f + k * number_faces();
+  }
+
+  /// Index of an axial face flux (below layer k, or the top for k = nz)
+  size_t axial_face(const size_t c, const size_t k) const
+  {
+    Require(d_dimension == 3);
+    Require(c < number_cells_2d());
+    Require(k <= number_layers());
+    return number_layers() * number_faces() + c + k * number_cells_2d();
+  }
+
+  /// Number of nodes
+  size_t number_nodes() const { return d_node.size(); }
+
+  /// Node coordinates
+  const Point& node(const size_t n) const
+  {
+    Require(n < d_node.size());
+    return d_node[n];
+  }
+
+  /// Number of faces
+  size_t number_faces() const { return d_face_length.size(); }
+
+  /// Owner (side 0) or neighbor (side 1) of a face; -1 off the mesh
+  int face_cell(const size_t f, const size_t side) const
+  {
+    Require(f < number_faces());
+    Require(side < 2);
+    return d_face_cell[side][f];
+  }
+
+  /// Is a face on the boundary?
+  bool is_boundary(const size_t f) const
+  {
+    return face_cell(f, 1) < 0;
+  }
+
+  /// Side of a boundary face, or -1
+  int face_side(const size_t f) const
+  {
+    Require(f < number_faces());
+    return d_face_side[f];
+  }
+
+  /// Rotational partner of a boundary face, or -1
+  int face_partner(const size_t f) const
+  {
+    Require(f < number_faces());
+    return d_face_partner[f];
+  }
+
+  /// Face length
+  double face_length(const size_t f) const
+  {
+    Require(f < number_faces());
+    return d_face_length[f];
+  }
+
+  /// Unit face normal, pointing out of the owner
+  const Point& face_normal(const size_t f) const
+  {
+    Require(f < number_faces());
+    return d_face_normal[f];
+  }
+
+  /// Face midpoint
+  const Point& face_center(const size_t f) const
+  {
+    Require(f < number_faces());
+    return d_face_center[f];
+  }
+
+  /// Number of faces of a cell
+  size_t number_cell_faces(const size_t c) const
+  {
+    Require(c < number_cells_2d());
+    return d_cell_face[c].size();
+  }
+
+  /// Global index of a cell's face
+  size_t cell_face(const size_t c, const size_t i) const
+  {
+    Require(i < number_cell_faces(c));
+    return d_cell_face[c][i];
+  }
+
+  /// +1 if a cell owns its face (normal outward), otherwise -1
+  int cell_face_sign(const size_t c, const size_t i) const
+  {
+    Require(i < number_cell_faces(c));
+    return d_cell_face_sign[c][i];
+  }
+
+  /// Cell across a cell's face, or -1 on the boundary
+  int cell_neighbor(const size_t c, const size_t i) const
+  {
+    size_t f = cell_face(c, i);
+    return d_cell_face_sign[c][i] > 0 ? d_face_cell[1][f] : d_face_cell[0][f];
+  }
+
+  /// Cell centroid
+  const Point& cell_centroid(const size_t c) const
+  {
+    Require(c < number_cells_2d());
+    return d_centroid[c];
+  }
+
+  /// Polygon area
+  double cell_area(const size_t c) const
+  {
+    Require(c < number_cells_2d());
+    return d_dx[c];
+  }
+
+protected:
+
+  /// Constructor for subclasses, which must call build
+  MeshUnstructured() : Mesh(2) {}
+
+  /// Build the mesh (see the constructor)
+  void build(vec_dbl  x,
+             vec_dbl  y,
+             vec2_int cells,
+             vec_int  mat_map,
+             vec_dbl  z);
+
+  /// Reassign the side of a boundary face
+  void set_face_side(const size_t f, const int side);
+
+  /// Pair two boundary faces for rotational symmetry
+  void set_face_partner(const size_t f, const size_t g);
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Nodes
+  vec_point d_node;
+  /// Owner [0] and neighbor [1] of each face
+  vec2_int d_face_cell;
+  /// Side of each boundary face
+  vec_int d_face_side;
+  /// Rotational partner of each boundary face
+  vec_int d_face_partner;
+  /// Face lengths
+  vec_dbl d_face_length;
+  /// Face normals
+  vec_point d_face_normal;
+  /// Face midpoints
+  vec_point d_face_center;
+  /// Faces of each cell, in order around the cell
+  vec2_int d_cell_face;
+  /// Orientation of each cell's faces
+  vec2_int d_cell_face_sign;
+  /// Cell centroids
+  vec_point d_centroid;
+
+};
+
+GEOMETRY_TEMPLATE_EXPORT(detran_utilities::SP<MeshUnstructured>)
+
+} // end namespace detran_geometry
+
+#endif /* detran_geometry_MESHUNSTRUCTURED_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of MeshUnstructured.hh
+//---------------------------------------------------------------------------//
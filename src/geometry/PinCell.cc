@@ -7,6 +7,7 @@
 //---------------------------------------------------------------------------//
 
 #include "PinCell.hh"
+#include "utilities/Constants.hh"
 #include "utilities/SoftEquivalence.hh"
 #include "utilities/Warning.hh"
 #include <cmath>
@@ -21,6 +22,7 @@ PinCell::PinCell(double pitch, vec_dbl radii, vec_int mat_map, bool fuel_flag)
   , d_radii(radii)
   , d_mat_map(mat_map)
   , d_fuel_flag(fuel_flag)
+  , d_number_sectors(1)
 {
   Require(d_pitch > 0.0);
   Require(d_mat_map.size() == 1 + d_radii.size());
@@ -212,6 +214,102 @@ int PinCell::find_region(int i, int j, double width)
   return r;
 }
 
+//---------------------------------------------------------------------------//
+void PinCell::set_number_sectors(int number_sectors)
+{
+  Insist(number_sectors == 1 || number_sectors == 2 ||
+         number_sectors == 4 || number_sectors == 8,
+         "A pin cell can have only 1, 2, 4, or 8 sectors.");
+  d_number_sectors = number_sectors;
+}
+
+//---------------------------------------------------------------------------//
+int PinCell::find_region(const detran_utilities::Point &p) const
+{
+  double hp = 0.5 * d_pitch;
+  double x = p.x() - hp;
+  double y = p.y() - hp;
+
+  // Ring, starting off in the outer region.
+  int r = d_radii.size();
+  double rho = std::sqrt(x * x + y * y);
+  for (size_t k = 0; k < d_radii.size(); k++)
+  {
+    if (rho < d_radii[k])
+    {
+      r = k;
+      break;
+    }
+  }
+
+  // Sector
+  int s = 0;
+  if (d_number_sectors > 1)
+  {
+    double theta = std::atan2(y, x);
+    if (theta < 0.0) theta += detran_utilities::two_pi;
+    s = (int) (theta * d_number_sectors / detran_utilities::two_pi);
+    if (s == d_number_sectors) s = 0;
+  }
+
+  return r * d_number_sectors + s;
+}
+
+//---------------------------------------------------------------------------//
+double PinCell::region_volume(int r) const
+{
+  Require(r < number_regions());
+  Require(d_radii.empty() || d_radii.back() <= 0.5 * d_pitch);
+  int ring = r / d_number_sectors;
+  double inner = ring > 0 ? d_radii[ring - 1] : 0.0;
+  double v = 0.0;
+  if (ring < d_radii.size())
+    v = detran_utilities::pi * (d_radii[ring] * d_radii[ring] - inner * inner);
+  else
+    v = d_pitch * d_pitch - detran_utilities::pi * inner * inner;
+  // The square is symmetric about each sector plane.
+  return v / d_number_sectors;
+}
+
+//---------------------------------------------------------------------------//
+void PinCell::intersect(const detran_utilities::Point &p0,
+                        const detran_utilities::Point &p1,
+                        vec_dbl                       &t) const
+{
+  double hp = 0.5 * d_pitch;
+  double x = p0.x() - hp;
+  double y = p0.y() - hp;
+  double u = p1.x() - p0.x();
+  double v = p1.y() - p0.y();
+
+  // Circles: |p0 + t (p1 - p0) - c|^2 = r^2
+  double a = u * u + v * v;
+  double b = 2.0 * (x * u + y * v);
+  for (size_t k = 0; k < d_radii.size(); k++)
+  {
+    double c = x * x + y * y - d_radii[k] * d_radii[k];
+    double disc = b * b - 4.0 * a * c;
+    if (disc <= 0.0) continue;
+    disc = std::sqrt(disc);
+    double tt[] = {(-b - disc) / (2.0 * a), (-b + disc) / (2.0 * a)};
+    for (int i = 0; i < 2; i++)
+      if (tt[i] > 0.0 && tt[i] < 1.0) t.push_back(tt[i]);
+  }
+
+  // Sector planes, i.e. lines through the center at the sector angles
+  // below pi, with normals (-sin, cos)
+  for (int k = 0; k < d_number_sectors / 2; k++)
+  {
+    double theta = detran_utilities::two_pi * k / d_number_sectors;
+    double nx = -std::sin(theta);
+    double ny = std::cos(theta);
+    double denominator = nx * u + ny * v;
+    if (denominator == 0.0) continue;
+    double tt = -(nx * x + ny * y) / denominator;
+    if (tt > 0.0 && tt < 1.0) t.push_back(tt);
+  }
+}
+
 } // end namespace detran_geometry
 
 
@@ -48,6 +48,17 @@ namespace detran_geometry
  *  \f ]
  *  Note, the initial decision to use a single step of half the face
  *  width was arbitrary.
+ *
+ *  Alternatively, the pin cell can be used as exact constructive solid
+ *  geometry (see MeshCSG).  The cell is then divided into rings by the
+ *  circles and, optionally, into equal azimuthal sectors by planes
+ *  through its center.  The rings and sectors are the flat source
+ *  regions, which tracks intersect directly via intersect().  Region
+ *  $ r s + k $ is sector $ k $ of ring $ r $, where the
+ *  rings are numbered from the center outward (so that the last is the
+ *  moderator outside the outer circle) and $ s $ is the number of
+ *  sectors.  Sector $ k $ spans the angles
+ *  $ [2\pi k/s, 2\pi (k+1)/s) $ about the center.
  */
 //---------------------------------------------------------------------------//
 class GEOMETRY_EXPORT PinCell
@@ -104,6 +115,68 @@ public:
     return d_fuel_flag;
   }
 
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTIVE SOLID GEOMETRY
+  //-------------------------------------------------------------------------//
+
+  /// Pin cell pitch
+  double pitch() const
+  {
+    return d_pitch;
+  }
+
+  /**
+   *  @brief Divide each ring into equal azimuthal sectors.
+   *
+   *  Only 1, 2, 4, or 8 sectors are allowed, for which the moderator
+   *  sectors have equal areas.
+   */
+  void set_number_sectors(int number_sectors);
+
+  /// Number of azimuthal sectors per ring
+  int number_sectors() const
+  {
+    return d_number_sectors;
+  }
+
+  /// Number of flat source regions, i.e. rings times sectors
+  int number_regions() const
+  {
+    return (d_radii.size() + 1) * d_number_sectors;
+  }
+
+  /**
+   *  @brief Find the region containing a point.
+   *  @param p  Point relative to the lower left corner of the cell
+   *  @return   Region index
+   */
+  int find_region(const detran_utilities::Point &p) const;
+
+  /// Material of a region
+  int region_material(int r) const
+  {
+    Require(r < number_regions());
+    return d_mat_map[r / d_number_sectors];
+  }
+
+  /// Exact area of a region
+  double region_volume(int r) const;
+
+  /**
+   *  @brief Find where a chord crosses the region boundaries.
+   *
+   *  The chord $ p_0 + t (p_1 - p_0) $ is intersected with the
+   *  circles and the sector planes.  The parameters $ t \in (0, 1) $
+   *  of the crossings are appended, unsorted.
+   *
+   *  @param p0  Chord start relative to the lower left corner of the cell
+   *  @param p1  Chord end relative to the lower left corner of the cell
+   *  @param t   Crossing parameters
+   */
+  void intersect(const detran_utilities::Point &p0,
+                 const detran_utilities::Point &p1,
+                 vec_dbl                       &t) const;
+
 private:
 
   //-------------------------------------------------------------------------//
@@ -120,6 +193,8 @@ private:
   vec_int d_mat_map;
   /// Fuel flag (true if fuel).
   bool d_fuel_flag;
+  /// Number of azimuthal sectors per ring.
+  int d_number_sectors;
 
   //-------------------------------------------------------------------------//
   // IMPLEMENTATION
@@ -88,6 +88,11 @@ public:
   {
     d_segments.push_back(s);
   }
+  /// Release the segments, e.g. once they are stored elsewhere
+  void clear_segments()
+  {
+    vec_segment().swap(d_segments);
+  }
 
   /// Mutable reference to segment
   Segment& segment(size_t i)
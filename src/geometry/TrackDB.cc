@@ -8,48 +8,425 @@
 //---------------------------------------------------------------------------//
 
 #include "TrackDB.hh"
+#include "Tracker.hh"
+#include <fstream>
 #include <iostream>
+#include <map>
+#include <set>
 
 namespace detran_geometry
 {
 
+//---------------------------------------------------------------------------//
+// Identifies a track file and its layout version.
+static const char track_file_magic[8] = {'D','T','R','N','T','R','K','1'};
+
+//---------------------------------------------------------------------------//
+void TrackDB::finalize()
+{
+  // Offsets of each azimuth's tracks
+  d_track_offset.assign(d_tracks.size() + 1, 0);
+  for (size_t a = 0; a < d_tracks.size(); a++)
+    d_track_offset[a + 1] = d_track_offset[a] + d_tracks[a].size();
+
+  d_finalized = true;
+
+  // Tracks whose segments are stored: none, all tracks, or the module
+  // tracks
+  vec_track stored;
+  if (is_otf())
+  {
+    // Nothing is stored.
+  }
+  else if (is_modular())
+  {
+    stored = d_module_tracks;
+  }
+  else
+  {
+    for (size_t a = 0; a < d_tracks.size(); a++)
+      stored.insert(stored.end(), d_tracks[a].begin(), d_tracks[a].end());
+  }
+
+  // Offsets of each stored track's segments
+  d_segment_offset.assign(stored.size() + 1, 0);
+  for (size_t k = 0; k < stored.size(); k++)
+    d_segment_offset[k + 1] = d_segment_offset[k] + stored[k]->number_segments();
+
+  // Segment data
+  d_segment_region.resize(d_segment_offset.back());
+  d_segment_length.resize(d_segment_offset.back());
+  int i = 0;
+  for (size_t k = 0; k < stored.size(); k++)
+  {
+    for (int s = 0; s < stored[k]->number_segments(); s++, i++)
+    {
+      d_segment_region[i] = stored[k]->segment(s).region();
+      d_segment_length[i] = stored[k]->segment(s).length();
+    }
+    stored[k]->clear_segments();
+  }
+
+  // Pieces of each track
+  if (is_modular())
+  {
+    d_piece_offset.assign(d_track_offset.back() + 1, 0);
+    d_piece_base.clear();
+    d_piece_track.clear();
+    int k = 0;
+    for (size_t a = 0; a < d_tracks.size(); a++)
+    {
+      for (size_t t = 0; t < d_tracks[a].size(); t++, k++)
+      {
+        Insist(a < d_pieces.size() && t < d_pieces[a].size() &&
+               !d_pieces[a][t].empty(), "Modular track has no pieces.");
+        const vec_int &pieces = d_pieces[a][t];
+        for (size_t p = 0; p < pieces.size(); p += 2)
+        {
+          d_piece_base.push_back(pieces[p]);
+          d_piece_track.push_back(pieces[p + 1]);
+        }
+        d_piece_offset[k + 1] = d_piece_base.size();
+      }
+    }
+    std::vector<std::vector<vec_int> >().swap(d_pieces);
+  }
+}
+
+//---------------------------------------------------------------------------//
+int TrackDB::segments(size_t a, size_t t,
+                      const int*    &region,
+                      const double* &length,
+                      SegmentBuffer &buffer) const
+{
+  Require(is_finalized());
+  Require(a < d_tracks.size());
+  Require(t < d_tracks[a].size());
+
+  int k = d_track_offset[a] + t;
+
+  if (is_otf())
+  {
+    buffer.region.clear();
+    buffer.length.clear();
+    Tracker::trace_segments(d_tracks[a][t]->enter(), d_tracks[a][t]->exit(),
+                            d_grid_x, d_grid_y, buffer.region, buffer.length);
+    for (size_t s = 0; s < buffer.region.size(); s++)
+      buffer.length[s] *= d_region_factor[buffer.region[s]];
+    region = buffer.region.empty() ? 0 : &buffer.region[0];
+    length = buffer.length.empty() ? 0 : &buffer.length[0];
+    return buffer.region.size();
+  }
+
+  if (!is_modular())
+  {
+    int s0 = d_segment_offset[k];
+    region = &d_segment_region[0] + s0;
+    length = &d_segment_length[0] + s0;
+    return d_segment_offset[k + 1] - s0;
+  }
+
+  // Expand the pieces.
+  buffer.region.clear();
+  buffer.length.clear();
+  for (int p = d_piece_offset[k]; p < d_piece_offset[k + 1]; p++)
+  {
+    int base = d_piece_base[p];
+    int m    = d_piece_track[p];
+    for (int s = d_segment_offset[m]; s < d_segment_offset[m + 1]; s++)
+    {
+      buffer.region.push_back(base + d_segment_region[s]);
+      buffer.length.push_back(d_segment_length[s]);
+    }
+  }
+  region = buffer.region.empty() ? 0 : &buffer.region[0];
+  length = buffer.length.empty() ? 0 : &buffer.length[0];
+  return buffer.region.size();
+}
+
+//---------------------------------------------------------------------------//
 void TrackDB::normalize(vec_dbl &volume)
 {
+  Require(is_finalized());
+  Require(volume.size() == (size_t) d_number_regions);
+
+  // Tracked volume of each region
   vec_dbl appx_volume(volume.size(), 0.0);
+  SegmentBuffer buffer;
   for (size_t a = 0; a < d_tracks.size(); a++)
   {
+    double w = d_spacing[a] * d_quadrature->azimuth_weight(a) /
+               detran_utilities::pi;
     for (size_t t = 0; t < d_tracks[a].size(); t++)
     {
-      for (int s = 0; s < d_tracks[a][t]->number_segments(); s++)
+      const int    *region = 0;
+      const double *length = 0;
+      int n = segments(a, t, region, length, buffer);
+      for (int s = 0; s < n; s++)
       {
-        int region = d_tracks[a][t]->segment(s).region();
-        Assert(region < d_number_regions);
-        appx_volume[region] +=
-          d_tracks[a][t]->segment(s).length() * d_spacing[a] *
-            d_quadrature->azimuth_weight(a) / detran_utilities::pi;
+        Assert(region[s] < d_number_regions);
+        appx_volume[region[s]] += length[s] * w;
       }
     }
   }
-//  for (int r = 0; r < d_number_regions; r++)
-//  {
-//    std::cout << " REGION: " << r
-//              << " volume: " << volume[r]
-//              << " appx: " << appx_volume[r] << std::endl;
-//  }
-  for (size_t a = 0; a < d_tracks.size(); a++)
+
+  // Segments generated on the fly are scaled by region.
+  if (is_otf())
   {
-    for (size_t t = 0; t < d_tracks[a].size(); t++)
+    for (int r = 0; r < d_number_regions; r++)
+      d_region_factor[r] *= volume[r] / appx_volume[r];
+    return;
+  }
+
+  // Scale factor for each stored segment
+  vec_dbl factor(d_segment_region.size(), 0.0);
+  if (!is_modular())
+  {
+    for (size_t s = 0; s < factor.size(); s++)
+    {
+      int r = d_segment_region[s];
+      factor[s] = volume[r] / appx_volume[r];
+    }
+  }
+  else
+  {
+    // Sum the true and tracked volumes over all instances of each
+    // module cell, identified by its offset.
+    std::set<int> bases(d_piece_base.begin(), d_piece_base.end());
+    std::set<int> offsets(d_segment_region.begin(), d_segment_region.end());
+    std::map<int, double> true_local, appx_local;
+    for (std::set<int>::iterator o = offsets.begin(); o != offsets.end(); ++o)
+    {
+      for (std::set<int>::iterator b = bases.begin(); b != bases.end(); ++b)
+      {
+        true_local[*o] += volume[*b + *o];
+        appx_local[*o] += appx_volume[*b + *o];
+      }
+    }
+    for (size_t s = 0; s < factor.size(); s++)
     {
-      for (int s = 0; s < d_tracks[a][t]->number_segments(); s++)
+      int o = d_segment_region[s];
+      factor[s] = true_local[o] / appx_local[o];
+    }
+  }
+
+  // Scale the packed segments.
+  for (size_t s = 0; s < factor.size(); s++)
+    d_segment_length[s] *= factor[s];
+}
+
+//---------------------------------------------------------------------------//
+void TrackDB::compute_centroids()
+{
+  Require(is_finalized());
+
+  d_centroid.assign(2 * d_number_regions, 0.0);
+  d_moments.assign(3 * d_number_regions, 0.0);
+  vec_dbl weight(d_number_regions, 0.0);
+
+  // The first pass yields the centroids, and the second the moments
+  // about them.  A segment of length l centered at m with direction
+  // u contributes l (m - c)(m - c)^T + (l^3 / 12) u u^T.
+  SegmentBuffer buffer;
+  for (int pass = 0; pass < 2; ++pass)
+  {
+    for (size_t a = 0; a < d_tracks.size(); ++a)
+    {
+      double w = d_spacing[a] * d_quadrature->azimuth_weight(a);
+      for (size_t t = 0; t < d_tracks[a].size(); ++t)
       {
-        int r = d_tracks[a][t]->segment(s).region();
-        d_tracks[a][t]->segment(s).scale(volume[r]/appx_volume[r]);
+        const int    *region = 0;
+        const double *length = 0;
+        int n = segments(a, t, region, length, buffer);
+        if (n == 0) continue;
+        Point r0 = d_tracks[a][t]->enter();
+        Point r1 = d_tracks[a][t]->exit();
+        double L = distance(r0, r1);
+        double total = 0.0;
+        for (int s = 0; s < n; ++s)
+          total += length[s];
+        double ux = (r1.x() - r0.x()) / L;
+        double uy = (r1.y() - r0.y()) / L;
+        double scale = L / total;
+        double x = r0.x();
+        double y = r0.y();
+        for (int s = 0; s < n; ++s)
+        {
+          int r = region[s];
+          double l  = length[s] * scale;
+          double mx = x + 0.5 * l * ux;
+          double my = y + 0.5 * l * uy;
+          if (pass == 0)
+          {
+            d_centroid[2 * r]     += w * length[s] * mx;
+            d_centroid[2 * r + 1] += w * length[s] * my;
+            weight[r]             += w * length[s];
+          }
+          else
+          {
+            double dx = mx - d_centroid[2 * r];
+            double dy = my - d_centroid[2 * r + 1];
+            double l2 = l * l / 12.0;
+            d_moments[3 * r]     += w * length[s] * (dx * dx + l2 * ux * ux);
+            d_moments[3 * r + 1] += w * length[s] * (dx * dy + l2 * ux * uy);
+            d_moments[3 * r + 2] += w * length[s] * (dy * dy + l2 * uy * uy);
+          }
+          x += l * ux;
+          y += l * uy;
+        }
       }
     }
+    for (int r = 0; r < d_number_regions; ++r)
+    {
+      Insist(weight[r] > 0.0, "A region is not crossed by any track.");
+      if (pass == 0)
+      {
+        d_centroid[2 * r]     /= weight[r];
+        d_centroid[2 * r + 1] /= weight[r];
+      }
+      else
+      {
+        for (int i = 0; i < 3; ++i)
+          d_moments[3 * r + i] /= weight[r];
+      }
+    }
+  }
+}
+
+//---------------------------------------------------------------------------//
+bool TrackDB::write(const std::string &filename, const key_type key) const
+{
+  Require(is_finalized());
+  Require(!is_modular() && !is_otf());
+
+  std::ofstream out(filename.c_str(), std::ios::binary);
+  if (!out) return false;
+
+  int number_tracks   = d_track_offset.back();
+  int number_segments = d_segment_offset.back();
+  out.write(track_file_magic, sizeof(track_file_magic));
+  out.write((const char*) &key,               sizeof(key_type));
+  out.write((const char*) &d_number_azimuths, sizeof(int));
+  out.write((const char*) &d_number_regions,  sizeof(int));
+  out.write((const char*) &number_tracks,     sizeof(int));
+  out.write((const char*) &number_segments,   sizeof(int));
+
+  // Angles
+  out.write((const char*) &d_cos_phi[0],      d_number_azimuths * sizeof(double));
+  out.write((const char*) &d_sin_phi[0],      d_number_azimuths * sizeof(double));
+  out.write((const char*) &d_spacing[0],      d_number_azimuths * sizeof(double));
+  out.write((const char*) &d_track_offset[0], (d_number_azimuths + 1) * sizeof(int));
+
+  // Track end points
+  vec_dbl points(4 * number_tracks, 0.0);
+  int k = 0;
+  for (size_t a = 0; a < d_tracks.size(); a++)
+  {
+    for (size_t t = 0; t < d_tracks[a].size(); t++, k++)
+    {
+      points[4 * k + 0] = d_tracks[a][t]->enter().x();
+      points[4 * k + 1] = d_tracks[a][t]->enter().y();
+      points[4 * k + 2] = d_tracks[a][t]->exit().x();
+      points[4 * k + 3] = d_tracks[a][t]->exit().y();
+    }
+  }
+  if (number_tracks)
+    out.write((const char*) &points[0], points.size() * sizeof(double));
+
+  // Segments
+  out.write((const char*) &d_segment_offset[0], (number_tracks + 1) * sizeof(int));
+  if (number_segments)
+  {
+    out.write((const char*) &d_segment_region[0], number_segments * sizeof(int));
+    out.write((const char*) &d_segment_length[0], number_segments * sizeof(double));
   }
 
+  return out.good();
 }
 
+//---------------------------------------------------------------------------//
+bool TrackDB::read(const std::string &filename, const key_type key)
+{
+  Require(!is_finalized());
+  for (size_t a = 0; a < d_tracks.size(); a++)
+    Require(d_tracks[a].empty());
+
+  std::ifstream in(filename.c_str(), std::ios::binary);
+  if (!in) return false;
+
+  // Check the header
+  char magic[sizeof(track_file_magic)];
+  key_type file_key = 0;
+  int number_azimuths = 0, number_regions = 0;
+  int number_tracks = 0, number_segments = 0;
+  in.read(magic, sizeof(magic));
+  in.read((char*) &file_key,        sizeof(key_type));
+  in.read((char*) &number_azimuths, sizeof(int));
+  in.read((char*) &number_regions,  sizeof(int));
+  in.read((char*) &number_tracks,   sizeof(int));
+  in.read((char*) &number_segments, sizeof(int));
+  if (!in ||
+      std::string(magic, sizeof(magic)) !=
+        std::string(track_file_magic, sizeof(track_file_magic)) ||
+      file_key != key ||
+      number_azimuths != d_number_azimuths ||
+      number_regions != d_number_regions ||
+      number_tracks < 0 || number_segments < 0)
+  {
+    return false;
+  }
+
+  // Read everything before touching the database.
+  vec_dbl cos_phi(number_azimuths), sin_phi(number_azimuths);
+  vec_dbl spacing(number_azimuths);
+  vec_int track_offset(number_azimuths + 1);
+  vec_dbl points(4 * number_tracks);
+  vec_int segment_offset(number_tracks + 1);
+  vec_int segment_region(number_segments);
+  vec_dbl segment_length(number_segments);
+  in.read((char*) &cos_phi[0],      number_azimuths * sizeof(double));
+  in.read((char*) &sin_phi[0],      number_azimuths * sizeof(double));
+  in.read((char*) &spacing[0],      number_azimuths * sizeof(double));
+  in.read((char*) &track_offset[0], (number_azimuths + 1) * sizeof(int));
+  if (number_tracks)
+    in.read((char*) &points[0], points.size() * sizeof(double));
+  in.read((char*) &segment_offset[0], (number_tracks + 1) * sizeof(int));
+  if (number_segments)
+  {
+    in.read((char*) &segment_region[0], number_segments * sizeof(int));
+    in.read((char*) &segment_length[0], number_segments * sizeof(double));
+  }
+  if (!in ||
+      track_offset.back() != number_tracks ||
+      segment_offset.back() != number_segments)
+  {
+    return false;
+  }
+
+  // Rebuild the tracks
+  d_cos_phi = cos_phi;
+  d_sin_phi = sin_phi;
+  d_spacing = spacing;
+  int k = 0;
+  for (int a = 0; a < number_azimuths; a++)
+  {
+    for (int t = track_offset[a]; t < track_offset[a + 1]; t++, k++)
+    {
+      d_tracks[a].push_back(
+        Track::Create(Point(points[4 * k + 0], points[4 * k + 1]),
+                      Point(points[4 * k + 2], points[4 * k + 3])));
+    }
+  }
+  d_track_offset.swap(track_offset);
+  d_segment_offset.swap(segment_offset);
+  d_segment_region.swap(segment_region);
+  d_segment_length.swap(segment_length);
+  d_finalized = true;
+
+  return true;
+}
+
+//---------------------------------------------------------------------------//
 void TrackDB::display() const
 {
   using std::cout;
@@ -59,12 +436,22 @@ void TrackDB::display() const
   cout << "TrackDB data" << endl;
   cout << "------------" << endl;
   cout << endl;
+  SegmentBuffer buffer;
   for (size_t a = 0; a < d_tracks.size(); a++)
   {
     cout << "    azimuth = " << a << endl;
     for (size_t t = 0; t < d_tracks[a].size(); t++)
     {
       cout << "       track = " << t << *d_tracks[a][t] << endl;
+      if (!d_finalized) continue;
+      const int    *region = 0;
+      const double *length = 0;
+      int n = segments(a, t, region, length, buffer);
+      for (int s = 0; s < n; s++)
+      {
+        cout << "          segment = " << s << " "
+             << Segment(region[s], length[s]) << endl;
+      }
     }
   }
 }
@@ -16,6 +16,8 @@
 #include "utilities/DBC.hh"
 #include "utilities/Definitions.hh"
 #include "utilities/SP.hh"
+#include <stdint.h>
+#include <string>
 #include <vector>
 
 namespace detran_geometry
@@ -39,6 +41,33 @@ namespace detran_geometry
  *  The track index in the other two octancts keeps
  *  the index of their reflection.
  *
+ *  Once all tracks are segmented, finalize() packs the segments
+ *  into contiguous region and length arrays indexed by a running
+ *  segment number, with the segments of track t of azimuth a
+ *  occupying [segment_begin(a, t), segment_end(a, t)).  The Track
+ *  objects then release their own segments, so each segment is
+ *  stored once, and the tracks remain only for geometric queries.
+ *
+ *  Alternatively, the database can be modular.  Segments are then
+ *  stored only for a set of module tracks crossing one module of a
+ *  lattice of geometrically identical modules, with regions given
+ *  as offsets from the module's first cell.  Each track is a chain
+ *  of pieces, each piece being a module track placed at a module
+ *  (i.e. given the module's first cell).  The tracks themselves
+ *  store no segments.
+ *
+ *  Finally, segments need not be stored at all.  In on-the-fly mode,
+ *  the database keeps only the Cartesian grid and a normalization
+ *  factor per region, and each track is ray traced again whenever
+ *  its segments are requested.  This trades the segment storage for
+ *  one traversal of the grid per track per sweep.
+ *
+ *  Use segments() to get the segments of a track in any case.
+ *
+ *  A finalized, non-modular database can be written to and read
+ *  from a binary file identified by a key (see Tracker).  The file
+ *  is a cache: it uses native byte order and is not meant to be
+ *  portable.
  */
 /*!
  *  \example geometry/test/test_TrackDB.cc
@@ -57,11 +86,20 @@ public:
   typedef detran_utilities::SP<TrackDB>               SP_trackdb;
   typedef detran_angle::QuadratureMOC::SP_quadrature  SP_quadrature;
   typedef Track::SP_track                             SP_track;
+  typedef Track::Point                                Point;
   typedef std::vector<SP_track>                       vec_track;
   typedef std::vector<vec_track>                      vec2_track;
   typedef detran_utilities::size_t                    size_t;
   typedef detran_utilities::vec_int                   vec_int;
   typedef detran_utilities::vec_dbl                   vec_dbl;
+  typedef uint64_t                                    key_type;
+
+  /// Scratch space for segments expanded from modular tracks
+  struct SegmentBuffer
+  {
+    vec_int region;
+    vec_dbl length;
+  };
 
   //-------------------------------------------------------------------------//
   // CONSTRUCTOR & DESTRUCTOR
@@ -79,6 +117,8 @@ public:
     , d_cos_phi(num_azimuths, 0.0)
     , d_sin_phi(num_azimuths, 0.0)
     , d_spacing(num_azimuths, 0.0)
+    , d_track_offset(num_azimuths + 1, 0)
+    , d_finalized(false)
   {
     Require(d_number_azimuths > 0);
     Require(d_number_regions > 0);
@@ -109,6 +149,11 @@ public:
     return d_tracks.size();
   }
 
+  int number_regions() const
+  {
+    return d_number_regions;
+  }
+
   double spacing(size_t a) const
   {
     Require(a < d_spacing.size());
@@ -118,6 +163,7 @@ public:
   void add_track(size_t a, SP_track t)
   {
     Require(a < d_tracks.size());
+    Require(!is_finalized());
     d_tracks[a].push_back(t);
   }
 
@@ -130,9 +176,220 @@ public:
     d_spacing[a] = space;
   }
 
-  /// Normalize the tracks given a vector of true volumes.
+  /**
+   *  @brief Add a module track
+   *  @param  t   Track in module coordinates whose segment regions are
+   *              offsets from the first cell of a module
+   *  @return     Index of the module track
+   */
+  int add_module_track(SP_track t)
+  {
+    Require(!is_finalized());
+    Require(!is_otf());
+    d_module_tracks.push_back(t);
+    return d_module_tracks.size() - 1;
+  }
+
+  /**
+   *  @brief Append a piece to a track of a modular database
+   *  @param  a       Azimuth
+   *  @param  t       Track
+   *  @param  base    First cell of the module crossed
+   *  @param  m       Module track crossing it
+   */
+  void add_piece(size_t a, size_t t, int base, size_t m)
+  {
+    Require(a < d_tracks.size());
+    Require(t < d_tracks[a].size());
+    Require(!is_finalized());
+    Require(m < d_module_tracks.size());
+    if (d_pieces.empty()) d_pieces.resize(d_tracks.size());
+    if (d_pieces[a].size() < d_tracks[a].size())
+      d_pieces[a].resize(d_tracks[a].size());
+    d_pieces[a][t].push_back(base);
+    d_pieces[a][t].push_back(m);
+  }
+
+  /// Are segments stored per module?
+  bool is_modular() const
+  {
+    return !d_module_tracks.empty();
+  }
+
+  /**
+   *  @brief Generate segments on the fly rather than storing them
+   *  @param  x   Grid edges in x
+   *  @param  y   Grid edges in y
+   */
+  void set_otf(const vec_dbl &x, const vec_dbl &y)
+  {
+    Require(!is_finalized());
+    Require(!is_modular());
+    Require(x.size() > 1 && y.size() > 1);
+    Require((x.size() - 1) * (y.size() - 1) == (size_t) d_number_regions);
+    d_grid_x = x;
+    d_grid_y = y;
+    d_region_factor.assign(d_number_regions, 1.0);
+  }
+
+  /// Are segments generated on the fly?
+  bool is_otf() const
+  {
+    return !d_grid_x.empty();
+  }
+
+  /// Number of module tracks
+  int number_module_tracks() const
+  {
+    return d_module_tracks.size();
+  }
+
+  /// Pack the track segments into contiguous arrays.
+  void finalize();
+
+  /// Have the segments been packed?
+  bool is_finalized() const
+  {
+    return d_finalized;
+  }
+
+  /// Total number of tracks over all azimuths
+  int number_tracks() const
+  {
+    Require(is_finalized());
+    return d_track_offset.back();
+  }
+
+  /// Total number of stored segments (over module tracks if modular,
+  /// none if generated on the fly)
+  int number_segments() const
+  {
+    Require(is_finalized());
+    return d_segment_region.size();
+  }
+
+  /// Index of the first segment of a track
+  int segment_begin(size_t a, size_t t) const
+  {
+    Require(is_finalized());
+    Require(!is_modular() && !is_otf());
+    Require(a < d_tracks.size());
+    Require(t < d_tracks[a].size());
+    return d_segment_offset[d_track_offset[a] + t];
+  }
+
+  /// Index one past the last segment of a track
+  int segment_end(size_t a, size_t t) const
+  {
+    Require(is_finalized());
+    Require(!is_modular() && !is_otf());
+    Require(a < d_tracks.size());
+    Require(t < d_tracks[a].size());
+    return d_segment_offset[d_track_offset[a] + t + 1];
+  }
+
+  /// Flat source region of a packed segment
+  int segment_region(size_t s) const
+  {
+    Require(s < d_segment_region.size());
+    return d_segment_region[s];
+  }
+
+  /// Length of a packed segment
+  double segment_length(size_t s) const
+  {
+    Require(s < d_segment_length.size());
+    return d_segment_length[s];
+  }
+
+  /**
+   *  @brief Get the segments of a track
+   *
+   *  For a packed database, the pointers refer to the database
+   *  itself.  Otherwise, the segments are expanded from the module
+   *  tracks or ray traced into the buffer, to which the pointers
+   *  then refer.
+   *
+   *  @param  a         Azimuth
+   *  @param  t         Track
+   *  @param  region    On output, the segment regions
+   *  @param  length    On output, the segment lengths
+   *  @param  buffer    Scratch space (one per thread)
+   *  @return           Number of segments
+   */
+  int segments(size_t a, size_t t,
+               const int*    &region,
+               const double* &length,
+               SegmentBuffer &buffer) const;
+
+  /**
+   *  @brief Normalize the tracks given a vector of true volumes.
+   *
+   *  Every region is scaled so that its tracked volume is exact.
+   *  For a modular database, the segments are shared, and so all
+   *  instances of a module cell are scaled together.
+   */
   void normalize(vec_dbl &volume);
 
+  /**
+   *  @brief Compute the centroid and spatial moments of each region
+   *
+   *  Linear source methods need, for each region, the centroid
+   *  @f$ \bar{\mathbf{x}} @f$ and the matrix of second moments
+   *  @f[
+   *      C = \frac{1}{V} \int_V (\mathbf{x} - \bar{\mathbf{x}})
+   *                            (\mathbf{x} - \bar{\mathbf{x}})^T dV \, ,
+   *  @f]
+   *  both integrated numerically over the tracks, i.e. consistently
+   *  with the sweep.  Positions along a track are found from its
+   *  entrance point and its (normalized) segment lengths, scaled to
+   *  the track's geometric length.  Call this after normalize().
+   */
+  void compute_centroids();
+
+  /// Have the region centroids been computed?
+  bool has_centroids() const
+  {
+    return !d_centroid.empty();
+  }
+
+  /// Centroid of a region
+  Point centroid(size_t r) const
+  {
+    Require(has_centroids());
+    Require(r < (size_t) d_number_regions);
+    return Point(d_centroid[2 * r], d_centroid[2 * r + 1]);
+  }
+
+  /// Second spatial moment (i, j) of a region, with 0 = x and 1 = y
+  double moment(size_t r, size_t i, size_t j) const
+  {
+    Require(has_centroids());
+    Require(r < (size_t) d_number_regions);
+    Require(i < 2 && j < 2);
+    return d_moments[3 * r + i + j];
+  }
+
+  /**
+   *  @brief Write the tracks to a binary file
+   *  @param filename   File name
+   *  @param key        Key identifying the geometry and quadrature
+   *  @return           true if the file was written
+   */
+  bool write(const std::string &filename, const key_type key) const;
+
+  /**
+   *  @brief Read the tracks from a binary file
+   *
+   *  The database must not yet hold any tracks.  Nothing is read
+   *  if the file is missing or was written for another key or size.
+   *
+   *  @param filename   File name
+   *  @param key        Key identifying the geometry and quadrature
+   *  @return           true if the tracks were read
+   */
+  bool read(const std::string &filename, const key_type key);
+
   /// Pretty display of all track
   void display() const;
 
@@ -156,6 +413,36 @@ private:
   vec_dbl d_sin_phi;
   /// Constant track spacing for each angle.
   vec_dbl d_spacing;
+  /// Index of the first track of each azimuth (size number_angles + 1)
+  vec_int d_track_offset;
+  /// Index of the first segment of each track (size number_tracks + 1)
+  vec_int d_segment_offset;
+  /// Flat source region of each segment
+  vec_int d_segment_region;
+  /// Length of each segment
+  vec_dbl d_segment_length;
+  /// Module tracks (if modular)
+  vec_track d_module_tracks;
+  /// Pieces of each track as (base, module track) pairs before packing
+  std::vector<std::vector<vec_int> > d_pieces;
+  /// Index of the first piece of each track (size number_tracks + 1)
+  vec_int d_piece_offset;
+  /// First cell of the module crossed by each piece
+  vec_int d_piece_base;
+  /// Module track of each piece
+  vec_int d_piece_track;
+  /// Grid edges in x (if generating segments on the fly)
+  vec_dbl d_grid_x;
+  /// Grid edges in y (if generating segments on the fly)
+  vec_dbl d_grid_y;
+  /// Normalization factor of each region (if generating on the fly)
+  vec_dbl d_region_factor;
+  /// Region centroids as (x, y) pairs
+  vec_dbl d_centroid;
+  /// Region second moments as (xx, xy, yy) triples
+  vec_dbl d_moments;
+  /// Flag indicating the database is ready for use
+  bool d_finalized;
 
 };
 
@@ -0,0 +1,162 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  TrackStack.cc
+ *  @brief TrackStack class member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "TrackStack.hh"
+#include <algorithm>
+#include <cmath>
+
+namespace detran_geometry
+{
+
+//---------------------------------------------------------------------------//
+TrackStack::TrackStack(SP_trackdb     tracks,
+                       SP_quadrature  quadrature,
+                       const vec_dbl &z,
+                       const size_t   number_z)
+  : d_number_z(number_z)
+  , d_spacing_z(0.0)
+  , d_number_regions_2d(0)
+  , d_z(2, z)
+{
+  Require(tracks);
+  Require(quadrature);
+  Insist(z.size() > 1, "The axial mesh needs at least one cell.");
+  Insist(d_number_z > 0, "The number of axial intercepts must be positive.");
+
+  d_number_regions_2d = tracks->number_regions();
+
+  // Mirror the axial edges for the downward family.
+  size_t nz = z.size() - 1;
+  double height = z[nz] - z[0];
+  for (size_t k = 0; k <= nz; ++k)
+  {
+    d_z[0][k] = z[k] - z[0];
+    d_z[1][k] = height - d_z[0][nz - k];
+  }
+  d_spacing_z = height / d_number_z;
+
+  // Polar slopes
+  size_t np = quadrature->number_polar_octant();
+  d_slope.resize(np, 0.0);
+  for (size_t p = 0; p < np; ++p)
+    d_slope[p] = quadrature->cos_theta(p) / quadrature->sin_theta(p);
+
+  // Count the tracks of each family.  Track j meets the domain if
+  // its height at the 2D track's end, (x - j) delta, is nonnegative.
+  size_t na = tracks->number_angles();
+  d_length.resize(na);
+  d_number.resize(na, vec2_int(np));
+  d_offset.resize(na, vec2_int(np));
+  for (size_t a = 0; a < na; ++a)
+  {
+    size_t nt = tracks->number_tracks_angle(a);
+    d_length[a].resize(nt, 0.0);
+    for (size_t t = 0; t < nt; ++t)
+    {
+      TrackDB::SP_track track = tracks->track(a, t);
+      d_length[a][t] = distance(track->enter(), track->exit());
+    }
+    for (size_t p = 0; p < np; ++p)
+    {
+      d_number[a][p].resize(nt, 0);
+      d_offset[a][p].resize(nt + 1, 0);
+      for (size_t t = 0; t < nt; ++t)
+      {
+        double x = d_number_z - 0.5 + d_length[a][t] * d_slope[p] / d_spacing_z;
+        d_number[a][p][t] = int(std::floor(x)) + 1;
+        d_offset[a][p][t + 1] = d_offset[a][p][t] + d_number[a][p][t];
+      }
+    }
+  }
+}
+
+//---------------------------------------------------------------------------//
+int TrackStack::segments(const size_t  a,
+                         const size_t  t,
+                         const size_t  p,
+                         const size_t  j,
+                         const bool    down,
+                         const bool    reverse,
+                         const int    *region,
+                         const double *length,
+                         const int     n,
+                         vec_int      &region_3d,
+                         vec_dbl      &length_3d) const
+{
+  Require(j < number_stacked(a, t, p));
+  Require(region);
+  Require(length);
+
+  region_3d.clear();
+  length_3d.clear();
+
+  const vec_dbl &z = d_z[down ? 1 : 0];
+  int nz = z.size() - 1;
+  double height = z[nz];
+
+  // Track height at the start of the 2D track and the interval of
+  // the 2D track within the domain.
+  double k  = d_slope[p];
+  double c  = (d_number_z - 0.5 - j) * d_spacing_z;
+  double L  = d_length[a][t];
+  double s0 = std::max(0.0, -c / k);
+  double s1 = std::min(L, (height - c) / k);
+
+  // Normalized segment lengths are converted to the geometric track.
+  double total = 0.0;
+  for (int i = 0; i < n; ++i)
+    total += length[i];
+  Assert(total > 0.0);
+  double scale = L / total;
+
+  // Starting axial cell
+  int kz = std::upper_bound(z.begin(), z.end(), c + k * s0) - z.begin() - 1;
+  kz = std::max(0, std::min(kz, nz - 1));
+
+  double s = 0.0;
+  for (int ii = 0; ii < n && s < s1; ++ii)
+  {
+    int i = reverse ? n - ii - 1 : ii;
+    double s_end = s + length[i] * scale;
+    double a0 = std::max(s, s0);
+    double b0 = std::min(s_end, s1);
+    while (a0 < b0)
+    {
+      // Cut at the next axial plane, if crossed.
+      double e = b0;
+      bool cross = false;
+      if (kz + 1 < nz)
+      {
+        double s_plane = (z[kz + 1] - c) / k;
+        if (s_plane < b0)
+        {
+          e = s_plane;
+          cross = true;
+        }
+      }
+      if (e > a0)
+      {
+        int k_actual = down ? nz - 1 - kz : kz;
+        region_3d.push_back(region[i] + k_actual * d_number_regions_2d);
+        length_3d.push_back((e - a0) / scale);
+      }
+      a0 = e;
+      if (!cross) break;
+      ++kz;
+    }
+    s = s_end;
+  }
+
+  return region_3d.size();
+}
+
+} // end namespace detran_geometry
+
+//---------------------------------------------------------------------------//
+//              end of TrackStack.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,202 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  TrackStack.hh
+ *  @brief TrackStack class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_geometry_TRACKSTACK_HH_
+#define detran_geometry_TRACKSTACK_HH_
+
+#include "TrackDB.hh"
+#include "utilities/DBC.hh"
+#include <vector>
+
+namespace detran_geometry
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class TrackStack
+ *  @brief Three-dimensional tracks stacked axially over two-dimensional ones.
+ *
+ *  An axially extruded problem is tracked by ray tracing its xy
+ *  projection (see Tracker) and then stacking, over each 2D track and
+ *  for each polar angle, a family of parallel 3D tracks lying in the
+ *  vertical plane of the 2D track.  The 3D tracks of a family are
+ *  spaced a constant distance \f$ \delta = H / n_z \f$ apart in z, where
+ *  \f$ H \f$ is the height of the domain and \f$ n_z \f$ is the number
+ *  of axial intercepts.  With \f$ s \f$ the distance travelled along
+ *  the 2D track and \f$ k = \cos\theta / \sin\theta \f$ the polar
+ *  slope, track j of the upward family is
+ *  @f[
+ *      z_j(s) = (n_z - 1/2 - j) \delta + k s \, ,
+ *  @f]
+ *  for all j for which the line meets the domain.  Tracks j < n_z
+ *  enter through the side at the center of axial bin n_z - 1 - j,
+ *  and the rest enter through the bottom.  The downward family is
+ *  the mirror image in z.  A track of one family leaving through the
+ *  top (bottom) continues as track j + n_z of the other family, which
+ *  starts at the same point, while a track leaving through a side
+ *  does so within axial bin floor(z / delta).
+ *
+ *  Since the 3D tracks need only the 2D segments, the polar slope,
+ *  and the axial mesh, their segments are never stored: segments()
+ *  cuts the 2D segments of a track at the axial mesh planes as the
+ *  sweep needs them.  The memory needed is that of the 2D tracking
+ *  plus a few integers per 2D track and polar angle.  Each 3D track
+ *  represents a volume \f$ \Delta \delta \f$ per unit projected
+ *  length, where \f$ \Delta \f$ is the 2D track spacing.  The tracked
+ *  volumes are exact (given normalized 2D segments) when each cell
+ *  height is a multiple of \f$ \delta \f$.
+ *
+ *  The 3D tracks of a 2D track are numbered consecutively, so that
+ *  those of an azimuth and polar angle have the flattened index
+ *  offset(a, p, t) + j.
+ */
+//---------------------------------------------------------------------------//
+class GEOMETRY_EXPORT TrackStack
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<TrackStack>            SP_trackstack;
+  typedef TrackDB::SP_trackdb                         SP_trackdb;
+  typedef TrackDB::SP_quadrature                      SP_quadrature;
+  typedef detran_utilities::size_t                    size_t;
+  typedef detran_utilities::vec_int                   vec_int;
+  typedef detran_utilities::vec2_int                  vec2_int;
+  typedef detran_utilities::vec3_int                  vec3_int;
+  typedef detran_utilities::vec_dbl                   vec_dbl;
+  typedef detran_utilities::vec2_dbl                  vec2_dbl;
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC INTERFACE
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param tracks       Tracks of the xy projection
+   *  @param quadrature   MOC quadrature giving the polar angles
+   *  @param z            Axial mesh edges
+   *  @param number_z     Number of axial intercepts on a side
+   */
+  TrackStack(SP_trackdb     tracks,
+             SP_quadrature  quadrature,
+             const vec_dbl &z,
+             const size_t   number_z);
+
+  /// Number of axial intercepts on a side
+  size_t number_z() const { return d_number_z; }
+
+  /// Axial track spacing
+  double spacing_z() const { return d_spacing_z; }
+
+  /// Number of 2D regions
+  size_t number_regions_2d() const { return d_number_regions_2d; }
+
+  /// Number of 3D tracks stacked over a 2D track
+  size_t number_stacked(const size_t a, const size_t t, const size_t p) const
+  {
+    Require(a < d_number.size());
+    Require(p < d_number[a].size());
+    Require(t < d_number[a][p].size());
+    return d_number[a][p][t];
+  }
+
+  /// Flattened index of the first 3D track stacked over a 2D track
+  size_t offset(const size_t a, const size_t p, const size_t t) const
+  {
+    Require(a < d_offset.size());
+    Require(p < d_offset[a].size());
+    Require(t < d_offset[a][p].size());
+    return d_offset[a][p][t];
+  }
+
+  /// Number of 3D tracks for an azimuth and polar angle
+  size_t number_tracks(const size_t a, const size_t p) const
+  {
+    Require(a < d_offset.size());
+    Require(p < d_offset[a].size());
+    return d_offset[a][p].back();
+  }
+
+  /**
+   *  @brief Axial bin through which a 3D track leaves a side
+   *  @return   The bin, or -1 if the track leaves through the top
+   *            (bottom, for the downward family)
+   */
+  int exit_bin(const size_t a, const size_t t, const size_t p,
+               const size_t j) const
+  {
+    Require(j < number_stacked(a, t, p));
+    int bin = d_number[a][p][t] - 1 - j;
+    return bin < (int) d_number_z ? bin : -1;
+  }
+
+  /**
+   *  @brief Cut the 2D segments of a track into those of a 3D track
+   *  @param  a         Azimuth of the 2D track
+   *  @param  t         2D track
+   *  @param  p         Polar index
+   *  @param  j         3D track in the family
+   *  @param  down      Is this the downward family?
+   *  @param  reverse   Is the 2D track traversed backward?
+   *  @param  region    2D segment regions
+   *  @param  length    2D segment lengths
+   *  @param  n         Number of 2D segments
+   *  @param  region_3d 3D segment regions (cardinal mesh index)
+   *  @param  length_3d 3D segment lengths projected onto the xy plane
+   *  @return           Number of 3D segments
+   */
+  int segments(const size_t  a,
+               const size_t  t,
+               const size_t  p,
+               const size_t  j,
+               const bool    down,
+               const bool    reverse,
+               const int    *region,
+               const double *length,
+               const int     n,
+               vec_int      &region_3d,
+               vec_dbl      &length_3d) const;
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Number of axial intercepts on a side
+  size_t d_number_z;
+  /// Axial track spacing
+  double d_spacing_z;
+  /// Number of 2D regions
+  size_t d_number_regions_2d;
+  /// Axial mesh edges for the upward [0] and (mirrored) downward [1] family
+  vec2_dbl d_z;
+  /// Polar slopes
+  vec_dbl d_slope;
+  /// Geometric 2D track lengths [azimuth][track]
+  vec2_dbl d_length;
+  /// Number of stacked tracks [azimuth][polar][track]
+  vec3_int d_number;
+  /// Flattened offsets [azimuth][polar][track + 1]
+  vec3_int d_offset;
+
+};
+
+GEOMETRY_TEMPLATE_EXPORT(detran_utilities::SP<TrackStack>)
+
+} // end namespace detran_geometry
+
+#endif /* detran_geometry_TRACKSTACK_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of TrackStack.hh
+//---------------------------------------------------------------------------//
@@ -8,19 +8,48 @@
 
 #include "Tracker.hh"
 #include "utilities/SoftEquivalence.hh"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
 #include <iostream>
+#include <map>
+#include <sstream>
 
 namespace detran_geometry
 {
 
-Tracker::Tracker(SP_mesh mesh, SP_quadrature quadrature)
+//---------------------------------------------------------------------------//
+// Fold bytes into a 64-bit FNV-1a hash.
+static void hash_bytes(Tracker::key_type &h, const void *data, size_t n)
+{
+  const unsigned char *c = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < n; i++)
+  {
+    h ^= c[i];
+    h *= 1099511628211ULL;
+  }
+}
+
+//---------------------------------------------------------------------------//
+Tracker::Tracker(SP_mesh mesh, SP_quadrature quadrature, SP_input input)
   : d_mesh(mesh)
   , d_quadrature(quadrature)
+  , d_csg(0)
+  , d_key(14695981039346656037ULL)
+  , d_cached(false)
 {
   Require(d_mesh);
-  Insist(d_mesh->dimension() == 2, "Only 2D MOC is currently supported.");
-  Insist(detran_utilities::soft_equiv(d_mesh->total_width_x(),
-                                      d_mesh->total_width_y()),
+
+  // Pin cells are tracked by cutting the segments of their base mesh.
+  d_csg = dynamic_cast<MeshCSG*>(d_mesh.bp());
+  d_grid = d_csg ? d_csg->base() : d_mesh;
+
+  // A 3D mesh is tracked in its xy projection, over which the 3D tracks
+  // are stacked.
+  Insist(d_grid->dimension() == 2 || (d_grid->dimension() == 3 && !d_csg),
+         "MOC requires a 2D mesh or a 3D Cartesian mesh.");
+  Insist(detran_utilities::soft_equiv(d_grid->total_width_x(),
+                                      d_grid->total_width_y()),
     "MOC is currently supported only on square domains");
   Require(d_quadrature);
   d_number_azimuths = d_quadrature->number_azimuths_octant();
@@ -33,12 +62,41 @@ Tracker::Tracker(SP_mesh mesh, SP_quadrature quadrature)
   //-------------------------------------------------------------------------//
 
   // Doing first two quadrants (eta > 0)
+  int number_regions = d_mesh->number_cells();
+  if (d_mesh->dimension() == 3)
+    number_regions = d_mesh->number_cells_x() * d_mesh->number_cells_y();
   d_trackdb = new TrackDB(2 * d_number_azimuths,
-                          d_mesh->number_cells(),
+                          number_regions,
                           d_quadrature);
 
   // Domain width (for x and y)
-  double width = d_mesh->total_width_x();
+  double width = d_grid->total_width_x();
+
+  // The key depends on the mesh edges...
+  int n[] = {(int) d_grid->number_cells_x(), (int) d_grid->number_cells_y()};
+  hash_bytes(d_key, n, sizeof(n));
+  for (int i = 0; i < n[0]; i++)
+  {
+    double dx = d_grid->dx(i);
+    hash_bytes(d_key, &dx, sizeof(double));
+  }
+  for (int j = 0; j < n[1]; j++)
+  {
+    double dy = d_grid->dy(j);
+    hash_bytes(d_key, &dy, sizeof(double));
+  }
+
+  // ... on the pin cell regions, if any, ...
+  if (d_csg)
+  {
+    int number_regions = d_mesh->number_cells();
+    hash_bytes(d_key, &number_regions, sizeof(int));
+    for (int r = 0; r < number_regions; r++)
+    {
+      double v = d_mesh->volume(r);
+      hash_bytes(d_key, &v, sizeof(double));
+    }
+  }
 
   // Loop over all azimuths in the first two quadrants
   for (int a = 0; a < 2 * d_number_azimuths; a++)
@@ -50,35 +108,111 @@ Tracker::Tracker(SP_mesh mesh, SP_quadrature quadrature)
                            d_quadrature->sin_phi(a),
                            width*d_quadrature->spacing(a));
 
+    // ... and on the track end points.
+    int number_tracks = d_quadrature->number_tracks(a);
+    hash_bytes(d_key, &number_tracks, sizeof(int));
     for (size_t t = 0; t < d_quadrature->number_tracks(a); t++)
     {
-
-      // Define the entrance and exit points on the actual mesh.
-      // \todo This assumes a square mesh.
       Point enter = width * d_quadrature->enter(a, t);
       Point exit = width * d_quadrature->exit(a, t);
+      double p[] = {enter.x(), enter.y(), exit.x(), exit.y()};
+      hash_bytes(d_key, p, sizeof(p));
+    }
+
+  } // end angle
+
+  //-------------------------------------------------------------------------//
+  // READ THE CACHED TRACKS OR GENERATE THEM
+  //-------------------------------------------------------------------------//
+
+  // Modules for modular tracking, if any.
+  std::string modules;
+  if (input && input->check("tracker_modules"))
+    modules = input->get<std::string>("tracker_modules");
+
+  // Generate segments on the fly?
+  bool otf = false;
+  if (input && input->check("tracker_otf"))
+    otf = input->get<int>("tracker_otf");
+  Insist(!(otf && !modules.empty()),
+         "Modular tracking and on-the-fly segments are exclusive.");
+  Insist(!(d_csg && (otf || !modules.empty())),
+         "Pin cells support neither modular nor on-the-fly tracking.");
+  Insist(!(d_mesh->dimension() == 3 && !modules.empty()),
+         "Modular tracking is not supported in 3D.");
+
+  // Only conventional tracks are cached.
+  std::string path;
+  if (input && input->check("tracker_cache_path") && modules.empty() && !otf)
+    path = input->get<std::string>("tracker_cache_path");
+
+  if (!path.empty()) d_cached = d_trackdb->read(cache_file(path), d_key);
+
+  if (!d_cached)
+  {
+    for (int a = 0; a < 2 * d_number_azimuths; a++)
+    {
+      for (size_t t = 0; t < d_quadrature->number_tracks(a); t++)
+      {
+        // Define the entrance and exit points on the actual mesh.
+        // \todo This assumes a square mesh.
+        Point enter = width * d_quadrature->enter(a, t);
+        Point exit = width * d_quadrature->exit(a, t);
 
-      // Create new track
-      SP_track track(new Track(enter, exit));
+        // Create new track
+        SP_track track(new Track(enter, exit));
 
-      // Add the track to the database.
-      d_trackdb->add_track(a, track);
+        // Add the track to the database.
+        d_trackdb->add_track(a, track);
 
-    } // end track
+      } // end track
+    } // end angle
 
-  } // end angle
+    // Do the actual track generation.
+    if (otf)
+      generate_otf_tracks();
+    else if (modules.empty())
+      generate_tracks();
+    else
+      generate_modular_tracks(modules);
+
+    if (!path.empty() && !d_trackdb->write(cache_file(path), d_key))
+    {
+      cout << "Warning: unable to write tracks to "
+           << cache_file(path) << endl;
+    }
+  }
 
+  //-------------------------------------------------------------------------//
+  // STACK THE 3D TRACKS
+  //-------------------------------------------------------------------------//
 
-  // Do the actual track generation.
-  generate_tracks();
+  if (d_mesh->dimension() == 3)
+  {
+    vec_dbl z(d_mesh->number_cells_z() + 1, 0.0);
+    for (size_t k = 0; k < d_mesh->number_cells_z(); k++)
+      z[k + 1] = z[k] + d_mesh->dz(k);
+    int number_z = 2 * d_mesh->number_cells_z();
+    if (input && input->check("tracker_number_z"))
+      number_z = input->get<int>("tracker_number_z");
+    d_stack = new TrackStack(d_trackdb, d_quadrature, z, number_z);
+  }
 
+  Ensure(d_trackdb->is_finalized());
 }
 
 void Tracker::normalize()
 {
-  vec_dbl volume(d_mesh->number_cells(), 0.0);
+  vec_dbl volume(d_trackdb->number_regions(), 0.0);
   for (size_t i = 0; i < volume.size(); i++)
-    volume[i] = d_mesh->volume(i);
+  {
+    // The tracks of a 3D mesh cross the areas of its projection.
+    if (d_mesh->dimension() == 3)
+      volume[i] = d_mesh->dx(d_mesh->cell_to_i(i)) *
+                  d_mesh->dy(d_mesh->cell_to_j(i));
+    else
+      volume[i] = d_mesh->volume(i);
+  }
   // Normalize track lengths by volume.
   d_trackdb->normalize(volume);
 }
@@ -89,9 +223,6 @@ void Tracker::normalize()
 
 void Tracker::generate_tracks()
 {
-
-  using std::cout;
-  using std::endl;
   /*
    *  for all azimuth
    *    for all origins
@@ -100,172 +231,375 @@ void Tracker::generate_tracks()
    *        ray trace the grid
    */
 
-  bool db = false;
-
   // Create the mesh grid.
-  d_x.resize(d_mesh->number_cells_x() + 1, 0.0);
-  d_y.resize(d_mesh->number_cells_y() + 1, 0.0);
+  build_grid();
+
+  // Gather all tracks so that each can be traced independently.
+  std::vector<Track*> tracks;
+  for (int a = 0; a < d_number_azimuths * 2; a++)
+    for (int t = 0; t < d_trackdb->number_tracks_angle(a); t++)
+      tracks.push_back(d_trackdb->track(a, t).bp());
+
+  // Tracks are of very different lengths, so assign them dynamically.
+  #pragma omp parallel for schedule(dynamic)
+  for (int k = 0; k < (int) tracks.size(); k++)
+  {
+    if (d_csg)
+      trace_csg(*tracks[k]);
+    else
+      trace(*tracks[k], d_x, d_y);
+  }
+
+  // Pack the segments.
+  d_trackdb->finalize();
+}
+
+void Tracker::generate_otf_tracks()
+{
+  // Only the grid is needed to trace the tracks later.
+  build_grid();
+  d_trackdb->set_otf(d_x, d_y);
+  d_trackdb->finalize();
+}
+
+void Tracker::build_grid()
+{
+  d_x.resize(d_grid->number_cells_x() + 1, 0.0);
+  d_y.resize(d_grid->number_cells_y() + 1, 0.0);
   for (size_t i = 0; i < d_x.size()-1; i++)
   {
-    d_x[i + 1] = d_x[i] + d_mesh->dx(i);
+    d_x[i + 1] = d_x[i] + d_grid->dx(i);
   }
   for (size_t i = 0; i < d_y.size()-1; i++)
   {
-    d_y[i + 1] = d_y[i] + d_mesh->dy(i);
+    d_y[i + 1] = d_y[i] + d_grid->dy(i);
   }
+}
 
-  // Loop through azimuths
-  for (int a = 0; a < d_number_azimuths * 2; a++)
-  {
-    if (db) cout << "AZIMUTH = " << a << endl;
-    if (db) cout << "    number tracks = " << d_trackdb->number_tracks_angle(a) << endl;
+void Tracker::generate_modular_tracks(const std::string &key)
+{
+  Insist(d_mesh->mesh_map_exists(key),
+         "Modular tracking requires the mesh map " + key);
+  const detran_utilities::vec_int &map = d_mesh->mesh_map(key);
 
-    // Loop through tracks
-    for (int t = 0; t < d_trackdb->number_tracks_angle(a); t++)
+  //-------------------------------------------------------------------------//
+  // IDENTIFY THE MODULE LATTICE
+  //-------------------------------------------------------------------------//
+
+  // Modules are the rectangular blocks of the map, which must all have
+  // the same cells as the first one.
+  int nx = d_mesh->number_cells_x();
+  int ny = d_mesh->number_cells_y();
+  int mx = 1;
+  while (mx < nx && map[mx] == map[0]) mx++;
+  int my = 1;
+  while (my < ny && map[my * nx] == map[0]) my++;
+  Insist(nx % mx == 0 && ny % my == 0,
+         "Modules must tile the mesh for modular tracking.");
+  for (int j = 0; j < ny; j++)
+  {
+    for (int i = 0; i < nx; i++)
     {
-      if (db) cout << "    TRACK = " << t << endl;
+      Insist(map[i + j * nx] == map[(i - i % mx) + (j - j % my) * nx],
+             "Modules must be rectangular blocks for modular tracking.");
+      Insist(detran_utilities::soft_equiv(d_mesh->dx(i), d_mesh->dx(i % mx)) &&
+             detran_utilities::soft_equiv(d_mesh->dy(j), d_mesh->dy(j % my)),
+             "Modules must be meshed identically for modular tracking.");
+    }
+  }
 
+  // Module grid and the lattice of modules
+  vec_dbl x(mx + 1, 0.0);
+  vec_dbl y(my + 1, 0.0);
+  for (int i = 0; i < mx; i++)
+    x[i + 1] = x[i] + d_mesh->dx(i);
+  for (int j = 0; j < my; j++)
+    y[j + 1] = y[j] + d_mesh->dy(j);
+  int number_x = nx / mx;
+  int number_y = ny / my;
+  vec_dbl lattice_x(number_x + 1, 0.0);
+  vec_dbl lattice_y(number_y + 1, 0.0);
+  for (int i = 0; i < number_x; i++)
+    lattice_x[i + 1] = lattice_x[i] + x[mx];
+  for (int j = 0; j < number_y; j++)
+    lattice_y[j + 1] = lattice_y[j] + y[my];
 
-      // Get the track
+  //-------------------------------------------------------------------------//
+  // CUT THE TRACKS INTO PIECES AND FIND THE UNIQUE MODULE TRACKS
+  //-------------------------------------------------------------------------//
+
+  double eps = 1.0e-9 * std::max(x[mx], y[my]);
+  typedef std::pair<int, std::vector<long> > piece_key;
+  std::map<piece_key, int> unique;
+  std::vector<SP_track> module_tracks;
+  for (int a = 0; a < d_number_azimuths * 2; a++)
+  {
+    for (int t = 0; t < d_trackdb->number_tracks_angle(a); t++)
+    {
+      // Trace the track over the lattice of modules.
       SP_track track = d_trackdb->track(a, t);
+      Track lattice_track(track->enter(), track->exit());
+      trace(lattice_track, lattice_x, lattice_y);
 
-      // Compute the track length
-      Point enter = track->enter();
-      Point exit  = track->exit();
-      double track_length = distance(enter, exit);
+      Point u = track->exit() - track->enter();
+      u = u * (1.0 / distance(track->enter(), track->exit()));
+      double s = 0.0;
+      for (int p = 0; p < lattice_track.number_segments(); p++)
+      {
+        int module = lattice_track.segment(p).region();
+        double length = lattice_track.segment(p).length();
+        Point r0 = track->enter() + u * s;
+        s += length;
+        if (length < eps) continue;
+        Point r1 = track->enter() + u * s;
+
+        // Local end points, snapped to the module edges
+        int I = module % number_x;
+        int J = module / number_x;
+        Point origin(lattice_x[I], lattice_y[J]);
+        double r[] = {(r0 - origin).x(), (r0 - origin).y(),
+                      (r1 - origin).x(), (r1 - origin).y()};
+        double w[] = {x[mx], y[my], x[mx], y[my]};
+        std::vector<long> code(4, 0);
+        for (int k = 0; k < 4; k++)
+        {
+          if (std::abs(r[k]) < eps) r[k] = 0.0;
+          if (std::abs(r[k] - w[k]) < eps) r[k] = w[k];
+          code[k] = (long) std::floor(r[k] / eps + 0.5);
+        }
 
-      // Compute tangent of angle with respect to x
-      Point p = exit - enter;
-      double tan_phi = p.y() / p.x();
-      double sin_phi = (exit.y()-enter.y()) / track_length;
-      double cos_phi = (exit.x()-enter.x()) / track_length;
-      if (db) cout << "        tan_phi = " << tan_phi << endl;
-      if (db) cout << "        sin_phi = " << sin_phi << endl;
-      if (db) cout << "        cos_phi = " << cos_phi << endl;
-      if (db) cout << "         length = " << track_length << endl;
+        // Reuse an identical module track or add a new one.
+        piece_key k(a, code);
+        std::map<piece_key, int>::iterator it = unique.find(k);
+        int m = 0;
+        if (it == unique.end())
+        {
+          m = module_tracks.size();
+          unique[k] = m;
+          module_tracks.push_back(Track::Create(Point(r[0], r[1]),
+                                                Point(r[2], r[3])));
+        }
+        else
+        {
+          m = it->second;
+        }
+        d_trackdb->add_piece(a, t, I * mx + J * my * nx, m);
+      }
+    }
+  }
 
-      // Find the starting cell
-      int IJ[] = {0, 0};
-      find_starting_cell(enter, tan_phi, IJ);
-      int I = IJ[0];
-      int J = IJ[1];
+  //-------------------------------------------------------------------------//
+  // TRACE THE MODULE TRACKS
+  //-------------------------------------------------------------------------//
 
-      // Get segments
-      double d_to_x = 0;
-      double d_to_y = 0;
-      p = enter;
+  #pragma omp parallel for schedule(dynamic)
+  for (int m = 0; m < (int) module_tracks.size(); m++)
+    trace(*module_tracks[m], x, y);
 
-      if (db) cout << "          ENTER = " << enter <<  endl;
-      if (db) cout << "           EXIT = " << exit << endl;
-      if (db) cout << "              I = " << I << endl;
-      if (db) cout << "              J = " << J << endl;
+  // Store the module tracks with regions as offsets from a module's
+  // first cell on the full mesh.
+  for (size_t m = 0; m < module_tracks.size(); m++)
+  {
+    SP_track track(new Track(module_tracks[m]->enter(),
+                             module_tracks[m]->exit()));
+    for (int s = 0; s < module_tracks[m]->number_segments(); s++)
+    {
+      const Segment &segment = module_tracks[m]->segment(s);
+      int i = segment.region() % mx;
+      int j = segment.region() / mx;
+      track->add_segment(Segment(i + j * nx, segment.length()));
+    }
+    d_trackdb->add_module_track(track);
+  }
 
+  d_trackdb->finalize();
+}
 
-      Assert(I <= d_mesh->number_cells_x());
-      Assert(J <= d_mesh->number_cells_y());
+void Tracker::trace(Track &track, const vec_dbl &x, const vec_dbl &y) const
+{
+  vec_int region;
+  vec_dbl length;
+  trace_segments(track.enter(), track.exit(), x, y, region, length);
+  for (size_t s = 0; s < region.size(); s++)
+    track.add_segment(Segment(region[s], length[s]));
+}
 
+void Tracker::trace_csg(Track &track) const
+{
+  Require(d_csg);
+
+  // Trace the base mesh.
+  vec_int cell;
+  vec_dbl length;
+  trace_segments(track.enter(), track.exit(), d_x, d_y, cell, length);
+
+  Point u = track.exit() - track.enter();
+  u = u * (1.0 / distance(track.enter(), track.exit()));
+  int number_x = d_x.size() - 1;
+  double s = 0.0;
+  vec_dbl t;
+  for (size_t k = 0; k < cell.size(); k++)
+  {
+    Point p0 = track.enter() + u * s;
+    s += length[k];
+    MeshCSG::SP_pincell pin = d_csg->pincell(cell[k]);
+    int offset = d_csg->region_offset(cell[k]);
+    if (!pin)
+    {
+      track.add_segment(Segment(offset, length[k]));
+      continue;
+    }
 
-      int count = 0;
-      while (1)
+    // Cut the segment where it crosses the pin's circles and planes.
+    Point origin(d_x[cell[k] % number_x], d_y[cell[k] / number_x]);
+    Point r0 = p0 - origin;
+    Point r1 = r0 + u * length[k];
+    t.assign(1, 0.0);
+    pin->intersect(r0, r1, t);
+    t.push_back(1.0);
+    std::sort(t.begin(), t.end());
+    int region_last = -1;
+    double length_last = 0.0;
+    for (size_t i = 0; i < t.size() - 1; i++)
+    {
+      double l = (t[i + 1] - t[i]) * length[k];
+      if (l < 1.0e-12) continue;
+      Point mid = r0 + (r1 - r0) * (0.5 * (t[i] + t[i + 1]));
+      int region = offset + pin->find_region(mid);
+      if (region == region_last)
       {
+        // A tangent crossing does not start a new region.
+        length_last += l;
+        continue;
+      }
+      if (region_last >= 0)
+        track.add_segment(Segment(region_last, length_last));
+      region_last = region;
+      length_last = l;
+    }
+    if (region_last >= 0)
+      track.add_segment(Segment(region_last, length_last));
+  }
+}
 
-        if (db) cout << "        SEGMENT = " << count << endl;
-        if (db) cout << "              I = " << I << endl;
-        if (db) cout << "              J = " << J << endl;
-
-        if (tan_phi > 0)
-          d_to_x = d_x[I + 1] - p.x();
-        else
-          d_to_x = p.x() - d_x[I];
-
-        d_to_y = d_y[J + 1] - p.y();
-
-        // Flat source region.
-        int region = d_mesh->index(I, J);
-        if (db) cout << "            reg = " << region << endl;
-        if (db) cout << "            d2x = " << d_to_x << endl;
-        if (db) cout << "            d2y = " << d_to_y << endl;
-
-        // Segment length
-        double length = 0.0;
-
-        double temp = std::abs(d_to_x * tan_phi) - d_to_y;
+void Tracker::trace_segments(const Point   &enter,
+                             const Point   &exit,
+                             const vec_dbl &x,
+                             const vec_dbl &y,
+                             vec_int       &region,
+                             vec_dbl       &length)
+{
+  // Compute the track length
+  double track_length = distance(enter, exit);
+
+  // Compute tangent of angle with respect to x
+  Point p = exit - enter;
+  double tan_phi = p.y() / p.x();
+  double sin_phi = (exit.y()-enter.y()) / track_length;
+  double cos_phi = (exit.x()-enter.x()) / track_length;
+
+  // Find the starting cell
+  int IJ[] = {0, 0};
+  find_starting_cell(enter, tan_phi, IJ, x, y);
+  int I = IJ[0];
+  int J = IJ[1];
+
+  // Get segments
+  double d_to_x = 0;
+  double d_to_y = 0;
+  p = enter;
+
+  int number_x = x.size() - 1;
+  Assert(I <= number_x);
+  Assert(J <= (int) y.size() - 1);
+
+  while (1)
+  {
+    if (tan_phi > 0)
+      d_to_x = x[I + 1] - p.x();
+    else
+      d_to_x = p.x() - x[I];
 
-        if (db) cout << "           temp = " << temp << endl;
-        if (std::abs(temp) > 1e-12 && temp > 0.0)
-        {
-          // I hit the top
-          p = Point(p.x() + d_to_y / tan_phi, d_y[++J]);
-          length = d_to_y / sin_phi;
-          if (db) cout << "                NEW POINT 1 = " << p << endl;
-        }
-        else if (std::abs(temp) > 1e-12 && temp < 0.0)
-        {
-          // I hit the side
-          if (tan_phi > 0.0)
-            p = Point(d_x[++I], d_to_x * std::abs(tan_phi) + p.y());
-          else
-            p = Point(d_x[I--], d_to_x * std::abs(tan_phi) + p.y());
-          length = d_to_x / std::abs(cos_phi);
-          if (db) cout << "                NEW POINT 2 = " << p << endl;
-        }
-        else
-        {
-          // I cross through a corner
-          if (tan_phi > 0.0)
-            p = Point(d_x[++I], d_y[++J]);
-          else
-            p = Point(d_x[I--], d_y[++J]);
-          length = d_to_y / sin_phi;
-          if (db) cout << "                NEW POINT 3 = " << p << endl;
-        }
+    d_to_y = y[J + 1] - p.y();
 
-        if (db) cout << "            len = " << length << endl;
-        // Add a segment
-        track->add_segment(Segment(region, length));
+    // Flat source region.
+    int r = I + J * number_x;
 
-        // Check to see if we've left.
-        if (I == -1 || I == d_x.size()-1 || J == d_y.size()-1)
-        {
-          double temp = distance(enter, p);
+    // Segment length
+    double l = 0.0;
 
-          if (db) cout << " lengths: " << temp <<  " " << track_length << " " << enter << " " << p << endl;
-          Ensure(detran_utilities::soft_equiv(temp, track_length));
-          break;
-        }
-        count++;
+    double temp = std::abs(d_to_x * tan_phi) - d_to_y;
 
-      } // segment loop
+    if (std::abs(temp) > 1e-12 && temp > 0.0)
+    {
+      // I hit the top
+      p = Point(p.x() + d_to_y / tan_phi, y[++J]);
+      l = d_to_y / sin_phi;
+    }
+    else if (std::abs(temp) > 1e-12 && temp < 0.0)
+    {
+      // I hit the side
+      if (tan_phi > 0.0)
+        p = Point(x[++I], d_to_x * std::abs(tan_phi) + p.y());
+      else
+        p = Point(x[I--], d_to_x * std::abs(tan_phi) + p.y());
+      l = d_to_x / std::abs(cos_phi);
+    }
+    else
+    {
+      // I cross through a corner
+      if (tan_phi > 0.0)
+        p = Point(x[++I], y[++J]);
+      else
+        p = Point(x[I--], y[++J]);
+      l = d_to_y / sin_phi;
+    }
 
-    } // track loop
+    // Add a segment
+    region.push_back(r);
+    length.push_back(l);
 
-  } // azimuth loop
+    // Check to see if we've left.
+    if (I == -1 || I == x.size()-1 || J == y.size()-1)
+    {
+      Ensure(detran_utilities::soft_equiv(distance(enter, p), track_length));
+      break;
+    }
 
+  } // segment loop
+}
 
+std::string Tracker::cache_file(const std::string &path) const
+{
+  std::ostringstream name;
+  name << path << "/tracks_" << std::hex << std::setw(16)
+       << std::setfill('0') << d_key << ".bin";
+  return name.str();
 }
 
 // Find the indices of the cell we are to enter
-void Tracker::find_starting_cell(Point enter, double tan_phi, int *IJ)
+void Tracker::find_starting_cell(Point enter, double tan_phi, int *IJ,
+                                 const vec_dbl &x, const vec_dbl &y)
 {
   int i = 0;
   int j = 0;
 
   // Going right.
-  for (i = 1; i < d_x.size(); i++)
+  for (i = 1; i < x.size(); i++)
   {
 
-    if ( std::abs(d_x[i]-enter.x()) < 1e-10 )
+    if ( std::abs(x[i]-enter.x()) < 1e-10 )
     {
       if (tan_phi < 0.0) i--;
       break;
     }
-    if (d_x[i] >= enter.x())
+    if (x[i] >= enter.x())
     {
       i--;
       break;
     }
   }
-  if (i == d_x.size())
+  if (i == x.size())
   {
     i--; i--;
   }
@@ -273,15 +607,15 @@ void Tracker::find_starting_cell(Point enter, double tan_phi, int *IJ)
   Assert(i >= 0);
 
 
-  for (j = 1; i < d_y.size() - 1; j++)
+  for (j = 1; j < y.size(); j++)
   {
-    if (d_y[j] > enter.y())
+    if (y[j] > enter.y())
     {
       j--;
       break;
     }
   }
-  if (j == d_y.size())
+  if (j == y.size())
   {
     j--; j--;
   }
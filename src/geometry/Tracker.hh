@@ -12,10 +12,14 @@
 
 #include "Track.hh"
 #include "TrackDB.hh"
+#include "MeshCSG.hh"
 #include "MeshMOC.hh"
+#include "TrackStack.hh"
 #include "angle/QuadratureMOC.hh"
 #include "utilities/DBC.hh"
+#include "utilities/InputDB.hh"
 #include "utilities/SP.hh"
+#include <string>
 #include <vector>
 
 namespace detran_geometry
@@ -24,6 +28,48 @@ namespace detran_geometry
 /*!
  *  \class Tracker
  *  \brief Track a mesh.
+ *
+ *  Tracks are ray traced independently and, when OpenMP is enabled,
+ *  in parallel.  The segments are then packed into the track database
+ *  (see TrackDB::finalize).
+ *
+ *  Because tracking depends only on the mesh edges and the track
+ *  end points, the result can be cached.  If the input database
+ *  contains "tracker_cache_path", the tracks are read from the file
+ *  "tracks_<key>.bin" in that directory, where the key is a hash of
+ *  the mesh and quadrature; if no such file exists, the tracks are
+ *  generated and written there for later runs.  Cached tracks are
+ *  not normalized, so normalize() must be called either way.
+ *
+ *  If the input database contains "tracker_modules", the mesh map of
+ *  that name (e.g. "PINS" or "ASSEMBLIES") defines a lattice of
+ *  modules, which must be identically meshed rectangular blocks of
+ *  cells.  Each track is then cut into pieces, one per module
+ *  crossed, and only the distinct pieces (relative to their module)
+ *  are ray traced and stored (see TrackDB).  For cyclic quadratures
+ *  (e.g. Collocated with a multiplier equal to the number of modules
+ *  along a side), each module sees the same few pieces, and the
+ *  segment storage drops by roughly the number of modules.
+ *
+ *  If "tracker_otf" is set, no segments are stored; the track
+ *  database ray traces each track whenever its segments are needed
+ *  (see TrackDB), which suits problems whose segments would not fit
+ *  in memory.
+ *
+ *  If the mesh is a MeshCSG, the tracks are traced over its Cartesian
+ *  base mesh, and each segment within a pin cell is then cut where it
+ *  crosses the pin's circles and sector planes, so that the segments
+ *  follow the true geometry.  The segment regions are then those of
+ *  the MeshCSG, and normalize() uses their exact volumes.  Neither
+ *  modular nor on-the-fly tracking is supported with pin cells.
+ *
+ *  Only conventional tracks are cached.
+ *
+ *  A 3D Cartesian mesh is tracked in its xy projection, and 3D tracks
+ *  are stacked over the 2D ones (see TrackStack), with a number of
+ *  axial intercepts per side given by "tracker_number_z" (twice the
+ *  number of axial cells by default).  normalize() then conserves the
+ *  projected areas, and the 3D segments are generated by the sweeper.
  */
 class GEOMETRY_EXPORT Tracker
 {
@@ -39,20 +85,30 @@ public:
   typedef detran_angle::QuadratureMOC::SP_quadrature  SP_quadrature;
   typedef Track::SP_track                             SP_track;
   typedef TrackDB::SP_trackdb                         SP_trackdb;
+  typedef detran_utilities::vec_int                   vec_int;
   typedef detran_utilities::vec_dbl                   vec_dbl;
   typedef detran_utilities::Point                     Point;
+  typedef detran_utilities::InputDB::SP_input         SP_input;
+  typedef TrackDB::key_type                           key_type;
 
   //-------------------------------------------------------------------------//
   // PUBLIC INTERFACE
   //-------------------------------------------------------------------------//
 
-  Tracker(SP_mesh mesh, SP_quadrature quadrature);
+  /**
+   *  @brief Constructor
+   *  @param mesh         Cartesian mesh to track
+   *  @param quadrature   MOC quadrature defining the tracks
+   *  @param input        Optional input database (for track caching)
+   */
+  Tracker(SP_mesh mesh, SP_quadrature quadrature, SP_input input = SP_input());
 
   static SP_tracker
   Create(SP_mesh       mesh,
-         SP_quadrature quadrature)
+         SP_quadrature quadrature,
+         SP_input      input = SP_input())
   {
-    SP_tracker p(new Tracker(mesh, quadrature));
+    SP_tracker p(new Tracker(mesh, quadrature, input));
     return p;
   }
 
@@ -65,13 +121,46 @@ public:
   SP_mesh meshmoc()
   {
     // Create the MOC mesh
-    SP_mesh newmesh(new MeshMOC(d_mesh, d_trackdb));
+    SP_mesh newmesh(new MeshMOC(d_mesh, d_trackdb, d_stack));
     return newmesh;
   }
 
   // Normalize the track segments based on actual volumes.
   void normalize();
 
+  /// Hash of the mesh and track end points identifying the tracking
+  key_type key() const
+  {
+    return d_key;
+  }
+
+  /// Were the tracks read from the cache?
+  bool cached() const
+  {
+    return d_cached;
+  }
+
+  /**
+   *  @brief Ray trace one track across a Cartesian grid
+   *
+   *  The track must travel upward (i.e. have an azimuth in [0, pi]).
+   *  Segments are appended in order of travel, with regions given
+   *  by the cell index i + j * (x.size() - 1).
+   *
+   *  @param  enter   Track entrance point
+   *  @param  exit    Track exit point
+   *  @param  x       Grid edges in x
+   *  @param  y       Grid edges in y
+   *  @param  region  Segment regions
+   *  @param  length  Segment lengths
+   */
+  static void trace_segments(const Point   &enter,
+                             const Point   &exit,
+                             const vec_dbl &x,
+                             const vec_dbl &y,
+                             vec_int       &region,
+                             vec_dbl       &length);
+
 private:
 
   //-------------------------------------------------------------------------//
@@ -79,19 +168,36 @@ private:
   //-------------------------------------------------------------------------//
 
   SP_mesh d_mesh;
+  // Cartesian mesh that is ray traced
+  SP_mesh d_grid;
   SP_quadrature d_quadrature;
+  // Pin cell geometry, if any
+  MeshCSG *d_csg;
   SP_trackdb d_trackdb;
+  // Axially stacked tracks of a 3D mesh
+  TrackStack::SP_trackstack d_stack;
   // Number azimuths per octant
   int d_number_azimuths;
   vec_dbl d_x;
   vec_dbl d_y;
+  // Tracking key
+  key_type d_key;
+  // Flag indicating the tracks came from the cache
+  bool d_cached;
 
   //-------------------------------------------------------------------------//
   // IMPLEMENTATION
   //-------------------------------------------------------------------------//
 
   void generate_tracks();
-  void find_starting_cell(Point enter, double tan_phi, int *IJ);
+  void generate_modular_tracks(const std::string &key);
+  void generate_otf_tracks();
+  void build_grid();
+  void trace(Track &track, const vec_dbl &x, const vec_dbl &y) const;
+  void trace_csg(Track &track) const;
+  static void find_starting_cell(Point enter, double tan_phi, int *IJ,
+                                 const vec_dbl &x, const vec_dbl &y);
+  std::string cache_file(const std::string &path) const;
 
 };
 
@@ -14,11 +14,15 @@
 #include "Mesh2D.hh"
 #include "Mesh3D.hh"
 #include "PinCell.hh"
+#include "MeshCSG.hh"
+#include "MeshUnstructured.hh"
+#include "MeshHex.hh"
 #include "Assembly.hh"
 #include "Core.hh"
 #include "Segment.hh"
 #include "Track.hh"
 #include "TrackDB.hh"
+#include "TrackStack.hh"
 #include "Tracker.hh"
 #include "MeshMOC.hh"
 
@@ -13,6 +13,9 @@
 #include "geometry/Assembly.hh"
 #include "geometry/Core.hh"
 #include "geometry/Mesh.hh"
+#include "geometry/MeshCSG.hh"
+#include "geometry/MeshUnstructured.hh"
+#include "geometry/MeshHex.hh"
 #include "geometry/MeshMOC.hh"
 #include "geometry/Mesh1D.hh" 
 #include "geometry/Mesh2D.hh" 
@@ -21,6 +24,7 @@
 #include "geometry/Segment.hh"
 #include "geometry/Track.hh"
 #include "geometry/TrackDB.hh"
+#include "geometry/TrackStack.hh"
 #include "geometry/Tracker.hh"
 %}
 
@@ -40,6 +44,9 @@
 //%include "Mesh2D.hh"
 //%include "Mesh3D.hh"
 %include "PinCell.hh"
+%include "MeshCSG.hh"
+%include "MeshUnstructured.hh"
+%include "MeshHex.hh"
 %include "Assembly.hh"
 %include "Core.hh"
 //
@@ -47,6 +54,7 @@
 //%include "Segment.hh"
 //%include "Track.hh"
 %include "TrackDB.hh"
+%include "TrackStack.hh"
 %include "Tracker.hh"
 
 namespace detran_geometry
@@ -148,12 +156,16 @@ public:
 %template(Mesh2DSP)   detran_utilities::SP<detran_geometry::Mesh2D>;
 %template(Mesh3DSP)   detran_utilities::SP<detran_geometry::Mesh3D>;
 %template(PinCellSP)  detran_utilities::SP<detran_geometry::PinCell>;
+%template(MeshCSGSP)  detran_utilities::SP<detran_geometry::MeshCSG>;
+%template(MeshUnstructuredSP)  detran_utilities::SP<detran_geometry::MeshUnstructured>;
+%template(MeshHexSP)           detran_utilities::SP<detran_geometry::MeshHex>;
 %template(AssemblySP) detran_utilities::SP<detran_geometry::Assembly>;
 %template(CoreSP)     detran_utilities::SP<detran_geometry::Core>;
 
 %template(SegmentSP)  detran_utilities::SP<detran_geometry::Tracker>;
 %template(TrackSP)    detran_utilities::SP<detran_geometry::Track>;
 %template(TrackDBSP)  detran_utilities::SP<detran_geometry::TrackDB>;
+%template(TrackStackSP) detran_utilities::SP<detran_geometry::TrackStack>;
 %template(TrackerSP)  detran_utilities::SP<detran_geometry::Tracker>;
 
 //---------------------------------------------------------------------------//
@@ -17,6 +17,7 @@
 #include "PinCell.hh"
 #include "Assembly.hh"
 #include "Core.hh"
+#include "MeshUnstructured.hh"
 
 // Detran utilities
 #include "DBC.hh"
@@ -190,6 +191,79 @@ static SP_core core_fixture()
   return core;
 }
 
+/*!
+ *  \brief Create an unstructured mesh of the cells of a Cartesian grid.
+ *
+ *  The cells are numbered as in Mesh2D, i.e. x first.  If axial edges
+ *  are given, the grid is extruded.
+ */
+static detran_geometry::MeshUnstructured::SP_mesh
+unstructured_grid_fixture(const detran_utilities::vec_dbl &xe,
+                          const detran_utilities::vec_dbl &ye,
+                          const detran_utilities::vec_int &mat,
+                          const detran_utilities::vec_dbl &ze =
+                            detran_utilities::vec_dbl(0))
+{
+  int nx = xe.size() - 1;
+  int ny = ye.size() - 1;
+  Require(mat.size() % (nx * ny) == 0);
+  detran_utilities::vec_dbl x, y;
+  for (int j = 0; j <= ny; ++j)
+  {
+    for (int i = 0; i <= nx; ++i)
+    {
+      x.push_back(xe[i]);
+      y.push_back(ye[j]);
+    }
+  }
+  detran_utilities::vec2_int cells(nx * ny, detran_utilities::vec_int(4));
+  for (int j = 0; j < ny; ++j)
+  {
+    for (int i = 0; i < nx; ++i)
+    {
+      int c = i + j * nx;
+      int n = i + j * (nx + 1);
+      cells[c][0] = n;
+      cells[c][1] = n + 1;
+      cells[c][2] = n + nx + 2;
+      cells[c][3] = n + nx + 1;
+    }
+  }
+  detran_geometry::MeshUnstructured::SP_mesh
+    mesh(new detran_geometry::MeshUnstructured(x, y, cells, mat, ze));
+  return mesh;
+}
+
+/*!
+ *  \brief Create a 3x3 unstructured mesh with a dependency cycle.
+ *
+ *  Two L-shaped cells interlock around a unit square, (1,1) to (2,2),
+ *  so that the cell dependencies are cyclic for directions in the first
+ *  and third quadrants.
+ */
+static detran_geometry::MeshUnstructured::SP_mesh
+unstructured_mesh_fixture(detran_utilities::vec_int mat =
+                          detran_utilities::vec_int(3, 0))
+{
+  // Nodes on a 4x4 lattice, numbered x first.
+  detran_utilities::vec_dbl x(16, 0.0), y(16, 0.0);
+  for (int n = 0; n < 16; ++n)
+  {
+    x[n] = n % 4;
+    y[n] = n / 4;
+  }
+  int a[] = {0, 1, 2, 3, 7, 11, 10, 6, 5, 4};
+  int b[] = {4, 5, 9, 10, 11, 15, 14, 13, 12, 8};
+  int e[] = {5, 6, 10, 9};
+  detran_utilities::vec2_int cells(3);
+  cells[0].assign(a, a + 10);
+  cells[1].assign(b, b + 10);
+  cells[2].assign(e, e + 4);
+  detran_geometry::MeshUnstructured::SP_mesh
+    mesh(new detran_geometry::MeshUnstructured(x, y, cells, mat));
+  return mesh;
+}
+
 } // end namespace detran_test
 
 #endif /* MESH_FIXTURE_HH_ */
@@ -0,0 +1,157 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_MeshHex.cc
+ *  @author Jeremy Roberts
+ *  @date   Feb 25, 2013
+ *  @brief  Test of MeshHex class
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                       \
+        FUNC(test_MeshHex)              \
+        FUNC(test_MeshHex_sector)       \
+        FUNC(test_MeshHex_extruded)
+
+#include "TestDriver.hh"
+#include "MeshHex.hh"
+#include <cmath>
+
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace detran_test;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  RUN(argc, argv);
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+// Total area of the cells of a mesh
+double area(const MeshUnstructured &mesh)
+{
+  double a = 0.0;
+  for (int c = 0; c < mesh.number_cells_2d(); ++c)
+    a += mesh.cell_area(c);
+  return a;
+}
+
+// Full core of two rings with subdivided triangles.
+int test_MeshHex(int argc, char *argv[])
+{
+  double pitch = 2.0;
+  double hex_area = 0.5 * sqrt(3.0) * pitch * pitch;
+  TEST(MeshHex::number_hexagons(1) == 1);
+  TEST(MeshHex::number_hexagons(3) == 19);
+
+  vec_int mat(7, 0);
+  mat[0] = 1;
+  MeshHex mesh(pitch, 2, mat, 1, 2);
+  TEST(mesh.number_cells() == 7 * 6 * 4);
+  TEST(mesh.dimension() == 2);
+  TEST(soft_equiv(area(mesh), 7.0 * hex_area));
+
+  // Hexagon centers are a pitch from their neighbors.
+  for (int h = 1; h < 7; ++h)
+  {
+    TEST(soft_equiv(distance(mesh.hexagon_center(h), Point(0, 0)), pitch));
+    Point next = mesh.hexagon_center(h % 6 + 1);
+    TEST(soft_equiv(distance(mesh.hexagon_center(h), next), pitch));
+  }
+  TEST(soft_equiv(mesh.hexagon_center(1).y(), 1.0));
+
+  // Materials and hexagons
+  const vec_int &hex = mesh.mesh_map("HEXAGON");
+  const vec_int &m   = mesh.mesh_map("MATERIAL");
+  vec_dbl hex_sum(7, 0.0);
+  for (int c = 0; c < mesh.number_cells(); ++c)
+  {
+    TEST(m[c] == (hex[c] == 0 ? 1 : 0));
+    hex_sum[hex[c]] += mesh.cell_area(c);
+  }
+  for (int h = 0; h < 7; ++h)
+    TEST(soft_equiv(hex_sum[h], hex_area));
+
+  // The outer boundary of 18 hexagon sides, each split in two, is vacuum.
+  int number_boundary = 0;
+  for (int f = 0; f < mesh.number_faces(); ++f)
+  {
+    if (!mesh.is_boundary(f)) continue;
+    ++number_boundary;
+    TEST(mesh.face_side(f) == -1);
+    TEST(mesh.face_partner(f) == -1);
+  }
+  TEST(number_boundary == 36);
+  return 0;
+}
+
+// One sixth and one third of a three ring core.
+int test_MeshHex_sector(int argc, char *argv[])
+{
+  double pitch = 1.5;
+  vec_int mat(19, 0);
+  MeshHex full(pitch, 3, mat);
+  for (int s = 3; s <= 6; s += 3)
+  {
+    MeshHex mesh(pitch, 3, mat, s, 1, true);
+    TEST(mesh.number_cells() == 19 * 6 / s);
+    TEST(soft_equiv(area(mesh), area(full) / s));
+    int number_south = 0, number_west = 0;
+    for (int f = 0; f < mesh.number_faces(); ++f)
+    {
+      if (!mesh.is_boundary(f)) continue;
+      int side = mesh.face_side(f);
+      int partner = mesh.face_partner(f);
+      if (side == Mesh::SOUTH) ++number_south;
+      if (side == Mesh::WEST)  ++number_west;
+      if (side < 0)
+      {
+        TEST(partner == -1);
+        continue;
+      }
+      // Partners are the same distance from the center.
+      TEST(partner >= 0);
+      TEST(mesh.face_partner(partner) == f);
+      TEST(mesh.face_side(partner) != side);
+      TEST(soft_equiv(distance(mesh.face_center(f), Point(0, 0)),
+                      distance(mesh.face_center(partner), Point(0, 0))));
+    }
+    // Each sector edge is four circumradii long.
+    TEST(number_south == 4);
+    TEST(number_west  == 4);
+  }
+  return 0;
+}
+
+// A hexagonal-Z mesh with materials varying axially.
+int test_MeshHex_extruded(int argc, char *argv[])
+{
+  vec_dbl z(3, 0.0);
+  z[1] = 1.0; z[2] = 3.0;
+  vec_int mat(14, 0);
+  for (int h = 7; h < 14; ++h) mat[h] = 2;
+  MeshHex mesh(1.0, 2, mat, 6, 1, false, z);
+  TEST(mesh.dimension() == 3);
+  TEST(mesh.number_cells_2d() == 7);
+  TEST(mesh.number_layers() == 2);
+  TEST(mesh.number_cells() == 14);
+  TEST(mesh.number_face_fluxes() == 2 * mesh.number_faces() + 3 * 7);
+  TEST(soft_equiv(mesh.volume(7), 2.0 * mesh.volume(0)));
+  const vec_int &m = mesh.mesh_map("MATERIAL");
+  const vec_int &hex = mesh.mesh_map("HEXAGON");
+  for (int c = 0; c < 7; ++c)
+  {
+    TEST(m[c] == 0);
+    TEST(m[c + 7] == 2);
+    TEST(hex[c] == hex[c + 7]);
+  }
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_MeshHex.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,127 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_MeshUnstructured.cc
+ *  @author Jeremy Roberts
+ *  @date   Feb 22, 2013
+ *  @brief  Test of MeshUnstructured class
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                              \
+        FUNC(test_MeshUnstructured)            \
+        FUNC(test_MeshUnstructured_nonconvex)
+
+#include "TestDriver.hh"
+#include "MeshUnstructured.hh"
+#include "geometry/test/mesh_fixture.hh"
+
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace detran_test;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  RUN(argc, argv);
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+// Two by two squares of width two, with one cell given clockwise.
+int test_MeshUnstructured(int argc, char *argv[])
+{
+  vec_dbl x(9, 0.0), y(9, 0.0);
+  for (int n = 0; n < 9; ++n)
+  {
+    x[n] = 2.0 * (n % 3);
+    y[n] = 2.0 * (n / 3);
+  }
+  vec2_int cells(4, vec_int(4, 0));
+  cells[0][0] = 0; cells[0][1] = 1; cells[0][2] = 4; cells[0][3] = 3;
+  cells[1][0] = 1; cells[1][1] = 4; cells[1][2] = 5; cells[1][3] = 2;
+  cells[2][0] = 3; cells[2][1] = 4; cells[2][2] = 7; cells[2][3] = 6;
+  cells[3][0] = 4; cells[3][1] = 5; cells[3][2] = 8; cells[3][3] = 7;
+  vec_int mat(4, 0); mat[3] = 1;
+  MeshUnstructured mesh(x, y, cells, mat);
+
+  TEST(mesh.number_cells() == 4);
+  TEST(mesh.number_nodes() == 9);
+  TEST(mesh.number_faces() == 12);
+  TEST(soft_equiv(mesh.total_width_x(), 4.0));
+  TEST(soft_equiv(mesh.total_width_y(), 4.0));
+  TEST(mesh.mesh_map("MATERIAL")[3] == 1);
+  int number_boundary = 0;
+  for (int c = 0; c < 4; ++c)
+  {
+    TEST(soft_equiv(mesh.volume(c), 4.0));
+    TEST(mesh.number_cell_faces(c) == 4);
+    for (int i = 0; i < 4; ++i)
+    {
+      // Each face normal points out of the cell and away from its center.
+      int f = mesh.cell_face(c, i);
+      Point d = mesh.face_center(f) - mesh.cell_centroid(c);
+      Point n = mesh.face_normal(f) * mesh.cell_face_sign(c, i);
+      TEST(soft_equiv(d.x() * n.x() + d.y() * n.y(), 1.0));
+      TEST(soft_equiv(mesh.face_length(f), 2.0));
+      if (mesh.cell_neighbor(c, i) < 0) ++number_boundary;
+    }
+  }
+  TEST(number_boundary == 8);
+  TEST(soft_equiv(mesh.cell_centroid(3).x(), 3.0));
+  TEST(soft_equiv(mesh.cell_centroid(3).y(), 3.0));
+
+  // Boundary sides
+  for (int f = 0; f < mesh.number_faces(); ++f)
+  {
+    if (!mesh.is_boundary(f))
+    {
+      TEST(mesh.face_side(f) == -1);
+      continue;
+    }
+    const Point &c = mesh.face_center(f);
+    if (soft_equiv(c.x(), 0.0)) TEST(mesh.face_side(f) == Mesh::WEST);
+    if (soft_equiv(c.x(), 4.0)) TEST(mesh.face_side(f) == Mesh::EAST);
+    if (soft_equiv(c.y(), 0.0)) TEST(mesh.face_side(f) == Mesh::SOUTH);
+    if (soft_equiv(c.y(), 4.0)) TEST(mesh.face_side(f) == Mesh::NORTH);
+  }
+  return 0;
+}
+
+// Two interlocking L-shaped cells around a square.
+int test_MeshUnstructured_nonconvex(int argc, char *argv[])
+{
+  MeshUnstructured::SP_mesh mesh = unstructured_mesh_fixture();
+  TEST(mesh->number_cells() == 3);
+  TEST(mesh->number_faces() == 18);
+  TEST(soft_equiv(mesh->volume(0), 4.0));
+  TEST(soft_equiv(mesh->volume(1), 4.0));
+  TEST(soft_equiv(mesh->volume(2), 1.0));
+  TEST(soft_equiv(mesh->cell_centroid(2).x(), 1.5));
+  TEST(soft_equiv(mesh->cell_centroid(2).y(), 1.5));
+  TEST(mesh->number_cell_faces(0) == 10);
+  int number_boundary = 0;
+  for (int f = 0; f < mesh->number_faces(); ++f)
+  {
+    if (!mesh->is_boundary(f)) continue;
+    ++number_boundary;
+    TEST(mesh->face_side(f) >= 0);
+  }
+  TEST(number_boundary == 12);
+  // The square touches both L cells twice.
+  int number_a = 0, number_b = 0;
+  for (int i = 0; i < mesh->number_cell_faces(2); ++i)
+  {
+    if (mesh->cell_neighbor(2, i) == 0) ++number_a;
+    if (mesh->cell_neighbor(2, i) == 1) ++number_b;
+  }
+  TEST(number_a == 2);
+  TEST(number_b == 2);
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_MeshUnstructured.cc
+//---------------------------------------------------------------------------//
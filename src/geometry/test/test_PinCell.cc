@@ -10,11 +10,14 @@
 
 // LIST OF TEST FUNCTIONS
 #define TEST_LIST                  \
-        FUNC(test_PinCell)
+        FUNC(test_PinCell)             \
+        FUNC(test_PinCell_csg)
 
 // Detran headers
 #include "TestDriver.hh"
 #include "PinCell.hh"
+#include "utilities/Constants.hh"
+#include <algorithm>
 
 // Setup
 #include "geometry/test/mesh_fixture.hh"
@@ -58,6 +61,41 @@ int test_PinCell(int argc, char *argv[])
   return 0;
 }
 
+int test_PinCell_csg(int argc, char *argv[])
+{
+  vec_dbl radii(2, 0.3); radii[1] = 0.54;
+  vec_int mat(3, 0); mat[1] = 1; mat[2] = 2;
+  PinCell pin(1.26, radii, mat);
+  pin.set_number_sectors(4);
+  TEST(pin.number_regions() == 12);
+
+  // Rings from the center outward, sectors counterclockwise from +x
+  TEST(pin.find_region(Point(0.73, 0.68)) == 0);
+  TEST(pin.find_region(Point(0.23, 0.53)) == 6);
+  TEST(pin.find_region(Point(0.05, 0.05)) == 10);
+  TEST(pin.region_material(6) == 1);
+  TEST(pin.region_material(10) == 2);
+
+  // Exact areas
+  double total = 0.0;
+  for (int r = 0; r < pin.number_regions(); r++)
+    total += pin.region_volume(r);
+  TEST(soft_equiv(total, 1.26 * 1.26));
+  TEST(soft_equiv(pin.region_volume(0), pi * 0.09 / 4.0));
+  TEST(soft_equiv(pin.region_volume(5), pi * (0.54 * 0.54 - 0.09) / 4.0));
+
+  // A chord through the center crosses four circles and one plane.
+  vec_dbl t;
+  pin.intersect(Point(0.0, 0.63), Point(1.26, 0.63), t);
+  TEST(t.size() == 5);
+  sort(t.begin(), t.end());
+  TEST(soft_equiv(t[0], 0.09 / 1.26));
+  TEST(soft_equiv(t[1], 0.33 / 1.26));
+  TEST(soft_equiv(t[2], 0.5));
+  TEST(soft_equiv(t[4], 1.17 / 1.26));
+  return 0;
+}
+
 //---------------------------------------------------------------------------//
-//              end of test_Mesh3D.cc
+//              end of test_PinCell.cc
 //---------------------------------------------------------------------------//
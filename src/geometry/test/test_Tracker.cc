@@ -11,14 +11,25 @@
 // LIST OF TEST FUNCTIONS
 #define TEST_LIST                     \
         FUNC(test_Tracker_2x2)        \
-        FUNC(test_Tracker_3x3)
+        FUNC(test_Tracker_3x3)        \
+        FUNC(test_Tracker_cache)      \
+        FUNC(test_Tracker_modular)    \
+        FUNC(test_Tracker_otf)        \
+        FUNC(test_Tracker_csg)        \
+        FUNC(test_Tracker_3D)
 
 // Detran headers
 #include "TestDriver.hh"
 #include "Tracker.hh"
 //
 #include "Mesh2D.hh"
+#include "Mesh3D.hh"
+#include "MeshCSG.hh"
 #include "Uniform.hh"
+#include "Collocated.hh"
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
 
 // Setup
 /* ... */
@@ -69,12 +80,12 @@ int test_Tracker_2x2(int argc, char *argv[])
     TEST(tracks->number_tracks_angle(a) == 3);
     for (int t = 0; t < 3; t++)
     {
-      Tracker::SP_track track = tracks->track(a, t);
-      TEST(track->number_segments() == ns[t]);
+      int s0 = tracks->segment_begin(a, t);
+      TEST(tracks->segment_end(a, t) - s0 == ns[t]);
       for (int s = 0; s < ns[t]; s++)
       {
-        TEST(soft_equiv(track->segment(s).length(), length));
-        TEST(track->segment(s).region() == region[r++]);
+        TEST(soft_equiv(tracks->segment_length(s0 + s), length));
+        TEST(tracks->segment_region(s0 + s) == region[r++]);
       }
     }
   }
@@ -118,20 +129,360 @@ int test_Tracker_3x3(int argc, char *argv[])
     int l = 0;
     for (int t = 0; t < 3; t++)
     {
-      Tracker::SP_track track = tracks->track(a, t);
-      TEST(track->number_segments() == ns[t]);
+      int s0 = tracks->segment_begin(a, t);
+      TEST(tracks->segment_end(a, t) - s0 == ns[t]);
       for (int s = 0; s < ns[t]; s++)
       {
-        TEST(soft_equiv(track->segment(s).length(), length[l++]));
-        TEST(track->segment(s).region() == region[r++]);
+        TEST(soft_equiv(tracks->segment_length(s0 + s), length[l++]));
+        TEST(tracks->segment_region(s0 + s) == region[r++]);
       }
+      // The tracks keep no copy of the packed segments.
+      TEST(tracks->track(a, t)->number_segments() == 0);
     }
   }
 
   // Normalize the lengths.
   tracker.normalize();
   tracks->display();
-  TEST(soft_equiv(tracks->track(0, 0)->segment(0).length(), 0.662538659999938));
+  TEST(soft_equiv(tracks->segment_length(tracks->segment_begin(0, 0)),
+                  0.662538659999938));
+  return 0;
+}
+
+std::string test_Tracker_cache_file(Tracker::key_type key)
+{
+  std::ostringstream name;
+  name << "./tracks_" << std::hex << std::setw(16) << std::setfill('0')
+       << key << ".bin";
+  return name.str();
+}
+
+int test_Tracker_cache(int argc, char *argv[])
+{
+  // Nonuniform 5x5 mesh
+  vec_dbl cm(3, 0.0);
+  cm[1] = 0.4;
+  cm[2] = 1.0;
+  vec_int fm(2, 2);
+  fm[1] = 3;
+  vec_int mat(2, 0);
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mat));
+  QuadratureMOC::SP_quadrature quad(new Uniform(2, 3, 7, 1, "TY"));
+
+  InputDB::SP_input db(new InputDB());
+  db->put<std::string>("tracker_cache_path", ".");
+
+  // The first tracker writes the cache; the second reads it.
+  Tracker tracker0(mesh, quad, db);
+  std::string filename = test_Tracker_cache_file(tracker0.key());
+  std::remove(filename.c_str());
+  Tracker tracker1(mesh, quad, db);
+  TEST(!tracker1.cached());
+  Tracker tracker2(mesh, quad, db);
+  TEST(tracker2.cached());
+  TEST(tracker2.key() == tracker1.key());
+
+  // The cached tracks and packed segments match, and only the packed
+  // segments are kept.
+  Tracker::SP_trackdb tracks1 = tracker1.trackdb();
+  Tracker::SP_trackdb tracks2 = tracker2.trackdb();
+  TEST(tracks2->number_tracks()   == tracks1->number_tracks());
+  TEST(tracks2->number_segments() == tracks1->number_segments());
+  for (int a = 0; a < tracks1->number_angles(); a++)
+  {
+    TEST(tracks2->number_tracks_angle(a) == tracks1->number_tracks_angle(a));
+    TEST(soft_equiv(tracks2->spacing(a), tracks1->spacing(a)));
+    for (int t = 0; t < tracks1->number_tracks_angle(a); t++)
+    {
+      Tracker::SP_track track = tracks1->track(a, t);
+      int s0 = tracks1->segment_begin(a, t);
+      int s1 = tracks1->segment_end(a, t);
+      TEST(tracks2->segment_begin(a, t) == s0);
+      TEST(tracks2->segment_end(a, t)   == s1);
+      for (int s = s0; s < s1; s++)
+      {
+        TEST(tracks2->segment_region(s) == tracks1->segment_region(s));
+        TEST(soft_equiv(tracks2->segment_length(s),
+                        tracks1->segment_length(s)));
+      }
+      TEST(track->number_segments() == 0);
+      TEST(tracks2->track(a, t)->number_segments() == 0);
+      TEST(soft_equiv(tracks2->track(a, t)->enter().x(), track->enter().x()));
+      TEST(soft_equiv(tracks2->track(a, t)->exit().y(),  track->exit().y()));
+    }
+  }
+
+  // Normalization acts on the packed segments too.
+  tracker1.normalize();
+  tracker2.normalize();
+  for (int s = 0; s < tracks1->number_segments(); s++)
+    TEST(soft_equiv(tracks2->segment_length(s), tracks1->segment_length(s)));
+
+  // A different mesh has a different key.
+  cm[1] = 0.5;
+  Mesh::SP_mesh mesh3(new Mesh2D(fm, fm, cm, cm, mat));
+  Tracker tracker3(mesh3, quad, db);
+  TEST(tracker3.key() != tracker1.key());
+  TEST(!tracker3.cached());
+
+  std::remove(filename.c_str());
+  std::remove(test_Tracker_cache_file(tracker3.key()).c_str());
+  return 0;
+}
+
+// Expanded segments of a track, skipping negligible ones
+void test_Tracker_segments(TrackDB::SP_trackdb tracks, int a, int t,
+                           vec_int &region, vec_dbl &length)
+{
+  TrackDB::SegmentBuffer buffer;
+  const int *r = 0;
+  const double *l = 0;
+  int n = tracks->segments(a, t, r, l, buffer);
+  region.clear();
+  length.clear();
+  for (int s = 0; s < n; s++)
+  {
+    if (l[s] < 1e-10) continue;
+    region.push_back(r[s]);
+    length.push_back(l[s]);
+  }
+}
+
+int test_Tracker_modular(int argc, char *argv[])
+{
+  // A 3x3 lattice of identically meshed pins
+  int number_pins = 3;
+  double pin_edges[] = {0.0, 0.3, 0.96, 1.26};
+  vec_dbl edges(1, 0.0);
+  for (int p = 0; p < number_pins; p++)
+    for (int i = 1; i < 4; i++)
+      edges.push_back(p * 1.26 + pin_edges[i]);
+  int n = edges.size() - 1;
+  vec_int mat(n * n, 0);
+  vec_int pins(n * n, 0);
+  for (int j = 0; j < n; j++)
+    for (int i = 0; i < n; i++)
+      pins[i + j * n] = i / 3 + (j / 3) * number_pins;
+  Mesh::SP_mesh mesh(new Mesh2D(edges, edges, mat));
+  mesh->add_mesh_map("PINS", pins);
+
+  InputDB::SP_input db(new InputDB());
+  db->put<std::string>("tracker_modules", "PINS");
+
+  // Cyclic (collocated) and non-cyclic (uniform) quadratures
+  QuadratureMOC::SP_quadrature quads[] =
+    {QuadratureMOC::SP_quadrature(new Collocated(2, 3, number_pins, 1, "TY")),
+     QuadratureMOC::SP_quadrature(new Uniform(2, 3, 7, 1, "TY"))};
+
+  for (int q = 0; q < 2; q++)
+  {
+    Tracker tracker(mesh, quads[q]);
+    Tracker modular(mesh, quads[q], db);
+    Tracker::SP_trackdb tracks  = tracker.trackdb();
+    Tracker::SP_trackdb mtracks = modular.trackdb();
+    TEST(!tracks->is_modular());
+    TEST(mtracks->is_modular());
+
+    // Modular tracks expand to the conventional ones.
+    vec_int r0, r1;
+    vec_dbl l0, l1;
+    for (int a = 0; a < tracks->number_angles(); a++)
+    {
+      TEST(mtracks->number_tracks_angle(a) == tracks->number_tracks_angle(a));
+      for (int t = 0; t < tracks->number_tracks_angle(a); t++)
+      {
+        test_Tracker_segments(tracks,  a, t, r0, l0);
+        test_Tracker_segments(mtracks, a, t, r1, l1);
+        TEST(r1.size() == r0.size());
+        for (int s = 0; s < r0.size(); s++)
+        {
+          TEST(r1[s] == r0[s]);
+          TEST(soft_equiv(l1[s], l0[s], 1e-9));
+        }
+      }
+    }
+
+    // Cyclic tracks store far fewer segments.
+    if (q == 0)
+    {
+      TEST(mtracks->number_segments() * 4 < tracks->number_segments());
+
+      // With cyclic tracks, normalizing per module cell is exact.
+      tracker.normalize();
+      modular.normalize();
+      for (int a = 0; a < tracks->number_angles(); a++)
+      {
+        for (int t = 0; t < tracks->number_tracks_angle(a); t++)
+        {
+          test_Tracker_segments(tracks,  a, t, r0, l0);
+          test_Tracker_segments(mtracks, a, t, r1, l1);
+          for (int s = 0; s < r0.size(); s++)
+            TEST(soft_equiv(l1[s], l0[s], 1e-9));
+        }
+      }
+    }
+  }
+
+  return 0;
+}
+
+int test_Tracker_otf(int argc, char *argv[])
+{
+  vec_dbl cm(3, 0.0); cm[1] = 0.4; cm[2] = 1.26;
+  vec_int fm(2, 3);
+  vec_int mat(4, 0);
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mat));
+
+  InputDB::SP_input db(new InputDB());
+  db->put<int>("tracker_otf", 1);
+
+  QuadratureMOC::SP_quadrature quad(new Uniform(2, 3, 7, 1, "TY"));
+  Tracker tracker(mesh, quad);
+  Tracker otf(mesh, quad, db);
+  Tracker::SP_trackdb tracks  = tracker.trackdb();
+  Tracker::SP_trackdb otracks = otf.trackdb();
+  TEST(!tracks->is_otf());
+  TEST(otracks->is_otf());
+
+  // No segments are stored.
+  TEST(otracks->number_segments() == 0);
+
+  // Segments traced on the fly match the stored ones, before and
+  // after normalization.
+  for (int n = 0; n < 2; n++)
+  {
+    if (n == 1)
+    {
+      tracker.normalize();
+      otf.normalize();
+    }
+    vec_int r0, r1;
+    vec_dbl l0, l1;
+    for (int a = 0; a < tracks->number_angles(); a++)
+    {
+      TEST(otracks->number_tracks_angle(a) == tracks->number_tracks_angle(a));
+      for (int t = 0; t < tracks->number_tracks_angle(a); t++)
+      {
+        test_Tracker_segments(tracks,  a, t, r0, l0);
+        test_Tracker_segments(otracks, a, t, r1, l1);
+        TEST(r1.size() == r0.size());
+        for (int s = 0; s < r0.size(); s++)
+        {
+          TEST(r1[s] == r0[s]);
+          TEST(soft_equiv(l1[s], l0[s], 1e-12));
+        }
+      }
+    }
+  }
+
+  return 0;
+}
+
+int test_Tracker_csg(int argc, char *argv[])
+{
+  // Three sectored pins and a moderator box on a 2x2 mesh
+  vec_dbl edges(3, 0.0); edges[1] = 1.26; edges[2] = 2.52;
+  vec_int mat(4, 2);
+  Mesh::SP_mesh base(new Mesh2D(edges, edges, mat));
+  vec_int pin_map(4, 0); pin_map[3] = -1;
+  base->add_mesh_map("PINCELL", pin_map);
+  vec_dbl radii(2, 0.3); radii[1] = 0.54;
+  vec_int pin_mat(3, 0); pin_mat[1] = 1; pin_mat[2] = 2;
+  MeshCSG::vec_pincell pins(1, PinCell::Create(1.26, radii, pin_mat));
+  pins[0]->set_number_sectors(4);
+  Mesh::SP_mesh mesh(new MeshCSG(base, pins));
+
+  // Regions carry their exact volumes and materials.
+  TEST(mesh->number_cells() == 37);
+  double total = 0.0;
+  for (int r = 0; r < mesh->number_cells(); r++)
+    total += mesh->volume(r);
+  TEST(soft_equiv(total, 2.52 * 2.52));
+  TEST(mesh->mesh_map("MATERIAL")[6] == 1);
+  TEST(mesh->mesh_map("MATERIAL")[36] == 2);
+  TEST(mesh->mesh_map("CELL")[36] == 3);
+
+  QuadratureMOC::SP_quadrature quad(new Uniform(2, 2, 100, 1, "TY"));
+  Tracker tracker(mesh, quad);
+  Tracker::SP_trackdb tracks = tracker.trackdb();
+
+  // The regions are not a grid, and the tracked mesh knows it.
+  TEST(!mesh->is_cartesian());
+  TEST(!tracker.meshmoc()->is_cartesian());
+  TEST(base->is_cartesian());
+
+  // Each angle's tracks cover the true regions closely.
+  vec_int r;
+  vec_dbl l;
+  for (int a = 0; a < tracks->number_angles(); a++)
+  {
+    vec_dbl volume(37, 0.0);
+    for (int t = 0; t < tracks->number_tracks_angle(a); t++)
+    {
+      test_Tracker_segments(tracks, a, t, r, l);
+      for (int s = 0; s < r.size(); s++)
+        volume[r[s]] += l[s] * tracks->spacing(a);
+    }
+    for (int i = 0; i < 37; i++)
+      TEST(soft_equiv(volume[i], mesh->volume(i), 0.03));
+  }
+
+  return 0;
+}
+
+int test_Tracker_3D(int argc, char *argv[])
+{
+  // A 2x2x2 mesh whose cell heights are multiples of the axial spacing
+  vec_dbl xy(3, 0.0); xy[1] = 1.0; xy[2] = 3.0;
+  vec_dbl z(3, 0.0);  z[1] = 1.0;  z[2] = 3.0;
+  vec_int mat(8, 0);
+  Mesh::SP_mesh mesh(new Mesh3D(xy, xy, z, mat));
+  QuadratureMOC::SP_quadrature quad(new Uniform(3, 2, 10, 2, "TY"));
+  InputDB::SP_input db(new InputDB());
+  db->put<int>("tracker_number_z", 3);
+  Tracker tracker(mesh, quad, db);
+  tracker.normalize();
+  Tracker::SP_trackdb tracks = tracker.trackdb();
+  MeshMOC::SP_mesh meshmoc = tracker.meshmoc();
+  TrackStack::SP_trackstack stack = meshmoc->stack();
+  TEST(stack);
+  TEST(tracks->number_regions() == 4);
+  TEST(soft_equiv(stack->spacing_z(), 1.0));
+
+  // The stacked tracks of each azimuth, polar angle, and direction
+  // conserve the cell volumes.
+  vec_int r;
+  vec_dbl l;
+  vec_int r3;
+  vec_dbl l3;
+  for (int a = 0; a < tracks->number_angles(); a++)
+  {
+    for (int p = 0; p < 2; p++)
+    {
+      for (int d = 0; d < 4; d++)
+      {
+        bool down = d % 2, reverse = d / 2;
+        vec_dbl volume(8, 0.0);
+        for (int t = 0; t < tracks->number_tracks_angle(a); t++)
+        {
+          test_Tracker_segments(tracks, a, t, r, l);
+          int n = stack->number_stacked(a, t, p);
+          TEST(n >= 3);
+          TEST(stack->offset(a, p, t) + n <= stack->number_tracks(a, p));
+          for (int j = 0; j < n; j++)
+          {
+            int ns = stack->segments(a, t, p, j, down, reverse,
+                                     &r[0], &l[0], r.size(), r3, l3);
+            for (int s = 0; s < ns; s++)
+              volume[r3[s]] += l3[s] * tracks->spacing(a) * stack->spacing_z();
+          }
+        }
+        for (int i = 0; i < 8; i++)
+          TEST(soft_equiv(volume[i], mesh->volume(i), 1e-9));
+      }
+    }
+  }
+
   return 0;
 }
 
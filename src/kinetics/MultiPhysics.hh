@@ -83,6 +83,13 @@ public:
     return d_number_variables;
   }
 
+  /// Exchange the variables with another container of the same size
+  void swap(MultiPhysics &other)
+  {
+    Require(d_number_variables == other.d_number_variables);
+    d_physics_variables.swap(other.d_physics_variables);
+  }
+
   /// Pretty display of contents
   void display() const;
 
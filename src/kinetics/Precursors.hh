@@ -21,6 +21,9 @@ namespace detran
 /**
  *  @class Precursors
  *  @brief Container for precursor concentrations
+ *
+ *  The concentrations of each precursor group are contiguous over
+ *  cells, so kernels over a group sweep the cells with unit stride.
  */
 class KINETICS_EXPORT Precursors
 {
@@ -76,6 +79,14 @@ public:
     return d_number_cells;
   }
 
+  /// Exchange the concentrations with another vector of the same size
+  void swap(Precursors &other)
+  {
+    Require(d_number_precursor_groups == other.d_number_precursor_groups);
+    Require(d_number_cells == other.d_number_cells);
+    d_C.swap(other.d_C);
+  }
+
   void display() const;
 
 private:
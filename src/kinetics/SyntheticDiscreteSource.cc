@@ -19,6 +19,7 @@ SyntheticDiscreteSource::SyntheticDiscreteSource(const size_t number_groups,
                                                  SP_material material)
   : Base(number_groups, mesh, quadrature, material, true)
   , d_source(d_number_groups)
+  , d_delayed(d_mesh->number_cells(), 0.0)
 {
   // Preconditions
   Require(d_quadrature);
@@ -88,6 +88,8 @@ private:
 
   /// Discrete source [group][angle][space]
   vec3_dbl d_source;
+  /// Delayed source of a group [space]
+  vec_dbl d_delayed;
 
 };
 
@@ -64,84 +64,39 @@ inline void SyntheticDiscreteSource::build(const double dt,
   size_t size_precursor = precursors.size();
   Require((size_precursor == size_state) || (size_precursor == 0));
 
-  // Number of precursors
-  size_t np = 0;
-  if (size_precursor) np = precursors[0]->number_precursor_groups();
+  // Weights of the previous solutions and decay of the previous
+  // precursors, which are shared by all groups
+  build_history_factors(dt, order);
+  if (size_precursor) build_emission(dt, precursors, order);
 
-  // Material map
-  const detran_utilities::vec_int &mt = d_mesh->mesh_map("MATERIAL");
-
-  // Leading coefficient
-  double a_0 = bdf_coefs[order - 1][0];
-
-  // Clear the source
   for (size_t g = 0; g < d_material->number_groups(); ++g)
-    for (size_t o = 0; o < d_quadrature->number_octants(); ++o)
-      for (size_t a = 0; a < d_quadrature->number_angles_octant(); ++a)
-        for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
-          d_source[g][d_quadrature->index(o, a)][cell] = 0.0;
-
-  // Add all backward terms
-  for (size_t j = 0; j < order; ++j)
   {
-    Assert(states[j]);
-    if (size_precursor)
-    {
-      Assert(precursors[j]);
-    }
-
-    // Skip the first entry, which is for the (n+1) term
-    double a_j = bdf_coefs[order - 1][j + 1];
-
-    for (size_t g = 0; g < d_material->number_groups(); ++g)
+    // The delayed source is isotropic, so it is built once for all angles.
+    for (size_t cell = 0; cell < d_delayed.size(); ++cell)
+      d_delayed[cell] = 0.0;
+    if (size_precursor) add_delayed_source(g, d_norm, d_delayed);
+
+    // Add the backward terms of the angular flux.  The first
+    // coefficient is for the (n+1) term.
+    for (size_t angle = 0; angle < d_quadrature->number_angles(); ++angle)
     {
-      double psi_factor = a_j / dt / d_material->velocity(g);
-
-      for (size_t o = 0; o < d_quadrature->number_octants(); ++o)
+      size_t o = angle / d_quadrature->number_angles_octant();
+      size_t a = angle % d_quadrature->number_angles_octant();
+      Assert(d_quadrature->index(o, a) == angle);
+      vec_dbl &q = d_source[g][angle];
+      q = d_delayed;
+      for (size_t j = 0; j < order; ++j)
       {
-        for (size_t a = 0; a < d_quadrature->number_angles_octant(); ++a)
-        {
-
-          size_t angle = d_quadrature->index(o, a);
-
-          // Add flux
-          for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
-          {
-            d_source[g][angle][cell] +=
-              psi_factor * states[j]->psi(g, o, a)[cell];
-            //std::cout << " j = " << j << " psi = " << states[j]->psi(g, o, a)[cell] << std::endl;
-          }
-
-          // Add the precursor concentration, if applicable
-          if (size_precursor)
-          {
-            for (size_t i = 0; i < np; ++i)
-            {
-              double C_factor =  a_j * d_norm * d_material->lambda(i) /
-                                (a_0 + dt * d_material->lambda(i));
-//              std::cout << " Cfactor=" << C_factor
-//                        << " den=" << a_0 + dt * d_material->lambda(i)
-//                        << " num=" << a_j * d_norm * d_material->lambda(i)
-//                        << " aj=" << a_j
-//                        << " lam=" << d_material->lambda(i)
-//                        << " nrm=" << d_norm << std::endl;
-              for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
-              {
-//                std::cout << " C=" <<precursors[j]->C(i)[cell]
-//                          << " chid = " << d_material->chi_d(mt[cell], i, g)
-//                          << std::endl;
-                d_source[g][angle][cell] += C_factor *
-                  d_material->chi_d(mt[cell], i, g) *
-                    precursors[j]->C(i)[cell];
-              }
-            }
-          }
-
-        } // end angle
-      } // end octant
-    } // end groups
-  } // end backward terms
-
+        Assert(states[j]);
+        double psi_factor =
+          bdf_coefs[order - 1][j + 1] / dt / d_material->velocity(g);
+        const vec_dbl &f = d_history_factors[j];
+        const State::angular_flux_type &psi = states[j]->psi(g, o, a);
+        for (size_t cell = 0; cell < q.size(); ++cell)
+          q[cell] += f[cell] * psi_factor * psi[cell];
+      }
+    } // end angles
+  } // end groups
 }
 
 } // end namespace detran
@@ -54,71 +54,41 @@ inline void SyntheticMomentSource::build(const double dt,
   size_t size_precursor = precursors.size();
   Require((size_precursor == size_state) || (size_precursor == 0));
 
-  // Number of precursors
-  size_t np = 0;
-  if (size_precursor) np = precursors[0]->number_precursor_groups();
+  // Weights of the previous solutions and decay of the previous
+  // precursors, which are shared by all groups
+  build_history_factors(dt, order);
+  if (size_precursor) build_emission(dt, precursors, order);
 
-  // Material map
-  const detran_utilities::vec_int &mt = d_mesh->mesh_map("MATERIAL");
-
-  // Leading coefficient
-  double a_0 = bdf_coefs[order-1][0];
-
-  // Clear the source
   for (size_t g = 0; g < d_material->number_groups(); ++g)
-    for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
-      d_source[g][cell] = 0.0;
-
-  // Add all backward terms
-  for (size_t j = 0; j < order; ++j)
   {
-    Assert(states[j]);
-    if (size_precursor)
-    {
-      Assert(precursors[j]);
-    }
+    vec_dbl &q = d_source[g];
 
-    // Skip the first entry, which is for the (n+1) term
-    double a_j = bdf_coefs[order-1][j + 1];
-
-    for (size_t g = 0; g < d_material->number_groups(); ++g)
+    // Add all backward terms, starting with the most recent.  The
+    // first coefficient is for the (n+1) term.
+    for (size_t j = 0; j < order; ++j)
     {
+      Assert(states[j]);
+      double a_j = bdf_coefs[order-1][j + 1];
+      const vec_dbl &f = d_history_factors[j];
 
       // Add the flux term
       double phi_factor = a_j / dt / d_material->velocity(g);
-      for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
+      const State::moments_type &phi = states[j]->phi(g);
+      if (j == 0)
       {
-//        std::cout << " phi factor=" << phi_factor
-//                  << " phi = " << states[j]->phi(g)[cell]
-//                  << " source = " << d_source[g][cell] << std::endl;
-        d_source[g][cell] += phi_factor * states[j]->phi(g)[cell];
+        for (size_t cell = 0; cell < q.size(); ++cell)
+          q[cell] = f[cell] * phi_factor * phi[cell];
       }
-
-      // Add the precursor concentration, if applicable
-      if (size_precursor)
+      else
       {
-        for (size_t i = 0; i < np; ++i)
-        {
-          double C_factor = a_j * d_material->lambda(i) /
-                            (a_0 + dt * d_material->lambda(i));
-          for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
-          {
-
-            d_source[g][cell] += C_factor *
-                                 d_material->chi_d(mt[cell], i, g) *
-                                 precursors[j]->C(i)[cell];
-//            std::cout << " C=" << precursors[j]->C(i)[cell]
-//                      << " chid = " << d_material->chi_d(mt[cell], i, g)
-//                      << " q= " << d_source[g][cell]
-//                      << std::endl;
-          }
-        }
+        for (size_t cell = 0; cell < q.size(); ++cell)
+          q[cell] += f[cell] * phi_factor * phi[cell];
       }
+    } // end backward terms
 
-    } // end groups
-  } // end backward terms
-//  std::cout << " source = " << this->source(0, 0) << "  " << this->source(1, 0) << std::endl;
-//  std::cout << " source = " << this->source(0, 0, 0) << "  " << this->source(1, 0, 0) << " " << dt << std::endl;
+    // Add the delayed source, if applicable
+    if (size_precursor) add_delayed_source(g, 1.0, q);
+  } // end groups
 }
 
 } // end namespace detran
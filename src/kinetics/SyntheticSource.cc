@@ -22,6 +22,7 @@ SyntheticSource::SyntheticSource(const size_t   number_groups,
   : Base(number_groups, mesh, quadrature, discrete)
   , d_material(material)
   , d_norm(detran_angle::Quadrature::angular_norm(d_mesh->dimension()))
+  , d_history_factors(6, vec_dbl(d_mesh->number_cells(), 1.0))
 {
   /* ... */
 }
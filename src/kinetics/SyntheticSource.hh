@@ -36,6 +36,19 @@ namespace detran
  *  to implement the implicit midpoint rule as used in
  *  PARTISN.
  *
+ *  Optionally, the previous solutions of each cell can be weighted
+ *  for a local frequency \f$ \omega \f$ (see set_frequency).  The
+ *  flux and precursors are factored as
+ *  \f$ \phi(t) = e^{\omega (t - t_{n+1})} \hat{\phi}(t) \f$, and
+ *  the BDF terms of step \f$ j \f$ back are weighted by
+ *  @f[
+ *      f_j = \Big(1 - \frac{\omega \Delta}{a_0}\Big)
+ *            e^{j \omega \Delta} \, ,
+ *  @f]
+ *  which makes the discrete derivative exact for
+ *  \f$ e^{\omega t} \f$ while leaving the leading term, and hence
+ *  the synthetic material, unchanged.  The product
+ *  \f$ \omega \Delta \f$ is limited to \f$ a_0/2 \f$.
  */
 class KINETICS_EXPORT SyntheticSource:
   public detran_external_source::ExternalSource
@@ -91,6 +104,33 @@ public:
                      const vec_precursors &precursors,
                      const size_t order = 1) = 0;
 
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Set the frequency of each cell
+   *
+   *  An empty vector turns the frequency weighting off.
+   */
+  void set_frequency(const vec_dbl &omega)
+  {
+    Require(omega.empty() || omega.size() == d_mesh->number_cells());
+    d_omega = omega;
+  }
+
+  /**
+   *  @brief Weight of a previous solution for the frequency of a cell
+   *  @param cell   Cell index
+   *  @param j      Index of the previous solution, i.e. j + 1 steps back
+   *  @param dt     Time step size
+   *  @param order  BDF order
+   */
+  inline double history_factor(const size_t cell,
+                               const size_t j,
+                               const double dt,
+                               const size_t order) const;
+
 protected:
 
   //-------------------------------------------------------------------------//
@@ -103,6 +143,38 @@ protected:
   /// Angular norm
   double d_norm;
 
+  /// Frequency of each cell (empty if not used)
+  vec_dbl d_omega;
+
+  /// Weights of the previous solutions [step back][cell]
+  vec2_dbl d_history_factors;
+
+  /// Weighted decay of the previous precursors [precursor group][cell]
+  vec2_dbl d_emission;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Fill the weights of the previous solutions for a step.
+  inline void build_history_factors(const double dt, const size_t order);
+
+  /**
+   *  @brief Sum the decay of the previous precursors of each group
+   *
+   *  The history factors must be built first.  Summing over the steps
+   *  once per precursor group leaves only the emission spectra to
+   *  apply for each energy group (see add_delayed_source).
+   */
+  inline void build_emission(const double          dt,
+                             const vec_precursors &precursors,
+                             const size_t          order);
+
+  /// Add the scaled delayed source of a group to a cell vector.
+  inline void add_delayed_source(const size_t  g,
+                                 const double  scale,
+                                 vec_dbl      &q) const;
+
 };
 
 KINETICS_TEMPLATE_EXPORT(detran_utilities::SP<SyntheticSource>)
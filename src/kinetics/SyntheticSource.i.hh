@@ -10,10 +10,105 @@
 #ifndef detran_SYNTHETICSOURCE_I_HH_
 #define detran_SYNTHETICSOURCE_I_HH_
 
+#include <algorithm>
+#include <cmath>
+
 namespace detran
 {
 
-/* ... */
+//---------------------------------------------------------------------------//
+inline double SyntheticSource::history_factor(const size_t cell,
+                                              const size_t j,
+                                              const double dt,
+                                              const size_t order) const
+{
+  // Preconditions
+  Require(order > 0);
+  Require(order <= 6);
+
+  if (d_omega.empty()) return 1.0;
+  Require(cell < d_omega.size());
+  double a_0 = bdf_coefs[order - 1][0];
+  double x = std::min(d_omega[cell] * dt, 0.5 * a_0);
+  return (1.0 - x / a_0) * std::exp((j + 1) * x);
+}
+
+//---------------------------------------------------------------------------//
+inline void SyntheticSource::build_history_factors(const double dt,
+                                                   const size_t order)
+{
+  Require(order <= d_history_factors.size());
+  for (size_t j = 0; j < order; ++j)
+  {
+    vec_dbl &f = d_history_factors[j];
+    if (d_omega.empty())
+    {
+      for (size_t cell = 0; cell < f.size(); ++cell)
+        f[cell] = 1.0;
+      continue;
+    }
+    for (size_t cell = 0; cell < f.size(); ++cell)
+      f[cell] = history_factor(cell, j, dt, order);
+  }
+}
+
+//---------------------------------------------------------------------------//
+inline void SyntheticSource::build_emission(const double          dt,
+                                            const vec_precursors &precursors,
+                                            const size_t          order)
+{
+  size_t np = 0;
+  if (precursors.size()) np = precursors[0]->number_precursor_groups();
+  d_emission.resize(np, vec_dbl(d_mesh->number_cells(), 0.0));
+
+  // Each group is a unit-stride sweep over cells with no material lookups.
+  double a_0 = bdf_coefs[order - 1][0];
+  for (size_t i = 0; i < np; ++i)
+  {
+    double lambda = d_material->lambda(i);
+    double factor = lambda / (a_0 + dt * lambda);
+    vec_dbl &E = d_emission[i];
+    for (size_t j = 0; j < order; ++j)
+    {
+      Assert(precursors[j]);
+      double C_factor = bdf_coefs[order - 1][j + 1] * factor;
+      const vec_dbl &f = d_history_factors[j];
+      const vec_dbl &C = precursors[j]->C(i);
+      if (j == 0)
+      {
+        for (size_t cell = 0; cell < E.size(); ++cell)
+          E[cell] = f[cell] * C_factor * C[cell];
+      }
+      else
+      {
+        for (size_t cell = 0; cell < E.size(); ++cell)
+          E[cell] += f[cell] * C_factor * C[cell];
+      }
+    }
+  }
+}
+
+//---------------------------------------------------------------------------//
+inline void SyntheticSource::add_delayed_source(const size_t  g,
+                                                const double  scale,
+                                                vec_dbl      &q) const
+{
+  size_t np = d_emission.size();
+  if (!np) return;
+  const detran_utilities::vec_int &mt = d_mesh->mesh_map("MATERIAL");
+  int number_cells = q.size();
+#ifdef DETRAN_ENABLE_OPENMP
+  #pragma omp parallel for
+#endif
+  for (int cell = 0; cell < number_cells; ++cell)
+  {
+    size_t m = mt[cell];
+    double value = 0.0;
+    for (size_t i = 0; i < np; ++i)
+      value += d_material->chi_d(m, i, g) * d_emission[i][cell];
+    q[cell] += scale * value;
+  }
+}
 
 } // end namespace detran
 
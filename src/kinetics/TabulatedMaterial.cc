@@ -0,0 +1,218 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   TabulatedMaterial.cc
+ *  @brief  TabulatedMaterial
+ *  @author Jeremy Roberts
+ *  @date   Mar 6, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#include "TabulatedMaterial.hh"
+#include <algorithm>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+TabulatedMaterial::TabulatedMaterial(const vec2_dbl     &parameters,
+                                     const vec_material &materials,
+                                     const vec_int      &composition,
+                                     SP_multiphysics     physics,
+                                     const vec_int      &variables,
+                                     std::string         name)
+  : Base(composition.size(),
+         materials[0]->number_groups(),
+         materials[0]->number_precursor_groups(),
+         name)
+  , d_parameters(parameters)
+  , d_composition(composition)
+  , d_physics(physics)
+  , d_variables(variables)
+  , d_values(parameters.size(), 0.0)
+  , d_number_compositions(materials[0]->number_materials())
+  , d_number_points(1)
+{
+  // Preconditions
+  Require(d_parameters.size() > 0);
+  Require(d_variables.size() == d_parameters.size());
+
+  d_strides.resize(d_parameters.size());
+  for (size_t p = 0; p < d_parameters.size(); ++p)
+  {
+    Require(d_parameters[p].size() > 0);
+    for (size_t k = 1; k < d_parameters[p].size(); ++k)
+    {
+      Require(d_parameters[p][k - 1] < d_parameters[p][k]);
+    }
+    if (d_variables[p] >= 0)
+    {
+      Require(d_physics);
+      Require(d_variables[p] < d_physics->number_variables());
+    }
+    d_strides[p] = d_number_points;
+    d_number_points *= d_parameters[p].size();
+    d_values[p] = d_parameters[p][0];
+  }
+  Insist(materials.size() == d_number_points,
+         "There must be one material for each point of the parameter grid.");
+  for (size_t m = 0; m < d_number_materials; ++m)
+  {
+    Require(d_composition[m] >= 0);
+    Require(d_composition[m] < d_number_compositions);
+  }
+
+  // Pack the table.
+  d_block_size = d_number_groups *
+                 (6 + d_number_groups + d_number_precursor_groups) +
+                 d_number_precursor_groups;
+  d_table.resize(d_number_compositions * d_number_points * d_block_size);
+  d_work.resize(d_block_size);
+  for (size_t i = 0; i < d_number_points; ++i)
+  {
+    Require(materials[i]);
+    Require(materials[i]->number_materials() == d_number_compositions);
+    Require(materials[i]->number_groups() == d_number_groups);
+    Require(materials[i]->number_precursor_groups() ==
+            d_number_precursor_groups);
+    for (size_t c = 0; c < d_number_compositions; ++c)
+      pack(materials[i], c, &d_table[(c * d_number_points + i) * d_block_size]);
+  }
+
+  for (size_t g = 0; g < d_number_groups; ++g)
+    d_velocity[g] = materials[0]->velocity(g);
+
+  for (size_t i = 0; i < d_number_precursor_groups; ++i)
+    d_lambda[i] = materials[0]->lambda(i);
+
+  // Start with the cross sections at the current parameters.
+  update_impl();
+  finalize();
+}
+
+//---------------------------------------------------------------------------//
+TabulatedMaterial::SP_material
+TabulatedMaterial::Create(const vec2_dbl     &parameters,
+                          const vec_material &materials,
+                          const vec_int      &composition,
+                          SP_multiphysics     physics,
+                          const vec_int      &variables,
+                          std::string         name)
+{
+  SP_material p(new TabulatedMaterial(parameters, materials, composition,
+                                      physics, variables, name));
+  return p;
+}
+
+//---------------------------------------------------------------------------//
+void TabulatedMaterial::set_parameter(const size_t p, const double value)
+{
+  Require(p < d_parameters.size());
+  Require(d_variables[p] < 0);
+  d_values[p] = value;
+}
+
+//---------------------------------------------------------------------------//
+// IMPLEMENTATION
+//---------------------------------------------------------------------------//
+
+//---------------------------------------------------------------------------//
+void TabulatedMaterial::update_impl()
+{
+  size_t number_parameters = d_parameters.size();
+  size_t number_corners    = 1 << number_parameters;
+
+  // Lower grid index and weight of the upper point for each parameter
+  vec_size_t index(number_parameters, 0);
+  vec_dbl    weight(number_parameters, 0.0);
+
+  for (size_t m = 0; m < d_number_materials; ++m)
+  {
+    for (size_t p = 0; p < number_parameters; ++p)
+    {
+      const vec_dbl &x = d_parameters[p];
+      double v = d_values[p];
+      if (d_variables[p] >= 0) v = d_physics->variable(d_variables[p])[m];
+      index[p]  = 0;
+      weight[p] = 0.0;
+      if (x.size() == 1 || v <= x[0]) continue;
+      if (v >= x.back())
+      {
+        index[p] = x.size() - 1;
+        continue;
+      }
+      index[p]  = std::upper_bound(x.begin(), x.end(), v) - x.begin() - 1;
+      weight[p] = (v - x[index[p]]) / (x[index[p] + 1] - x[index[p]]);
+    }
+
+    // Sum the weighted blocks at the corners of the enclosing cell
+    // of the grid.  Corners of zero weight are skipped, which also
+    // keeps the index in bounds at the edges.
+    const double *table =
+      &d_table[d_composition[m] * d_number_points * d_block_size];
+    std::fill(d_work.begin(), d_work.end(), 0.0);
+    for (size_t corner = 0; corner < number_corners; ++corner)
+    {
+      double w = 1.0;
+      size_t point = 0;
+      for (size_t p = 0; p < number_parameters; ++p)
+      {
+        size_t upper = (corner >> p) & 1;
+        w *= upper ? weight[p] : 1.0 - weight[p];
+        point += (index[p] + upper) * d_strides[p];
+      }
+      if (w == 0.0) continue;
+      const double *block = table + point * d_block_size;
+      for (size_t s = 0; s < d_block_size; ++s)
+        d_work[s] += w * block[s];
+    }
+    unpack(m, &d_work[0]);
+  }
+}
+
+//---------------------------------------------------------------------------//
+void TabulatedMaterial::pack(SP_kineticsmaterial material,
+                             const size_t        c,
+                             double             *block)
+{
+  for (size_t g = 0; g < d_number_groups; ++g)
+  {
+    *block++ = material->sigma_t(c, g);
+    *block++ = material->sigma_a(c, g);
+    *block++ = material->sigma_f(c, g);
+    *block++ = material->nu(c, g);
+    *block++ = material->diff_coef(c, g);
+    *block++ = material->chi(c, g);
+    for (size_t gp = 0; gp < d_number_groups; ++gp)
+      *block++ = material->sigma_s(c, g, gp);
+    for (size_t i = 0; i < d_number_precursor_groups; ++i)
+      *block++ = material->chi_d(c, i, g);
+  }
+  for (size_t i = 0; i < d_number_precursor_groups; ++i)
+    *block++ = material->beta(c, i);
+}
+
+//---------------------------------------------------------------------------//
+void TabulatedMaterial::unpack(const size_t m, const double *block)
+{
+  for (size_t g = 0; g < d_number_groups; ++g)
+  {
+    d_sigma_t[g][m]   = *block++;
+    d_sigma_a[g][m]   = *block++;
+    d_sigma_f[g][m]   = *block++;
+    d_nu[g][m]        = *block++;
+    d_diff_coef[g][m] = *block++;
+    d_chi[g][m]       = *block++;
+    for (size_t gp = 0; gp < d_number_groups; ++gp)
+      d_sigma_s[g][gp][m] = *block++;
+    for (size_t i = 0; i < d_number_precursor_groups; ++i)
+      d_chi_d[g][i][m] = *block++;
+  }
+  for (size_t i = 0; i < d_number_precursor_groups; ++i)
+    d_beta[i][m] = *block++;
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of file TabulatedMaterial.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,154 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   TabulatedMaterial.hh
+ *  @brief  TabulatedMaterial
+ *  @author Jeremy Roberts
+ *  @date   Mar 6, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_TABULATEDMATERIAL_HH_
+#define detran_TABULATEDMATERIAL_HH_
+
+#include "TimeDependentMaterial.hh"
+#include "MultiPhysics.hh"
+
+namespace detran
+{
+
+/**
+ *  @class TabulatedMaterial
+ *  @brief Material interpolated from cross sections tabulated over
+ *         feedback parameters
+ *
+ *  Cross sections are given on a tensor-product grid of parameters,
+ *  e.g. fuel temperature, moderator density, and boron concentration.
+ *  Each grid point is a KineticsMaterial whose materials are the
+ *  compositions to be tabulated, and the points are ordered with the
+ *  first parameter varying fastest.  Every cell is its own material,
+ *  mapped to one of the compositions.
+ *
+ *  A parameter is either read cell-wise from a MultiPhysics variable or
+ *  is a single value set by the client (e.g. a boron concentration).  On
+ *  update, the cross sections of each cell are interpolated multilinearly
+ *  in its parameters.  Values outside the grid take the value at the
+ *  nearest edge.
+ *
+ *  At construction, the table is packed into one contiguous array
+ *  ordered by composition, then grid point, then cross section, so that
+ *  the cross sections at a grid point are adjacent in memory and the
+ *  interpolation is a weighted sum of a few contiguous blocks.
+ *
+ *  The kinetics parameters (velocities and decay constants) are taken
+ *  from the first grid point.  The delayed fractions and spectra are
+ *  interpolated along with the cross sections.
+ */
+class KINETICS_EXPORT TabulatedMaterial: public TimeDependentMaterial
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef TimeDependentMaterial             Base;
+  typedef KineticsMaterial::SP_material     SP_kineticsmaterial;
+  typedef std::vector<SP_kineticsmaterial>  vec_material;
+  typedef MultiPhysics::SP_multiphysics     SP_multiphysics;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param parameters     Increasing grid values for each parameter
+   *  @param materials      Materials at each grid point
+   *  @param composition    Composition (table material) of each cell
+   *  @param physics        Multiphysics holding cell-wise parameters
+   *  @param variables      Multiphysics variable for each parameter, or
+   *                        -1 if the parameter is set by set_parameter
+   */
+  TabulatedMaterial(const vec2_dbl     &parameters,
+                    const vec_material &materials,
+                    const vec_int      &composition,
+                    SP_multiphysics     physics,
+                    const vec_int      &variables,
+                    std::string         name = "TabulatedMaterial");
+
+  /// SP constructor
+  static SP_material Create(const vec2_dbl     &parameters,
+                            const vec_material &materials,
+                            const vec_int      &composition,
+                            SP_multiphysics     physics,
+                            const vec_int      &variables,
+                            std::string         name = "TabulatedMaterial");
+
+  /// Virtual destructor
+  virtual ~TabulatedMaterial(){};
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /// Set the value of a parameter that is not read from the multiphysics.
+  void set_parameter(const size_t p, const double value);
+
+  /// Number of tabulated parameters
+  size_t number_parameters() const {return d_parameters.size();}
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Grid values of each parameter
+  vec2_dbl d_parameters;
+  /// Composition of each cell
+  vec_int d_composition;
+  /// Multiphysics holding the cell-wise parameters
+  SP_multiphysics d_physics;
+  /// Multiphysics variable of each parameter, or -1
+  vec_int d_variables;
+  /// Values of the parameters set by the client
+  vec_dbl d_values;
+  /// Number of compositions and grid points
+  size_t d_number_compositions;
+  size_t d_number_points;
+  /// Number of cross section values per composition and grid point
+  size_t d_block_size;
+  /// Stride of each parameter in grid points
+  vec_size_t d_strides;
+  /// Packed table, [composition][point][cross section]
+  vec_dbl d_table;
+  /// Interpolated cross sections of a cell
+  vec_dbl d_work;
+
+  //-------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL TIME DEPENDENT MATERIALS MUST IMPLEMENT THESE
+  //-------------------------------------------------------------------------//
+
+  /// Interpolate the cross sections of each cell
+  void update_impl();
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Pack the cross sections of one composition at one grid point.
+  void pack(SP_kineticsmaterial material, const size_t c, double *block);
+
+  /// Set the cross sections of a cell from an interpolated block.
+  void unpack(const size_t m, const double *block);
+
+};
+
+} // end namespace detran
+
+#endif // detran_TABULATEDMATERIAL_HH_
+
+//---------------------------------------------------------------------------//
+//              end of file TabulatedMaterial.hh
+//---------------------------------------------------------------------------//
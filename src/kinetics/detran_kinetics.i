@@ -14,6 +14,7 @@
 #include "kinetics/TimeDependentMaterial.hh"
 #include "kinetics/PyTimeDependentMaterial.hh"
 #include "kinetics/LinearMaterial.hh"
+#include "kinetics/TabulatedMaterial.hh"
 #include "kinetics/Precursors.hh"
 // source
 #include "external_source/ExternalSource.hh"
@@ -74,6 +75,7 @@ setCallbackMethod(1, // this is a *unique* identifier
 %include "TimeDependentMaterial.hh"
 %include "PyTimeDependentMaterial.hh"
 %include "LinearMaterial.hh"
+%include "TabulatedMaterial.hh"
 %include "Precursors.hh"
 %template(KineticsMaterialSP)   detran_utilities::SP<detran::KineticsMaterial>;
 %template(TDMaterialSP)         detran_utilities::SP<detran::TimeDependentMaterial>;
@@ -0,0 +1,134 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_TabulatedMaterial.cc
+ *  @author Jeremy Roberts
+ *  @date   Mar 6, 2013
+ *  @brief  Test of TabulatedMaterial class.
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                       \
+        FUNC(test_TabulatedMaterial)
+
+// Detran headers
+#include "utilities/TestDriver.hh"
+#include "kinetics/TabulatedMaterial.hh"
+#include <cmath>
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_utilities;
+using detran_utilities::soft_equiv;
+
+int main(int argc, char *argv[])
+{
+  RUN(argc, argv);
+}
+
+//----------------------------------------------//
+// TEST DEFINITIONS
+//----------------------------------------------//
+
+// Bilinear data, which the interpolation reproduces exactly
+double test_TabulatedMaterial_xs(int c, int g, double T, double rho)
+{
+  return (1.0 + c + 0.1 * g) *
+         (0.5 + 1.0e-4 * T + 0.2 * rho + 1.0e-4 * T * rho);
+}
+
+// Test of basic public interface
+int test_TabulatedMaterial(int argc, char *argv[])
+{
+  // Fuel temperature and moderator density grids
+  vec2_dbl parameters(2);
+  parameters[0].resize(3);
+  parameters[0][0] = 300.0; parameters[0][1] = 600.0; parameters[0][2] = 900.0;
+  parameters[1].resize(2);
+  parameters[1][0] = 0.6;   parameters[1][1] = 0.8;
+
+  // Two compositions and two groups at each point, temperature fastest
+  TabulatedMaterial::vec_material materials;
+  for (int j = 0; j < 2; ++j)
+  {
+    for (int i = 0; i < 3; ++i)
+    {
+      double T = parameters[0][i], rho = parameters[1][j];
+      KineticsMaterial::SP_material mat(new KineticsMaterial(2, 2, 1));
+      for (int c = 0; c < 2; ++c)
+      {
+        for (int g = 0; g < 2; ++g)
+        {
+          double xs = test_TabulatedMaterial_xs(c, g, T, rho);
+          mat->set_sigma_t(c, g,        xs);
+          mat->set_sigma_a(c, g,        0.1 * xs);
+          mat->set_sigma_f(c, g,        0.05 * xs);
+          mat->set_nu(c, g,             2.5);
+          mat->set_diff_coef(c, g,      1.0 / (3.0 * xs));
+          mat->set_chi(c, g,            1.0 - g);
+          mat->set_chi_d(c, 0, g,       1.0 - g);
+          mat->set_velocity(g,          g ? 2.2e5 : 1.0e7);
+        }
+        mat->set_sigma_s(c, 1, 0,
+                         0.02 * test_TabulatedMaterial_xs(c, 0, T, rho));
+        mat->set_beta(c, 0, 0.006 + 1.0e-6 * T);
+      }
+      mat->set_lambda(0, 0.08);
+      mat->finalize();
+      materials.push_back(mat);
+    }
+  }
+
+  // Cell temperatures from the multiphysics.  The density is global.
+  MultiPhysics::SP_multiphysics physics(new MultiPhysics(1));
+  vec_dbl T(4, 0.0);
+  T[0] = 300.0; T[1] = 450.0; T[2] = 750.0; T[3] = 1200.0;
+  physics->add_variable(0, T);
+  vec_int composition(4, 0);
+  composition[1] = 1; composition[3] = 1;
+  vec_int variables(2, -1);
+  variables[0] = 0;
+
+  detran_utilities::SP<TabulatedMaterial>
+    mat(new TabulatedMaterial(parameters, materials, composition,
+                              physics, variables));
+  TEST(mat->number_materials() == 4);
+  TEST(mat->number_groups() == 2);
+  TEST(soft_equiv(mat->velocity(1), 2.2e5));
+  TEST(soft_equiv(mat->lambda(0), 0.08));
+
+  double rho = 0.75;
+  mat->set_parameter(1, rho);
+  mat->update(0.0, 0.0, 1, false);
+
+  for (int m = 0; m < 4; ++m)
+  {
+    int c = composition[m];
+    // Outside the grid, the edge value is used.
+    double t = std::min(T[m], 900.0);
+    for (int g = 0; g < 2; ++g)
+    {
+      double xs = test_TabulatedMaterial_xs(c, g, t, rho);
+      TEST(soft_equiv(mat->sigma_t(m, g),    xs));
+      TEST(soft_equiv(mat->sigma_a(m, g),    0.1 * xs));
+      TEST(soft_equiv(mat->nu_sigma_f(m, g), 2.5 * 0.05 * xs));
+      TEST(soft_equiv(mat->chi(m, g),        1.0 - g));
+      TEST(soft_equiv(mat->chi_d(m, 0, g),   1.0 - g));
+    }
+    TEST(soft_equiv(mat->sigma_s(m, 1, 0),
+                    0.02 * test_TabulatedMaterial_xs(c, 0, t, rho)));
+    TEST(soft_equiv(mat->beta(m, 0), 0.006 + 1.0e-6 * t));
+  }
+
+  // Changing the physics changes the cross sections on update.
+  physics->variable(0)[0] = 600.0;
+  mat->update(0.0, 0.0, 1, false);
+  TEST(soft_equiv(mat->sigma_t(0, 0),
+                  test_TabulatedMaterial_xs(0, 0, 600.0, rho)));
+
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_TabulatedMaterial.cc
+//---------------------------------------------------------------------------//
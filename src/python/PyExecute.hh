@@ -222,7 +222,7 @@ void PyExecute<D>::setup()
   d_moc = false;
   if (d_input->check("equation"))
     eq = d_input->get<std::string>("equation");
-  if (eq == "scmoc" || eq == "ddmoc")
+  if (eq == "scmoc" || eq == "ddmoc" || eq == "lsmoc")
     d_moc = true;
 
   //-------------------------------------------------------------------------//
@@ -239,10 +239,11 @@ void PyExecute<D>::setup()
   if (d_moc)
   {
     // Track the mesh
-    detran_geometry::Tracker tracker(d_mesh, d_quadrature);
+    detran_geometry::Tracker tracker(d_mesh, d_quadrature, d_input);
 
     // Normalize segments to conserve volume.
     tracker.normalize();
+    if (eq == "lsmoc") tracker.trackdb()->compute_centroids();
 
     // Replace the mesh with the tracked one.  This suggests refactoring
     // to have a (possibly null) trackdb in Mesh.
@@ -0,0 +1,272 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   AdaptiveRefinement.cc
+ *  @brief  AdaptiveRefinement member definitions
+ *  @author Jeremy Roberts
+ *  @date   Feb 27, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#include "AdaptiveRefinement.hh"
+#include "geometry/Mesh1D.hh"
+#include "geometry/Mesh2D.hh"
+#include "geometry/Mesh3D.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class D>
+AdaptiveRefinement<D>::AdaptiveRefinement(SP_input    input,
+                                          SP_material material,
+                                          SP_mesh     mesh)
+  : d_input(input)
+  , d_material(material)
+  , d_mesh(mesh)
+  , d_max_levels(3)
+  , d_fraction(0.5)
+  , d_tolerance(0.0)
+  , d_max_cells(1000000)
+  , d_print_level(0)
+  , d_number_refinements(0)
+{
+  Require(d_input);
+  Require(d_material);
+  Require(d_mesh);
+  Require(d_mesh->dimension() == D::dimension);
+
+  if (d_input->check("amr_max_levels"))
+    d_max_levels = d_input->template get<int>("amr_max_levels");
+  if (d_input->check("amr_fraction"))
+    d_fraction = d_input->template get<double>("amr_fraction");
+  if (d_input->check("amr_tolerance"))
+    d_tolerance = d_input->template get<double>("amr_tolerance");
+  if (d_input->check("amr_max_cells"))
+    d_max_cells = d_input->template get<int>("amr_max_cells");
+  if (d_input->check("amr_print_level"))
+    d_print_level = d_input->template get<int>("amr_print_level");
+  Insist(d_fraction >= 0.0 && d_fraction <= 1.0,
+         "The AMR fraction must be in [0, 1].");
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+bool AdaptiveRefinement<D>::solve()
+{
+  SP_mesh  coarse_mesh;
+  SP_state coarse_state;
+  vec2_int parent;
+
+  // The refined solves start from the projected solution, which is set
+  // on a copy of the input so that the caller's database is untouched.
+  SP_input input = d_input;
+
+  for (size_t level = 0; ; ++level)
+  {
+    d_manager = new Manager_T(input, d_material, d_mesh);
+
+    // Project the previous solution as constant over each parent cell.
+    if (coarse_state)
+    {
+      SP_state state = d_manager->state();
+      for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
+      {
+        size_t i = parent[0][d_mesh->cell_to_i(cell)];
+        size_t j = D::dimension > 1 ? parent[1][d_mesh->cell_to_j(cell)] : 0;
+        size_t k = D::dimension > 2 ? parent[2][d_mesh->cell_to_k(cell)] : 0;
+        size_t coarse_cell = coarse_mesh->index(i, j, k);
+        for (size_t g = 0; g < d_material->number_groups(); ++g)
+          state->phi(g)[cell] = coarse_state->phi(g)[coarse_cell];
+      }
+      state->set_eigenvalue(coarse_state->eigenvalue());
+    }
+
+    if (!d_manager->solve()) return false;
+
+    // Estimate the error and mark the intervals to refine.
+    vec2_dbl eta = estimate(d_mesh, d_manager->state());
+    double eta_max = 0.0;
+    for (size_t d = 0; d < D::dimension; ++d)
+      eta_max = std::max(eta_max,
+                         *std::max_element(eta[d].begin(), eta[d].end()));
+    if (d_print_level > 0)
+    {
+      printf(" AMR level %2i: cells %8i  keff %12.9f  max indicator %10.3e \n",
+             level, d_mesh->number_cells(),
+             d_manager->state()->eigenvalue(), eta_max);
+    }
+    if (level == d_max_levels) break;
+
+    vec2_int marked(D::dimension);
+    size_t number_marked = 0;
+    size_t number_cells = 1;
+    for (size_t d = 0; d < D::dimension; ++d)
+    {
+      marked[d].assign(eta[d].size(), 0);
+      for (size_t i = 0; i < eta[d].size(); ++i)
+      {
+        if (eta[d][i] > d_tolerance && eta[d][i] >= d_fraction * eta_max)
+        {
+          marked[d][i] = 1;
+          ++number_marked;
+        }
+      }
+      number_cells *= eta[d].size() + std::count(marked[d].begin(),
+                                                 marked[d].end(), 1);
+    }
+    if (number_marked == 0 || number_cells > d_max_cells) break;
+
+    // Refine, and start the next solve from this one.
+    coarse_mesh  = d_mesh;
+    coarse_state = d_manager->state();
+    d_mesh = refine(coarse_mesh, marked, parent);
+    if (input == d_input)
+      input = new detran_utilities::InputDB(*d_input);
+    input->template put<int>("eigen_pi_initial_guess", 1);
+    ++d_number_refinements;
+  }
+
+  return true;
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+typename AdaptiveRefinement<D>::vec2_dbl
+AdaptiveRefinement<D>::estimate(SP_mesh mesh, SP_state state)
+{
+  Require(mesh);
+  Require(state);
+
+  vec2_dbl eta(D::dimension);
+  for (size_t d = 0; d < D::dimension; ++d)
+    eta[d].assign(mesh->number_cells(d), 0.0);
+
+  for (size_t g = 0; g < state->number_groups(); ++g)
+  {
+    const vec_dbl &phi = state->phi(g);
+    double phi_max = 0.0;
+    for (size_t cell = 0; cell < phi.size(); ++cell)
+      phi_max = std::max(phi_max, std::abs(phi[cell]));
+    if (phi_max == 0.0) continue;
+
+    for (size_t cell = 0; cell < mesh->number_cells(); ++cell)
+    {
+      size_t ijk[3] = {mesh->cell_to_i(cell),
+                       mesh->cell_to_j(cell),
+                       mesh->cell_to_k(cell)};
+      for (size_t d = 0; d < D::dimension; ++d)
+      {
+        size_t n = mesh->number_cells(d);
+        if (n < 2) continue;
+        size_t i  = ijk[d];
+
+        // Cell whose curvature is used, and its neighbors
+        size_t c = i;
+        if (n > 2 && i == 0)     c = 1;
+        if (n > 2 && i == n - 1) c = n - 2;
+        size_t lo = c > 0 ? c - 1 : c;
+        size_t hi = c < n - 1 ? c + 1 : c;
+        size_t ijk_n[3] = {ijk[0], ijk[1], ijk[2]};
+        ijk_n[d] = lo;
+        double phi_lo = phi[mesh->index(ijk_n[0], ijk_n[1], ijk_n[2])];
+        ijk_n[d] = c;
+        double phi_c  = phi[mesh->index(ijk_n[0], ijk_n[1], ijk_n[2])];
+        ijk_n[d] = hi;
+        double phi_hi = phi[mesh->index(ijk_n[0], ijk_n[1], ijk_n[2])];
+
+        double e = std::abs(phi_hi - phi_lo) / phi_max;
+        if (n > 2)
+        {
+          double d_lo = 0.5 * (mesh->width(d, lo) + mesh->width(d, c));
+          double d_hi = 0.5 * (mesh->width(d, c) + mesh->width(d, hi));
+          double curvature = 2.0 * ((phi_hi - phi_c) / d_hi -
+                                    (phi_c - phi_lo) / d_lo) / (d_lo + d_hi);
+          e = std::abs(curvature) * std::pow(mesh->width(d, i), 2) / phi_max;
+        }
+        eta[d][i] = std::max(eta[d][i], e);
+      }
+    }
+  }
+  return eta;
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+typename AdaptiveRefinement<D>::SP_mesh
+AdaptiveRefinement<D>::refine(SP_mesh         mesh,
+                              const vec2_int &marked,
+                              vec2_int       &parent)
+{
+  Require(mesh);
+  Require(marked.size() == D::dimension);
+
+  // New edges along each axis, with the parent of each interval
+  vec2_dbl edges(3, vec_dbl(1, 0.0));
+  parent.assign(3, vec_int(1, 0));
+  for (size_t d = 0; d < D::dimension; ++d)
+  {
+    Require(marked[d].size() == mesh->number_cells(d));
+    edges[d][0] = mesh->origin(d);
+    parent[d].resize(0);
+    for (size_t i = 0; i < mesh->number_cells(d); ++i)
+    {
+      int n = marked[d][i] ? 2 : 1;
+      double w = mesh->width(d, i) / n;
+      for (int m = 0; m < n; ++m)
+      {
+        edges[d].push_back(edges[d].back() + w);
+        parent[d].push_back(i);
+      }
+    }
+  }
+
+  // Mesh maps inherited from the parent cells
+  size_t nx = parent[0].size();
+  size_t ny = parent[1].size();
+  size_t nz = parent[2].size();
+  const detran_geometry::Mesh::mesh_map_type &maps = mesh->get_mesh_map();
+  detran_geometry::Mesh::mesh_map_type new_maps;
+  for (detran_geometry::Mesh::mesh_map_type::const_iterator it = maps.begin();
+       it != maps.end(); ++it)
+  {
+    vec_int &m = new_maps[it->first];
+    m.resize(nx * ny * nz);
+    for (size_t k = 0; k < nz; ++k)
+      for (size_t j = 0; j < ny; ++j)
+        for (size_t i = 0; i < nx; ++i)
+          m[i + j * nx + k * nx * ny] =
+            it->second[mesh->index(parent[0][i], parent[1][j], parent[2][k])];
+  }
+
+  SP_mesh fine;
+  const vec_int &mat_map = new_maps["MATERIAL"];
+  if (D::dimension == 1)
+    fine = new detran_geometry::Mesh1D(edges[0], mat_map);
+  else if (D::dimension == 2)
+    fine = new detran_geometry::Mesh2D(edges[0], edges[1], mat_map);
+  else
+    fine = new detran_geometry::Mesh3D(edges[0], edges[1], edges[2], mat_map);
+  for (detran_geometry::Mesh::mesh_map_type::const_iterator it =
+       new_maps.begin(); it != new_maps.end(); ++it)
+  {
+    fine->add_mesh_map(it->first, it->second);
+  }
+  return fine;
+}
+
+//---------------------------------------------------------------------------//
+// EXPLICIT INSTANTIATIONS
+//---------------------------------------------------------------------------//
+
+template class AdaptiveRefinement<_1D>;
+template class AdaptiveRefinement<_2D>;
+template class AdaptiveRefinement<_3D>;
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of AdaptiveRefinement.cc
+//---------------------------------------------------------------------------//
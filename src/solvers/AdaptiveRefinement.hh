@@ -0,0 +1,176 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   AdaptiveRefinement.hh
+ *  @brief  AdaptiveRefinement class definition
+ *  @author Jeremy Roberts
+ *  @date   Feb 27, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_ADAPTIVEREFINEMENT_HH_
+#define detran_ADAPTIVEREFINEMENT_HH_
+
+#include "solvers/solvers_export.hh"
+#include "solvers/EigenvalueManager.hh"
+
+namespace detran
+{
+
+/**
+ *  @class AdaptiveRefinement
+ *  @brief Solves an eigenvalue problem on adaptively refined Cartesian meshes
+ *
+ *  Starting from a coarse mesh, the problem is solved, the error of
+ *  each fine mesh interval is estimated from the flux, the intervals
+ *  with the largest errors are bisected, and the problem is solved
+ *  again, starting from the previous solution projected onto the new
+ *  mesh.  Because Cartesian meshes are tensor products, an interval is
+ *  refined across the whole mesh, but only the intervals where the
+ *  flux varies are refined.
+ *
+ *  The error of a cell along an axis is estimated from the curvature of
+ *  the flux, to which the truncation error of discretizations at most
+ *  linear within a cell is proportional:
+ *  @f[
+ *      e_i = \max_g \frac{| \phi''_{g,i} | \Delta_i^2}{\max \phi_g} \, ,
+ *  @f]
+ *  where the second derivative is the divided difference over cell
+ *  \f$ i \f$ and its neighbors.  A cell on the boundary uses the
+ *  curvature of its inner neighbor, and an axis with only two cells
+ *  uses the flux jump between them.  The indicator of an interval is
+ *  the largest of its cells.  An interval is bisected if its indicator
+ *  exceeds both a fraction of the largest indicator over all axes and
+ *  an absolute tolerance.  The previous flux is projected as constant
+ *  over the children of each cell, and all mesh maps are inherited
+ *  from the parent cells.
+ *
+ *  Only power iteration uses the projected eigenvalue and fission
+ *  density (see EigenPI); the other eigensolvers start over, but the
+ *  inner iterations still start from the projected flux.
+ *
+ *  Relevant database parameters:
+ *    - amr_max_levels      -- maximum number of refinements (default 3)
+ *    - amr_fraction        -- fraction of the largest indicator above
+ *                             which intervals are refined (default 0.5)
+ *    - amr_tolerance       -- indicator below which intervals are never
+ *                             refined (default 0.0)
+ *    - amr_max_cells       -- refinement stops before exceeding this
+ *                             number of cells (default 1000000)
+ *    - amr_print_level     -- print each level if positive (default 0)
+ *
+ *  Note, eigen_pi_initial_guess is set in the input after the first
+ *  solve.
+ */
+template <class D>
+class AdaptiveRefinement
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<AdaptiveRefinement>      SP_refinement;
+  typedef EigenvalueManager<D>                          Manager_T;
+  typedef detran_utilities::SP<Manager_T>               SP_manager;
+  typedef detran_utilities::InputDB::SP_input           SP_input;
+  typedef detran_material::Material::SP_material        SP_material;
+  typedef detran_geometry::Mesh::SP_mesh                SP_mesh;
+  typedef State::SP_state                               SP_state;
+  typedef detran_utilities::vec_int                     vec_int;
+  typedef detran_utilities::vec2_int                    vec2_int;
+  typedef detran_utilities::vec_dbl                     vec_dbl;
+  typedef detran_utilities::vec2_dbl                    vec2_dbl;
+  typedef detran_utilities::size_t                      size_t;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param input      Input database
+   *  @param material   Material database
+   *  @param mesh       Initial Cartesian mesh
+   */
+  AdaptiveRefinement(SP_input    input,
+                     SP_material material,
+                     SP_mesh     mesh);
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /// Solve on successively refined meshes.
+  bool solve();
+
+  /**
+   *  @brief Estimate the error of each fine mesh interval.
+   *  @param mesh   Cartesian mesh
+   *  @param state  Converged state on the mesh
+   *  @return       Indicators [dimension][interval]
+   */
+  static vec2_dbl estimate(SP_mesh mesh, SP_state state);
+
+  /// Final mesh
+  SP_mesh mesh() const { return d_mesh; }
+
+  /// Manager of the final solve
+  SP_manager manager() const { return d_manager; }
+
+  /// Final state
+  SP_state state() const { return d_manager->state(); }
+
+  /// Number of refinements performed
+  size_t number_refinements() const { return d_number_refinements; }
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Input database
+  SP_input d_input;
+  /// Material database
+  SP_material d_material;
+  /// Current mesh
+  SP_mesh d_mesh;
+  /// Manager of the current mesh
+  SP_manager d_manager;
+  /// Maximum number of refinements
+  size_t d_max_levels;
+  /// Fraction of the largest indicator above which intervals are refined
+  double d_fraction;
+  /// Indicator below which intervals are not refined
+  double d_tolerance;
+  /// Maximum number of cells
+  size_t d_max_cells;
+  /// Print level
+  int d_print_level;
+  /// Number of refinements performed
+  size_t d_number_refinements;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Bisect marked intervals of the mesh.
+   *  @param mesh     Cartesian mesh
+   *  @param marked   Whether to bisect each interval [dimension][interval]
+   *  @param parent   Parent of each new interval [dimension][interval]
+   *  @return         Refined mesh
+   */
+  static SP_mesh refine(SP_mesh mesh, const vec2_int &marked, vec2_int &parent);
+
+};
+
+} // end namespace detran
+
+#endif /* detran_ADAPTIVEREFINEMENT_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of AdaptiveRefinement.hh
+//---------------------------------------------------------------------------//
@@ -84,6 +84,8 @@ public:
   SP_boundary boundary() const { return d_mg_solver->boundary(); }
   SP_quadrature quadrature() const { return d_mg_solver->quadrature(); }
   SP_fissionsource fissionsource() const { return d_mg_solver->fissionsource(); }
+  SP_mg_solver mg_solver() const { return d_mg_solver; }
+  SP_solver solver() const { return d_solver; }
   /// @}
 
 private:
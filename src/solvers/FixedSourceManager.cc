@@ -13,6 +13,7 @@
 #include "boundary/BoundaryMOC.hh"
 #include "boundary/BoundarySN.hh"
 #include "boundary/BoundaryFactory.t.hh"
+#include "geometry/MeshUnstructured.hh"
 #include "geometry/Tracker.hh"
 // Multigroup solvers
 #include "MGSolverGS.hh"
@@ -89,11 +90,43 @@ void FixedSourceManager<D>::setup()
   d_discretization = SN;
   if (d_input->check("equation"))
     eq = d_input->get<std::string>("equation");
-  if (eq == "scmoc" || eq == "ddmoc")
+  if (eq == "scmoc" || eq == "ddmoc" || eq == "lsmoc")
     d_discretization = MOC;
   else if (eq == "diffusion")
     d_discretization = DIFF;
 
+  // Pin cell regions and polygons are exposed as a row of cells, which
+  // only the MOC and unstructured sweepers, respectively, understand.
+  if (dynamic_cast<detran_geometry::MeshCSG*>(d_mesh.bp()))
+  {
+    Insist(d_discretization == MOC,
+           "A MeshCSG requires an MOC equation, not " + eq + ".");
+  }
+  bool unstructured =
+    dynamic_cast<detran_geometry::MeshUnstructured*>(d_mesh.bp());
+  Insist(unstructured == (eq == "usd"),
+         "Equation usd requires, and is the only one to support, "
+         "a MeshUnstructured.");
+
+  // Linear source MOC lags the source moments and the unstructured
+  // sweeper lags face fluxes from one sweep to the next.  Hence, only
+  // source iteration within groups, Gauss-Seidel over groups, and power
+  // iteration are supported.
+  if (eq == "lsmoc" || eq == "usd")
+  {
+    Insist(D::dimension == 2 || eq == "usd",
+           "Equation " + eq + " is implemented in 2D.");
+    Insist(!d_input->check("inner_solver") ||
+           d_input->get<std::string>("inner_solver") == "SI",
+           "Equation " + eq + " requires the SI inner solver.");
+    Insist(!d_input->check("outer_solver") ||
+           d_input->get<std::string>("outer_solver") == "GS",
+           "Equation " + eq + " requires the GS outer solver.");
+    Insist(!d_input->check("eigen_solver") ||
+           d_input->get<std::string>("eigen_solver") == "PI",
+           "Equation " + eq + " requires the PI eigensolver.");
+  }
+
   //-------------------------------------------------------------------------//
   // QUADRATURE
   //-------------------------------------------------------------------------//
@@ -107,9 +140,11 @@ void FixedSourceManager<D>::setup()
     if (d_discretization == MOC)
     {
       // Track the mesh
-      detran_geometry::Tracker tracker(d_mesh, d_quadrature);
+      detran_geometry::Tracker tracker(d_mesh, d_quadrature, d_input);
       // Normalize segments to conserve volume.
       tracker.normalize();
+      // Linear sources need the region centroids and moments.
+      if (eq == "lsmoc") tracker.trackdb()->compute_centroids();
       // Replace the mesh with the tracked one.  This suggests refactoring
       // to have a (possibly null) trackdb in Mesh.
       d_mesh = tracker.meshmoc();
@@ -0,0 +1,82 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   InexactControl.cc
+ *  @brief  InexactControl member definitions
+ *  @author Jeremy Roberts
+ *  @date   Jan 24, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#include "InexactControl.hh"
+#include "utilities/DBC.hh"
+#include <algorithm>
+#include <cmath>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+InexactControl::InexactControl(SP_input input, std::string prefix)
+  : d_type(NONE)
+  , d_gamma(0.1)
+  , d_alpha(0.5 * (1.0 + std::sqrt(5.0)))
+  , d_eta(0.0)
+  , d_residual(0.0)
+{
+  Require(input);
+
+  std::string type = "none";
+  if (input->check(prefix + "_adaptive"))
+    type = input->get<std::string>(prefix + "_adaptive");
+  if (type == "fixed")
+    d_type = FIXED;
+  else if (type == "ew")
+    d_type = EISENSTAT_WALKER;
+  else
+    Insist(type == "none", "Unknown adaptive tolerance type: " + type);
+
+  if (input->check(prefix + "_adaptive_factor"))
+    d_gamma = input->get<double>(prefix + "_adaptive_factor");
+  if (input->check(prefix + "_adaptive_alpha"))
+    d_alpha = input->get<double>(prefix + "_adaptive_alpha");
+  Insist(d_gamma > 0.0 && d_gamma < 1.0,
+         "The adaptive tolerance factor must be in (0, 1).");
+  Insist(d_alpha > 1.0 && d_alpha <= 2.0,
+         "The Eisenstat-Walker exponent must be in (1, 2].");
+  d_eta = d_gamma;
+}
+
+//---------------------------------------------------------------------------//
+double InexactControl::update(const double residual)
+{
+  Require(residual >= 0.0);
+
+  if (d_type == EISENSTAT_WALKER && d_residual > 0.0)
+  {
+    double eta = d_gamma * std::pow(residual / d_residual, d_alpha);
+    // Safeguard against a sudden decrease that oversolves
+    double eta_safe = d_gamma * std::pow(d_eta, d_alpha);
+    if (eta_safe > 0.1) eta = std::max(eta, eta_safe);
+    d_eta = std::min(eta, d_gamma);
+  }
+  else
+  {
+    d_eta = d_gamma;
+  }
+  d_residual = residual;
+
+  return forcing();
+}
+
+//---------------------------------------------------------------------------//
+void InexactControl::reset()
+{
+  d_eta      = d_gamma;
+  d_residual = 0.0;
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of file InexactControl.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,124 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   InexactControl.hh
+ *  @brief  InexactControl class definition
+ *  @author Jeremy Roberts
+ *  @date   Jan 24, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_INEXACTCONTROL_HH_
+#define detran_INEXACTCONTROL_HH_
+
+#include "utilities/Definitions.hh"
+#include "utilities/InputDB.hh"
+#include "utilities/SP.hh"
+#include <string>
+
+namespace detran
+{
+
+/**
+ *  @class InexactControl
+ *  @brief Sets the relative tolerance of inner solves from an outer residual
+ *
+ *  Nested iterations need not solve the inner problem more accurately
+ *  than the current outer iterate warrants.  Each inner solve is
+ *  asked only to reduce its own residual by a forcing term
+ *  \f$ \eta_k \f$ relative to its first residual (see
+ *  Solver::set_relative_tolerance), unless it meets its fixed
+ *  tolerance first.  A relative criterion is used because the inner
+ *  solvers measure convergence by successive differences, which, for
+ *  a warm started inner solve, can be small long before the inner
+ *  error is.  Because each inner solve still reduces its error, the
+ *  outer fixed point, and hence the final accuracy, is unchanged.
+ *
+ *  Given the outer residual \f$ r_k \f$, the forcing term is either
+ *  fixed, \f$ \eta_k = \gamma \f$, or the second choice of
+ *  Eisenstat and Walker,
+ *  @f[
+ *      \eta_k = \gamma (r_k / r_{k-1})^{\alpha} \, ,
+ *  @f]
+ *  safeguarded by \f$ \eta_k \ge \gamma \eta_{k-1}^\alpha \f$
+ *  whenever the latter exceeds 0.1, and capped at \f$ \gamma \f$.
+ *
+ *  Relevant database parameters, where "prefix" identifies the outer
+ *  solver (e.g. "eigen" or "outer"):
+ *    - prefix_adaptive         -- none (default), fixed, or ew
+ *    - prefix_adaptive_factor  -- \f$ \gamma \f$ (default 0.1)
+ *    - prefix_adaptive_alpha   -- \f$ \alpha \f$ (default 1.618)
+ */
+class InexactControl
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<InexactControl>      SP_control;
+  typedef detran_utilities::InputDB::SP_input       SP_input;
+
+  enum forcing_types
+  {
+    NONE, FIXED, EISENSTAT_WALKER, END_FORCING_TYPES
+  };
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param input      Input database
+   *  @param prefix     Key prefix of the outer solver
+   */
+  InexactControl(SP_input input, std::string prefix);
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /// Are inner solves inexact?
+  bool active() const { return d_type != NONE; }
+
+  /**
+   *  @brief Compute the next forcing term
+   *  @param residual   Current outer residual
+   *  @return           Relative tolerance for the next inner solves
+   */
+  double update(const double residual);
+
+  /// Current forcing term (zero when inactive)
+  double forcing() const { return active() ? d_eta : 0.0; }
+
+  /// Forget the residual history, e.g. before a new outer solve
+  void reset();
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Forcing term type
+  int d_type;
+  /// Forcing factor
+  double d_gamma;
+  /// Eisenstat-Walker exponent
+  double d_alpha;
+  /// Current forcing term
+  double d_eta;
+  /// Last outer residual
+  double d_residual;
+
+};
+
+} // end namespace detran
+
+#endif // detran_INEXACTCONTROL_HH_
+
+//---------------------------------------------------------------------------//
+//              end of file InexactControl.hh
+//---------------------------------------------------------------------------//
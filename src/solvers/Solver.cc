@@ -27,6 +27,7 @@ Solver<D>::Solver(SP_state                  state,
   , d_number_groups(0)
   , d_maximum_iterations(100)
   , d_tolerance(1e-5)
+  , d_relative_tolerance(0.0)
   , d_print_level(2)
   , d_print_interval(10)
   , d_adjoint(false)
@@ -84,6 +84,23 @@ public:
     d_tolerance = tol;
   }
 
+  /// Fixed convergence tolerance
+  double tolerance() const {return d_tolerance;}
+
+  /**
+   *  @brief Reset the relative tolerance.
+   *
+   *  When positive, an iteration also stops once its residual falls
+   *  below this fraction of its first residual, which lets an outer
+   *  iteration solve inner problems inexactly.  Zero (the default)
+   *  leaves only the fixed tolerance.
+   */
+  virtual void set_relative_tolerance(double tol)
+  {
+    Require(tol >= 0.0 && tol < 1.0);
+    d_relative_tolerance = tol;
+  }
+
   /// Reset the maximum iterations.
   void set_max_iters(int max_iters)
   {
@@ -128,6 +145,8 @@ protected:
   size_t d_maximum_iterations;
   /// Convergence tolerance
   double d_tolerance;
+  /// Relative convergence tolerance
+  double d_relative_tolerance;
   /// Print out flag
   int d_print_level;
   /// Interval for print out
@@ -143,6 +162,7 @@ protected:
   Solver()
     : d_maximum_iterations(100)
     , d_tolerance(1e-5)
+    , d_relative_tolerance(0.0)
     , d_print_level(2)
     , d_print_interval(10)
     , d_adjoint(false)
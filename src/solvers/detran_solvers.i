@@ -11,7 +11,11 @@
 #include <stddef.h>
 #include "FixedSourceManager.hh"
 #include "EigenvalueManager.hh"
+#include "AdaptiveRefinement.hh"
 #include "time/TimeStepper.hh"
+#include "time/ThermalFeedback.hh"
+#include "time/Parareal.hh"
+#include "time/PointKinetics.hh"
 #include "Manager.hh"
 #include "time/LRA.hh"
 //
@@ -71,11 +75,28 @@ setCallbackMethod(4,
 %template(Eigen2D) detran::EigenvalueManager<detran::_2D>;
 %template(Eigen3D) detran::EigenvalueManager<detran::_3D>;
 
+%include "AdaptiveRefinement.hh"
+%template(AdaptiveRefinement1D) detran::AdaptiveRefinement<detran::_1D>;
+%template(AdaptiveRefinement2D) detran::AdaptiveRefinement<detran::_2D>;
+%template(AdaptiveRefinement3D) detran::AdaptiveRefinement<detran::_3D>;
+
 %include "time/TimeStepper.hh"
 %template(Time1D) detran::TimeStepper<detran::_1D>;
 %template(Time2D) detran::TimeStepper<detran::_2D>;
 %template(Time3D) detran::TimeStepper<detran::_3D>;
 
+%include "time/ThermalFeedback.hh"
+%template(ThermalFeedback1D) detran::ThermalFeedback<detran::_1D>;
+%template(ThermalFeedback2D) detran::ThermalFeedback<detran::_2D>;
+%template(ThermalFeedback3D) detran::ThermalFeedback<detran::_3D>;
+
+%include "time/Parareal.hh"
+%template(Parareal1D) detran::Parareal<detran::_1D>;
+%template(Parareal2D) detran::Parareal<detran::_2D>;
+%template(Parareal3D) detran::Parareal<detran::_3D>;
+
+%include "time/PointKinetics.hh"
+
 %include "time/LRA.hh"
 %template(SPLRA) detran_utilities::SP<detran_user::LRA>;
 
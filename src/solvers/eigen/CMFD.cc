@@ -0,0 +1,292 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   CMFD.cc
+ *  @brief  CMFD member definitions
+ *  @author Jeremy Roberts
+ *  @date   Jan 14, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#include "CMFD.hh"
+#include "solvers/mg/MGTransportSolver.hh"
+#include "transport/Homogenize.hh"
+#include "callow/solver/EigenSolverCreator.hh"
+#include <cmath>
+#include <string>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class D>
+CMFD<D>::CMFD(SP_mg_solver mg_solver)
+{
+  // Preconditions
+  Require(mg_solver);
+
+  d_input    = mg_solver->input();
+  d_state    = mg_solver->state();
+  d_mesh     = mg_solver->mesh();
+  d_material = mg_solver->material();
+  d_number_groups = d_material->number_groups();
+
+  Insist(mg_solver->discretization() == Fixed_T::MOC,
+         "CMFD requires MOC, the only sweeper that tallies partial currents.");
+
+  // Only source iteration sweeps the physical flux, so tallies from any
+  // Krylov inner solver would not be partial currents.
+  Insist(!d_input->check("inner_solver") ||
+         d_input->template get<std::string>("inner_solver") == "SI",
+         "CMFD requires the SI inner solver.");
+
+  // Get the transport solver that owns the sweeper
+  MGTransportSolver<D>* mg_transport =
+    dynamic_cast<MGTransportSolver<D>*>(mg_solver->solver().bp());
+  Insist(mg_transport, "CMFD requires a multigroup transport solver");
+
+  // Coarse mesh, by default the fine mesh cells themselves
+  size_t level = 1;
+  if (d_input->check("eigen_pi_cmfd_level"))
+    level = d_input->template get<int>("eigen_pi_cmfd_level");
+  Insist(level > 0, "The CMFD coarse mesh level must be positive.");
+  Insist(d_mesh->is_cartesian(), "CMFD requires a Cartesian mesh.");
+  d_coarsemesh = new CoarseMesh(d_mesh, level);
+  d_fine_to_coarse = d_mesh->mesh_map("COARSEMESH");
+
+  // Current tally, filled on each sweep
+  d_tally = new Tally_T(d_coarsemesh, mg_solver->quadrature(), d_number_groups);
+  mg_transport->wg_solver()->get_sweeper()->set_tally(d_tally);
+
+  // Coarse eigensolver parameters
+  if (d_input->check("eigen_pi_cmfd_db"))
+  {
+    d_db = d_input->template get<SP_input>("eigen_pi_cmfd_db");
+  }
+  else
+  {
+    d_db = new detran_utilities::InputDB("eigen_pi_cmfd_db");
+    d_db->put<std::string>("eigen_solver_type",       "power");
+    d_db->put<double>("eigen_solver_tol",             1e-10);
+    d_db->put<int>("eigen_solver_maxit",              10000);
+    d_db->put<int>("eigen_solver_monitor_level",      0);
+    d_db->put<std::string>("linear_solver_type",      "gmres");
+    d_db->put<double>("linear_solver_atol",           1e-13);
+    d_db->put<double>("linear_solver_rtol",           1e-13);
+    d_db->put<int>("linear_solver_maxit",             1000);
+    d_db->put<int>("linear_solver_monitor_level",     0);
+  }
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+double CMFD<D>::update()
+{
+  SP_mesh cmesh = d_coarsemesh->get_coarse_mesh();
+  size_t nc = cmesh->number_cells();
+  size_t ng = d_number_groups;
+  size_t n  = nc * ng;
+
+  //-------------------------------------------------------------------------//
+  // COARSE MESH FLUX AND CROSS SECTIONS
+  //-------------------------------------------------------------------------//
+
+  Homogenize H(d_material);
+  SP_material cmat = H.homogenize(d_state, d_mesh, "COARSEMESH",
+                                  Homogenize::PHI_SIGMA_TR);
+
+  const vec_int &mat_map = d_mesh->mesh_map("MATERIAL");
+  vec2_dbl phi(ng, vec_dbl(nc, 0.0));
+  vec2_dbl chi(nc, vec_dbl(ng, 0.0));
+  vec_dbl  fission_rate(nc, 0.0);
+  for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+  {
+    size_t c = d_fine_to_coarse[i];
+    size_t m = mat_map[i];
+    double f = 0.0;
+    for (size_t g = 0; g < ng; ++g)
+    {
+      phi[g][c] += d_state->phi(g)[i] * d_mesh->volume(i);
+      f += d_material->nu_sigma_f(m, g) * d_state->phi(g)[i];
+    }
+    f *= d_mesh->volume(i);
+    for (size_t g = 0; g < ng; ++g)
+      chi[c][g] += d_material->chi(m, g) * f;
+    fission_rate[c] += f;
+  }
+  for (size_t c = 0; c < nc; ++c)
+  {
+    for (size_t g = 0; g < ng; ++g)
+    {
+      phi[g][c] /= cmesh->volume(c);
+      Assert(phi[g][c] > 0.0);
+      if (fission_rate[c] > 0.0) chi[c][g] /= fission_rate[c];
+    }
+  }
+
+  //-------------------------------------------------------------------------//
+  // LOSS AND GAIN OPERATORS
+  //-------------------------------------------------------------------------//
+
+  SP_matrix M(new callow::Matrix(n, n, 1 + 2 * D::dimension + ng));
+  SP_matrix F(new callow::Matrix(n, n, ng));
+
+  for (size_t g = 0; g < ng; ++g)
+  {
+    for (size_t c = 0; c < nc; ++c)
+    {
+      int row = c + g * nc;
+      double volume = cmesh->volume(c);
+      size_t ijk[] = {cmesh->cell_to_i(c),
+                      cmesh->cell_to_j(c),
+                      cmesh->cell_to_k(c)};
+
+      // Removal
+      double diag = (cmat->sigma_t(c, g) - cmat->sigma_s(c, g, g)) * volume;
+
+      // Leakage
+      for (size_t axis = 0; axis < D::dimension; ++axis)
+      {
+        double area = 1.0;
+        for (size_t d = 0; d < D::dimension; ++d)
+          if (d != axis) area *= cmesh->width(d, ijk[d]);
+
+        for (size_t side = 0; side < 2; ++side)
+        {
+          // Net positive-directed current through the face.
+          size_t e[] = {ijk[0], ijk[1], ijk[2]};
+          e[axis] += side;
+          double J = d_tally->partial_current(e[0], e[1], e[2], g, axis, 1) -
+                     d_tally->partial_current(e[0], e[1], e[2], g, axis, 0);
+
+          int nb = neighbor(c, axis, side);
+          if (nb < 0)
+          {
+            // Boundary: the outgoing net current defines the coefficient.
+            double J_out = side ? J : -J;
+            diag += J_out / phi[g][c];
+            continue;
+          }
+
+          // Left and right cells with respect to the face.
+          size_t l = side ? c : nb;
+          size_t r = side ? nb : c;
+          double h_l = cmesh->width(axis, side ? ijk[axis] : ijk[axis] - 1);
+          double h_r = cmesh->width(axis, side ? ijk[axis] + 1 : ijk[axis]);
+          double D_l = cmat->diff_coef(l, g);
+          double D_r = cmat->diff_coef(r, g);
+          double dtilde = area * 2.0 * D_l * D_r / (D_l * h_r + D_r * h_l);
+          double dhat   = -(J + dtilde * (phi[g][r] - phi[g][l])) /
+                           (phi[g][r] + phi[g][l]);
+
+          double val = 0.0;
+          if (side)
+          {
+            diag += dtilde - dhat;
+            val   = -dtilde - dhat;
+          }
+          else
+          {
+            diag += dtilde + dhat;
+            val   = -dtilde + dhat;
+          }
+          bool flag = M->insert(row, nb + g * nc, val);
+          Insist(flag, "CMFD coupling insertion failed.");
+        }
+      }
+      bool flag = M->insert(row, row, diag);
+      Insist(flag, "CMFD diagonal insertion failed.");
+
+      // Inscatter and fission
+      for (size_t gp = 0; gp < ng; ++gp)
+      {
+        int col = c + gp * nc;
+        if (gp != g)
+        {
+          flag = M->insert(row, col, -cmat->sigma_s(c, g, gp) * volume);
+          Insist(flag, "CMFD scattering insertion failed.");
+        }
+        flag = F->insert(row, col,
+                         chi[c][g] * cmat->nu_sigma_f(c, gp) * volume);
+        Insist(flag, "CMFD fission insertion failed.");
+      }
+    }
+  }
+  M->assemble();
+  F->assemble();
+
+  //-------------------------------------------------------------------------//
+  // SOLVE THE COARSE MESH EIGENPROBLEM
+  //-------------------------------------------------------------------------//
+
+  callow::Vector x(n, 0.0);
+  callow::Vector x0(n, 0.0);
+  for (size_t g = 0; g < ng; ++g)
+    for (size_t c = 0; c < nc; ++c)
+      x0[c + g * nc] = phi[g][c];
+
+  callow::EigenSolver::SP_solver
+    eigensolver = callow::EigenSolverCreator::Create(d_db);
+  eigensolver->set_operators(F, M, d_db);
+  eigensolver->solve(x, x0);
+  double keff_cmfd = eigensolver->eigenvalue();
+
+  //-------------------------------------------------------------------------//
+  // PROLONG: RESCALE THE FINE MESH FLUX
+  //-------------------------------------------------------------------------//
+
+  // Preserve the total fission production of the transport iterate.
+  double production_old = 0.0;
+  double production_new = 0.0;
+  for (size_t g = 0; g < ng; ++g)
+  {
+    for (size_t c = 0; c < nc; ++c)
+    {
+      double nsf_v = cmat->nu_sigma_f(c, g) * cmesh->volume(c);
+      production_old += nsf_v * phi[g][c];
+      production_new += nsf_v * x[c + g * nc];
+    }
+  }
+  Assert(production_new != 0.0);
+  double scale = production_old / production_new;
+
+  for (size_t g = 0; g < ng; ++g)
+  {
+    for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+    {
+      size_t c = d_fine_to_coarse[i];
+      d_state->phi(g)[i] *= scale * x[c + g * nc] / phi[g][c];
+    }
+  }
+
+  return keff_cmfd;
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+int CMFD<D>::neighbor(const size_t c,
+                      const size_t axis,
+                      const size_t side) const
+{
+  SP_mesh cmesh = d_coarsemesh->get_coarse_mesh();
+  int ijk[] = {(int) cmesh->cell_to_i(c),
+               (int) cmesh->cell_to_j(c),
+               (int) cmesh->cell_to_k(c)};
+  ijk[axis] += side ? 1 : -1;
+  if (ijk[axis] < 0 || ijk[axis] >= (int)cmesh->number_cells(axis))
+    return -1;
+  return cmesh->index(ijk[0], ijk[1], ijk[2]);
+}
+
+//---------------------------------------------------------------------------//
+// EXPLICIT INSTANTIATIONS
+//---------------------------------------------------------------------------//
+
+template class CMFD<_1D>;
+template class CMFD<_2D>;
+template class CMFD<_3D>;
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of file CMFD.cc
+//---------------------------------------------------------------------------//
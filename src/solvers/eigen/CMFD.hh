@@ -0,0 +1,169 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   CMFD.hh
+ *  @brief  CMFD class definition
+ *  @author Jeremy Roberts
+ *  @date   Jan 14, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_CMFD_HH_
+#define detran_CMFD_HH_
+
+#include "solvers/FixedSourceManager.hh"
+#include "transport/CoarseMesh.hh"
+#include "transport/CurrentTally.hh"
+#include "callow/matrix/Matrix.hh"
+#include "callow/vector/Vector.hh"
+
+namespace detran
+{
+
+/**
+ *  @class CMFD
+ *  @brief Coarse mesh finite difference acceleration of power iteration
+ *
+ *  After each transport (multigroup) solve, the partial currents
+ *  tallied by the sweeper on coarse mesh edges are used to build a
+ *  coarse mesh diffusion operator that preserves the transport
+ *  net currents.  For a face between coarse cells \f$ l \f$ and
+ *  \f$ r \f$ (with \f$ r \f$ on the positive side), the net current
+ *  is written
+ *  @f[
+ *      J_{lr} = -\tilde{D}_{lr} (\phi_r - \phi_l)
+ *               -\hat{D}_{lr} (\phi_r + \phi_l) \, ,
+ *  @f]
+ *  where \f$ \tilde{D} \f$ is the usual finite difference coupling
+ *  coefficient and \f$ \hat{D} \f$ is the nonlinear correction that
+ *  forces agreement with the transport current.  On the boundary,
+ *  \f$ J_{out} = \hat{D} \phi \f$.  The resulting generalized
+ *  eigenproblem is solved with a callow eigensolver, and the fine
+ *  mesh flux is rescaled cell-wise by the ratio of the new and old
+ *  coarse mesh fluxes.
+ *
+ *  The coarse mesh cross sections are flux-weighted via Homogenize
+ *  using the latest transport flux, except the fission spectrum, which
+ *  is weighted by the fission rate so that the coarse balance is
+ *  exact when the transport iterate is converged.
+ *
+ *  Currently, only the 2D MOC sweeper tallies partial currents,
+ *  so only that discretization is supported, and only with source
+ *  iteration for the within-group equations.
+ *
+ *  The acceleration degrades as the coarse cells become optically
+ *  thick, since \f$ \hat{D} \f$ must then absorb most of the leakage
+ *  and the low order operator no longer captures the slowly decaying
+ *  error modes.  For a two group quarter core of 40 cm of fuel and
+ *  10 cm of water, power iteration takes 44 iterations; with CMFD, it
+ *  takes 6, 10, and 20 on 2, 4, and 10 cm coarse cells (about 2, 4,
+ *  and 10 thermal mean free paths).  On 8 cm cells, CMFD can even be
+ *  slower than unaccelerated iteration.  Because the MOC mesh cells
+ *  are typically pin cells already, the default coarse mesh is the
+ *  fine mesh; coarsen only when the fine cells are well below a mean
+ *  free path thick.
+ *
+ *  Relevant database parameters:
+ *    - eigen_pi_cmfd_level     -- fine cells per coarse cell (default 1)
+ *    - eigen_pi_cmfd_db        -- optional callow eigensolver database
+ */
+template <class D>
+class CMFD
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<CMFD>                SP_cmfd;
+  typedef FixedSourceManager<D>                     Fixed_T;
+  typedef typename Fixed_T::SP_manager              SP_mg_solver;
+  typedef detran_utilities::InputDB::SP_input       SP_input;
+  typedef State::SP_state                           SP_state;
+  typedef detran_geometry::Mesh::SP_mesh            SP_mesh;
+  typedef detran_material::Material::SP_material    SP_material;
+  typedef CoarseMesh::SP_coarsemesh                 SP_coarsemesh;
+  typedef CurrentTally<D>                           Tally_T;
+  typedef detran_utilities::SP<Tally_T>             SP_tally;
+  typedef callow::Matrix::SP_matrix                 SP_matrix;
+  typedef detran_utilities::vec_int                 vec_int;
+  typedef detran_utilities::vec_dbl                 vec_dbl;
+  typedef detran_utilities::vec2_dbl                vec2_dbl;
+  typedef detran_utilities::size_t                  size_t;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *
+   *  This builds the coarse mesh and attaches a current tally to the
+   *  transport sweeper.
+   *
+   *  @param mg_solver    Multigroup fixed source manager
+   */
+  CMFD(SP_mg_solver mg_solver);
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Update the fine mesh flux and eigenvalue
+   *
+   *  This should follow a multigroup solve so that the tallied
+   *  currents are consistent with the state flux.
+   *
+   *  @return       Updated eigenvalue
+   */
+  double update();
+
+  /// Get the coarse mesh
+  SP_coarsemesh coarsemesh() const { return d_coarsemesh; }
+
+  /// Get the current tally
+  SP_tally tally() const { return d_tally; }
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Input
+  SP_input d_input;
+  /// State
+  SP_state d_state;
+  /// Fine mesh
+  SP_mesh d_mesh;
+  /// Fine mesh material
+  SP_material d_material;
+  /// Coarse mesh
+  SP_coarsemesh d_coarsemesh;
+  /// Fine-to-coarse cell map
+  vec_int d_fine_to_coarse;
+  /// Partial current tally
+  SP_tally d_tally;
+  /// Optional database for the coarse eigensolver
+  SP_input d_db;
+  /// Number of groups
+  size_t d_number_groups;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Coarse cell index of the neighbor across a face, or -1 on the boundary
+  int neighbor(const size_t c, const size_t axis, const size_t side) const;
+
+};
+
+} // end namespace detran
+
+#endif // detran_CMFD_HH_
+
+//---------------------------------------------------------------------------//
+//              end of file CMFD.hh
+//---------------------------------------------------------------------------//
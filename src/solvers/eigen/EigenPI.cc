@@ -19,6 +19,7 @@ EigenPI<D>::EigenPI(SP_mg_solver mg_solver)
   : Base(mg_solver)
   , d_aitken(false)
   , d_omega(1.0)
+  , d_initial_guess(false)
 {
 
   if (d_input->check("eigen_pi_aitken"))
@@ -27,6 +28,19 @@ EigenPI<D>::EigenPI(SP_mg_solver mg_solver)
   if (d_input->check("eigen_pi_omega"))
     d_omega = d_input->template get<double>("eigen_pi_omega");
 
+  if (d_input->check("eigen_pi_initial_guess"))
+    d_initial_guess = d_input->template get<int>("eigen_pi_initial_guess");
+
+  if (d_input->check("eigen_pi_cmfd") &&
+      d_input->template get<int>("eigen_pi_cmfd"))
+  {
+    Insist(d_omega == 1.0,
+           "EigenPI with CMFD does not support eigen_pi_omega.");
+    d_cmfd = new CMFD<D>(mg_solver);
+  }
+
+  d_control = new InexactControl(d_input, "eigen");
+
 }
 
 //---------------------------------------------------------------------------//
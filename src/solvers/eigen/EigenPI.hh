@@ -11,6 +11,8 @@
 #define detran_EIGENPI_HH_
 
 #include "Eigensolver.hh"
+#include "CMFD.hh"
+#include "solvers/InexactControl.hh"
 
 namespace detran
 {
@@ -44,7 +46,28 @@ namespace detran
  *  with \f$ || d^{0} || = 1 \f$.
  *
  *  Note, this is a hand-coded power iteration implementation that
- *  can be used with nonlinear acceleration.
+ *  can be used with nonlinear acceleration.  Currently, coarse mesh
+ *  finite difference (see \ref CMFD) is available for MOC, in which
+ *  case the eigenvalue and flux are updated after each multigroup
+ *  solve via the coarse mesh problem.
+ *
+ *  Relevant database parameters:
+ *    - eigen_pi_aitken         -- display Aitken extrapolation (default 0)
+ *    - eigen_pi_omega          -- over-relaxation parameter (default 1)
+ *    - eigen_pi_cmfd           -- use CMFD acceleration (default 0);
+ *                                 not with eigen_pi_omega
+ *    - eigen_pi_initial_guess  -- start from the flux and eigenvalue of
+ *                                 the state, if it has any (default 0)
+ *    - eigen_adaptive          -- solve the multigroup equations
+ *                                 inexactly based on the fission
+ *                                 density error (see \ref InexactControl;
+ *                                 default none)
+ *
+ *  With eigen_adaptive, each printed iteration also gives its sweeps
+ *  and forcing term, and the final summary gives the sweeps per
+ *  iteration and the smallest forcing term next to the fixed
+ *  multigroup tolerance.  The sweeps saved are found by comparing the
+ *  total against a run with eigen_adaptive off.
  *
  */
 //---------------------------------------------------------------------------//
@@ -68,6 +91,7 @@ public:
   typedef typename Base::SP_material                SP_material;
   typedef typename Base::SP_boundary                SP_boundary;
   typedef typename Base::SP_fissionsource           SP_fissionsource;
+  typedef typename CMFD<D>::SP_cmfd                 SP_cmfd;
 
   //-------------------------------------------------------------------------//
   // CONSTRUCTOR & DESTRUCTOR
@@ -105,6 +129,7 @@ protected:
   using Base::d_print_interval;
   using Base::d_adjoint;
   using Base::d_mg_solver;
+  using Base::d_number_iterations;
 
   /// Display Aitken extrapolation
   bool d_aitken;
@@ -112,6 +137,15 @@ protected:
   /// Over-relaxation parameter
   double d_omega;
 
+  /// Start from the current state?
+  bool d_initial_guess;
+
+  /// Coarse mesh finite difference accelerator (optional)
+  SP_cmfd d_cmfd;
+
+  /// Multigroup tolerance control
+  InexactControl::SP_control d_control;
+
 };
 
 } // namespace detran
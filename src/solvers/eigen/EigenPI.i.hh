@@ -28,13 +28,30 @@ void EigenPI<D>::solve()
 
   // New k-eigenvalue
   double keff = 1.0;
+
+  // Initialize the fission density, either from the current state (with
+  // unit norm) or from the fission cross sections.
+  bool guess = false;
+  if (d_initial_guess && d_state->eigenvalue() > 0.0)
+  {
+    d_fissionsource->update();
+    State::moments_type fd_0(d_fissionsource->density());
+    double norm_density = norm(fd_0, "L1");
+    if (norm_density > 0.0)
+    {
+      for (int g = 0; g < d_number_groups; ++g)
+        detran_utilities::vec_scale(d_state->phi(g), 1.0 / norm_density);
+      d_fissionsource->update();
+      keff = d_state->eigenvalue();
+      guess = true;
+    }
+  }
+  if (!guess) d_fissionsource->initialize();
+
   // k-eigenvalue from 1 time ago
-  double keff_1 = 1.0;
+  double keff_1 = keff;
   // k-eigenvalue from 2 times ago
-  double keff_2 = 1.0;
-
-  // Initialize the fission density
-  d_fissionsource->initialize();
+  double keff_2 = keff;
 //
 //  d_state->clear();
 //  for (int g = 0; g < d_number_groups; ++g)
@@ -44,10 +61,29 @@ void EigenPI<D>::solve()
 
   // Power iterations.
   int iteration;
-  double error;
+  double error = 0.0;
+
+  // Start the multigroup forcing term afresh.
+  d_control->reset();
+
+  // Sweeps of each multigroup solve, and the smallest forcing term used
+  int sweeps = d_mg_solver->solver()->number_sweeps();
+  int sweeps_0 = sweeps;
+  double eta = 0.0;
+  double eta_min = 1.0;
 
   for (iteration = 1; iteration <= d_maximum_iterations; iteration++)
   {
+    // Solve the multigroup equations only as accurately as the last
+    // fission density error warrants.
+    if (d_control->active())
+    {
+      eta = d_control->forcing();
+      if (iteration > 1) eta = d_control->update(error);
+      eta_min = std::min(eta_min, eta);
+      d_mg_solver->solver()->set_relative_tolerance(eta);
+    }
+
     // Reset the error.
     error = 0.0;
 
@@ -59,6 +95,8 @@ void EigenPI<D>::solve()
 
     // Solve the multigroup equations.
     d_mg_solver->solve();
+    int sweeps_k = d_mg_solver->solver()->number_sweeps() - sweeps;
+    sweeps += sweeps_k;
 
     // Update density.
     d_fissionsource->update();
@@ -67,15 +105,26 @@ void EigenPI<D>::solve()
     // volume-integrated fission rate if desired.
     State::moments_type fd(d_fissionsource->density());
 
-    // Overrelaxation
-    if (d_omega != 1.0)
-    {
-      for (int i = 0; i < fd.size(); ++i)
-        fd[i] = d_omega * fd[i] + (1.0 - d_omega) * fd_old[i];
-    }
     keff_2 = keff_1;
     keff_1 = keff;
-    keff   = keff_1 * norm(fd, "L1") / norm(fd_old, "L1");
+    if (d_cmfd)
+    {
+      // The coarse mesh problem yields the eigenvalue and a corrected
+      // flux, from which the density is rebuilt.
+      keff = d_cmfd->update();
+      d_fissionsource->update();
+      fd = d_fissionsource->density();
+    }
+    else
+    {
+      // Overrelaxation
+      if (d_omega != 1.0)
+      {
+        for (int i = 0; i < fd.size(); ++i)
+          fd[i] = d_omega * fd[i] + (1.0 - d_omega) * fd_old[i];
+      }
+      keff = keff_1 * norm(fd, "L1") / norm(fd_old, "L1");
+    }
 
     // Compute error in fission density.
     error = norm_residual(fd, fd_old, "L1");
@@ -94,16 +143,36 @@ void EigenPI<D>::solve()
         printf("PI Iter: %3i  Error: %12.9f  keff: %12.9f \n",
                iteration, error, keff);
       }
+      if (d_control->active())
+      {
+        printf("         Sweeps: %6i  Forcing: %9.2e \n", sweeps_k, eta);
+      }
     }
     if (error < d_tolerance) break;
 
   } // eigensolver loop
 
+  d_number_iterations = std::min(iteration, (int) d_maximum_iterations);
+
+  // Restore exact multigroup solves.
+  if (d_control->active()) d_mg_solver->solver()->set_relative_tolerance(0.0);
+
   if (d_print_level > 0)
   {
     printf("*********************************************************************\n");
     printf(" PI Final: Number Iters: %3i  Error: %12.9f keff: %12.9f \n",
            iteration, error, keff);
+    printf(" PI Final: Total Sweeps: %8i \n",
+           d_mg_solver->solver()->number_sweeps());
+    if (d_control->active())
+    {
+      // Without eigen_adaptive, every multigroup solve would run to
+      // the fixed tolerance rather than stop at the forcing term.
+      printf(" PI Final: Sweeps/Iter: %8.1f  Smallest Forcing: %9.2e "
+             " Fixed Tolerance: %9.2e \n",
+             double(sweeps - sweeps_0) / d_number_iterations, eta_min,
+             d_mg_solver->solver()->tolerance());
+    }
     printf("*********************************************************************\n");
   }
 
@@ -16,6 +16,7 @@ namespace detran
 template <class D>
 Eigensolver<D>::Eigensolver(SP_mg_solver mg_solver)
   : d_mg_solver(mg_solver)
+  , d_number_iterations(0)
 {
   // Preconditions
   Require(mg_solver);
@@ -168,6 +168,13 @@ public:
   /// Solve the eigenvalue problem.
   virtual void solve() = 0;
 
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /// Number of outer (eigenvalue) iterations used in the last solve
+  int number_iterations() const { return d_number_iterations; }
+
 protected:
 
   //-------------------------------------------------------------------------//
@@ -189,6 +196,8 @@ protected:
 
   // Multigroup solver
   SP_mg_solver d_mg_solver;
+  // Number of iterations used in the last solve
+  int d_number_iterations;
 
 };
 
@@ -0,0 +1,198 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   MGCMTSA.cc
+ *  @author robertsj
+ *  @date   Dec 6, 2012
+ *  @brief  MGCMTSA member definitions.
+ */
+//---------------------------------------------------------------------------//
+
+#include "MGCMTSA.hh"
+#include "angle/QuadratureFactory.hh"
+#include "boundary/BoundarySN.hh"
+#include "boundary/BoundaryFactory.t.hh"
+#include "transport/Homogenize.hh"
+#include "transport/FissionSource.hh"
+#include <string>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class D>
+MGCMTSA<D>::MGCMTSA(SP_input          input,
+                    SP_material       material,
+                    SP_mesh           mesh,
+                    SP_scattersource  source,
+                    size_t            cutoff,
+                    bool              include_fission)
+  : Base(input, material, mesh, cutoff, "MG-CMTSA")
+  , d_scattersource(source)
+{
+  // Preconditions
+  Require(d_scattersource);
+
+  using std::string;
+
+  //-------------------------------------------------------------------------//
+  // COARSE MESH AND MATERIAL
+  //-------------------------------------------------------------------------//
+
+  size_t level = 2;
+  if (d_input->check("outer_pc_coarse_level"))
+    level = d_input->template get<int>("outer_pc_coarse_level");
+  Insist(level > 0, "The CMTSA coarse mesh level must be positive.");
+  Insist(d_mesh->is_cartesian(), "CMTSA requires a Cartesian mesh.");
+
+  d_coarsener = new CoarseMesh(d_mesh, level);
+  d_coarse_mesh = d_coarsener->get_coarse_mesh();
+  d_fine_to_coarse = d_mesh->mesh_map("COARSEMESH");
+
+  // Homogenize with a flat flux, i.e. volume weighting.  The
+  // preconditioner is built before any flux is available, and a
+  // flat flux keeps the coarse operator independent of the iterate.
+  SP_state flat_state(new State(d_input, d_mesh));
+  for (size_t g = 0; g < d_number_groups; ++g)
+    for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+      flat_state->phi(g)[i] = 1.0;
+  Homogenize H(d_material);
+  d_coarse_material = H.homogenize(flat_state, d_mesh, "COARSEMESH",
+                                   Homogenize::PHI_SIGMA_TR);
+
+  //-------------------------------------------------------------------------//
+  // COARSE MESH S2 TRANSPORT PROBLEM
+  //-------------------------------------------------------------------------//
+
+  // The coarse solve is iterative, so a loose tolerance makes the
+  // preconditioner (slightly) nonlinear, which GMRES does not tolerate.
+  double tolerance = 1e-10;
+  if (d_input->check("outer_pc_tolerance"))
+    tolerance = d_input->template get<double>("outer_pc_tolerance");
+  int max_iters = 100;
+  if (d_input->check("outer_pc_max_iters"))
+    max_iters = d_input->template get<int>("outer_pc_max_iters");
+  int number_polar = 1;
+  if (d_input->check("outer_pc_coarse_polar_octant"))
+    number_polar = d_input->template get<int>("outer_pc_coarse_polar_octant");
+  Insist(number_polar > 0, "The CMTSA coarse quadrature needs a polar angle.");
+
+  SP_input db(new detran_utilities::InputDB("MGCMTSA"));
+  db->put<int>("number_groups",             d_number_groups);
+  db->put<string>("equation",               "dd");
+  db->put<string>("quad_type",              "levelsymmetric");
+  if (D::dimension == 1) db->put<string>("quad_type", "gausslegendre");
+  db->put<int>("quad_number_polar_octant",  number_polar);
+  db->put<string>("inner_solver",           "SI");
+  db->put<double>("inner_tolerance",        tolerance);
+  db->put<int>("inner_max_iters",           max_iters);
+  db->put<int>("inner_print_level",         0);
+  db->put<string>("outer_solver",           "GS");
+  db->put<double>("outer_tolerance",        tolerance);
+  db->put<int>("outer_max_iters",           max_iters);
+  db->put<int>("outer_print_level",         0);
+
+  // The correction problem sees the same boundary conditions.
+  string bc[] = {"bc_west", "bc_east", "bc_south",
+                 "bc_north", "bc_bottom", "bc_top"};
+  for (int side = 0; side < 2 * D::dimension; ++side)
+    if (d_input->check(bc[side]))
+      db->put<string>(bc[side], d_input->template get<string>(bc[side]));
+
+  detran_angle::QuadratureFactory quad_factory;
+  detran_angle::Quadrature::SP_quadrature
+    quad = quad_factory.build(db, D::dimension);
+  Assert(quad);
+
+  d_coarse_boundary =
+    BoundaryFactory<D, BoundarySN>::build(db, d_coarse_mesh, quad);
+  d_coarse_state = new State(db, d_coarse_mesh, quad);
+
+  // One spectrum per coarse cell, reset on each application
+  vec_int source_map(d_coarse_mesh->number_cells(), 0);
+  for (size_t i = 0; i < source_map.size(); ++i)
+    source_map[i] = i;
+  vec2_dbl spectra(d_coarse_mesh->number_cells(),
+                   detran_utilities::vec_dbl(d_number_groups, 0.0));
+  d_coarse_source = new Source_T(d_number_groups, d_coarse_mesh,
+                                 spectra, source_map, quad);
+  typename MGSolverGS<D>::vec_externalsource q_e(1, d_coarse_source);
+
+  FissionSource::SP_fissionsource q_f;
+  if (include_fission)
+    q_f = new FissionSource(d_coarse_state, d_coarse_mesh, d_coarse_material);
+
+  d_coarse_solver = new MGSolverGS<D>(d_coarse_state,
+                                      d_coarse_material,
+                                      d_coarse_boundary,
+                                      q_e,
+                                      q_f,
+                                      include_fission);
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void MGCMTSA<D>::apply(Vector &V_in, Vector &V_out)
+{
+  // As for DSA, the correction is applied only to the flux moments.
+  size_t size_moments = d_mesh->number_cells();
+
+  // Copy input vector to a multigroup flux; only the Krylov block is used.
+  State::vec_moments_type
+    phi(d_number_groups, State::moments_type(size_moments, 0.0));
+  for (size_t g = d_group_cutoff; g < d_number_groups; ++g)
+    for (size_t i = 0; i < size_moments; ++i)
+      phi[g][i] = V_in[(g - d_group_cutoff) * size_moments + i];
+
+  //-------------------------------------------------------------------------//
+  // RESTRICT: coarse source <-- R*S*V0, by volume averaging
+  //-------------------------------------------------------------------------//
+
+  vec2_dbl spectra(d_coarse_mesh->number_cells(),
+                   detran_utilities::vec_dbl(d_number_groups, 0.0));
+  for (size_t g = d_group_cutoff; g < d_number_groups; ++g)
+  {
+    State::moments_type source(size_moments, 0.0);
+    d_scattersource->build_total_group_source(g, d_group_cutoff, phi, source);
+    for (size_t i = 0; i < size_moments; ++i)
+      spectra[d_fine_to_coarse[i]][g] += source[i] * d_mesh->volume(i);
+  }
+  for (size_t c = 0; c < spectra.size(); ++c)
+    for (size_t g = d_group_cutoff; g < d_number_groups; ++g)
+      spectra[c][g] /= d_coarse_mesh->volume(c);
+  d_coarse_source->set_spectra(spectra);
+
+  //-------------------------------------------------------------------------//
+  // OPERATE: coarse correction <-- inv(C)*R*S*V0
+  //-------------------------------------------------------------------------//
+
+  d_coarse_state->clear();
+  d_coarse_boundary->clear();
+  d_coarse_solver->solve();
+
+  //-------------------------------------------------------------------------//
+  // PROLONG: V_out <-- V0 + P*inv(C)*R*S*V0
+  //-------------------------------------------------------------------------//
+
+  V_out.copy(V_in);
+  for (size_t g = d_group_cutoff; g < d_number_groups; ++g)
+  {
+    const State::moments_type &dphi = d_coarse_state->phi(g);
+    for (size_t i = 0; i < size_moments; ++i)
+      V_out[(g - d_group_cutoff) * size_moments + i] +=
+        dphi[d_fine_to_coarse[i]];
+  }
+}
+
+//---------------------------------------------------------------------------//
+// EXPLICIT INSTANTIATIONS
+//---------------------------------------------------------------------------//
+
+template class MGCMTSA<_1D>;
+template class MGCMTSA<_2D>;
+template class MGCMTSA<_3D>;
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of file MGCMTSA.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,281 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   MGEnergyMultigrid.cc
+ *  @brief  MGEnergyMultigrid member definitions
+ *  @author Jeremy Roberts
+ *  @date   Jan 20, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#include "MGEnergyMultigrid.hh"
+#include "transport/Homogenize.hh"
+#include "callow/solver/LinearSolverCreator.hh"
+#include "utilities/MathUtilities.hh"
+#include <cmath>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+MGEnergyMultigrid::MGEnergyMultigrid(SP_input          input,
+                                     SP_material       material,
+                                     SP_mesh           mesh,
+                                     SP_scattersource  source,
+                                     size_t            cutoff,
+                                     bool              include_fission)
+  : Base(input, material, mesh, cutoff, "MG-ENERGY-MG")
+  , d_scattersource(source)
+{
+  // Preconditions
+  Require(d_scattersource);
+
+  // Compute the diffusion coefficients.
+  // \todo Need a flag that says whether they are build or not.
+  d_material->compute_diff_coef();
+
+  //-------------------------------------------------------------------------//
+  // COARSE ENERGY GRID
+  //-------------------------------------------------------------------------//
+
+  // Groups below the cutoff are not part of the Krylov block and
+  // are carried along as single-group "coarse" groups.
+  vec_int coarse_active(1, d_number_active_groups);
+  if (d_input->check("outer_pc_coarse_groups"))
+    coarse_active = d_input->get<vec_int>("outer_pc_coarse_groups");
+  Insist(detran_utilities::vec_sum(coarse_active) ==
+         (int) d_number_active_groups,
+         "The coarse groups must partition the Krylov block groups.");
+
+  vec_int coarsegroup(d_group_cutoff, 1);
+  coarsegroup.insert(coarsegroup.end(),
+                     coarse_active.begin(), coarse_active.end());
+  d_number_coarse_groups = coarsegroup.size();
+
+  d_fine_to_coarse.resize(d_number_groups, 0);
+  size_t g = 0;
+  for (size_t cg = 0; cg < d_number_coarse_groups; ++cg)
+  {
+    Insist(coarsegroup[cg] > 0, "Each coarse group needs a fine group.");
+    for (int gg = 0; gg < coarsegroup[cg]; ++gg, ++g)
+      d_fine_to_coarse[g] = cg;
+  }
+
+  //-------------------------------------------------------------------------//
+  // COLLAPSED MATERIAL AND PROLONGATION
+  //-------------------------------------------------------------------------//
+
+  // Weighting spectrum for each material, mapped onto the mesh.
+  vec2_dbl spectrum = spectra();
+  const vec_int &mat_map = d_mesh->mesh_map("MATERIAL");
+  State::SP_state weight(new State(d_input, d_mesh));
+  for (size_t g = 0; g < d_number_groups; ++g)
+    for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+      weight->phi(g)[i] = spectrum[mat_map[i]][g];
+
+  // Collapse over the material map, so that each "coarse cell" is a
+  // material and the fine mesh material map indexes the result.
+  Homogenize H(d_material);
+  d_coarse_material = H.homogenize(weight, d_mesh, "MATERIAL",
+                                   coarsegroup, Homogenize::PHI_D);
+
+  d_prolongation.resize(spectrum.size(), vec_dbl(d_number_groups, 0.0));
+  for (size_t m = 0; m < spectrum.size(); ++m)
+  {
+    vec_dbl total(d_number_coarse_groups, 0.0);
+    for (size_t g = 0; g < d_number_groups; ++g)
+      total[d_fine_to_coarse[g]] += spectrum[m][g];
+    for (size_t g = 0; g < d_number_groups; ++g)
+      d_prolongation[m][g] = spectrum[m][g] / total[d_fine_to_coarse[g]];
+  }
+
+  //-------------------------------------------------------------------------//
+  // FINE AND COARSE GROUP DIFFUSION OPERATORS AND SOLVERS
+  //-------------------------------------------------------------------------//
+
+  SP_input db;
+  if (d_input->check("outer_pc_db"))
+    db = d_input->get<SP_input>("outer_pc_db");
+
+  d_fine_operator = new Operator_T(d_input,
+                                   d_material,
+                                   d_mesh,
+                                   include_fission,
+                                   d_group_cutoff,
+                                   false, // adjoint
+                                   1.0);  // keff
+
+  d_smoothers.resize(d_number_active_groups);
+  for (size_t g = d_group_cutoff; g < d_number_groups; ++g)
+  {
+    SP_operator A(new WGOperator_T(d_input, d_material, d_mesh, g));
+    d_smoothers[g - d_group_cutoff] = callow::LinearSolverCreator::Create(db);
+    d_smoothers[g - d_group_cutoff]->set_operators(A, db);
+  }
+
+  d_operator = new Operator_T(d_input,
+                              d_coarse_material,
+                              d_mesh,
+                              include_fission,
+                              d_group_cutoff,
+                              false, // adjoint
+                              1.0);  // keff
+
+  d_solver = callow::LinearSolverCreator::Create(db);
+  d_solver->set_operators(d_operator, db);
+}
+
+//---------------------------------------------------------------------------//
+void MGEnergyMultigrid::apply(Vector &V_in, Vector &V_out)
+{
+  // As for DSA, the correction is applied only to the flux moments.
+  size_t size_moments = d_mesh->number_cells();
+  size_t number_active_coarse = d_number_coarse_groups - d_group_cutoff;
+  const vec_int &mat_map = d_mesh->mesh_map("MATERIAL");
+
+  // Copy input vector to a multigroup flux; only the Krylov block is used.
+  State::vec_moments_type
+    phi(d_number_groups, State::moments_type(size_moments, 0.0));
+  for (size_t g = d_group_cutoff; g < d_number_groups; ++g)
+    for (size_t i = 0; i < size_moments; ++i)
+      phi[g][i] = V_in[(g - d_group_cutoff) * size_moments + i];
+
+  // Scattering source of the input, b <-- S*V0
+  Vector B(size_moments * d_number_active_groups, 0.0);
+  for (size_t g = d_group_cutoff; g < d_number_groups; ++g)
+  {
+    State::moments_type source(size_moments, 0.0);
+    d_scattersource->build_total_group_source(g, d_group_cutoff, phi, source);
+    for (size_t i = 0; i < size_moments; ++i)
+      B[(g - d_group_cutoff) * size_moments + i] = source[i];
+  }
+
+  //-------------------------------------------------------------------------//
+  // PRE-SMOOTH: E <-- inv(D)*b
+  //-------------------------------------------------------------------------//
+
+  Vector E(size_moments * d_number_active_groups, 0.0);
+  smooth(B, E);
+
+  //-------------------------------------------------------------------------//
+  // RESTRICT: Z <-- R*(b - C*E), by summing over fine groups
+  //-------------------------------------------------------------------------//
+
+  Vector CE(size_moments * d_number_active_groups, 0.0);
+  d_fine_operator->multiply(E, CE);
+  Vector Z(size_moments * number_active_coarse, 0.0);
+  for (size_t g = d_group_cutoff; g < d_number_groups; ++g)
+  {
+    size_t cg = d_fine_to_coarse[g] - d_group_cutoff;
+    for (size_t i = 0; i < size_moments; ++i)
+    {
+      size_t k = (g - d_group_cutoff) * size_moments + i;
+      Z[cg * size_moments + i] += B[k] - CE[k];
+    }
+  }
+
+  //-------------------------------------------------------------------------//
+  // OPERATE: Z_out <-- inv(C_c)*Z
+  //-------------------------------------------------------------------------//
+
+  Vector Z_out(size_moments * number_active_coarse, 0.0);
+  d_solver->solve(Z, Z_out);
+
+  //-------------------------------------------------------------------------//
+  // PROLONG: E <-- E + P*Z_out
+  //-------------------------------------------------------------------------//
+
+  for (size_t g = d_group_cutoff; g < d_number_groups; ++g)
+  {
+    size_t cg = d_fine_to_coarse[g] - d_group_cutoff;
+    for (size_t i = 0; i < size_moments; ++i)
+    {
+      E[(g - d_group_cutoff) * size_moments + i] +=
+        d_prolongation[mat_map[i]][g] * Z_out[cg * size_moments + i];
+    }
+  }
+
+  //-------------------------------------------------------------------------//
+  // POST-SMOOTH AND CORRECT: V_out <-- V0 + E + inv(D)*(b - C*E)
+  //-------------------------------------------------------------------------//
+
+  smooth(B, E);
+  V_out.copy(V_in);
+  for (size_t i = 0; i < size_moments * d_number_active_groups; ++i)
+    V_out[i] += E[i];
+}
+
+//---------------------------------------------------------------------------//
+MGEnergyMultigrid::vec2_dbl MGEnergyMultigrid::spectra() const
+{
+  // Solve the infinite medium problem for each material by Gauss-Seidel
+  // over the groups.  A material without removal in some group (e.g. a
+  // void), or without enough absorption for a bounded infinite medium
+  // solution, has no such spectrum, and a flat one is used instead.
+  vec2_dbl spectrum(d_material->number_materials(),
+                    vec_dbl(d_number_groups, 1.0));
+  for (size_t m = 0; m < spectrum.size(); ++m)
+  {
+    vec_dbl removal(d_number_groups, 0.0);
+    bool flat = false;
+    for (size_t g = 0; g < d_number_groups; ++g)
+    {
+      removal[g] = d_material->sigma_t(m, g) - d_material->sigma_s(m, g, g);
+      if (removal[g] <= 0.0) flat = true;
+    }
+    if (flat) continue;
+
+    vec_dbl phi(d_number_groups, 0.0);
+    bool converged = false;
+    for (int iteration = 0; iteration < 1000; ++iteration)
+    {
+      double error = 0.0;
+      for (size_t g = 0; g < d_number_groups; ++g)
+      {
+        double source = 1.0;
+        for (size_t gp = 0; gp < d_number_groups; ++gp)
+          if (gp != g) source += d_material->sigma_s(m, g, gp) * phi[gp];
+        double phi_g = source / removal[g];
+        error = std::max(error, std::abs(phi_g - phi[g]) / phi_g);
+        phi[g] = phi_g;
+      }
+      if (error < 1.0e-12)
+      {
+        converged = true;
+        break;
+      }
+    }
+    if (converged) spectrum[m] = phi;
+  }
+  return spectrum;
+}
+
+//---------------------------------------------------------------------------//
+void MGEnergyMultigrid::smooth(const Vector &b, Vector &e)
+{
+  size_t size_moments = d_mesh->number_cells();
+
+  // Residual of the fine multigroup diffusion equation
+  Vector r(b);
+  if (e.norm() > 0.0)
+  {
+    Vector Ce(b.size(), 0.0);
+    d_fine_operator->multiply(e, Ce);
+    r.subtract(Ce);
+  }
+
+  // The groups are independent.
+  for (size_t g = 0; g < d_number_active_groups; ++g)
+  {
+    Vector r_g(size_moments, &r[g * size_moments]);
+    Vector e_g(size_moments, 0.0);
+    d_smoothers[g]->solve(r_g, e_g);
+    for (size_t i = 0; i < size_moments; ++i)
+      e[g * size_moments + i] += e_g[i];
+  }
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of file MGEnergyMultigrid.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,187 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   MGEnergyMultigrid.hh
+ *  @brief  MGEnergyMultigrid class definition
+ *  @author Jeremy Roberts
+ *  @date   Jan 20, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_MGENERGYMULTIGRID_HH_
+#define detran_MGENERGYMULTIGRID_HH_
+
+#include "MGPreconditioner.hh"
+#include "DiffusionLossOperator.hh"
+#include "WGDiffusionLossOperator.hh"
+#include "transport/ScatterSource.hh"
+#include "callow/solver/LinearSolver.hh"
+
+namespace detran
+{
+
+/**
+ *  @class MGEnergyMultigrid
+ *  @brief Multigroup preconditioner based on a coarse energy grid
+ *
+ *  The preconditioning process \$ \mathbf{P}^{-1} \$ is defined to be
+ *  @f[
+ *      (\mathbf{I} + \tilde{\mathbf{C}}^{-1} \mathbf{S}) \, ,
+ *  @f]
+ *  where \f$ \tilde{\mathbf{C}}^{-1} \f$ approximates the inverse of
+ *  the multigroup diffusion operator \f$ \mathbf{C} \f$ used by MGDSA
+ *  by one two-grid cycle in energy.  Given \f$ \mathbf{b} = \mathbf{S}
+ *  \mathbf{x} \f$, the cycle
+ *    -# smooths, \f$ \mathbf{e} = \mathbf{D}^{-1} \mathbf{b} \f$, where
+ *       \f$ \mathbf{D} \f$ is the block diagonal of within-group
+ *       diffusion operators,
+ *    -# corrects on the coarse grid, \f$ \mathbf{e} \leftarrow
+ *       \mathbf{e} + \mathbf{P} \mathbf{C}_c^{-1} \mathbf{R}
+ *       (\mathbf{b} - \mathbf{C} \mathbf{e}) \f$, and
+ *    -# smooths again, \f$ \mathbf{e} \leftarrow \mathbf{e} +
+ *       \mathbf{D}^{-1} (\mathbf{b} - \mathbf{C} \mathbf{e}) \f$.
+ *
+ *  Here, \f$ \mathbf{C}_c \f$ is a few-group diffusion operator on the
+ *  transport mesh, \f$ \mathbf{R} \f$ sums the fine group residuals
+ *  over each coarse group, and \f$ \mathbf{P} \f$ prolongs the coarse
+ *  group correction to the fine groups using a within-coarse-group
+ *  spectrum.  The smoother removes the within-group spatial error,
+ *  which a coarse group correction cannot represent, while the coarse
+ *  grid removes the error coupled across groups by scattering, which
+ *  the within-group solves cannot.  Only independent one-group
+ *  solves and a few-group solve are needed, rather than the coupled
+ *  multigroup solve of MGDSA.  With one fine group per coarse group,
+ *  the cycle is an exact inverse of \f$ \mathbf{C} \f$, and the
+ *  preconditioner reduces to MGDSA.
+ *
+ *  The coarse group materials are collapsed via Homogenize using, for
+ *  each material, its infinite medium spectrum driven by a flat
+ *  source, which is strictly positive and, for the thermal groups,
+ *  close to the slowing down spectrum.  The same spectrum defines
+ *  the prolongation.  Only groups at or above the Krylov cutoff are
+ *  collapsed.
+ *
+ *  Relevant database parameters:
+ *    - outer_pc_coarse_groups  -- fine groups per coarse group over the
+ *                                 Krylov block (default: one coarse group)
+ *    - outer_pc_db             -- callow database for the one-group and
+ *                                 coarse solves
+ */
+
+class MGEnergyMultigrid: public MGPreconditioner
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef MGPreconditioner                          Base;
+  typedef detran_utilities::SP<MGEnergyMultigrid>   SP_pc;
+  typedef ScatterSource::SP_scattersource           SP_scattersource;
+  typedef DiffusionLossOperator                     Operator_T;
+  typedef WGDiffusionLossOperator                   WGOperator_T;
+  typedef std::vector<SP_solver>                    vec_solver;
+  typedef detran_utilities::vec_int                 vec_int;
+  typedef detran_utilities::vec_dbl                 vec_dbl;
+  typedef detran_utilities::vec2_dbl                vec2_dbl;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *
+   *  @param input            Input database
+   *  @param material         Material database
+   *  @param mesh             Cartesian mesh
+   *  @param source           Scattering source
+   *  @param cutoff           First group included in solve
+   *  @param include_fission  Treat fission implicitly in the coarse solve
+   */
+  MGEnergyMultigrid(SP_input          input,
+                    SP_material       material,
+                    SP_mesh           mesh,
+                    SP_scattersource  source,
+                    size_t            cutoff,
+                    bool              include_fission);
+
+  /// virtual destructor
+  virtual ~MGEnergyMultigrid(){}
+
+  //-------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL PRECONDITIONERS MUST IMPLEMENT THIS
+  //-------------------------------------------------------------------------//
+
+  /// solve Px = b
+  void apply(Vector &b, Vector &x);
+
+  //-------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL SHELL MATRICES MUST IMPLEMENT THIS
+  //-------------------------------------------------------------------------//
+
+  // the client must implement the action y <-- A * x
+  void multiply(const Vector &x,  Vector &y)
+  {
+    Vector b(x.size(), 0.0);
+    b.copy(x);
+    apply(b, y);
+  }
+
+  // the client must implement the action y <-- A' * x
+  void multiply_transpose(const Vector &x, Vector &y)
+  {
+    THROW("NOT IMPLEMENTED");
+  }
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /// Get the collapsed material
+  SP_material coarse_material() const { return d_coarse_material; }
+
+  /// Get the fine-to-coarse group map
+  const vec_int& fine_to_coarse_group() const { return d_fine_to_coarse; }
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Scatter source
+  SP_scattersource d_scattersource;
+  /// Collapsed material, indexed as the fine material
+  SP_material d_coarse_material;
+  /// Number of coarse groups, including those below the cutoff
+  size_t d_number_coarse_groups;
+  /// Fine-to-coarse group map
+  vec_int d_fine_to_coarse;
+  /// Prolongation weight for each material and fine group
+  vec2_dbl d_prolongation;
+  /// Fine multigroup diffusion operator, used for residuals
+  SP_operator d_fine_operator;
+  /// Within-group diffusion solvers for each Krylov block group
+  vec_solver d_smoothers;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Infinite medium spectra [material][group] used for weighting
+  vec2_dbl spectra() const;
+
+  /// Add the within-group solution for the residual b - C*e to e.
+  void smooth(const Vector &b, Vector &e);
+
+};
+
+} // end namespace detran
+
+#endif // detran_MGENERGYMULTIGRID_HH_
+
+//---------------------------------------------------------------------------//
+//              end of file MGEnergyMultigrid.hh
+//---------------------------------------------------------------------------//
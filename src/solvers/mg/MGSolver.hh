@@ -104,6 +104,7 @@ protected:
   using Base::d_number_groups;
   using Base::d_maximum_iterations;
   using Base::d_tolerance;
+  using Base::d_relative_tolerance;
   using Base::d_print_level;
   using Base::d_print_interval;
   using Base::d_adjoint;
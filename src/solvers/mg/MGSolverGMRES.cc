@@ -9,7 +9,10 @@
 
 #include "MGSolverGMRES.hh"
 #include "MGDSA.hh"
+#include "MGCMTSA.hh"
+#include "MGEnergyMultigrid.hh"
 #include "callow/solver/LinearSolverCreator.hh"
+#include <algorithm>
 
 namespace detran
 {
@@ -29,6 +32,8 @@ MGSolverGMRES<D>::MGSolverGMRES(SP_state                  state,
   , d_boundary_size_group(0)
   , d_reflective_solve_iterations(0)
   , d_update_boundary_flux(false)
+  , d_solver_relative_tolerance(0.0)
+  , d_warm_start(false)
 {
 
   //-------------------------------------------------------------------------//
@@ -82,6 +87,7 @@ MGSolverGMRES<D>::MGSolverGMRES(SP_state                  state,
     }
     d_solver = callow::LinearSolverCreator::Create(db);
     Assert(d_solver);
+    d_solver_relative_tolerance = d_solver->relative_tolerance();
 
     // Set the transport operator.  Note, no second db argument
     // is given, since that is for setting PC's.  We do that
@@ -118,6 +124,26 @@ MGSolverGMRES<D>::MGSolverGMRES(SP_state                  state,
                        d_krylov_group_cutoff,
                        d_multiply);
     }
+    else if (pc_type == "mgcmtsa")
+    {
+      Assert(d_sweepsource->get_scatter_source());
+      d_pc = new MGCMTSA<D>(d_input,
+                            d_material,
+                            d_mesh,
+                            d_sweepsource->get_scatter_source(),
+                            d_krylov_group_cutoff,
+                            d_multiply);
+    }
+    else if (pc_type == "mgenergy")
+    {
+      Assert(d_sweepsource->get_scatter_source());
+      d_pc = new MGEnergyMultigrid(d_input,
+                                   d_material,
+                                   d_mesh,
+                                   d_sweepsource->get_scatter_source(),
+                                   d_krylov_group_cutoff,
+                                   d_multiply);
+    }
 
     if (d_pc)
       d_solver->set_preconditioner(d_pc, pc_side);
@@ -135,6 +161,10 @@ MGSolverGMRES<D>::MGSolverGMRES(SP_state                  state,
     }
   }
 
+  // Check for starting from the current flux.
+  if (d_input->check("outer_warm_start"))
+    d_warm_start = d_input->template get<int>("outer_warm_start");
+
 }
 
 //---------------------------------------------------------------------------//
@@ -145,6 +175,18 @@ int MGSolverGMRES<D>::number_sweeps() const
   return d_sweeper->number_sweeps();
 }
 
+//---------------------------------------------------------------------------//
+template <class D>
+void MGSolverGMRES<D>::set_relative_tolerance(double tol)
+{
+  Base::set_relative_tolerance(tol);
+  // Without a Krylov block, the solve is a single Gauss-Seidel pass.
+  if (!d_solver) return;
+  d_solver->set_tolerances(d_solver->absolute_tolerance(),
+                           std::max(d_solver_relative_tolerance, tol),
+                           d_solver->maximum_iterations());
+}
+
 //---------------------------------------------------------------------------//
 // EXPLICIT INSTANTIATIONS
 //---------------------------------------------------------------------------//
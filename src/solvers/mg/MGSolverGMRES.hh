@@ -76,6 +76,9 @@ namespace detran
  * downscatter, it is used for the downscatter-only block.  The user can
  * switch this using "outer_upscatter_cutoff".
  *
+ * By default, the initial guess is the uncollided flux.  With
+ * "outer_warm_start", it is the current flux of the state.
+ *
  * Reference:
  *   Evans, T., Davidson, G. and Mosher, S. "Parallel Algorithms for
  *   Fixed-Source and Eigenvalue Problems", NSTD Seminar (ORNL), May 27, 2010.
@@ -145,6 +148,9 @@ public:
   /// Solve the multigroup equations.
   void solve(const double keff = 1.0);
 
+  /// Reset the relative tolerance, never loosening the user's own.
+  void set_relative_tolerance(double tol);
+
   //-------------------------------------------------------------------------//
   // PUBLIC FUNCTIONS
   //-------------------------------------------------------------------------//
@@ -171,6 +177,7 @@ private:
   using Base::d_number_groups;
   using Base::d_maximum_iterations;
   using Base::d_tolerance;
+  using Base::d_relative_tolerance;
   using Base::d_print_level;
   using Base::d_print_interval;
   using Base::d_adjoint;
@@ -224,6 +231,10 @@ private:
   SP_sweepsource d_sweepsource;
   /// Flag to update the outgoing fluxes (default: false)
   bool d_update_boundary_flux;
+  /// Relative tolerance requested through the solver database
+  double d_solver_relative_tolerance;
+  /// Flag to start from the current flux (default: false)
+  bool d_warm_start;
 
   //-------------------------------------------------------------------------//
   // IMPLEMENTATION
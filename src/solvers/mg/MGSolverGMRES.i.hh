@@ -61,7 +61,17 @@ inline void MGSolverGMRES<D>::solve(const double keff)
     // SOLVE MULTIGROUP TRANSPORT EQUATION
     //-----------------------------------------------------------------------//
 
+    // Start with the uncollided flux, or with the current flux if requested.
     d_x->copy(d_b);
+    if (d_warm_start)
+    {
+      for (int g = d_krylov_group_cutoff; g < d_number_groups; g++)
+      {
+        int offset = (g - d_krylov_group_cutoff) * d_moments_size_group;
+        memcpy(&((*d_x)[offset]), &d_state->phi(g)[0],
+               d_moments_size_group*sizeof(double));
+      }
+    }
     d_solver->solve(*d_b, *d_x);
 
     //-----------------------------------------------------------------------//
@@ -28,6 +28,19 @@ MGSolverGS<D>::MGSolverGS(SP_state                  state,
   if (d_input->check("outer_norm_type"))
     d_norm_type = d_input->template get<std::string>("outer_norm_type");
 
+  // Two-grid acceleration applies to the upscatter block only, so fission
+  // must not couple the groups.
+  int two_grid = 0;
+  if (d_input->check("outer_two_grid"))
+    two_grid = d_input->template get<int>("outer_two_grid");
+  if (two_grid && !d_multiply && !d_adjoint &&
+      d_material->upscatter_cutoff() < d_number_groups)
+  {
+    d_twogrid = new MGTwoGrid(d_input, d_material, d_mesh);
+  }
+
+  d_control = new InexactControl(d_input, "outer");
+
   // Post conditions
   Ensure(d_norm_type == "Linf" || d_norm_type == "L1" || d_norm_type == "L2");
 }
@@ -11,6 +11,8 @@
 #define detran_MGSOLVERGS_HH_
 
 #include "MGTransportSolver.hh"
+#include "MGTwoGrid.hh"
+#include "solvers/InexactControl.hh"
 
 namespace detran
 {
@@ -22,6 +24,11 @@ namespace detran
  *
  *  Relevant db entries:
  *  - outer_norm_type (str) [default = "Linf"]
+ *  - outer_two_grid (int) [default = 0] -- apply two-grid acceleration
+ *    to the upscatter iterations of non-multiplying forward problems
+ *  - outer_adaptive (str) [default = "none"] -- solve within-group
+ *    equations inexactly based on the upscatter residual (see
+ *    \ref InexactControl)
  */
 //---------------------------------------------------------------------------//
 
@@ -101,6 +108,7 @@ private:
   using Base::d_number_groups;
   using Base::d_maximum_iterations;
   using Base::d_tolerance;
+  using Base::d_relative_tolerance;
   using Base::d_print_level;
   using Base::d_print_interval;
   using Base::d_adjoint;
@@ -109,6 +117,10 @@ private:
 
   /// Determines which norm to use (default is Linf)
   std::string d_norm_type;
+  /// Optional two-grid upscatter acceleration
+  MGTwoGrid::SP_twogrid d_twogrid;
+  /// Within-group tolerance control
+  InexactControl::SP_control d_control;
 
 };
 
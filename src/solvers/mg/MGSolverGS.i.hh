@@ -36,6 +36,20 @@ void MGSolverGS<D>::solve(const double keff)
   // Set the scaling factor for multiplying problems
   if (d_multiply) d_fissionsource->setup_outer(1.0/keff);
 
+  // Decide whether to iterate or not
+  bool iterate = false;
+  if ((!d_downscatter && d_maximum_iterations > 0 && d_number_groups > 1)
+      || d_multiply)
+  {
+    iterate = true;
+  }
+
+  // Within-group solves may be inexact if upscatter iterations follow
+  // or if this solve is itself allowed to be inexact.
+  d_control->reset();
+  bool inexact = d_control->active() && (iterate || d_relative_tolerance > 0.0);
+  if (inexact) d_wg_solver->set_relative_tolerance(d_control->forcing());
+
   // Initial downscatter.
   for (size_t g = 0; g < d_number_groups; g++)
   {
@@ -45,17 +59,13 @@ void MGSolverGS<D>::solve(const double keff)
     d_wg_solver->solve(g);
   }
 
-  // Decide whether to iterate or not
-  bool iterate = false;
-  if ((!d_downscatter && d_maximum_iterations > 0 && d_number_groups > 1)
-      || d_multiply)
-  {
-    iterate = true;
-  }
-
   // Do upscatter iterations if required.  Skip these if the max_iters = 0.
   if (iterate)
   {
+    // Residual of the first and last iterations
+    double nres_first = 0.0;
+    double nres_last  = 0.0;
+
     // Iterations
     for (iteration = 1; iteration <= d_maximum_iterations; iteration++)
     {
@@ -71,6 +81,10 @@ void MGSolverGS<D>::solve(const double keff)
       int g_lower = d_material->upscatter_cutoff();
       if (d_multiply) g_lower = 0;
 
+      // Forcing term for the within-group solves from the last residual
+      if (inexact && iteration > 1)
+        d_wg_solver->set_relative_tolerance(d_control->update(nres_last));
+
       // Loop over required groups
       for (size_t g = g_lower; g < d_number_groups; ++g)
       {
@@ -78,6 +92,13 @@ void MGSolverGS<D>::solve(const double keff)
         if (d_multiply) d_fissionsource->update();
         // Solve the within-group equation
         d_wg_solver->solve(g);
+      }
+
+      // Two-grid correction of the thermal flux
+      if (d_twogrid) d_twogrid->update(d_state, phi_old);
+
+      for (size_t g = g_lower; g < d_number_groups; ++g)
+      {
         // Constructing the norm piecewise.
         nres_g = norm_residual(d_state->phi(g), phi_old[g], d_norm_type);
         if (d_norm_type == "Linf")
@@ -94,7 +115,10 @@ void MGSolverGS<D>::solve(const double keff)
       {
         printf("  GS Iter: %3i  Error: %12.9f \n", (int)iteration, nres);
       }
-      if (nres < d_tolerance) break;
+      if (iteration == 1) nres_first = nres;
+      nres_last = nres;
+      if (nres < std::max(d_tolerance, d_relative_tolerance * nres_first))
+        break;
 
     } // end upscatter iterations
 
@@ -106,6 +130,9 @@ void MGSolverGS<D>::solve(const double keff)
 
   } // end upscatter block
 
+  // Restore exact within-group solves.
+  if (inexact) d_wg_solver->set_relative_tolerance(0.0);
+
   // Diagnostic output
   if (d_print_level > 0)
   {
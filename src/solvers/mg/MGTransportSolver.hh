@@ -80,6 +80,13 @@ public:
   /// Solve the multigroup equations.
   virtual void solve(const double keff = 1.0) = 0;
 
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /// Get the within-group solver (e.g. to reach its sweeper)
+  SP_wg_solver wg_solver() const { return d_wg_solver; }
+
 protected:
 
   //-------------------------------------------------------------------------//
@@ -98,6 +105,7 @@ protected:
   using Base::d_number_groups;
   using Base::d_maximum_iterations;
   using Base::d_tolerance;
+  using Base::d_relative_tolerance;
   using Base::d_print_level;
   using Base::d_print_interval;
   using Base::d_adjoint;
@@ -0,0 +1,165 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   MGTwoGrid.cc
+ *  @brief  MGTwoGrid member definitions
+ *  @author Jeremy Roberts
+ *  @date   Jan 22, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#include "MGTwoGrid.hh"
+#include "transport/Homogenize.hh"
+#include "callow/solver/LinearSolverCreator.hh"
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+MGTwoGrid::MGTwoGrid(SP_input input, SP_material material, SP_mesh mesh)
+  : d_input(input)
+  , d_material(material)
+  , d_mesh(mesh)
+  , d_cutoff(material->upscatter_cutoff())
+  , d_number_groups(material->number_groups())
+  , d_spectral_radius(0.0)
+{
+  Require(d_input);
+  Require(d_material);
+  Require(d_mesh);
+  Insist(d_cutoff < d_number_groups,
+         "Two-grid acceleration requires an upscatter block.");
+
+  compute_spectra();
+
+  // Weight the thermal block with the error mode; the fast groups are
+  // not collapsed, so their weight is arbitrary.
+  const vec_int &mat_map = d_mesh->mesh_map("MATERIAL");
+  SP_state weight(new State(d_input, d_mesh));
+  for (size_t g = 0; g < d_number_groups; ++g)
+    for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+      weight->phi(g)[i] = g < d_cutoff ? 1.0 : d_spectrum[mat_map[i]][g];
+
+  d_material->compute_diff_coef();
+  vec_int coarsegroup(d_cutoff, 1);
+  coarsegroup.push_back(d_number_groups - d_cutoff);
+  Homogenize H(d_material);
+  SP_material cmat = H.homogenize(weight, d_mesh, "MATERIAL",
+                                  coarsegroup, Homogenize::PHI_D);
+
+  // One-group operator for the collapsed thermal block
+  d_operator = new Operator_T(d_input,
+                              cmat,
+                              d_mesh,
+                              false,    // include_fission
+                              d_cutoff, // only the collapsed group
+                              false,    // adjoint
+                              1.0);     // keff
+
+  SP_input db;
+  if (d_input->check("outer_two_grid_db"))
+  {
+    db = d_input->get<SP_input>("outer_two_grid_db");
+  }
+  else
+  {
+    db = new detran_utilities::InputDB("outer_two_grid_db");
+    db->put<std::string>("linear_solver_type",      "gmres");
+    db->put<double>("linear_solver_atol",           1e-12);
+    db->put<double>("linear_solver_rtol",           1e-12);
+    db->put<int>("linear_solver_maxit",             1000);
+    db->put<int>("linear_solver_monitor_level",     0);
+  }
+  d_solver = callow::LinearSolverCreator::Create(db);
+  d_solver->set_operators(d_operator, db);
+}
+
+//---------------------------------------------------------------------------//
+void MGTwoGrid::update(SP_state state, const State::group_moments_type &phi_old)
+{
+  Require(state);
+  Require(phi_old.size() == d_number_groups);
+
+  size_t number_cells = d_mesh->number_cells();
+  const vec_int &mat_map = d_mesh->mesh_map("MATERIAL");
+
+  // Upscatter residual summed over the thermal block
+  callow::Vector R(number_cells, 0.0);
+  for (size_t g = d_cutoff; g < d_number_groups; ++g)
+  {
+    for (size_t gp = g + 1; gp < d_number_groups; ++gp)
+    {
+      const State::moments_type &phi = state->phi(gp);
+      for (size_t i = 0; i < number_cells; ++i)
+      {
+        R[i] += d_material->sigma_s(mat_map[i], g, gp) *
+                (phi[i] - phi_old[gp][i]);
+      }
+    }
+  }
+
+  // Error amplitude
+  callow::Vector E(number_cells, 0.0);
+  d_solver->solve(R, E);
+
+  // Correct the fluxes
+  for (size_t g = d_cutoff; g < d_number_groups; ++g)
+  {
+    State::moments_type &phi = state->phi(g);
+    for (size_t i = 0; i < number_cells; ++i)
+      phi[i] += d_spectrum[mat_map[i]][g] * E[i];
+  }
+}
+
+//---------------------------------------------------------------------------//
+void MGTwoGrid::compute_spectra()
+{
+  size_t number_materials = d_material->number_materials();
+  d_spectrum.assign(number_materials, vec_dbl(d_number_groups, 0.0));
+
+  for (size_t m = 0; m < number_materials; ++m)
+  {
+    vec_dbl &xi = d_spectrum[m];
+    for (size_t g = d_cutoff; g < d_number_groups; ++g)
+      xi[g] = 1.0 / (d_number_groups - d_cutoff);
+
+    // Power iteration on the Gauss-Seidel error propagation.
+    double rho = 0.0;
+    vec_dbl y(d_number_groups, 0.0);
+    for (int iteration = 0; iteration < 1000; ++iteration)
+    {
+      double norm = 0.0;
+      for (size_t g = d_cutoff; g < d_number_groups; ++g)
+      {
+        double source = 0.0;
+        for (size_t gp = d_cutoff; gp < g; ++gp)
+          source += d_material->sigma_s(m, g, gp) * y[gp];
+        for (size_t gp = g + 1; gp < d_number_groups; ++gp)
+          source += d_material->sigma_s(m, g, gp) * xi[gp];
+        y[g] = source / (d_material->sigma_t(m, g) -
+                         d_material->sigma_s(m, g, g));
+        norm += y[g];
+      }
+      // No upscatter in this material: keep a flat mode.
+      if (norm <= 0.0) break;
+      rho = norm;
+
+      double error = 0.0;
+      for (size_t g = d_cutoff; g < d_number_groups; ++g)
+      {
+        error = std::max(error, std::abs(y[g] / norm - xi[g]));
+        xi[g] = y[g] / norm;
+      }
+      if (error < 1.0e-12) break;
+    }
+    d_spectral_radius = std::max(d_spectral_radius, rho);
+  }
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of file MGTwoGrid.cc
+//---------------------------------------------------------------------------//
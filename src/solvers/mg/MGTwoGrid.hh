@@ -0,0 +1,139 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   MGTwoGrid.hh
+ *  @brief  MGTwoGrid class definition
+ *  @author Jeremy Roberts
+ *  @date   Jan 22, 2013
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_MGTWOGRID_HH_
+#define detran_MGTWOGRID_HH_
+
+#include "DiffusionLossOperator.hh"
+#include "transport/State.hh"
+#include "callow/solver/LinearSolver.hh"
+
+namespace detran
+{
+
+/**
+ *  @class MGTwoGrid
+ *  @brief Two-grid acceleration of Gauss-Seidel upscatter iterations
+ *
+ *  Following Adams and Morel, the error remaining after a Gauss-Seidel
+ *  sweep over the upscatter block is dominated by a mode whose energy
+ *  shape is, in each material, the eigenvector \f$ \xi \f$ of the
+ *  infinite medium iteration
+ *  @f[
+ *      (\mathbf{T} - \mathbf{S}_D)^{-1} \mathbf{S}_U \xi = \rho \xi \, ,
+ *  @f]
+ *  where \f$ \mathbf{S}_D \f$ and \f$ \mathbf{S}_U \f$ are the within-
+ *  and downscatter and the upscatter parts of the thermal block.  The
+ *  amplitude \f$ \epsilon \f$ of that mode satisfies a one-group
+ *  diffusion equation whose source is the upscatter residual
+ *  @f[
+ *      R = \sum_{g} \sum_{g' > g} \Sigma_{s, g \leftarrow g'}
+ *          (\phi^{k+1}_{g'} - \phi^{k}_{g'}) \, ,
+ *  @f]
+ *  and whose coefficients are the thermal block collapsed with
+ *  \f$ \xi \f$ via Homogenize.  The corrected flux is
+ *  \f$ \phi_g \leftarrow \phi_g + \xi_g \epsilon \f$.
+ *
+ *  Only the scalar flux is corrected.
+ *
+ *  Relevant database parameters:
+ *    - outer_two_grid_db     -- callow database for the one-group solve
+ */
+class MGTwoGrid
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<MGTwoGrid>           SP_twogrid;
+  typedef detran_utilities::InputDB::SP_input       SP_input;
+  typedef detran_material::Material::SP_material    SP_material;
+  typedef detran_geometry::Mesh::SP_mesh            SP_mesh;
+  typedef State::SP_state                           SP_state;
+  typedef callow::LinearSolver::SP_solver           SP_solver;
+  typedef callow::MatrixBase::SP_matrix             SP_operator;
+  typedef DiffusionLossOperator                     Operator_T;
+  typedef detran_utilities::vec_int                 vec_int;
+  typedef detran_utilities::vec_dbl                 vec_dbl;
+  typedef detran_utilities::vec2_dbl                vec2_dbl;
+  typedef detran_utilities::size_t                  size_t;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param input      Input database
+   *  @param material   Material database
+   *  @param mesh       Cartesian mesh
+   */
+  MGTwoGrid(SP_input input, SP_material material, SP_mesh mesh);
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Correct the flux following a Gauss-Seidel upscatter sweep
+   *  @param state      State holding the newly swept flux
+   *  @param phi_old    Flux before the sweep
+   */
+  void update(SP_state state, const State::group_moments_type &phi_old);
+
+  /// Largest infinite medium spectral radius of unaccelerated iteration
+  double spectral_radius() const { return d_spectral_radius; }
+
+  /// Get the weighting spectrum for a material
+  const vec_dbl& spectrum(const size_t m) const { return d_spectrum[m]; }
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Input
+  SP_input d_input;
+  /// Material
+  SP_material d_material;
+  /// Mesh
+  SP_mesh d_mesh;
+  /// First group of the upscatter block
+  size_t d_cutoff;
+  /// Number of groups
+  size_t d_number_groups;
+  /// Error mode spectrum [material][group], normalized over the block
+  vec2_dbl d_spectrum;
+  /// Largest spectral radius over all materials
+  double d_spectral_radius;
+  /// One-group diffusion operator
+  SP_operator d_operator;
+  /// One-group diffusion solver
+  SP_solver d_solver;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Compute the error mode spectrum of each material by power iteration
+  void compute_spectra();
+
+};
+
+} // end namespace detran
+
+#endif // detran_MGTWOGRID_HH_
+
+//---------------------------------------------------------------------------//
+//              end of file MGTwoGrid.hh
+//---------------------------------------------------------------------------//
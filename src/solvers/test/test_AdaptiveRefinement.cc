@@ -0,0 +1,147 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_AdaptiveRefinement.cc
+ *  @author Jeremy Roberts
+ *  @date   Feb 27, 2013
+ *  @brief  Test of AdaptiveRefinement
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                               \
+        FUNC(test_AdaptiveRefinement_1D)        \
+        FUNC(test_AdaptiveRefinement_flat)
+
+#include "TestDriver.hh"
+#include "AdaptiveRefinement.hh"
+#include "Mesh1D.hh"
+#include "Mesh2D.hh"
+#include "callow/utils/Initialization.hh"
+#include "material/test/material_fixture.hh"
+#include <cmath>
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_material;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+InputDB::SP_input test_AdaptiveRefinement_input(int dimension)
+{
+  InputDB::SP_input inp(new InputDB());
+  inp->put<int>("number_groups",                  2);
+  inp->put<int>("dimension",                      dimension);
+  inp->put<string>("equation",                    "dd");
+  inp->put<string>("bc_west",                     "reflect");
+  inp->put<string>("bc_east",                     "reflect");
+  inp->put<string>("bc_south",                    "reflect");
+  inp->put<string>("bc_north",                    "reflect");
+  inp->put<int>("quad_number_polar_octant",       8);
+  inp->put<string>("inner_solver",                "SI");
+  inp->put<double>("inner_tolerance",             1e-10);
+  inp->put<int>("inner_max_iters",                10000);
+  inp->put<int>("inner_print_level",              0);
+  inp->put<string>("outer_solver",                "GS");
+  inp->put<double>("outer_tolerance",             1e-10);
+  inp->put<int>("outer_print_level",              0);
+  inp->put<string>("eigen_solver",                "PI");
+  inp->put<double>("eigen_tolerance",             1e-9);
+  inp->put<int>("eigen_max_iters",                1000);
+  inp->put<int>("eigen_print_level",              0);
+  return inp;
+}
+
+// Eigenvalue of a slab with uniform cells
+double test_AdaptiveRefinement_uniform(int number_cells)
+{
+  vec_dbl xfme(number_cells + 1, 0.0);
+  for (int i = 0; i <= number_cells; ++i)
+    xfme[i] = 60.0 * i / number_cells;
+  vec_int mat_map(number_cells, 1);
+  for (int i = 11 * number_cells / 12; i < number_cells; ++i)
+    mat_map[i] = 0;
+  Mesh::SP_mesh mesh(new Mesh1D(xfme, mat_map));
+  EigenvalueManager<_1D> manager(test_AdaptiveRefinement_input(1),
+                                 material_fixture_2g(), mesh);
+  manager.solve();
+  return manager.state()->eigenvalue();
+}
+
+// A reflected slab of fuel with a thin water region.  The flux varies
+// only near the water, so refining there gives a better eigenvalue than
+// a uniform mesh with more cells.  The slab starts at x = 10 to check
+// that the refined meshes keep the origin.
+int test_AdaptiveRefinement_1D(int argc, char *argv[])
+{
+  double keff_ref     = test_AdaptiveRefinement_uniform(192);
+  double keff_uniform = test_AdaptiveRefinement_uniform(48);
+
+  vec_dbl xfme(13, 0.0);
+  for (int i = 0; i < 13; ++i) xfme[i] = 10.0 + 5.0 * i;
+  vec_int mat_map(12, 1);
+  mat_map[11] = 0;
+  Mesh::SP_mesh coarse(new Mesh1D(xfme, mat_map));
+  InputDB::SP_input inp = test_AdaptiveRefinement_input(1);
+  inp->put<int>("amr_max_levels",   3);
+  inp->put<double>("amr_fraction",  0.2);
+  inp->put<int>("amr_print_level",  1);
+  AdaptiveRefinement<_1D> amr(inp, material_fixture_2g(), coarse);
+  TEST(amr.solve());
+  double keff = amr.state()->eigenvalue();
+  printf(" keff: amr = %12.9f uniform = %12.9f ref = %12.9f cells = %i \n",
+         keff, keff_uniform, keff_ref, amr.mesh()->number_cells());
+
+  TEST(amr.number_refinements() == 3);
+  TEST(!inp->check("eigen_pi_initial_guess"));
+  TEST(amr.mesh()->number_cells() < 48);
+  TEST(soft_equiv(amr.mesh()->origin(0), 10.0));
+  TEST(soft_equiv(amr.mesh()->total_width_x(), 60.0));
+  TEST(std::abs(keff - keff_ref) < std::abs(keff_uniform - keff_ref));
+
+  // The materials follow the parent cells.
+  const vec_int &m = amr.mesh()->mesh_map("MATERIAL");
+  double x = 10.0;
+  for (int i = 0; i < amr.mesh()->number_cells(); ++i)
+  {
+    x += amr.mesh()->dx(i);
+    TEST(m[i] == (x <= 65.0 + 1e-9 ? 1 : 0));
+  }
+  return 0;
+}
+
+// A reflected homogeneous medium has a flat flux, so nothing is refined.
+int test_AdaptiveRefinement_flat(int argc, char *argv[])
+{
+  Material::SP_material mat = material_fixture_2g();
+  vec_dbl xfme(4, 0.0);
+  xfme[1] = 1.0; xfme[2] = 3.0; xfme[3] = 4.0;
+  Mesh::SP_mesh mesh(new Mesh2D(xfme, xfme, vec_int(9, 1)));
+  InputDB::SP_input inp = test_AdaptiveRefinement_input(2);
+  inp->put<double>("amr_tolerance", 1e-6);
+  AdaptiveRefinement<_2D> amr(inp, mat, mesh);
+  TEST(amr.solve());
+  TEST(amr.number_refinements() == 0);
+  TEST(amr.mesh() == mesh);
+  vec2_dbl eta = AdaptiveRefinement<_2D>::estimate(mesh, amr.state());
+  TEST(eta.size() == 2);
+  for (int d = 0; d < 2; ++d)
+    for (int i = 0; i < 3; ++i)
+      TEST(eta[d][i] < 1e-6);
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_AdaptiveRefinement.cc
+//---------------------------------------------------------------------------//
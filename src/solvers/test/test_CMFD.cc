@@ -0,0 +1,175 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_CMFD.cc
+ *  @author Jeremy Roberts
+ *  @date   Jan 14, 2013
+ *  @brief  Test of CMFD acceleration of MOC power iteration.
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                     \
+        FUNC(test_CMFD_MOC)           \
+        FUNC(test_CMFD_MOC_core)      \
+        FUNC(test_CMFD_omega)
+
+#include "TestDriver.hh"
+#include "EigenvalueManager.hh"
+#include "Mesh2D.hh"
+#include "callow/utils/Initialization.hh"
+#include "material/test/material_fixture.hh"
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_material;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+// The coarse mesh level is left at its default unless given.
+InputDB::SP_input test_CMFD_input(int cmfd, int level = 0)
+{
+  InputDB::SP_input inp(new InputDB());
+  inp->put<int>("number_groups",                  2);
+  inp->put<int>("dimension",                      2);
+  inp->put<string>("equation",                    "scmoc");
+  inp->put<string>("bc_west",                     "reflect");
+  inp->put<string>("bc_east",                     "vacuum");
+  inp->put<string>("bc_south",                    "reflect");
+  inp->put<string>("bc_north",                    "vacuum");
+  inp->put<string>("quad_type",                   "uniform");
+  inp->put<int>("quad_number_polar_octant",       3);
+  inp->put<int>("quad_number_azimuth_octant",     4);
+  inp->put<int>("quad_uniform_number_space",      20);
+  inp->put<string>("inner_solver",                "SI");
+  inp->put<double>("inner_tolerance",             1e-12);
+  inp->put<int>("inner_max_iters",                10000);
+  inp->put<int>("inner_print_level",              0);
+  inp->put<string>("outer_solver",                "GS");
+  inp->put<double>("outer_tolerance",             1e-12);
+  inp->put<int>("outer_max_iters",                1000);
+  inp->put<int>("outer_print_level",              0);
+  inp->put<string>("eigen_solver",                "PI");
+  inp->put<double>("eigen_tolerance",             1e-10);
+  inp->put<int>("eigen_max_iters",                1000);
+  inp->put<int>("eigen_print_level",              0);
+  inp->put<int>("eigen_pi_cmfd",                  cmfd);
+  if (level > 0)
+    inp->put<int>("eigen_pi_cmfd_level",          level);
+  return inp;
+}
+
+int test_CMFD_MOC(int argc, char *argv[])
+{
+  typedef EigenvalueManager<_2D> Manager_T;
+
+  Material::SP_material mat = material_fixture_2g();
+
+  // Fuel in the reflected corner surrounded by water
+  vec_dbl cm(3, 0.0); cm[1] = 10.0; cm[2] = 20.0;
+  vec_int fm(2, 3);
+  vec_int mat_map(4, 0); mat_map[0] = 1;
+
+  // Reference via unaccelerated power iteration
+  Mesh::SP_mesh mesh_ref(new Mesh2D(fm, fm, cm, cm, mat_map));
+  Manager_T manager_ref(test_CMFD_input(0), mat, mesh_ref);
+  TEST(manager_ref.solve());
+  double keff_ref = manager_ref.state()->eigenvalue();
+
+  // CMFD-accelerated power iteration
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mat_map));
+  Manager_T manager(test_CMFD_input(1), mat, mesh);
+  TEST(manager.solve());
+  double keff = manager.state()->eigenvalue();
+
+  TEST(soft_equiv(keff, keff_ref, 1e-8));
+  for (int g = 0; g < 2; ++g)
+  {
+    for (int i = 0; i < mesh->number_cells(); ++i)
+    {
+      double phi_ref = manager_ref.state()->phi(g)[i];
+      double phi     = manager.state()->phi(g)[i];
+      TEST(soft_equiv(phi / manager.state()->phi(g)[0],
+                      phi_ref / manager_ref.state()->phi(g)[0], 1e-6));
+    }
+  }
+  return 0;
+}
+
+// A 40 cm fuel quarter core with a 10 cm water reflector on 2 cm cells.
+// Unaccelerated power iteration needs 44 iterations, while CMFD needs 6
+// on the default coarse mesh (the fine cells) and 10 on 4 cm cells.
+int test_CMFD_MOC_core(int argc, char *argv[])
+{
+  typedef EigenvalueManager<_2D> Manager_T;
+
+  Material::SP_material mat = material_fixture_2g();
+
+  vec_dbl cm(3, 0.0); cm[1] = 40.0; cm[2] = 50.0;
+  vec_int fm(2, 20); fm[1] = 5;
+  vec_int mat_map(4, 0); mat_map[0] = 1;
+
+  int    iterations[3];
+  double keff[3];
+  for (int level = 0; level < 3; ++level)
+  {
+    Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mat_map));
+    InputDB::SP_input inp = test_CMFD_input(level > 0, level == 2 ? 2 : 0);
+    inp->put<int>("quad_uniform_number_space",    40);
+    inp->put<double>("inner_tolerance",           1e-10);
+    inp->put<double>("outer_tolerance",           1e-10);
+    inp->put<double>("eigen_tolerance",           1e-8);
+    Manager_T manager(inp, mat, mesh);
+    TEST(manager.solve());
+    iterations[level] = manager.solver()->number_iterations();
+    keff[level] = manager.state()->eigenvalue();
+    printf(" level = %i iterations = %i keff = %12.10f \n",
+           level, iterations[level], keff[level]);
+  }
+  TEST(soft_equiv(keff[1], keff[0], 1e-7));
+  TEST(soft_equiv(keff[2], keff[0], 1e-7));
+  TEST(iterations[1] < iterations[0] / 4);
+  TEST(iterations[2] < iterations[0] / 2);
+  return 0;
+}
+
+// Overrelaxation of the fission density is not combined with CMFD.
+int test_CMFD_omega(int argc, char *argv[])
+{
+  typedef EigenvalueManager<_2D> Manager_T;
+
+  Material::SP_material mat = material_fixture_2g();
+  vec_dbl cm(2, 0.0); cm[1] = 10.0;
+  vec_int fm(1, 2);
+  vec_int mat_map(1, 1);
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mat_map));
+  InputDB::SP_input inp = test_CMFD_input(1);
+  inp->put<double>("eigen_pi_omega", 1.2);
+  bool rejected = false;
+  try
+  {
+    Manager_T manager(inp, mat, mesh);
+    manager.solve();
+  }
+  catch (detran_utilities::GenException &e)
+  {
+    rejected = true;
+  }
+  TEST(rejected);
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_CMFD.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,138 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_InexactControl.cc
+ *  @author Jeremy Roberts
+ *  @date   Jan 24, 2013
+ *  @brief  Test of adaptive inner tolerances.
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                     \
+        FUNC(test_InexactControl)     \
+        FUNC(test_InexactControl_PI)
+
+#include "TestDriver.hh"
+#include "InexactControl.hh"
+#include "EigenvalueManager.hh"
+#include "Mesh1D.hh"
+#include "callow/utils/Initialization.hh"
+#include "material/test/material_fixture.hh"
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_material;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+int test_InexactControl(int argc, char *argv[])
+{
+  InputDB::SP_input db(new InputDB());
+
+  // Off by default: inner solves are exact
+  {
+    InexactControl control(db, "eigen");
+    TEST(!control.active());
+    TEST(soft_equiv(control.forcing(), 0.0));
+  }
+
+  // Fixed forcing term
+  db->put<string>("eigen_adaptive",         "fixed");
+  db->put<double>("eigen_adaptive_factor",  0.01);
+  {
+    InexactControl control(db, "eigen");
+    TEST(control.active());
+    TEST(soft_equiv(control.forcing(),     0.01));
+    TEST(soft_equiv(control.update(1.0),   0.01));
+    TEST(soft_equiv(control.update(1e-3),  0.01));
+  }
+
+  // Eisenstat-Walker forcing with alpha = 2
+  db->put<string>("eigen_adaptive",         "ew");
+  db->put<double>("eigen_adaptive_factor",  0.5);
+  db->put<double>("eigen_adaptive_alpha",   2.0);
+  {
+    InexactControl control(db, "eigen");
+    // First call uses the factor
+    TEST(soft_equiv(control.update(1.0), 0.5));
+    // eta = 0.5 * (0.1/1)^2 = 0.005, but the safeguard 0.5*0.5^2 > 0.1
+    TEST(soft_equiv(control.update(0.1), 0.125));
+    // Safeguard now 0.5*0.125^2 < 0.1, so eta = 0.5 * (0.01/0.1)^2
+    TEST(soft_equiv(control.update(0.01), 0.005));
+    control.reset();
+    TEST(soft_equiv(control.forcing(), 0.5));
+  }
+  return 0;
+}
+
+InputDB::SP_input test_InexactControl_input(int adaptive)
+{
+  InputDB::SP_input inp(new InputDB());
+  inp->put<int>("number_groups",                  7);
+  inp->put<string>("equation",                    "dd");
+  inp->put<string>("bc_west",                     "reflect");
+  inp->put<string>("bc_east",                     "vacuum");
+  inp->put<int>("quad_number_polar_octant",       8);
+  inp->put<string>("inner_solver",                "SI");
+  inp->put<double>("inner_tolerance",             1e-12);
+  inp->put<int>("inner_max_iters",                100000);
+  inp->put<int>("inner_print_level",              0);
+  inp->put<string>("outer_solver",                "GS");
+  inp->put<double>("outer_tolerance",             1e-12);
+  inp->put<int>("outer_max_iters",                1000);
+  inp->put<int>("outer_print_level",              0);
+  inp->put<string>("eigen_solver",                "PI");
+  inp->put<double>("eigen_tolerance",             1e-10);
+  inp->put<int>("eigen_max_iters",                1000);
+  inp->put<int>("eigen_print_level",              1);
+  if (adaptive)
+  {
+    inp->put<string>("eigen_adaptive",            "fixed");
+    inp->put<string>("outer_adaptive",            "fixed");
+  }
+  return inp;
+}
+
+int test_InexactControl_PI(int argc, char *argv[])
+{
+  typedef EigenvalueManager<_1D> Manager_T;
+
+  Material::SP_material mat = material_fixture_7g();
+
+  // Fuel slab reflected by water
+  vec_dbl cm(3, 0.0); cm[1] = 10.0; cm[2] = 20.0;
+  vec_int fm(2, 10);
+  vec_int mat_map(2, 0); mat_map[1] = 3;
+
+  double keff[2];
+  int sweeps[2];
+  for (int adaptive = 0; adaptive < 2; ++adaptive)
+  {
+    Mesh::SP_mesh mesh(new Mesh1D(fm, cm, mat_map));
+    Manager_T manager(test_InexactControl_input(adaptive), mat, mesh);
+    TEST(manager.solve());
+    keff[adaptive] = manager.state()->eigenvalue();
+    sweeps[adaptive] = manager.mg_solver()->solver()->number_sweeps();
+  }
+
+  // Same eigenvalue in fewer sweeps
+  TEST(soft_equiv(keff[1], keff[0], 1e-9));
+  TEST(sweeps[1] < sweeps[0]);
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_InexactControl.cc
+//---------------------------------------------------------------------------//
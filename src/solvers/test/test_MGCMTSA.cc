@@ -0,0 +1,161 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_MGCMTSA.cc
+ *  @author robertsj
+ *  @date   Dec 6, 2012
+ *  @brief  Test of MGCMTSA preconditioner.
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                     \
+        FUNC(test_MGCMTSA_1D)         \
+        FUNC(test_MGCMTSA_2D)
+
+#include "TestDriver.hh"
+#include "FixedSourceManager.hh"
+#include "Mesh1D.hh"
+#include "Mesh2D.hh"
+#include "external_source/IsotropicSource.hh"
+#include "callow/utils/Initialization.hh"
+#include "material/test/material_fixture.hh"
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_material;
+using namespace detran_external_source;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+InputDB::SP_input test_MGCMTSA_input(std::string outer_solver,
+                                     std::string pc_type,
+                                     int number_groups)
+{
+  InputDB::SP_input inp(new InputDB());
+  inp->put<int>("number_groups",                  number_groups);
+  inp->put<string>("equation",                    "dd");
+  // Vacuum boundaries, so that the boundary unknowns, which are not
+  // preconditioned, do not limit the Krylov iterations.
+  inp->put<string>("bc_west",                     "vacuum");
+  inp->put<string>("bc_east",                     "vacuum");
+  inp->put<string>("bc_south",                    "vacuum");
+  inp->put<string>("bc_north",                    "vacuum");
+  inp->put<int>("quad_number_polar_octant",       4);
+  inp->put<int>("quad_number_azimuth_octant",     4);
+  inp->put<string>("inner_solver",                "SI");
+  inp->put<double>("inner_tolerance",             1e-12);
+  inp->put<int>("inner_max_iters",                10000);
+  inp->put<int>("inner_print_level",              0);
+  inp->put<string>("outer_solver",                outer_solver);
+  inp->put<double>("outer_tolerance",             1e-12);
+  inp->put<int>("outer_max_iters",                10000);
+  inp->put<int>("outer_print_level",              0);
+  inp->put<int>("outer_krylov_group_cutoff",      0);
+  inp->put<string>("outer_pc_type",               pc_type);
+  inp->put<int>("outer_pc_side",                  1);
+  inp->put<double>("outer_pc_tolerance",          1e-13);
+  InputDB::SP_input db(new InputDB("outer_solver_db"));
+  db->put<double>("linear_solver_atol",           1e-12);
+  db->put<double>("linear_solver_rtol",           1e-12);
+  db->put<string>("linear_solver_type",           "gmres");
+  db->put<int>("linear_solver_maxit",             1000);
+  db->put<int>("linear_solver_monitor_level",     0);
+  inp->put<InputDB::SP_input>("outer_solver_db",  db);
+  return inp;
+}
+
+// Fuel and moderator, 20 cm across in 0.5 cm cells
+Mesh::SP_mesh test_MGCMTSA_mesh(int d)
+{
+  vec_dbl cm(3, 0.0); cm[1] = 8.0; cm[2] = 20.0;
+  vec_int fm(2, 16); fm[1] = 24;
+  vec_int mat_map(2, 0); mat_map[1] = 3;
+  Mesh::SP_mesh mesh;
+  if (d == 1) mesh = new Mesh1D(fm, cm, mat_map);
+  else
+  {
+    vec_int mat_map2(4, 0); mat_map2[3] = 3;
+    mesh = new Mesh2D(fm, fm, cm, cm, mat_map2);
+  }
+  return mesh;
+}
+
+template <class D>
+int test_MGCMTSA_T(Mesh::SP_mesh mesh)
+{
+  typedef FixedSourceManager<D> Manager_T;
+
+  Material::SP_material mat = material_fixture_7g();
+  int ng = mat->number_groups();
+
+  vec2_dbl spectra(1, vec_dbl(ng, 1.0));
+  vec_int  source_map(mesh->number_cells(), 0);
+
+  // Reference via Gauss-Seidel
+  Manager_T manager_gs(test_MGCMTSA_input("GS", "none", ng), mat, mesh);
+  manager_gs.setup();
+  manager_gs.set_source(IsotropicSource::Create(ng, mesh, spectra,
+                                                source_map,
+                                                manager_gs.quadrature()));
+  manager_gs.set_solver();
+  manager_gs.solve();
+
+  // Unpreconditioned GMRES
+  Manager_T manager_none(test_MGCMTSA_input("GMRES", "none", ng), mat, mesh);
+  manager_none.setup();
+  manager_none.set_source(IsotropicSource::Create(ng, mesh, spectra,
+                                                  source_map,
+                                                  manager_none.quadrature()));
+  manager_none.set_solver();
+  manager_none.solve();
+
+  // Preconditioned GMRES
+  Manager_T manager(test_MGCMTSA_input("GMRES", "mgcmtsa", ng), mat, mesh);
+  manager.setup();
+  manager.set_source(IsotropicSource::Create(ng, mesh, spectra,
+                                             source_map,
+                                             manager.quadrature()));
+  manager.set_solver();
+  manager.solve();
+
+  // With the default coarse mesh and S2, at most 60% of the sweeps
+  // remain (98 of 245 in 1D and 119 of 238 in 2D).
+  printf(" sweeps = %i (none: %i) \n",
+         manager.number_sweeps(), manager_none.number_sweeps());
+  TEST(manager.number_sweeps() < 0.6 * manager_none.number_sweeps());
+  for (int g = 0; g < ng; ++g)
+  {
+    for (int i = 0; i < mesh->number_cells(); ++i)
+    {
+      TEST(soft_equiv(manager.state()->phi(g)[i],
+                      manager_gs.state()->phi(g)[i], 1e-8));
+    }
+  }
+  return 0;
+}
+
+int test_MGCMTSA_1D(int argc, char *argv[])
+{
+  return test_MGCMTSA_T<_1D>(test_MGCMTSA_mesh(1));
+}
+
+int test_MGCMTSA_2D(int argc, char *argv[])
+{
+  return test_MGCMTSA_T<_2D>(test_MGCMTSA_mesh(2));
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_MGCMTSA.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,185 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_MGEnergyMultigrid.cc
+ *  @author Jeremy Roberts
+ *  @date   Jan 20, 2013
+ *  @brief  Test of MGEnergyMultigrid preconditioner.
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                                 \
+        FUNC(test_MGEnergyMultigrid_thermal)      \
+        FUNC(test_MGEnergyMultigrid_no_removal)
+
+#include "TestDriver.hh"
+#include "FixedSourceManager.hh"
+#include "Mesh1D.hh"
+#include "Mesh2D.hh"
+#include "external_source/IsotropicSource.hh"
+#include "callow/utils/Initialization.hh"
+#include <cmath>
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_material;
+using namespace detran_external_source;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+/*
+ *  Four group moderator with one fast group and three thermal groups
+ *  coupled by strong upscatter and weak absorption.  Material 1 is the
+ *  same, except that the last group only scatters within itself, so
+ *  it has no removal and no infinite medium spectrum.
+ */
+Material::SP_material test_MGEnergyMultigrid_material()
+{
+  Material::SP_material mat(new Material(2, 4, "thermal"));
+  for (int m = 0; m < 2; ++m)
+  {
+    mat->set_sigma_t(m, 0, 0.25);
+    mat->set_sigma_t(m, 1, 0.45);
+    mat->set_sigma_t(m, 2, 0.60);
+    mat->set_sigma_t(m, 3, 0.80);
+    mat->set_sigma_s(m, 0, 0, 0.200);
+    mat->set_sigma_s(m, 1, 0, 0.047);
+    mat->set_sigma_s(m, 2, 0, 0.001);
+    mat->set_sigma_s(m, 1, 1, 0.330);
+    mat->set_sigma_s(m, 2, 1, 0.090);
+    mat->set_sigma_s(m, 3, 1, 0.020);
+    mat->set_sigma_s(m, 1, 2, 0.030);
+    mat->set_sigma_s(m, 2, 2, 0.400);
+    mat->set_sigma_s(m, 3, 2, 0.160);
+    mat->set_sigma_s(m, 2, 3, 0.120);
+    mat->set_sigma_s(m, 3, 3, 0.660);
+  }
+  mat->set_sigma_s(1, 2, 3, 0.0);
+  mat->set_sigma_s(1, 3, 3, 0.80);
+  mat->finalize();
+  return mat;
+}
+
+/// Solve with MG-GMRES over all groups and return the number of sweeps.
+template <class D>
+int test_MGEnergyMultigrid_solve(std::string           pc_type,
+                                 Material::SP_material mat,
+                                 Mesh::SP_mesh         mesh,
+                                 State::SP_state      &state)
+{
+  int ng = mat->number_groups();
+  InputDB::SP_input inp(new InputDB());
+  inp->put<int>("number_groups",                  ng);
+  inp->put<string>("equation",                    "dd");
+  inp->put<string>("bc_west",                     "reflect");
+  inp->put<string>("bc_east",                     "vacuum");
+  inp->put<string>("bc_south",                    "reflect");
+  inp->put<string>("bc_north",                    "vacuum");
+  inp->put<int>("quad_number_polar_octant",       4);
+  inp->put<int>("quad_number_azimuth_octant",     2);
+  inp->put<string>("inner_solver",                "SI");
+  inp->put<int>("inner_print_level",              0);
+  inp->put<string>("outer_solver",                "GMRES");
+  inp->put<int>("outer_print_level",              0);
+  inp->put<int>("outer_krylov_group_cutoff",      0);
+  inp->put<string>("outer_pc_type",               pc_type);
+  inp->put<int>("outer_pc_side",                  1);
+  // The fast group and the thermal block
+  vec_int coarse(2, 1); coarse[1] = ng - 1;
+  inp->put<vec_int>("outer_pc_coarse_groups",     coarse);
+  InputDB::SP_input pc_db(new InputDB("outer_pc_db"));
+  pc_db->put<double>("linear_solver_atol",        1e-13);
+  pc_db->put<double>("linear_solver_rtol",        1e-13);
+  pc_db->put<string>("linear_solver_type",        "gmres");
+  pc_db->put<int>("linear_solver_maxit",          1000);
+  inp->put<InputDB::SP_input>("outer_pc_db",      pc_db);
+  InputDB::SP_input db(new InputDB("outer_solver_db"));
+  db->put<double>("linear_solver_atol",           1e-12);
+  db->put<double>("linear_solver_rtol",           1e-12);
+  db->put<string>("linear_solver_type",           "gmres");
+  db->put<int>("linear_solver_maxit",             1000);
+  inp->put<InputDB::SP_input>("outer_solver_db",  db);
+
+  vec2_dbl spectra(1, vec_dbl(ng, 0.0)); spectra[0][0] = 1.0;
+  vec_int  source_map(mesh->number_cells(), 0);
+
+  FixedSourceManager<D> manager(inp, mat, mesh);
+  manager.setup();
+  manager.set_source(IsotropicSource::Create(ng, mesh, spectra, source_map,
+                                             manager.quadrature()));
+  manager.set_solver();
+  manager.solve();
+  state = manager.state();
+  return manager.number_sweeps();
+}
+
+double test_MGEnergyMultigrid_error(State::SP_state a, State::SP_state b)
+{
+  double error = 0.0;
+  for (int g = 0; g < a->number_groups(); ++g)
+  {
+    for (int i = 0; i < a->phi(g).size(); ++i)
+    {
+      double e = std::abs(a->phi(g)[i] - b->phi(g)[i]) / b->phi(g)[i];
+      error = std::isnan(e) ? 1.0 : std::max(error, e);
+    }
+  }
+  return error;
+}
+
+// A fast source slowing down into a thick, reflected slab of moderator.
+// Upscatter couples the thermal groups, and the coarse correction over
+// the thermal block removes most of the unpreconditioned sweeps.
+int test_MGEnergyMultigrid_thermal(int argc, char *argv[])
+{
+  vec_dbl cm(2, 0.0); cm[1] = 40.0;
+  vec_int fm(1, 40);
+  vec_int mat_map(1, 0);
+  Mesh::SP_mesh mesh(new Mesh1D(fm, cm, mat_map));
+  Material::SP_material mat = test_MGEnergyMultigrid_material();
+
+  State::SP_state phi_ref, phi;
+  int sweeps_ref = test_MGEnergyMultigrid_solve<_1D>("none", mat, mesh, phi_ref);
+  int sweeps = test_MGEnergyMultigrid_solve<_1D>("mgenergy", mat, mesh, phi);
+  double error = test_MGEnergyMultigrid_error(phi, phi_ref);
+  printf(" sweeps = %i (none: %i) error = %10.3e \n", sweeps, sweeps_ref, error);
+  TEST(error < 1e-8);
+  TEST(sweeps < sweeps_ref / 2);
+  return 0;
+}
+
+// A region without removal in the last group falls back to a flat
+// spectrum and still gives a finite, effective correction.
+int test_MGEnergyMultigrid_no_removal(int argc, char *argv[])
+{
+  vec_dbl cm(3, 0.0); cm[1] = 10.0; cm[2] = 20.0;
+  vec_int fm(2, 5);
+  vec_int mat_map(4, 0); mat_map[3] = 1;
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mat_map));
+  Material::SP_material mat = test_MGEnergyMultigrid_material();
+
+  State::SP_state phi_ref, phi;
+  int sweeps_ref = test_MGEnergyMultigrid_solve<_2D>("none", mat, mesh, phi_ref);
+  int sweeps = test_MGEnergyMultigrid_solve<_2D>("mgenergy", mat, mesh, phi);
+  double error = test_MGEnergyMultigrid_error(phi, phi_ref);
+  printf(" sweeps = %i (none: %i) error = %10.3e \n", sweeps, sweeps_ref, error);
+  TEST(error < 1e-8);
+  TEST(sweeps < 0.6 * sweeps_ref);
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_MGEnergyMultigrid.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,125 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_MGTwoGrid.cc
+ *  @author Jeremy Roberts
+ *  @date   Jan 22, 2013
+ *  @brief  Test of two-grid acceleration of Gauss-Seidel upscatter.
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                     \
+        FUNC(test_MGTwoGrid_1D)
+
+#include "TestDriver.hh"
+#include "FixedSourceManager.hh"
+#include "MGSolverGS.hh"
+#include "Mesh1D.hh"
+#include "external_source/IsotropicSource.hh"
+#include "callow/utils/Initialization.hh"
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_material;
+using namespace detran_external_source;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+InputDB::SP_input test_MGTwoGrid_input(int two_grid, int number_groups)
+{
+  InputDB::SP_input inp(new InputDB());
+  inp->put<int>("number_groups",                  number_groups);
+  inp->put<string>("equation",                    "dd");
+  inp->put<string>("bc_west",                     "reflect");
+  inp->put<string>("bc_east",                     "vacuum");
+  inp->put<int>("quad_number_polar_octant",       8);
+  inp->put<string>("inner_solver",                "SI");
+  inp->put<double>("inner_tolerance",             1e-13);
+  inp->put<int>("inner_max_iters",                100000);
+  inp->put<int>("inner_print_level",              0);
+  inp->put<string>("outer_solver",                "GS");
+  inp->put<double>("outer_tolerance",             1e-12);
+  inp->put<int>("outer_max_iters",                10000);
+  inp->put<int>("outer_print_level",              0);
+  inp->put<int>("outer_two_grid",                 two_grid);
+  return inp;
+}
+
+// Graphite-like three group data with two strongly coupled thermal groups
+Material::SP_material test_MGTwoGrid_material()
+{
+  Material::SP_material mat(new Material(1, 3, "two_grid"));
+  mat->set_sigma_t(0, 0, 0.20);
+  mat->set_sigma_t(0, 1, 0.40);
+  mat->set_sigma_t(0, 2, 0.42);
+  mat->set_sigma_s(0, 0, 0, 0.18);
+  mat->set_sigma_s(0, 1, 0, 0.0195);
+  mat->set_sigma_s(0, 1, 1, 0.20);
+  mat->set_sigma_s(0, 2, 1, 0.18);
+  mat->set_sigma_s(0, 1, 2, 0.18);
+  mat->set_sigma_s(0, 2, 2, 0.22);
+  mat->finalize();
+  return mat;
+}
+
+int test_MGTwoGrid_1D(int argc, char *argv[])
+{
+  typedef FixedSourceManager<_1D> Manager_T;
+
+  Material::SP_material mat = test_MGTwoGrid_material();
+  int ng = mat->number_groups();
+
+  // A thick, reflected slab in which thermal upscatter converges slowly
+  vec_dbl cm(2, 0.0); cm[1] = 50.0;
+  vec_int fm(1, 50);
+  vec_int mat_map(1, 0);
+  Mesh::SP_mesh mesh(new Mesh1D(fm, cm, mat_map));
+
+  vec2_dbl spectra(1, vec_dbl(ng, 1.0));
+  vec_int  source_map(mesh->number_cells(), 0);
+
+  int sweeps[2];
+  Manager_T::SP_state state[2];
+  for (int two_grid = 0; two_grid < 2; ++two_grid)
+  {
+    Manager_T manager(test_MGTwoGrid_input(two_grid, ng), mat, mesh);
+    manager.setup();
+    manager.set_source(IsotropicSource::Create(ng, mesh, spectra,
+                                               source_map,
+                                               manager.quadrature()));
+    manager.set_solver();
+    manager.solve();
+    MGSolverGS<_1D>* solver =
+      dynamic_cast<MGSolverGS<_1D>*>(manager.solver().bp());
+    TEST(solver);
+    sweeps[two_grid] = solver->number_sweeps();
+    state[two_grid]  = manager.state();
+  }
+
+  // Same answer in fewer sweeps
+  for (int g = 0; g < ng; ++g)
+  {
+    for (int i = 0; i < mesh->number_cells(); ++i)
+    {
+      TEST(soft_equiv(state[1]->phi(g)[i], state[0]->phi(g)[i], 1e-8));
+    }
+  }
+  TEST(sweeps[1] < sweeps[0]);
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_MGTwoGrid.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,158 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_MOC3D.cc
+ *  @author Jeremy Roberts
+ *  @date   Feb 11, 2013
+ *  @brief  Test of 3D MOC on axially stacked tracks.
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                     \
+        FUNC(test_MOC3D_reflect)      \
+        FUNC(test_MOC3D_vacuum)
+
+#include "TestDriver.hh"
+#include "EigenvalueManager.hh"
+#include "Mesh2D.hh"
+#include "Mesh3D.hh"
+#include "callow/utils/Initialization.hh"
+#include "material/test/material_fixture.hh"
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_material;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+typedef SP<EigenvalueManager<_2D> > SP_manager_2d;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+InputDB::SP_input test_MOC3D_input(int dimension, string bc_z)
+{
+  InputDB::SP_input inp(new InputDB());
+  inp->put<int>("number_groups",                  2);
+  inp->put<int>("dimension",                      dimension);
+  inp->put<string>("equation",                    "scmoc");
+  inp->put<string>("bc_west",                     "reflect");
+  inp->put<string>("bc_east",                     "vacuum");
+  inp->put<string>("bc_south",                    "reflect");
+  inp->put<string>("bc_north",                    "vacuum");
+  inp->put<string>("bc_bottom",                   bc_z);
+  inp->put<string>("bc_top",                      bc_z);
+  inp->put<string>("quad_type",                   "uniform");
+  inp->put<int>("quad_number_polar_octant",       3);
+  inp->put<int>("quad_number_azimuth_octant",     4);
+  inp->put<int>("quad_uniform_number_space",      20);
+  inp->put<string>("inner_solver",                "SI");
+  inp->put<double>("inner_tolerance",             1e-10);
+  inp->put<int>("inner_max_iters",                10000);
+  inp->put<int>("inner_print_level",              0);
+  inp->put<string>("outer_solver",                "GS");
+  inp->put<double>("outer_tolerance",             1e-10);
+  inp->put<int>("outer_max_iters",                1000);
+  inp->put<int>("outer_print_level",              0);
+  inp->put<string>("eigen_solver",                "PI");
+  inp->put<double>("eigen_tolerance",             1e-8);
+  inp->put<int>("eigen_max_iters",                1000);
+  inp->put<int>("eigen_print_level",              0);
+  return inp;
+}
+
+// Fuel in the reflected corner surrounded by water
+SP_manager_2d test_MOC3D_2D()
+{
+  Material::SP_material mat = material_fixture_2g();
+  vec_dbl cm(3, 0.0); cm[1] = 10.0; cm[2] = 20.0;
+  vec_int fm(2, 3);
+  vec_int mat_map(4, 0); mat_map[0] = 1;
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mat_map));
+  SP_manager_2d manager(new EigenvalueManager<_2D>(
+    test_MOC3D_input(2, "reflect"), mat, mesh));
+  manager->solve();
+  return manager;
+}
+
+// The same problem extruded in z
+double test_MOC3D_keff(string bc_z, Mesh::SP_mesh &mesh,
+                       State::SP_state &state)
+{
+  Material::SP_material mat = material_fixture_2g();
+  vec_dbl cm(3, 0.0); cm[1] = 10.0; cm[2] = 20.0;
+  vec_int fm(2, 3);
+  vec_dbl zcm(2, 0.0); zcm[1] = 20.0;
+  vec_int zfm(1, 4);
+  vec_int mat_map(4, 0); mat_map[0] = 1;
+  mesh = new Mesh3D(fm, fm, zfm, cm, cm, zcm, mat_map);
+  EigenvalueManager<_3D> manager(test_MOC3D_input(3, bc_z), mat, mesh);
+  if (!manager.solve()) return 0.0;
+  state = manager.state();
+  return state->eigenvalue();
+}
+
+int test_MOC3D_reflect(int argc, char *argv[])
+{
+  // 2D reference
+  SP_manager_2d manager_2d = test_MOC3D_2D();
+  double keff_2d = manager_2d->state()->eigenvalue();
+  Mesh::SP_mesh mesh_2d = manager_2d->mesh();
+
+  // With reflected top and bottom, the 3D problem is the 2D one.
+  Mesh::SP_mesh mesh;
+  State::SP_state state;
+  double keff = test_MOC3D_keff("reflect", mesh, state);
+  TEST(soft_equiv(keff, keff_2d, 1e-6));
+  int n = mesh_2d->number_cells();
+  for (int g = 0; g < 2; ++g)
+  {
+    for (int k = 0; k < 4; ++k)
+    {
+      for (int i = 0; i < n; ++i)
+      {
+        double phi_2d = manager_2d->state()->phi(g)[i];
+        double phi    = state->phi(g)[i + k * n];
+        TEST(soft_equiv(phi / state->phi(g)[0],
+                        phi_2d / manager_2d->state()->phi(g)[0], 1e-5));
+      }
+    }
+  }
+  return 0;
+}
+
+int test_MOC3D_vacuum(int argc, char *argv[])
+{
+  Mesh::SP_mesh mesh;
+  State::SP_state state;
+  double keff_2d = test_MOC3D_2D()->state()->eigenvalue();
+  double keff = test_MOC3D_keff("vacuum", mesh, state);
+
+  // Leakage through the top and bottom reduces keff, and the flux is
+  // symmetric about the midplane.
+  TEST(keff < keff_2d);
+  int n = mesh->number_cells_x() * mesh->number_cells_y();
+  for (int g = 0; g < 2; ++g)
+  {
+    for (int i = 0; i < n; ++i)
+    {
+      TEST(soft_equiv(state->phi(g)[i],     state->phi(g)[i + 3 * n], 1e-6));
+      TEST(soft_equiv(state->phi(g)[i + n], state->phi(g)[i + 2 * n], 1e-6));
+      TEST(state->phi(g)[i + n] > state->phi(g)[i]);
+    }
+  }
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_MOC3D.cc
+//---------------------------------------------------------------------------//
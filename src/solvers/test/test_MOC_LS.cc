@@ -0,0 +1,129 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_MOC_LS.cc
+ *  @author Jeremy Roberts
+ *  @date   Feb 18, 2013
+ *  @brief  Test of linear source MOC.
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                     \
+        FUNC(test_MOC_LS_uniform)     \
+        FUNC(test_MOC_LS_coarse)      \
+        FUNC(test_MOC_LS_team)
+
+#include "TestDriver.hh"
+#include "EigenvalueManager.hh"
+#include "Mesh2D.hh"
+#include "callow/utils/Initialization.hh"
+#include "material/test/material_fixture.hh"
+#include <cmath>
+#ifdef DETRAN_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_material;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+// Fuel in the reflected corner surrounded by water, with fm fine
+// cells per coarse cell, or reflected fuel if homogeneous.
+double test_MOC_LS_keff(string equation, int fm, bool homogeneous = false)
+{
+  string bc = homogeneous ? "reflect" : "vacuum";
+  InputDB::SP_input inp(new InputDB());
+  inp->put<int>("number_groups",                  2);
+  inp->put<int>("dimension",                      2);
+  inp->put<string>("equation",                    equation);
+  inp->put<string>("bc_west",                     "reflect");
+  inp->put<string>("bc_east",                     bc);
+  inp->put<string>("bc_south",                    "reflect");
+  inp->put<string>("bc_north",                    bc);
+  inp->put<string>("quad_type",                   "uniform");
+  inp->put<int>("quad_number_polar_octant",       2);
+  inp->put<int>("quad_number_azimuth_octant",     4);
+  inp->put<int>("quad_uniform_number_space",      50);
+  inp->put<string>("inner_solver",                "SI");
+  inp->put<double>("inner_tolerance",             1e-9);
+  inp->put<int>("inner_max_iters",                10000);
+  inp->put<int>("inner_print_level",              0);
+  inp->put<string>("outer_solver",                "GS");
+  inp->put<double>("outer_tolerance",             1e-9);
+  inp->put<int>("outer_max_iters",                1000);
+  inp->put<int>("outer_print_level",              0);
+  inp->put<string>("eigen_solver",                "PI");
+  inp->put<double>("eigen_tolerance",             1e-8);
+  inp->put<int>("eigen_max_iters",                1000);
+  inp->put<int>("eigen_print_level",              0);
+  Material::SP_material mat = material_fixture_2g();
+  vec_dbl cm(3, 0.0); cm[1] = 10.0; cm[2] = 20.0;
+  vec_int fm_v(2, fm);
+  vec_int mat_map(4, homogeneous ? 1 : 0); mat_map[0] = 1;
+  Mesh::SP_mesh mesh(new Mesh2D(fm_v, fm_v, cm, cm, mat_map));
+  EigenvalueManager<_2D> manager(inp, mat, mesh);
+  if (!manager.solve()) return 0.0;
+  return manager.state()->eigenvalue();
+}
+
+// In an infinite medium, the flux is flat and has no moments, so the
+// linear source reduces to the flat source.
+int test_MOC_LS_uniform(int argc, char *argv[])
+{
+  double keff_sc = test_MOC_LS_keff("scmoc", 2, true);
+  double keff_ls = test_MOC_LS_keff("lsmoc", 2, true);
+  printf(" keff: sc = %12.9f ls = %12.9f \n", keff_sc, keff_ls);
+  TEST(soft_equiv(keff_ls, keff_sc, 1e-7));
+  return 0;
+}
+
+// On a coarse mesh, the linear source is much closer to the fine mesh
+// reference than the flat source.
+int test_MOC_LS_coarse(int argc, char *argv[])
+{
+  double keff_ref = test_MOC_LS_keff("scmoc", 20);
+  double keff_sc  = test_MOC_LS_keff("scmoc", 2);
+  double keff_ls  = test_MOC_LS_keff("lsmoc", 2);
+  printf(" keff: ref = %12.9f sc = %12.9f ls = %12.9f \n",
+         keff_ref, keff_sc, keff_ls);
+  TEST(std::abs(keff_ls - keff_ref) < 0.25 * std::abs(keff_sc - keff_ref));
+  return 0;
+}
+
+// A sweep nested in a parallel region gets a team of one thread, which
+// must still sweep the tracks scheduled for all threads.
+int test_MOC_LS_team(int argc, char *argv[])
+{
+#ifdef DETRAN_ENABLE_OPENMP
+  omp_set_num_threads(4);
+  omp_set_max_active_levels(1);
+#endif
+  double keff_ref = test_MOC_LS_keff("lsmoc", 4);
+  double keff = 0.0;
+  #pragma omp parallel num_threads(2)
+  {
+    #pragma omp single
+    keff = test_MOC_LS_keff("lsmoc", 4);
+  }
+  printf(" keff: ref = %12.9f nested = %12.9f \n", keff_ref, keff);
+  TEST(soft_equiv(keff, keff_ref, 1e-10));
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_MOC_LS.cc
+//---------------------------------------------------------------------------//
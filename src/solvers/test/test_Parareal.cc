@@ -0,0 +1,250 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_Parareal.cc
+ *  @author robertsj
+ *  @date   Mar 8, 2013
+ *  @brief  Test of Parareal
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                       \
+        FUNC(test_Parareal_interval)    \
+        FUNC(test_Parareal)             \
+        FUNC(test_Parareal_threads)
+
+#include "TestDriver.hh"
+#include "Parareal.hh"
+#include "EigenvalueManager.hh"
+#include "Mesh1D.hh"
+#include "callow/utils/Initialization.hh"
+#include <cmath>
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+typedef TimeStepper<_1D>  TS_1D;
+typedef Parareal<_1D>     PR_1D;
+
+/// One-group material whose absorption in the left half of the slab
+/// is ramped down over the first half second.
+class RampMaterial: public TimeDependentMaterial
+{
+public:
+  RampMaterial(int number_cells)
+    : TimeDependentMaterial(number_cells, 1, 1, "RampMaterial")
+  {
+    update_impl();
+  }
+  void update_impl()
+  {
+    double f = std::min(time(), 0.5) / 0.5;
+    for (int m = 0; m < number_materials(); ++m)
+    {
+      double sa = 0.1;
+      if (m < number_materials() / 2) sa -= 5.0e-4 * f;
+      set_sigma_t(m, 0,   sa);
+      set_diff_coef(m, 0, 1.0);
+      set_sigma_f(m, 0,   0.11);
+      set_chi(m, 0,       1.0);
+      set_beta(m, 0,      0.0075);
+      set_chi_d(m, 0, 0,  1.0);
+    }
+    set_lambda(0,   0.08);
+    set_velocity(0, 1.0e5);
+    finalize();
+  }
+};
+
+InputDB::SP_input test_Parareal_input(double dt, int scheme)
+{
+  InputDB::SP_input inp(new InputDB("parareal test"));
+  inp->put<int>("dimension",                1);
+  inp->put<int>("number_groups",            1);
+  inp->put<std::string>("equation",         "diffusion");
+  inp->put<std::string>("bc_west",          "reflect");
+  inp->put<std::string>("bc_east",          "vacuum");
+  inp->put<double>("ts_final_time",         1.0);
+  inp->put<double>("ts_step_size",          dt);
+  inp->put<int>("ts_scheme",                scheme);
+  inp->put<int>("ts_monitor_level",         0);
+  inp->put<double>("eigen_tolerance",       1e-12);
+  inp->put<int>("eigen_max_iters",          100000);
+  inp->put<double>("outer_tolerance",       1e-12);
+  inp->put<double>("inner_tolerance",       1e-12);
+  inp->put<int>("outer_print_level",        0);
+  inp->put<int>("inner_print_level",        0);
+  inp->put<int>("eigen_print_level",        0);
+  return inp;
+}
+
+Mesh::SP_mesh test_Parareal_mesh()
+{
+  vec_dbl xfme(21, 0.0);
+  vec_int mat_map(20, 0);
+  for (int i = 0; i < 20; ++i)
+  {
+    xfme[i + 1] = 2.5 * (i + 1);
+    mat_map[i]  = i;
+  }
+  Mesh::SP_mesh mesh(new Mesh1D(xfme, mat_map));
+  return mesh;
+}
+
+/// Critical initial state of the material
+State::SP_state test_Parareal_ic(InputDB::SP_input     inp,
+                                 TS_1D::SP_material    mat,
+                                 Mesh::SP_mesh         mesh)
+{
+  EigenvalueManager<_1D> manager(inp, mat, mesh);
+  manager.solve();
+  mat->set_eigenvalue(manager.state()->eigenvalue());
+  return manager.state();
+}
+
+double test_Parareal_error(State::SP_state a, State::SP_state b)
+{
+  double norm = 0.0, error = 0.0;
+  for (int i = 0; i < a->phi(0).size(); ++i)
+  {
+    error = std::max(error, std::abs(a->phi(0)[i] - b->phi(0)[i]));
+    norm  = std::max(norm,  std::abs(b->phi(0)[i]));
+  }
+  return error / norm;
+}
+
+// Solving two intervals in turn, passing the state and precursors,
+// reproduces a solve over the whole transient with first order steps.
+int test_Parareal_interval(int argc, char *argv[])
+{
+  InputDB::SP_input inp = test_Parareal_input(0.05, TS_1D::BDF1);
+  // The two runs solve the same steps, so they should agree to rounding.
+  // The default diffusion solver tolerances (1e-8) would leave solver
+  // noise of the order of the bound below.
+  InputDB::SP_input db(new InputDB("outer_solver_db"));
+  db->put<double>("linear_solver_atol",  1e-14);
+  db->put<double>("linear_solver_rtol",  1e-14);
+  inp->put<InputDB::SP_input>("outer_solver_db", db);
+  Mesh::SP_mesh mesh = test_Parareal_mesh();
+  TS_1D::SP_material mat(new RampMaterial(20));
+  State::SP_state ic = test_Parareal_ic(inp, mat, mesh);
+
+  TS_1D stepper(inp, mat, mesh, true);
+  State::SP_state phi(new State(*ic));
+  stepper.solve(phi);
+  State::SP_state ref(new State(*stepper.state()));
+
+  phi = new State(*ic);
+  stepper.solve(phi, Precursors::SP_precursors(), 0.0, 0.4);
+  Precursors::SP_precursors C(new Precursors(*stepper.precursor()));
+  phi = new State(*stepper.state());
+  stepper.solve(phi, C, 0.4, 1.0);
+
+  double error = test_Parareal_error(stepper.state(), ref);
+  printf(" error = %12.4e \n", error);
+  TEST(error < 1e-10);
+  return 0;
+}
+
+// A fine propagator with short second order steps and a coarse one
+// with long first order steps.  Parareal converges to the fine
+// solution restarted at each slice in fewer iterations than slices.
+int test_Parareal(int argc, char *argv[])
+{
+  InputDB::SP_input fine   = test_Parareal_input(0.01, TS_1D::BDF2);
+  InputDB::SP_input coarse = test_Parareal_input(0.125, TS_1D::BDF1);
+  fine->put<int>("pr_number_slices", 8);
+  fine->put<double>("pr_tolerance",  1e-6);
+  fine->put<int>("pr_print_level",   1);
+  Mesh::SP_mesh mesh = test_Parareal_mesh();
+
+  PR_1D::vec_material materials(2);
+  materials[0] = new RampMaterial(20);
+  materials[1] = new RampMaterial(20);
+  State::SP_state ic = test_Parareal_ic(fine, materials[0], mesh);
+  materials[1]->set_eigenvalue(ic->eigenvalue());
+
+  PR_1D parareal(fine, coarse, materials, mesh, true);
+  TEST(parareal.number_slices() == 8);
+  TEST(parareal.solve(ic));
+  printf(" iterations = %i \n", (int) parareal.number_iterations());
+  TEST(parareal.number_iterations() < 8);
+  TEST(parareal.residual_norms().size() == parareal.number_iterations());
+  for (int k = 1; k < parareal.number_iterations(); ++k)
+    TEST(parareal.residual_norms()[k] < parareal.residual_norms()[k - 1]);
+
+  // Serial reference, restarting the fine scheme at each slice
+  TS_1D::SP_material mat(new RampMaterial(20));
+  mat->set_eigenvalue(ic->eigenvalue());
+  TS_1D stepper(fine, mat, mesh, true);
+  State::SP_state phi(new State(*ic));
+  Precursors::SP_precursors C;
+  for (int n = 0; n < 8; ++n)
+  {
+    stepper.solve(phi, C, 0.125 * n, 0.125 * (n + 1));
+    phi = new State(*stepper.state());
+    C   = new Precursors(*stepper.precursor());
+  }
+  double error = test_Parareal_error(parareal.state(), phi);
+  printf(" error = %12.4e \n", error);
+  TEST(error < 1e-5);
+
+  // The power has risen, and the coarse solution alone is less accurate.
+  TEST(parareal.state()->phi(0)[0] > 1.01 * ic->phi(0)[0]);
+  phi = new State(*ic);
+  parareal.coarse()->solve(phi);
+  double coarse_error = test_Parareal_error(parareal.coarse()->state(),
+                                            parareal.state());
+  printf(" coarse error = %12.4e \n", coarse_error);
+  TEST(coarse_error > error);
+  return 0;
+}
+
+// The number of materials sets the number of fine solves run at once.
+// With OpenMP, four concurrent fine solves must give the same iterates
+// as one at a time.
+int test_Parareal_threads(int argc, char *argv[])
+{
+  InputDB::SP_input fine   = test_Parareal_input(0.01, TS_1D::BDF2);
+  InputDB::SP_input coarse = test_Parareal_input(0.125, TS_1D::BDF1);
+  fine->put<int>("pr_number_slices", 8);
+  fine->put<double>("pr_tolerance",  1e-6);
+  Mesh::SP_mesh mesh = test_Parareal_mesh();
+
+  PR_1D::vec_material materials(4);
+  for (int i = 0; i < 4; ++i)
+    materials[i] = new RampMaterial(20);
+  State::SP_state ic = test_Parareal_ic(fine, materials[0], mesh);
+  for (int i = 1; i < 4; ++i)
+    materials[i]->set_eigenvalue(ic->eigenvalue());
+
+  PR_1D::vec_material material(1, materials[0]);
+  PR_1D serial(fine, coarse, material, mesh, true);
+  TEST(serial.solve(ic));
+  PR_1D parareal(fine, coarse, materials, mesh, true);
+  TEST(parareal.solve(ic));
+
+  TEST(parareal.number_iterations() == serial.number_iterations());
+  double error = test_Parareal_error(parareal.state(), serial.state());
+  printf(" error = %12.4e \n", error);
+  TEST(error < 1e-12);
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_Parareal.cc
+//---------------------------------------------------------------------------//
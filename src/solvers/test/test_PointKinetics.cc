@@ -0,0 +1,186 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_PointKinetics.cc
+ *  @author robertsj
+ *  @date   Mar 11, 2013
+ *  @brief  Test of PointKinetics
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                           \
+        FUNC(test_PointKinetics_step)       \
+        FUNC(test_PointKinetics_stiff)      \
+        FUNC(test_PointKinetics_state)
+
+#include "TestDriver.hh"
+#include "PointKinetics.hh"
+#include "EigenvalueManager.hh"
+#include "Mesh1D.hh"
+#include "callow/utils/Initialization.hh"
+#include <cmath>
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+/// Exact amplitude after a step insertion with one precursor group
+double test_PointKinetics_exact(double Lambda, double beta, double lambda,
+                                double rho, double t)
+{
+  // Eigenvalues of the 2x2 system
+  double T = (rho - beta) / Lambda - lambda;
+  double D = -lambda * rho / Lambda;
+  double s = std::sqrt(0.25 * T * T - D);
+  double w_1 = 0.5 * T + s, w_2 = 0.5 * T - s;
+  double c_1 = (rho / Lambda - w_2) / (w_1 - w_2);
+  return c_1 * std::exp(w_1 * t) + (1.0 - c_1) * std::exp(w_2 * t);
+}
+
+// A step insertion with one precursor group converges at second order.
+int test_PointKinetics_step(int argc, char *argv[])
+{
+  double Lambda = 1.0e-4, beta = 0.0065, lambda = 0.08, rho = 0.003;
+  PointKinetics pk(Lambda, vec_dbl(1, beta), vec_dbl(1, lambda));
+  TEST(soft_equiv(pk.beta_eff(), beta));
+  pk.set_reactivity(rho);
+
+  double ref = test_PointKinetics_exact(Lambda, beta, lambda, rho, 1.0);
+  pk.solve(1.0, 500);
+  double error_a = std::abs(pk.amplitude() - ref) / ref;
+  pk.solve(1.0, 1000);
+  double error_b = std::abs(pk.amplitude() - ref) / ref;
+  printf(" p = %12.8f ref = %12.8f errors = %10.3e %10.3e \n",
+         pk.amplitude(), ref, error_a, error_b);
+  TEST(pk.amplitudes().size() == 1001);
+  TEST(error_b < 1e-5);
+  TEST(error_a / error_b > 3.5);
+  TEST(error_a / error_b < 4.5);
+
+  // The precursors lag the amplitude.
+  TEST(pk.precursors()[0] < ref * beta / (Lambda * lambda));
+  return 0;
+}
+
+// Steps far longer than the prompt time constant remain accurate
+// after the prompt jump, and batch solves match single ones.
+int test_PointKinetics_stiff(int argc, char *argv[])
+{
+  double Lambda = 1.0e-6, beta = 0.0065, lambda = 0.08;
+  PointKinetics pk(Lambda, vec_dbl(1, beta), vec_dbl(1, lambda));
+
+  vec2_dbl times(3, vec_dbl(1, 0.0)), rho(3, vec_dbl(1, 0.0));
+  rho[0][0] = -0.002; rho[1][0] = 0.001; rho[2][0] = 0.003;
+  vec2_dbl p = pk.solve(times, rho, 2.0, 20);
+  TEST(p.size() == 3);
+  for (int i = 0; i < 3; ++i)
+  {
+    double ref = test_PointKinetics_exact(Lambda, beta, lambda, rho[i][0], 2.0);
+    printf(" rho = %8.4f p = %12.8f ref = %12.8f \n", rho[i][0], p[i][20], ref);
+    TEST(std::abs(p[i][20] - ref) < 0.01 * ref);
+    pk.set_reactivity(rho[i][0]);
+    pk.solve(2.0, 20);
+    TEST(soft_equiv(pk.amplitude(), p[i][20]));
+    if (i > 0) TEST(p[i][20] > p[i - 1][20]);
+  }
+
+  // A ramp to the same reactivity lags the step and keeps rising.
+  vec_dbl t_ramp(2, 0.0), rho_ramp(2, 0.003);
+  t_ramp[1] = 0.5; rho_ramp[0] = 0.0;
+  pk.set_reactivity(t_ramp, rho_ramp);
+  pk.solve(2.0, 200);
+  const vec_dbl &a = pk.amplitudes();
+  TEST(a[50] < test_PointKinetics_exact(Lambda, beta, lambda, 0.003, 0.5));
+  TEST(a[200] > a[100]);
+  return 0;
+}
+
+/// One-group slab with delayed neutrons
+KineticsMaterial::SP_material test_PointKinetics_material(double sigma_t)
+{
+  KineticsMaterial::SP_material mat(new KineticsMaterial(1, 1, 1));
+  mat->set_sigma_t(0, 0,   sigma_t);
+  mat->set_diff_coef(0, 0, 1.0);
+  mat->set_sigma_f(0, 0,   0.11);
+  mat->set_chi(0, 0,       1.0);
+  mat->set_beta(0, 0,      0.0075);
+  mat->set_chi_d(0, 0, 0,  1.0);
+  mat->set_lambda(0,       0.08);
+  mat->set_velocity(0,     1.0e5);
+  mat->finalize();
+  return mat;
+}
+
+// Parameters and reactivity edits from a steady state
+int test_PointKinetics_state(int argc, char *argv[])
+{
+  InputDB::SP_input inp(new InputDB("point kinetics test"));
+  inp->put<int>("dimension",                1);
+  inp->put<int>("number_groups",            1);
+  inp->put<std::string>("equation",         "diffusion");
+  inp->put<std::string>("bc_west",          "reflect");
+  inp->put<std::string>("bc_east",          "vacuum");
+  inp->put<double>("eigen_tolerance",       1e-12);
+  inp->put<int>("eigen_max_iters",          100000);
+  inp->put<int>("eigen_print_level",        0);
+  inp->put<int>("outer_print_level",        0);
+  inp->put<int>("inner_print_level",        0);
+  vec_dbl xfme(21, 0.0);
+  vec_int mat_map(20, 0);
+  for (int i = 0; i < 20; ++i)
+    xfme[i + 1] = 2.5 * (i + 1);
+  Mesh::SP_mesh mesh(new Mesh1D(xfme, mat_map));
+
+  KineticsMaterial::SP_material mat = test_PointKinetics_material(0.1);
+  EigenvalueManager<_1D> manager(inp, mat, mesh);
+  manager.solve();
+  State::SP_state phi = manager.state();
+  double k_0 = phi->eigenvalue();
+
+  // One-group diffusion is self-adjoint.
+  PointKinetics pk(mat, mesh, phi, phi);
+  TEST(soft_equiv(pk.beta_eff(), 0.0075));
+  double num = 0.0, den = 0.0;
+  for (int i = 0; i < 20; ++i)
+  {
+    num += phi->phi(0)[i] * phi->phi(0)[i] / 1.0e5;
+    den += phi->phi(0)[i] * 0.11 * phi->phi(0)[i] / k_0;
+  }
+  TEST(soft_equiv(pk.generation_time(), num / den));
+
+  // The first order reactivity of a small perturbation is close to
+  // that of the eigenvalues relative to the critical steady state.
+  KineticsMaterial::SP_material mat_1 = test_PointKinetics_material(0.0995);
+  EigenvalueManager<_1D> manager_1(inp, mat_1, mesh);
+  manager_1.solve();
+  double k_1 = manager_1.state()->eigenvalue();
+  double rho = pk.reactivity(mat_1);
+  double ref = 1.0 - k_0 / k_1;
+  printf(" rho = %12.8f ref = %12.8f \n", rho, ref);
+  TEST(rho > 0.0);
+  TEST(std::abs(rho - ref) < 0.02 * ref);
+  TEST(std::abs(pk.reactivity(mat)) < 1e-14);
+
+  // Supercritical but not prompt critical
+  pk.set_reactivity(rho);
+  pk.solve(1.0, 100);
+  TEST(pk.amplitude() > 1.0);
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_PointKinetics.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,219 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_ThermalFeedback.cc
+ *  @author robertsj
+ *  @date   Mar 4, 2013
+ *  @brief  Test of ThermalFeedback
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                               \
+        FUNC(test_ThermalFeedback_steady)       \
+        FUNC(test_ThermalFeedback_transient)
+
+#include "TestDriver.hh"
+#include "ThermalFeedback.hh"
+#include "EigenvalueManager.hh"
+#include "Mesh1D.hh"
+#include "callow/utils/Initialization.hh"
+#include <cmath>
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+typedef ThermalFeedback<_1D> TH_1D;
+
+/// One-group material for each cell with Doppler and coolant density
+/// feedback relative to the initial temperatures and densities.
+class ThermalMaterial: public TimeDependentMaterial
+{
+public:
+  ThermalMaterial(int number_cells, double perturbation, bool feedback)
+    : TimeDependentMaterial(number_cells, 1, 1, "ThermalMaterial")
+    , d_perturbation(perturbation)
+    , d_feedback(feedback)
+  {
+    update_impl();
+  }
+  void set_physics(MultiPhysics::SP_multiphysics physics)
+  {
+    d_physics = physics;
+    d_T_f_0 = d_physics->variable(TH_1D::FUEL_TEMPERATURE);
+    d_rho_0 = d_physics->variable(TH_1D::COOLANT_DENSITY);
+  }
+  void update_impl()
+  {
+    for (int m = 0; m < number_materials(); ++m)
+    {
+      double sa = 0.1;
+      if (d_physics && d_feedback)
+      {
+        const vec_dbl &T_f = d_physics->variable(TH_1D::FUEL_TEMPERATURE);
+        const vec_dbl &rho = d_physics->variable(TH_1D::COOLANT_DENSITY);
+        sa += 2.0e-3 * (std::sqrt(T_f[m]) - std::sqrt(d_T_f_0[m]));
+        sa += 5.0e-2 * (d_rho_0[m] - rho[m]);
+      }
+      if (m < number_materials() / 2 && time() > 0.0) sa -= d_perturbation;
+      set_sigma_t(m, 0,   sa);
+      set_diff_coef(m, 0, 1.0);
+      set_sigma_f(m, 0,   0.11);
+      set_chi(m, 0,       1.0);
+      set_beta(m, 0,      0.0075);
+      set_chi_d(m, 0, 0,  1.0);
+    }
+    set_lambda(0,   0.08);
+    set_velocity(0, 1.0e5);
+    finalize();
+  }
+  MultiPhysics::SP_multiphysics d_physics;
+  vec_dbl d_T_f_0;
+  vec_dbl d_rho_0;
+  double d_perturbation;
+  bool d_feedback;
+};
+
+InputDB::SP_input test_ThermalFeedback_input(double dt, double final_time)
+{
+  InputDB::SP_input inp(new InputDB("thermal feedback test"));
+  inp->put<int>("dimension",                1);
+  inp->put<int>("number_groups",            1);
+  inp->put<std::string>("equation",         "diffusion");
+  inp->put<std::string>("bc_west",          "reflect");
+  inp->put<std::string>("bc_east",          "vacuum");
+  inp->put<double>("ts_final_time",         final_time);
+  inp->put<double>("ts_step_size",          dt);
+  inp->put<int>("ts_scheme",                TimeStepper<_1D>::BDF2);
+  inp->put<int>("ts_no_extrapolation",      1);
+  inp->put<int>("ts_max_iters",             20);
+  inp->put<double>("ts_tolerance",          1e-10);
+  inp->put<int>("ts_monitor_level",         0);
+  inp->put<double>("eigen_tolerance",       1e-12);
+  inp->put<int>("eigen_max_iters",          100000);
+  inp->put<double>("outer_tolerance",       1e-12);
+  inp->put<double>("inner_tolerance",       1e-12);
+  inp->put<int>("outer_print_level",        0);
+  inp->put<int>("inner_print_level",        0);
+  inp->put<int>("eigen_print_level",        0);
+  inp->put<double>("th_power_density",      100.0);
+  return inp;
+}
+
+/// Run a transient of a 50 cm slab with the coolant flowing along x,
+/// returning the feedback at the final time.
+TH_1D::SP_feedback
+test_ThermalFeedback_run(double dt, double final_time, double perturbation,
+                         bool feedback, double &power, int depth = 0)
+{
+  InputDB::SP_input inp = test_ThermalFeedback_input(dt, final_time);
+  inp->put<int>("ts_anderson_depth", depth);
+  vec_dbl xfme(21, 0.0);
+  vec_int mat_map(20, 0);
+  for (int i = 0; i < 20; ++i)
+  {
+    xfme[i + 1] = 2.5 * (i + 1);
+    mat_map[i]  = i;
+  }
+  Mesh::SP_mesh mesh(new Mesh1D(xfme, mat_map));
+
+  detran_utilities::SP<ThermalMaterial>
+    mat(new ThermalMaterial(20, perturbation, feedback));
+  TimeStepper<_1D>::SP_material tdmat(mat);
+  EigenvalueManager<_1D> manager(inp, tdmat, mesh);
+  manager.solve();
+  State::SP_state ic = manager.state();
+  mat->set_eigenvalue(ic->eigenvalue());
+
+  TH_1D::SP_feedback th = TH_1D::Create(inp, mesh, tdmat);
+  th->initialize(ic);
+  mat->set_physics(th->physics());
+
+  TimeStepper<_1D> stepper(inp, tdmat, mesh, true);
+  th->set_stepper(stepper);
+  stepper.solve(ic);
+
+  power = 0.0;
+  for (int i = 0; i < 20; ++i)
+    power += th->power()[i] / 20.0;
+  return th;
+}
+
+// Without a perturbation, the initial steady state is kept, and
+// the coolant carries the power out of the channel.
+int test_ThermalFeedback_steady(int argc, char *argv[])
+{
+  double power;
+  TH_1D::SP_feedback th =
+    test_ThermalFeedback_run(0.1, 1.0, 0.0, true, power);
+  printf(" power = %12.8f \n", power);
+  TEST(soft_equiv(power, 100.0, 1e-5));
+
+  const vec_dbl &T_f = th->physics()->variable(TH_1D::FUEL_TEMPERATURE);
+  const vec_dbl &T_c = th->physics()->variable(TH_1D::COOLANT_TEMPERATURE);
+  const vec_dbl &rho = th->physics()->variable(TH_1D::COOLANT_DENSITY);
+  double T_in = 565.0;
+  for (int i = 0; i < 20; ++i)
+  {
+    double q = th->power()[i];
+    double T = T_in + q * 2.5 / (4.0 * 300.0);
+    TEST(soft_equiv(T_c[i], T, 1e-5));
+    TEST(soft_equiv(T_f[i], T + q / 0.5, 1e-5));
+    TEST(soft_equiv(rho[i], th->density(T), 1e-5));
+    TEST(T_f[i] > T_c[i]);
+    T_in = T;
+  }
+  // Total power per unit area leaves with the coolant.
+  TEST(soft_equiv(T_c[19], 565.0 + 100.0 * 50.0 / (4.0 * 300.0), 1e-5));
+  return 0;
+}
+
+// A positive reactivity insertion heats the fuel and coolant, and the
+// feedback limits the power.  Steps much longer than the coolant transit
+// time through a cell (about 0.008 s) are stable, though the coupling
+// with the flux then needs Anderson acceleration to converge.
+int test_ThermalFeedback_transient(int argc, char *argv[])
+{
+  double power, power_nofb, power_coarse, power_0;
+  TH_1D::SP_feedback th_0 =
+    test_ThermalFeedback_run(0.1, 0.1, 0.0, true, power_0);
+  TH_1D::SP_feedback th =
+    test_ThermalFeedback_run(0.05, 4.0, 5e-4, true, power);
+  test_ThermalFeedback_run(0.05, 4.0, 5e-4, false, power_nofb);
+  test_ThermalFeedback_run(0.5, 4.0, 5e-4, true, power_coarse, 3);
+  printf(" power: feedback = %12.8f no feedback = %12.8f coarse = %12.8f \n",
+         power, power_nofb, power_coarse);
+  TEST(power > 100.0);
+  TEST(power < power_nofb);
+  TEST(std::abs(power_coarse - power) < 0.01 * power);
+
+  const vec_dbl &T_f_0 = th_0->physics()->variable(TH_1D::FUEL_TEMPERATURE);
+  const vec_dbl &T_c_0 = th_0->physics()->variable(TH_1D::COOLANT_TEMPERATURE);
+  const vec_dbl &T_f = th->physics()->variable(TH_1D::FUEL_TEMPERATURE);
+  const vec_dbl &T_c = th->physics()->variable(TH_1D::COOLANT_TEMPERATURE);
+  const vec_dbl &rho = th->physics()->variable(TH_1D::COOLANT_DENSITY);
+  for (int i = 0; i < 20; ++i)
+  {
+    TEST(T_f[i] > T_f_0[i]);
+    TEST(T_c[i] > T_c_0[i]);
+    TEST(rho[i] < th->density(T_c_0[i]));
+  }
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_ThermalFeedback.cc
+//---------------------------------------------------------------------------//
@@ -10,10 +10,15 @@
 // LIST OF TEST FUNCTIONS
 #define TEST_LIST                   \
         FUNC(test_TimeStepper)      \
-        FUNC(test_BDF_Steps)
+        FUNC(test_BDF_Steps)        \
+        FUNC(test_Adaptive)         \
+        FUNC(test_QuasiStatic)      \
+        FUNC(test_Omega)            \
+        FUNC(test_Anderson)
 
 #include "TestDriver.hh"
 #include "TimeStepper.hh"
+#include "EigenvalueManager.hh"
 #include "Mesh1D.hh"
 #include "external_source/ConstantSource.hh"
 #include "callow/utils/Initialization.hh"
@@ -22,6 +27,8 @@
 #include "boundary/BoundarySN.hh"
 #include "kinetics/LinearExternalSource.hh"
 #include "kinetics/LinearMaterial.hh"
+#include "kinetics/MultiPhysics.hh"
+#include "kinetics/PulsedExternalSource.hh"
 //
 #include "angle/test/quadrature_fixture.hh"
 #include "geometry/test/mesh_fixture.hh"
@@ -314,6 +321,343 @@ int test_BDF_Steps(int argc, char *argv[])
   return 0;
 }
 
+/// Flux at the final time of a slab driven by a short pulse
+double test_Adaptive_flux(int scheme, double dt, int adaptive, int &steps)
+{
+  typedef TimeStepper<_1D> TS_1D;
+
+  InputDB::SP_input inp(new InputDB("adaptive time stepper test"));
+  inp->put<int>("dimension",                1);
+  inp->put<int>("number_groups",            1);
+  inp->put<std::string>("equation",         "diffusion");
+  inp->put<std::string>("bc_west",          "reflect");
+  inp->put<std::string>("bc_east",          "reflect");
+  inp->put<double>("ts_final_time",         2.1);
+  inp->put<double>("ts_step_size",          dt);
+  inp->put<int>("ts_max_steps",             100000);
+  inp->put<int>("ts_scheme",                scheme);
+  inp->put<int>("ts_monitor_level",         0);
+  inp->put<int>("ts_adaptive",              adaptive);
+  inp->put<double>("ts_rel_tol",            1e-4);
+  inp->put<double>("ts_abs_tol",            1e-8);
+  inp->put<int>("outer_print_level",        0);
+  inp->put<int>("inner_print_level",        0);
+
+  KineticsMaterial::SP_material
+    kinmat(new KineticsMaterial(1, 1, 0, "base material"));
+  kinmat->set_sigma_t(0, 0,    1.0);
+  kinmat->set_diff_coef(0, 0,  1.0/3.0);
+  kinmat->set_velocity(0,      1.0);
+  kinmat->finalize();
+  LinearMaterial::vec_material materials(1, kinmat);
+  LinearMaterial::vec_dbl      times(1, 0.0);
+  LinearMaterial::SP_material  linmat(new LinearMaterial(times, materials));
+
+  vec_int fm(1, 3);
+  vec_dbl cm(2, 0.0); cm[1] = 1.0;
+  vec_int mt(1, 0);
+  Mesh1D::SP_mesh mesh(new Mesh1D(fm, cm, mt));
+
+  // A pulse at 2 seconds on a decaying flux
+  IsotropicSource::spectra_type spectra(1, vec_dbl(1, 10.0));
+  vec_int source_map(mesh->number_cells(), 0);
+  IsotropicSource::SP_externalsource
+    q_e(new IsotropicSource(1, mesh, spectra, source_map));
+  PulsedExternalSource::SP_tdsource
+    q_td(new PulsedExternalSource(1, mesh, q_e, 2.0, 0.1));
+
+  TS_1D stepper(inp, linmat, mesh, false);
+  stepper.add_source(q_td);
+  TS_1D::SP_state ic = stepper.state();
+  for (int i = 0; i < mesh->number_cells(); ++i)
+    ic->phi(0)[i] = 1.0;
+  stepper.solve(ic);
+  steps = adaptive ? stepper.number_accepted_steps() : 2.1 / dt + 0.5;
+  if (adaptive)
+  {
+    printf(" adaptive: accepted %i rejected %i \n",
+           stepper.number_accepted_steps(), stepper.number_rejected_steps());
+  }
+  return stepper.state()->phi(0)[0];
+}
+
+/// Test adaptive BDF steps against fine fixed steps
+int test_Adaptive(int argc, char *argv[])
+{
+  typedef TimeStepper<_1D> TS_1D;
+
+  int steps = 0;
+  double ref = test_Adaptive_flux(TS_1D::BDF3, 0.0001, 0, steps);
+
+  // Start from a small step to resolve the initial decay.
+  int adaptive_steps = 0;
+  double phi = test_Adaptive_flux(TS_1D::BDF3, 0.001, 1, adaptive_steps);
+  TEST(adaptive_steps < steps / 10);
+
+  // Fixed steps of the same number are less accurate.
+  double dt = 2.1 / adaptive_steps;
+  double phi_fixed = test_Adaptive_flux(TS_1D::BDF3, dt, 0, steps);
+  printf(" phi: ref = %16.12f adaptive = %16.12f fixed = %16.12f \n",
+         ref, phi, phi_fixed);
+  TEST(std::abs(phi - ref) < 1e-3 * ref);
+  TEST(std::abs(phi - ref) < std::abs(phi_fixed - ref));
+  return 0;
+}
+
+/// Two region slab with a step decrease in absorption in the outer region
+class QuasiStaticMaterial: public TimeDependentMaterial
+{
+public:
+  QuasiStaticMaterial()
+    : TimeDependentMaterial(2, 1, 1, "QuasiStaticMaterial")
+  {
+    update_impl();
+  }
+  void update_impl()
+  {
+    for (int m = 0; m < 2; ++m)
+    {
+      double sa = 0.1;
+      if (m == 1 && time() > 0.0) sa -= 0.001;
+      set_sigma_t(m, 0,   sa);
+      set_diff_coef(m, 0, 1.0);
+      set_sigma_f(m, 0,   0.11);
+      set_chi(m, 0,       1.0);
+      set_beta(m, 0,      0.0075);
+      set_chi_d(m, 0, 0,  1.0);
+    }
+    set_lambda(0,   0.08);
+    set_velocity(0, 1.0e5);
+    finalize();
+  }
+};
+
+/// Integral of the flux at the final time relative to the initial time
+double test_QuasiStatic_flux(double dt, int quasistatic, double final_time,
+                             int omega = 0, int scheme = TimeStepper<_1D>::BDF2)
+{
+  typedef TimeStepper<_1D> TS_1D;
+
+  InputDB::SP_input inp(new InputDB("quasi-static test"));
+  inp->put<int>("dimension",                1);
+  inp->put<int>("number_groups",            1);
+  inp->put<std::string>("equation",         "diffusion");
+  inp->put<std::string>("bc_west",          "reflect");
+  inp->put<std::string>("bc_east",          "vacuum");
+  inp->put<double>("ts_final_time",         final_time);
+  inp->put<double>("ts_step_size",          dt);
+  inp->put<int>("ts_scheme",                scheme);
+  inp->put<int>("ts_no_extrapolation",      1);
+  inp->put<int>("ts_monitor_level",         0);
+  inp->put<int>("ts_quasistatic",           quasistatic);
+  inp->put<int>("ts_omega",                 omega);
+  inp->put<int>("ts_max_iters",             omega ? 20 : 1);
+  inp->put<double>("ts_tolerance",          1e-10);
+  inp->put<double>("eigen_tolerance",       1e-12);
+  inp->put<int>("eigen_max_iters",          100000);
+  inp->put<double>("outer_tolerance",       1e-12);
+  inp->put<double>("inner_tolerance",       1e-12);
+  inp->put<int>("outer_print_level",        0);
+  inp->put<int>("inner_print_level",        0);
+  inp->put<int>("eigen_print_level",        0);
+
+  vec_int fm(2, 10);
+  vec_dbl cm(3, 0.0); cm[1] = 25.0; cm[2] = 50.0;
+  vec_int mt(2, 0); mt[1] = 1;
+  Mesh1D::SP_mesh mesh(new Mesh1D(fm, cm, mt));
+
+  // Critical initial state, which is also the adjoint in one group
+  TS_1D::SP_material mat(new QuasiStaticMaterial());
+  EigenvalueManager<_1D> manager(inp, mat, mesh);
+  manager.solve();
+  State::SP_state ic = manager.state();
+  mat->set_eigenvalue(ic->eigenvalue());
+  mat->update(0, 0, 1, false);
+  State::SP_state weight(new State(*ic));
+
+  TS_1D stepper(inp, mat, mesh, true);
+  stepper.set_weight(weight);
+  State::SP_state ic_copy(new State(*ic));
+  stepper.solve(ic_copy);
+
+  double F = 0.0, F_0 = 0.0;
+  for (int i = 0; i < mesh->number_cells(); ++i)
+  {
+    F   += mesh->volume(i) * stepper.state()->phi(0)[i];
+    F_0 += mesh->volume(i) * ic->phi(0)[i];
+  }
+  if (quasistatic)
+  {
+    printf(" amplitude = %12.8f rho = %12.8f \n",
+           stepper.amplitude(), stepper.reactivity());
+  }
+  return F / F_0;
+}
+
+/// Test PCQS with large steps against fine BDF steps through the prompt jump
+int test_QuasiStatic(int argc, char *argv[])
+{
+  double ref   = test_QuasiStatic_flux(0.0001, 0, 0.2);
+  double bdf   = test_QuasiStatic_flux(0.05,   0, 0.2);
+  double pcqs  = test_QuasiStatic_flux(0.05,   1, 0.2);
+  printf(" relative power: ref = %12.8f bdf = %12.8f pcqs = %12.8f \n",
+         ref, bdf, pcqs);
+  TEST(ref > 1.4);
+  TEST(std::abs(pcqs - ref) < 0.2 * std::abs(bdf - ref));
+  TEST(std::abs(pcqs - ref) < 1e-3 * ref);
+  return 0;
+}
+
+/// Test the frequency transform with large steps during the stable period
+int test_Omega(int argc, char *argv[])
+{
+  typedef TimeStepper<_1D> TS_1D;
+  double ref   = test_QuasiStatic_flux(0.001, 0, 10.0, 0, TS_1D::BDF2);
+  double bdf   = test_QuasiStatic_flux(1.0,   0, 10.0, 0, TS_1D::BDF1);
+  double omega = test_QuasiStatic_flux(1.0,   0, 10.0, 1, TS_1D::BDF1);
+  printf(" relative power: ref = %12.8f bdf = %12.8f omega = %12.8f \n",
+         ref, bdf, omega);
+  TEST(std::abs(omega - ref) < 0.2 * std::abs(bdf - ref));
+  return 0;
+}
+
+/// Two region slab with a step decrease in absorption in the outer region
+/// and absorption increasing with the temperature of each region
+class FeedbackMaterial: public TimeDependentMaterial
+{
+public:
+  FeedbackMaterial()
+    : TimeDependentMaterial(2, 1, 1, "FeedbackMaterial")
+    , d_physics(new MultiPhysics(1))
+  {
+    d_physics->add_variable(0, vec_dbl(2, 0.0));
+    update_impl();
+  }
+  void update_impl()
+  {
+    for (int m = 0; m < 2; ++m)
+    {
+      double sa = 0.1 + 1.0e-4 * d_physics->variable(0)[m];
+      if (m == 1 && time() > 0.0) sa -= 0.003;
+      set_sigma_t(m, 0,   sa);
+      set_diff_coef(m, 0, 1.0);
+      set_sigma_f(m, 0,   0.11);
+      set_chi(m, 0,       1.0);
+      set_beta(m, 0,      0.0075);
+      set_chi_d(m, 0, 0,  1.0);
+    }
+    set_lambda(0,   0.08);
+    set_velocity(0, 1.0e5);
+    finalize();
+  }
+  MultiPhysics::SP_multiphysics d_physics;
+};
+
+/// Adiabatic heating of each region by its average fission rate
+void test_Anderson_rhs(void* data, TimeStepper<_1D>* ts, double t, double dt)
+{
+  vec_dbl &T = ts->multiphysics()->variable(0);
+  vec_dbl V(2, 0.0);
+  T.assign(2, 0.0);
+  const vec_int &mt = ts->mesh()->mesh_map("MATERIAL");
+  for (int i = 0; i < ts->mesh()->number_cells(); ++i)
+  {
+    T[mt[i]] += ts->mesh()->volume(i) * 50.0 *
+                ts->material()->sigma_f(mt[i], 0) * ts->state()->phi(0)[i];
+    V[mt[i]] += ts->mesh()->volume(i);
+  }
+  for (int m = 0; m < 2; ++m) T[m] /= V[m];
+}
+
+/// Count the Picard iterations
+void test_Anderson_monitor(void* data, TimeStepper<_1D>* ts, int step,
+                           double t, double dt, int it, bool conv)
+{
+  if (conv) *((int *) data) += it;
+}
+
+/// Integral of the flux at the final time with temperature feedback.
+/// Krylov warm starts are requested to check that the stepper leaves
+/// the caller's database as it was.
+double test_Anderson_flux(double dt, int max_iters, int depth, int &iters,
+                          bool &input_unchanged)
+{
+  typedef TimeStepper<_1D> TS_1D;
+
+  InputDB::SP_input inp(new InputDB("anderson test"));
+  inp->put<int>("dimension",                1);
+  inp->put<int>("number_groups",            1);
+  inp->put<std::string>("equation",         "diffusion");
+  inp->put<std::string>("bc_west",          "reflect");
+  inp->put<std::string>("bc_east",          "vacuum");
+  inp->put<double>("ts_final_time",         1.0);
+  inp->put<double>("ts_step_size",          dt);
+  inp->put<int>("ts_scheme",                TS_1D::BDF2);
+  inp->put<int>("ts_no_extrapolation",      1);
+  inp->put<int>("ts_max_iters",             max_iters);
+  inp->put<double>("ts_tolerance",          1e-9);
+  inp->put<int>("ts_anderson_depth",        depth);
+  inp->put<int>("ts_warm_start",            1);
+  inp->put<double>("eigen_tolerance",       1e-12);
+  inp->put<int>("eigen_max_iters",          100000);
+  inp->put<double>("outer_tolerance",       1e-12);
+  inp->put<double>("inner_tolerance",       1e-12);
+  inp->put<int>("outer_print_level",        0);
+  inp->put<int>("inner_print_level",        0);
+  inp->put<int>("eigen_print_level",        0);
+
+  vec_int fm(2, 10);
+  vec_dbl cm(3, 0.0); cm[1] = 25.0; cm[2] = 50.0;
+  vec_int mt(2, 0); mt[1] = 1;
+  Mesh1D::SP_mesh mesh(new Mesh1D(fm, cm, mt));
+
+  // Critical initial state with a unit average flux
+  detran_utilities::SP<FeedbackMaterial> mat(new FeedbackMaterial());
+  TS_1D::SP_material tdmat(mat);
+  EigenvalueManager<_1D> manager(inp, tdmat, mesh);
+  manager.solve();
+  State::SP_state ic = manager.state();
+  double F = 0.0;
+  for (int i = 0; i < mesh->number_cells(); ++i)
+    F += mesh->volume(i) * ic->phi(0)[i] / 50.0;
+  ic->scale(1.0 / F);
+  mat->set_eigenvalue(ic->eigenvalue());
+  mat->update(0, 0, 1, false);
+
+  TS_1D stepper(inp, tdmat, mesh, true);
+  input_unchanged = !inp->check("inner_warm_start") &&
+                    !inp->check("outer_warm_start");
+  iters = 0;
+  stepper.set_monitor(test_Anderson_monitor, &iters);
+  stepper.set_multiphysics(mat->d_physics, test_Anderson_rhs);
+  stepper.solve(ic);
+
+  F = 0.0;
+  for (int i = 0; i < mesh->number_cells(); ++i)
+    F += mesh->volume(i) * stepper.state()->phi(0)[i] / 50.0;
+  return F;
+}
+
+/// Test converged feedback against lagged feedback, and Anderson against
+/// plain Picard iteration
+int test_Anderson(int argc, char *argv[])
+{
+  int iters_ref, iters_lag, iters_picard, iters_anderson;
+  bool unchanged;
+  double ref      = test_Anderson_flux(0.005, 50, 3, iters_ref, unchanged);
+  double lag      = test_Anderson_flux(0.1,    1, 0, iters_lag, unchanged);
+  double picard   = test_Anderson_flux(0.1,  100, 0, iters_picard, unchanged);
+  double anderson = test_Anderson_flux(0.1,  100, 3, iters_anderson, unchanged);
+  TEST(unchanged);
+  printf(" power: ref = %12.8f lagged = %12.8f picard = %12.8f (%i) "
+         "anderson = %12.8f (%i) \n",
+         ref, lag, picard, iters_picard, anderson, iters_anderson);
+  TEST(std::abs(anderson - picard) < 1e-5 * picard);
+  TEST(std::abs(anderson - ref) < std::abs(lag - ref));
+  TEST(iters_anderson < iters_picard);
+  return 0;
+}
+
 //---------------------------------------------------------------------------//
 //              end of test_TimeStepper.cc
 //---------------------------------------------------------------------------//
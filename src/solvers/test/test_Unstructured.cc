@@ -0,0 +1,231 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_Unstructured.cc
+ *  @author Jeremy Roberts
+ *  @date   Feb 22, 2013
+ *  @brief  Test of transport on unstructured meshes.
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                       \
+        FUNC(test_Unstructured_grid)    \
+        FUNC(test_Unstructured_cycle)   \
+        FUNC(test_Unstructured_hex)     \
+        FUNC(test_Unstructured_extruded)  \
+        FUNC(test_Unstructured_mismatch)
+
+#include "TestDriver.hh"
+#include "EigenvalueManager.hh"
+#include "Mesh2D.hh"
+#include "MeshHex.hh"
+#include "transport/CoarseMesh.hh"
+#include "callow/utils/Initialization.hh"
+#include "geometry/test/mesh_fixture.hh"
+#include "material/test/material_fixture.hh"
+#include <cmath>
+
+using namespace detran_test;
+using namespace detran;
+using namespace detran_material;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  callow_initialize(argc, argv);
+  RUN(argc, argv);
+  callow_finalize();
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+// Eigenvalue and flux of a problem reflected on the west, south, bottom,
+// and top sides and either reflected or vacuum on the others.
+template <class D>
+double test_Unstructured_keff(string          equation,
+                              Mesh::SP_mesh   mesh,
+                              bool            reflect,
+                              vec_dbl        &phi)
+{
+  string bc = reflect ? "reflect" : "vacuum";
+  InputDB::SP_input inp(new InputDB());
+  inp->put<int>("number_groups",                  2);
+  inp->put<int>("dimension",                      D::dimension);
+  inp->put<string>("equation",                    equation);
+  inp->put<string>("bc_west",                     "reflect");
+  inp->put<string>("bc_east",                     bc);
+  inp->put<string>("bc_south",                    "reflect");
+  inp->put<string>("bc_north",                    bc);
+  inp->put<string>("bc_bottom",                   "reflect");
+  inp->put<string>("bc_top",                      "reflect");
+  inp->put<string>("quad_type",                   "chebyshevlegendre");
+  inp->put<int>("quad_number_polar_octant",       2);
+  inp->put<int>("quad_number_azimuth_octant",     3);
+  inp->put<string>("inner_solver",                "SI");
+  inp->put<double>("inner_tolerance",             1e-11);
+  inp->put<int>("inner_max_iters",                10000);
+  inp->put<int>("inner_print_level",              0);
+  inp->put<string>("outer_solver",                "GS");
+  inp->put<double>("outer_tolerance",             1e-11);
+  inp->put<int>("outer_max_iters",                1000);
+  inp->put<int>("outer_print_level",              0);
+  inp->put<string>("eigen_solver",                "PI");
+  inp->put<double>("eigen_tolerance",             1e-10);
+  inp->put<int>("eigen_max_iters",                1000);
+  inp->put<int>("eigen_print_level",              0);
+  Material::SP_material mat = material_fixture_2g();
+  EigenvalueManager<D> manager(inp, mat, mesh);
+  if (!manager.solve()) return 0.0;
+  phi = manager.state()->phi(0);
+  return manager.state()->eigenvalue();
+}
+
+// The step difference equation on a grid of quadrilaterals reproduces
+// the Cartesian step difference equation.
+int test_Unstructured_grid(int argc, char *argv[])
+{
+  vec_dbl xe(5, 0.0);
+  xe[1] = 1.0; xe[2] = 2.5; xe[3] = 3.0; xe[4] = 5.0;
+  vec_int mat_map(16, 0);
+  mat_map[0] = 1; mat_map[1] = 1; mat_map[4] = 1;
+  Mesh::SP_mesh cartesian(new Mesh2D(xe, xe, mat_map));
+  Mesh::SP_mesh unstructured = unstructured_grid_fixture(xe, xe, mat_map);
+
+  vec_dbl phi_sd, phi_usd;
+  double keff_sd  = test_Unstructured_keff<_2D>("sd",  cartesian,    false, phi_sd);
+  double keff_usd = test_Unstructured_keff<_2D>("usd", unstructured, false, phi_usd);
+  printf(" keff: sd = %12.9f usd = %12.9f \n", keff_sd, keff_usd);
+  TEST(soft_equiv(keff_usd, keff_sd, 1e-9));
+  for (int c = 0; c < 16; ++c)
+    TEST(soft_equiv(phi_usd[c] / phi_usd[0], phi_sd[c] / phi_sd[0], 1e-8));
+  return 0;
+}
+
+// In a reflected homogeneous medium, the flux is flat even though the
+// sweep of the cyclic mesh lags faces and the boundaries are reflected
+// cell face by cell face.
+int test_Unstructured_cycle(int argc, char *argv[])
+{
+  vec_dbl xe(4, 0.0);
+  xe[1] = 1.0; xe[2] = 2.0; xe[3] = 3.0;
+  Mesh::SP_mesh cartesian(new Mesh2D(xe, xe, vec_int(9, 1)));
+  Mesh::SP_mesh unstructured = unstructured_mesh_fixture(vec_int(3, 1));
+
+  vec_dbl phi_sd, phi_usd;
+  double keff_sd  = test_Unstructured_keff<_2D>("sd",  cartesian,    true, phi_sd);
+  double keff_usd = test_Unstructured_keff<_2D>("usd", unstructured, true, phi_usd);
+  printf(" keff: sd = %12.9f usd = %12.9f \n", keff_sd, keff_usd);
+  TEST(soft_equiv(keff_usd, keff_sd, 1e-8));
+  TEST(soft_equiv(phi_usd[1], phi_usd[0], 1e-8));
+  TEST(soft_equiv(phi_usd[2], phi_usd[0], 1e-8));
+  return 0;
+}
+
+// Sectors of a hexagonal core with a symmetric loading, with reflective
+// or rotational boundaries, reproduce the full core.
+int test_Unstructured_hex(int argc, char *argv[])
+{
+  vec_int mat(19, 1);
+  for (int h = 1; h < 7; ++h) mat[h] = 0;
+  Mesh::SP_mesh full = MeshHex::Create(1.2, 3, mat);
+  Mesh::SP_mesh sixth_reflect = MeshHex::Create(1.2, 3, mat, 6);
+  Mesh::SP_mesh sixth_rotate = MeshHex::Create(1.2, 3, mat, 6, 1, true);
+  Mesh::SP_mesh third_rotate = MeshHex::Create(1.2, 3, mat, 3, 1, true);
+
+  vec_dbl phi_full, phi_reflect, phi_sixth, phi_third;
+  double keff_full    = test_Unstructured_keff<_2D>("usd", full,
+                                                    true, phi_full);
+  double keff_reflect = test_Unstructured_keff<_2D>("usd", sixth_reflect,
+                                                    true, phi_reflect);
+  double keff_sixth   = test_Unstructured_keff<_2D>("usd", sixth_rotate,
+                                                    true, phi_sixth);
+  double keff_third   = test_Unstructured_keff<_2D>("usd", third_rotate,
+                                                    true, phi_third);
+  printf(" keff: full = %12.9f 1/6 reflect = %12.9f 1/6 rotate = %12.9f "
+         "1/3 rotate = %12.9f \n",
+         keff_full, keff_reflect, keff_sixth, keff_third);
+  TEST(soft_equiv(keff_reflect, keff_full, 1e-8));
+  TEST(soft_equiv(keff_sixth,   keff_full, 1e-8));
+  TEST(soft_equiv(keff_third,   keff_full, 1e-8));
+  for (int c = 0; c < sixth_reflect->number_cells(); ++c)
+    TEST(soft_equiv(phi_sixth[c], phi_reflect[c], 1e-7));
+  return 0;
+}
+
+// An extruded grid reflected axially reproduces the 2D grid.
+int test_Unstructured_extruded(int argc, char *argv[])
+{
+  vec_dbl xe(4, 0.0);
+  xe[1] = 1.0; xe[2] = 2.5; xe[3] = 3.0;
+  vec_dbl ze(3, 0.0);
+  ze[1] = 0.5; ze[2] = 2.0;
+  vec_int mat_map(9, 0);
+  mat_map[0] = 1; mat_map[1] = 1; mat_map[3] = 1;
+  Mesh::SP_mesh planar   = unstructured_grid_fixture(xe, xe, mat_map);
+  Mesh::SP_mesh extruded = unstructured_grid_fixture(xe, xe, mat_map, ze);
+
+  vec_dbl phi_2d, phi_3d;
+  double keff_2d = test_Unstructured_keff<_2D>("usd", planar,   false, phi_2d);
+  double keff_3d = test_Unstructured_keff<_3D>("usd", extruded, false, phi_3d);
+  printf(" keff: 2d = %12.9f 3d = %12.9f \n", keff_2d, keff_3d);
+  TEST(soft_equiv(keff_3d, keff_2d, 1e-8));
+  for (int c = 0; c < 9; ++c)
+  {
+    TEST(soft_equiv(phi_3d[c] / phi_3d[0], phi_2d[c] / phi_2d[0], 1e-7));
+    TEST(soft_equiv(phi_3d[c + 9], phi_3d[c], 1e-7));
+  }
+  return 0;
+}
+
+// Does setting up a manager for the equation and mesh fail?
+bool test_Unstructured_rejected(string equation, Mesh::SP_mesh mesh)
+{
+  InputDB::SP_input inp(new InputDB());
+  inp->put<int>("number_groups",  2);
+  inp->put<string>("equation",    equation);
+  FixedSourceManager<_2D> manager(inp, material_fixture_2g(), mesh);
+  try
+  {
+    manager.setup();
+  }
+  catch (detran_utilities::GenException &e)
+  {
+    return true;
+  }
+  return false;
+}
+
+// The polygons are a row of cells, which only the unstructured sweeper
+// and no coarse mesh may use.
+int test_Unstructured_mismatch(int argc, char *argv[])
+{
+  vec_dbl xe(3, 0.0);
+  xe[1] = 1.0; xe[2] = 2.0;
+  vec_int mat_map(4, 0);
+  Mesh::SP_mesh cartesian(new Mesh2D(xe, xe, mat_map));
+  Mesh::SP_mesh unstructured = unstructured_grid_fixture(xe, xe, mat_map);
+  TEST(cartesian->is_cartesian());
+  TEST(!unstructured->is_cartesian());
+  TEST(test_Unstructured_rejected("sd",  unstructured));
+  TEST(test_Unstructured_rejected("usd", cartesian));
+  TEST(!test_Unstructured_rejected("usd", unstructured));
+  bool rejected = false;
+  try
+  {
+    CoarseMesh coarse(unstructured, 1);
+  }
+  catch (detran_utilities::GenException &e)
+  {
+    rejected = true;
+  }
+  TEST(rejected);
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_Unstructured.cc
+//---------------------------------------------------------------------------//
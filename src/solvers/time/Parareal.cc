@@ -0,0 +1,251 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   Parareal.cc
+ *  @author robertsj
+ *  @date   Mar 8, 2013
+ *  @brief  Parareal member definitions.
+ */
+//---------------------------------------------------------------------------//
+
+#include "Parareal.hh"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#ifdef DETRAN_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class D>
+Parareal<D>::Parareal(SP_input            fine_input,
+                      SP_input            coarse_input,
+                      const vec_material &materials,
+                      SP_mesh             mesh,
+                      bool                multiply)
+  : d_fine_input(fine_input)
+  , d_coarse_input(coarse_input)
+  , d_mesh(mesh)
+  , d_number_slices(4)
+  , d_tolerance(1.0e-6)
+  , d_print_level(0)
+  , d_final_time(0.0)
+  , d_number_iterations(0)
+{
+  Require(d_fine_input);
+  Require(d_coarse_input);
+  Require(materials.size() > 0);
+  Require(d_mesh);
+
+  if (d_fine_input->check("pr_number_slices"))
+    d_number_slices = d_fine_input->template get<int>("pr_number_slices");
+  Insist(d_number_slices > 0, "Parareal needs at least one slice.");
+  d_maximum_iterations = d_number_slices;
+  if (d_fine_input->check("pr_max_iters"))
+    d_maximum_iterations = d_fine_input->template get<int>("pr_max_iters");
+  if (d_fine_input->check("pr_tolerance"))
+    d_tolerance = d_fine_input->template get<double>("pr_tolerance");
+  if (d_fine_input->check("pr_print_level"))
+    d_print_level = d_fine_input->template get<int>("pr_print_level");
+  Insist(d_fine_input->check("ts_final_time"),
+         "Parareal needs the final time ts_final_time.");
+  d_final_time = d_fine_input->template get<double>("ts_final_time");
+
+  // Only the flux moments and precursors are passed between slices.
+  Insist(!(d_fine_input->check("ts_discrete") &&
+           d_fine_input->template get<int>("ts_discrete")) &&
+         !(d_coarse_input->check("ts_discrete") &&
+           d_coarse_input->template get<int>("ts_discrete")),
+         "Parareal requires moment-based time stepping.");
+
+  d_number_groups = materials[0]->number_groups();
+  d_number_precursor_groups = 0;
+  if (multiply)
+    d_number_precursor_groups = materials[0]->number_precursor_groups();
+
+  d_coarse = new TimeStepper_T(d_coarse_input, materials[0], d_mesh, multiply);
+  d_fine.resize(materials.size());
+  for (size_t i = 0; i < materials.size(); ++i)
+  {
+    Require(materials[i]);
+    d_fine[i] = new TimeStepper_T(d_fine_input, materials[i], d_mesh, multiply);
+  }
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+bool Parareal<D>::solve(SP_state initial_state)
+{
+  Require(initial_state);
+
+  size_t N = d_number_slices;
+  vec2_dbl U(N + 1), G(N), F(N);
+
+  // The initial precursors are at steady state, which the
+  // propagators compute for the first slice.
+  pack(initial_state, SP_precursors(), U[0]);
+
+  // Initial coarse sweep
+  for (size_t n = 0; n < N; ++n)
+  {
+    propagate(d_coarse, d_coarse_input, n, U[n], G[n]);
+    U[n + 1] = G[n];
+  }
+
+  bool converged = false;
+  d_residual_norms.clear();
+  d_number_iterations = 0;
+  if (d_print_level > 0)
+  {
+    printf(" iteration     change \n");
+    printf("----------------------\n");
+  }
+  for (size_t k = 1; k <= d_maximum_iterations; ++k)
+  {
+    // After k - 1 iterations, the first k - 1 slices are exact, so
+    // only the rest need fine solves.  These are independent.
+    size_t first = k - 1;
+#ifdef DETRAN_ENABLE_OPENMP
+    #pragma omp parallel for schedule(dynamic) num_threads(d_fine.size())
+#endif
+    for (int n = first; n < (int) N; ++n)
+    {
+      size_t thread = 0;
+#ifdef DETRAN_ENABLE_OPENMP
+      thread = omp_get_thread_num();
+#endif
+      // The solvers contain orphaned worksharing loops (e.g. in
+      // callow::Matrix::multiply), which would bind to this team and
+      // wait at barriers that the other slices never reach.  A region
+      // of its own gives each slice a team to bind to.
+#ifdef DETRAN_ENABLE_OPENMP
+      #pragma omp parallel num_threads(1)
+#endif
+      propagate(d_fine[thread], d_fine_input, n, U[n], F[n]);
+    }
+
+    // Coarse correction sweep.  The first slice starts from an exact
+    // state, so its coarse solution is unchanged.
+    double norm = 0.0;
+    for (size_t n = first; n < N; ++n)
+    {
+      vec_dbl g = G[n];
+      if (n > first) propagate(d_coarse, d_coarse_input, n, U[n], g);
+      vec_dbl &u = U[n + 1];
+      double du[2] = {0.0, 0.0}, nu[2] = {0.0, 0.0};
+      size_t flux_size = u.size() -
+                         d_number_precursor_groups * d_mesh->number_cells();
+      for (size_t i = 0; i < u.size(); ++i)
+      {
+        double v = g[i] + F[n][i] - G[n][i];
+        size_t part = i < flux_size ? 0 : 1;
+        du[part] += (v - u[i]) * (v - u[i]);
+        nu[part] += v * v;
+        u[i] = v;
+      }
+      for (size_t part = 0; part < 2; ++part)
+        if (nu[part] > 0.0) norm = std::max(norm, std::sqrt(du[part] / nu[part]));
+      G[n] = g;
+    }
+    d_residual_norms.push_back(norm);
+    d_number_iterations = k;
+    if (d_print_level > 0) printf(" %9i  %9.3e \n", k, norm);
+
+    // After N iterations, all slices are exact.
+    if (norm <= d_tolerance || k >= N)
+    {
+      converged = true;
+      break;
+    }
+  }
+
+  // Store the final state.
+  d_state = new State(d_fine_input, d_mesh, d_fine[0]->quadrature());
+  if (d_number_precursor_groups)
+    d_precursor = new Precursors(d_number_precursor_groups,
+                                 d_mesh->number_cells());
+  unpack(U[N], d_state, d_precursor);
+
+  return converged;
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void Parareal<D>::propagate(SP_timestepper   stepper,
+                            SP_input         input,
+                            const size_t     n,
+                            const vec_dbl   &u,
+                            vec_dbl         &v)
+{
+  SP_state state(new State(input, d_mesh, stepper->quadrature()));
+  SP_precursors precursor;
+  if (n > 0 && d_number_precursor_groups)
+  {
+    precursor = new Precursors(d_number_precursor_groups,
+                               d_mesh->number_cells());
+  }
+  unpack(u, state, precursor);
+
+  double dt = d_final_time / d_number_slices;
+  double t_1 = n + 1 == d_number_slices ? d_final_time : (n + 1) * dt;
+  stepper->solve(state, precursor, n * dt, t_1);
+  pack(stepper->state(), stepper->precursor(), v);
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void Parareal<D>::pack(SP_state       state,
+                       SP_precursors  precursor,
+                       vec_dbl       &u) const
+{
+  size_t n = 0;
+  for (size_t g = 0; g < d_number_groups; ++g)
+    n += state->phi(g).size();
+  n += d_number_precursor_groups * d_mesh->number_cells();
+  u.assign(n, 0.0);
+
+  vec_dbl::iterator it = u.begin();
+  for (size_t g = 0; g < d_number_groups; ++g)
+    it = std::copy(state->phi(g).begin(), state->phi(g).end(), it);
+  if (!precursor) return;
+  for (size_t i = 0; i < d_number_precursor_groups; ++i)
+    it = std::copy(precursor->C(i).begin(), precursor->C(i).end(), it);
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void Parareal<D>::unpack(const vec_dbl  &u,
+                         SP_state        state,
+                         SP_precursors   precursor) const
+{
+  vec_dbl::const_iterator it = u.begin();
+  for (size_t g = 0; g < d_number_groups; ++g)
+  {
+    State::moments_type &phi = state->phi(g);
+    std::copy(it, it + phi.size(), phi.begin());
+    it += phi.size();
+  }
+  if (!precursor) return;
+  for (size_t i = 0; i < d_number_precursor_groups; ++i)
+  {
+    vec_dbl &C = precursor->C(i);
+    std::copy(it, it + C.size(), C.begin());
+    it += C.size();
+  }
+}
+
+//---------------------------------------------------------------------------//
+// EXPLICIT INSTANTIATIONS
+//---------------------------------------------------------------------------//
+
+SOLVERS_INSTANTIATE_EXPORT(Parareal<_1D>)
+SOLVERS_INSTANTIATE_EXPORT(Parareal<_2D>)
+SOLVERS_INSTANTIATE_EXPORT(Parareal<_3D>)
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of file Parareal.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,200 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   Parareal.hh
+ *  @author robertsj
+ *  @date   Mar 8, 2013
+ *  @brief  Parareal class definition.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_PARAREAL_HH_
+#define detran_PARAREAL_HH_
+
+#include "TimeStepper.hh"
+
+namespace detran
+{
+
+/**
+ *  @class Parareal
+ *  @brief Parallel-in-time solution of a transient
+ *
+ *  The transient is split into \f$ N \f$ slices of equal length.  A cheap
+ *  coarse propagator \f$ G \f$ (e.g. diffusion with long steps) and an
+ *  accurate fine propagator \f$ F \f$ (e.g. transport with short steps)
+ *  each advance the flux and precursors over one slice.  Starting from
+ *  a coarse sweep, Parareal iterates
+ *  @f[
+ *      U^{k+1}_{n+1} = G(U^{k+1}_n) + F(U^k_n) - G(U^k_n) \, ,
+ *  @f]
+ *  in which the fine solves of all slices are independent.  After
+ *  \f$ k \f$ iterations, the first \f$ k \f$ slices equal the serial fine
+ *  solution, so at most \f$ N \f$ iterations are needed; for mildly
+ *  nonlinear transients, far fewer are typically enough.  The slices
+ *  already converged are not solved again.
+ *
+ *  Each propagator is a TimeStepper built from its own input, so the
+ *  coarse and fine problems may use different equations, schemes, and
+ *  step sizes on the same mesh.  Both propagate the scalar flux moments
+ *  and precursors; each slice restarts its scheme at first order.
+ *
+ *  A TimeDependentMaterial holds the state of the step being taken, so
+ *  each concurrent fine solve needs its own material.  With OpenMP, one
+ *  thread is used per material given; the first material also serves
+ *  the coarse propagator, which runs while no fine solve does.  With a
+ *  single material, the fine solves are done in turn.  Each fine solve
+ *  runs in a nested parallel region of one thread, so the worksharing
+ *  loops inside the solvers never bind to the team of slices.
+ *
+ *  Relevant input database entries (from the fine input):
+ *    - pr_number_slices (4)      number of time slices
+ *    - pr_max_iters (slices)     maximum number of Parareal iterations
+ *    - pr_tolerance (1e-6)       tolerance on the relative change of the
+ *                                slice states between iterations
+ *    - pr_print_level (0)        print the change at each iteration
+ *    - ts_final_time             length of the transient
+ */
+template <class D>
+class SOLVERS_EXPORT Parareal
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<Parareal>            SP_parareal;
+  typedef TimeStepper<D>                            TimeStepper_T;
+  typedef typename TimeStepper_T::SP_timestepper    SP_timestepper;
+  typedef detran_utilities::InputDB::SP_input       SP_input;
+  typedef TimeDependentMaterial::SP_material        SP_material;
+  typedef std::vector<SP_material>                  vec_material;
+  typedef detran_geometry::Mesh::SP_mesh            SP_mesh;
+  typedef State::SP_state                           SP_state;
+  typedef Precursors::SP_precursors                 SP_precursors;
+  typedef detran_utilities::vec_dbl                 vec_dbl;
+  typedef detran_utilities::vec2_dbl                vec2_dbl;
+  typedef detran_utilities::size_t                  size_t;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param fine_input     Input for the fine propagator
+   *  @param coarse_input   Input for the coarse propagator
+   *  @param materials      Independent copies of the material, one per
+   *                        concurrent fine solve
+   *  @param mesh           Mesh
+   *  @param multiply       Flag for a multiplying problem
+   */
+  Parareal(SP_input            fine_input,
+           SP_input            coarse_input,
+           const vec_material &materials,
+           SP_mesh             mesh,
+           bool                multiply);
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Solve the transient
+   *  @param initial_state  State at t = 0, with steady precursors
+   *  @return               True if converged
+   */
+  bool solve(SP_state initial_state);
+
+  /// State at the end of the transient
+  SP_state state() {return d_state;}
+
+  /// Precursors at the end of the transient
+  SP_precursors precursor() {return d_precursor;}
+
+  /// Number of Parareal iterations performed
+  size_t number_iterations() const {return d_number_iterations;}
+
+  /// Relative change of the slice states at each iteration
+  const vec_dbl& residual_norms() const {return d_residual_norms;}
+
+  /// Number of slices
+  size_t number_slices() const {return d_number_slices;}
+
+  /// The coarse propagator
+  SP_timestepper coarse() {return d_coarse;}
+
+  /// The fine propagator of a thread
+  SP_timestepper fine(const size_t i = 0) {return d_fine[i];}
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Fine input
+  SP_input d_fine_input;
+  /// Coarse input
+  SP_input d_coarse_input;
+  /// Mesh
+  SP_mesh d_mesh;
+  /// Coarse propagator
+  SP_timestepper d_coarse;
+  /// Fine propagators, one per thread
+  std::vector<SP_timestepper> d_fine;
+  /// Number of slices
+  size_t d_number_slices;
+  /// Maximum number of iterations
+  size_t d_maximum_iterations;
+  /// Tolerance on the change of the slice states
+  double d_tolerance;
+  /// Print level
+  int d_print_level;
+  /// Length of the transient
+  double d_final_time;
+  /// Number of groups and precursor groups
+  size_t d_number_groups;
+  size_t d_number_precursor_groups;
+  /// Final state and precursors
+  SP_state d_state;
+  SP_precursors d_precursor;
+  /// Number of iterations
+  size_t d_number_iterations;
+  /// Change at each iteration
+  vec_dbl d_residual_norms;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Advance a packed state over one slice
+   *  @param stepper    Propagator
+   *  @param input      Input of the propagator
+   *  @param n          Slice index
+   *  @param u          Packed state at the start of the slice
+   *  @param v          Packed state at the end of the slice
+   */
+  void propagate(SP_timestepper   stepper,
+                 SP_input         input,
+                 const size_t     n,
+                 const vec_dbl   &u,
+                 vec_dbl         &v);
+
+  /// Pack a flux and precursors into one vector.
+  void pack(SP_state state, SP_precursors precursor, vec_dbl &u) const;
+
+  /// Unpack one vector into a flux and precursors.
+  void unpack(const vec_dbl &u, SP_state state, SP_precursors precursor) const;
+
+};
+
+} // end namespace detran
+
+#endif // detran_PARAREAL_HH_
+
+//---------------------------------------------------------------------------//
+//              end of file Parareal.hh
+//---------------------------------------------------------------------------//
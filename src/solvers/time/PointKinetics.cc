@@ -0,0 +1,325 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   PointKinetics.cc
+ *  @author robertsj
+ *  @date   Mar 11, 2013
+ *  @brief  PointKinetics member definitions.
+ */
+//---------------------------------------------------------------------------//
+
+#include "PointKinetics.hh"
+#include "utilities/DBC.hh"
+#include <algorithm>
+#include <cmath>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+PointKinetics::PointKinetics(SP_material material,
+                             SP_mesh     mesh,
+                             SP_state    forward,
+                             SP_state    adjoint)
+  : d_mesh(mesh)
+  , d_forward(forward)
+  , d_adjoint(adjoint)
+  , d_keff(1.0)
+  , d_production(0.0)
+  , d_generation_time(0.0)
+  , d_beta_eff(0.0)
+  , d_times(1, 0.0)
+  , d_rho(1, 0.0)
+{
+  Require(material);
+  Require(d_mesh);
+  Require(d_forward);
+
+  size_t number_groups     = material->number_groups();
+  size_t number_materials  = material->number_materials();
+  size_t number_precursors = material->number_precursor_groups();
+  Insist(d_forward->number_groups() == number_groups,
+         "The steady state must have one flux per group.");
+  if (d_adjoint)
+  {
+    Insist(d_adjoint->number_groups() == number_groups,
+           "The adjoint state must have one flux per group.");
+  }
+  if (d_forward->eigenvalue() > 0.0) d_keff = d_forward->eigenvalue();
+
+  // Keep the steady cross sections for reactivity edits.
+  d_sigma_t.assign(number_groups, vec_dbl(number_materials, 0.0));
+  d_nu_sigma_f.assign(number_groups, vec_dbl(number_materials, 0.0));
+  d_chi.assign(number_groups, vec_dbl(number_materials, 0.0));
+  d_sigma_s.assign(number_groups, vec2_dbl(number_groups,
+                   vec_dbl(number_materials, 0.0)));
+  for (size_t g = 0; g < number_groups; ++g)
+  {
+    for (size_t m = 0; m < number_materials; ++m)
+    {
+      d_sigma_t[g][m]    = material->sigma_t(m, g);
+      d_nu_sigma_f[g][m] = material->nu_sigma_f(m, g);
+      d_chi[g][m]        = material->chi(m, g);
+      for (size_t gp = 0; gp < number_groups; ++gp)
+        d_sigma_s[g][gp][m] = material->sigma_s(m, g, gp);
+    }
+  }
+
+  // Weighted products of the steady state
+  const vec_int &mt = d_mesh->mesh_map("MATERIAL");
+  double density = 0.0;
+  d_beta.assign(number_precursors, 0.0);
+  for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
+  {
+    size_t m = mt[cell];
+    double V = d_mesh->volume(cell);
+    double fd = 0.0;
+    for (size_t g = 0; g < number_groups; ++g)
+      fd += d_nu_sigma_f[g][m] * d_forward->phi(g)[cell] / d_keff;
+    for (size_t g = 0; g < number_groups; ++g)
+    {
+      double w = d_adjoint ? d_adjoint->phi(g)[cell] * V : V;
+      density      += w * d_forward->phi(g)[cell] / material->velocity(g);
+      d_production += w * d_chi[g][m] * fd;
+      for (size_t k = 0; k < number_precursors; ++k)
+        d_beta[k] += w * material->chi_d(m, k, g) * material->beta(m, k) * fd;
+    }
+  }
+  Insist(d_production > 0.0, "The weighted production must be positive.");
+
+  d_generation_time = density / d_production;
+  d_lambda.resize(number_precursors);
+  for (size_t k = 0; k < number_precursors; ++k)
+  {
+    d_beta[k] /= d_production;
+    d_beta_eff += d_beta[k];
+    d_lambda[k] = material->lambda(k);
+  }
+}
+
+//---------------------------------------------------------------------------//
+PointKinetics::PointKinetics(const double    generation_time,
+                             const vec_dbl  &beta,
+                             const vec_dbl  &lambda)
+  : d_keff(1.0)
+  , d_production(0.0)
+  , d_generation_time(generation_time)
+  , d_beta(beta)
+  , d_lambda(lambda)
+  , d_beta_eff(0.0)
+  , d_times(1, 0.0)
+  , d_rho(1, 0.0)
+{
+  Require(d_generation_time > 0.0);
+  Require(d_beta.size() == d_lambda.size());
+  for (size_t k = 0; k < d_beta.size(); ++k)
+  {
+    Require(d_lambda[k] > 0.0);
+    d_beta_eff += d_beta[k];
+  }
+}
+
+//---------------------------------------------------------------------------//
+double PointKinetics::reactivity(SP_material perturbed) const
+{
+  Require(perturbed);
+  Insist(d_mesh, "Reactivity edits need the steady state.");
+  size_t number_groups = d_sigma_t.size();
+  Require(perturbed->number_groups() == number_groups);
+  Require(perturbed->number_materials() == d_sigma_t[0].size());
+
+  // Change in the weighted net production of the steady flux
+  const vec_int &mt = d_mesh->mesh_map("MATERIAL");
+  double delta = 0.0;
+  for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
+  {
+    size_t m = mt[cell];
+    double V = d_mesh->volume(cell);
+    double fd = 0.0, fd_0 = 0.0;
+    for (size_t g = 0; g < number_groups; ++g)
+    {
+      fd   += perturbed->nu_sigma_f(m, g) * d_forward->phi(g)[cell];
+      fd_0 += d_nu_sigma_f[g][m] * d_forward->phi(g)[cell];
+    }
+    for (size_t g = 0; g < number_groups; ++g)
+    {
+      double w = d_adjoint ? d_adjoint->phi(g)[cell] * V : V;
+      double phi = d_forward->phi(g)[cell];
+      double d = (perturbed->chi(m, g) * fd - d_chi[g][m] * fd_0) / d_keff -
+                 (perturbed->sigma_t(m, g) - d_sigma_t[g][m]) * phi;
+      for (size_t gp = 0; gp < number_groups; ++gp)
+      {
+        d += (perturbed->sigma_s(m, g, gp) - d_sigma_s[g][gp][m]) *
+             d_forward->phi(gp)[cell];
+      }
+      delta += w * d;
+    }
+  }
+  return delta / d_production;
+}
+
+//---------------------------------------------------------------------------//
+void PointKinetics::set_reactivity(const vec_dbl &times, const vec_dbl &rho)
+{
+  Require(times.size() > 0);
+  Require(times.size() == rho.size());
+  for (size_t i = 1; i < times.size(); ++i)
+  {
+    Require(times[i - 1] <= times[i]);
+  }
+  d_times = times;
+  d_rho   = rho;
+}
+
+//---------------------------------------------------------------------------//
+void PointKinetics::set_reactivity(const double rho)
+{
+  d_times.assign(1, 0.0);
+  d_rho.assign(1, rho);
+}
+
+//---------------------------------------------------------------------------//
+void PointKinetics::solve(const double final_time, const size_t number_steps)
+{
+  integrate(d_times, d_rho, final_time, number_steps,
+            d_amplitudes, d_precursors);
+}
+
+//---------------------------------------------------------------------------//
+PointKinetics::vec2_dbl
+PointKinetics::solve(const vec2_dbl &times,
+                     const vec2_dbl &rho,
+                     const double    final_time,
+                     const size_t    number_steps) const
+{
+  Require(times.size() == rho.size());
+
+  int number_insertions = times.size();
+  for (int i = 0; i < number_insertions; ++i)
+  {
+    Require(times[i].size() > 0);
+    Require(times[i].size() == rho[i].size());
+  }
+
+  // The insertions are independent.
+  vec2_dbl p(number_insertions);
+#ifdef DETRAN_ENABLE_OPENMP
+  #pragma omp parallel for schedule(dynamic)
+#endif
+  for (int i = 0; i < number_insertions; ++i)
+  {
+    vec_dbl xi;
+    integrate(times[i], rho[i], final_time, number_steps, p[i], xi);
+  }
+  return p;
+}
+
+//---------------------------------------------------------------------------//
+// IMPLEMENTATION
+//---------------------------------------------------------------------------//
+
+//---------------------------------------------------------------------------//
+void PointKinetics::integrate(const vec_dbl  &times,
+                              const vec_dbl  &rho,
+                              const double    final_time,
+                              const size_t    number_steps,
+                              vec_dbl        &p,
+                              vec_dbl        &xi) const
+{
+  Require(final_time > 0.0);
+  Require(number_steps > 0);
+
+  // Start at equilibrium.
+  size_t number_precursors = d_beta.size();
+  p.assign(number_steps + 1, 1.0);
+  xi.resize(number_precursors);
+  for (size_t k = 0; k < number_precursors; ++k)
+    xi[k] = d_beta[k] / (d_generation_time * d_lambda[k]);
+
+  // TR-BDF2 coefficients
+  double gamma = 2.0 - std::sqrt(2.0);
+  double c_1   = 1.0 / (gamma * (2.0 - gamma));
+  double c_0   = (1.0 - gamma) * (1.0 - gamma) * c_1;
+  double c_2   = (1.0 - gamma) / (2.0 - gamma);
+
+  double h = final_time / number_steps;
+  double y = 1.0, y_g, dy;
+  vec_dbl xi_g(number_precursors, 0.0), dxi(number_precursors, 0.0);
+  for (size_t n = 0; n < number_steps; ++n)
+  {
+    double t = n * h;
+
+    // Trapezoid stage to t + gamma * h
+    derivative(interpolate(times, rho, t), y, xi, dy, dxi);
+    y_g = y + 0.5 * gamma * h * dy;
+    for (size_t k = 0; k < number_precursors; ++k)
+      xi_g[k] = xi[k] + 0.5 * gamma * h * dxi[k];
+    implicit_solve(interpolate(times, rho, t + gamma * h),
+                   0.5 * gamma * h, y_g, xi_g);
+
+    // BDF2 stage to t + h
+    y = c_1 * y_g - c_0 * y;
+    for (size_t k = 0; k < number_precursors; ++k)
+      xi[k] = c_1 * xi_g[k] - c_0 * xi[k];
+    implicit_solve(interpolate(times, rho, t + h), c_2 * h, y, xi);
+
+    p[n + 1] = y;
+  }
+}
+
+//---------------------------------------------------------------------------//
+double PointKinetics::interpolate(const vec_dbl &times,
+                                  const vec_dbl &rho,
+                                  const double   t) const
+{
+  if (t <= times[0]) return rho[0];
+  if (t >= times.back()) return rho.back();
+  size_t i = std::upper_bound(times.begin(), times.end(), t) -
+             times.begin() - 1;
+  double f = (t - times[i]) / (times[i + 1] - times[i]);
+  return (1.0 - f) * rho[i] + f * rho[i + 1];
+}
+
+//---------------------------------------------------------------------------//
+void PointKinetics::implicit_solve(const double  rho,
+                                   const double  c,
+                                   double       &p,
+                                   vec_dbl      &xi) const
+{
+  // Eliminate the precursors, xi_k = (b_k + c * beta_k / Lambda * p) /
+  // (1 + c * lambda_k), and solve for the amplitude.
+  double lhs = 1.0 - c * (rho - d_beta_eff) / d_generation_time;
+  double rhs = p;
+  for (size_t k = 0; k < xi.size(); ++k)
+  {
+    double den = 1.0 + c * d_lambda[k];
+    lhs -= c * d_lambda[k] * c * d_beta[k] / (d_generation_time * den);
+    rhs += c * d_lambda[k] * xi[k] / den;
+  }
+  p = rhs / lhs;
+  for (size_t k = 0; k < xi.size(); ++k)
+  {
+    xi[k] = (xi[k] + c * d_beta[k] * p / d_generation_time) /
+            (1.0 + c * d_lambda[k]);
+  }
+}
+
+//---------------------------------------------------------------------------//
+void PointKinetics::derivative(const double   rho,
+                               const double   p,
+                               const vec_dbl &xi,
+                               double        &dp,
+                               vec_dbl       &dxi) const
+{
+  dp = (rho - d_beta_eff) / d_generation_time * p;
+  for (size_t k = 0; k < xi.size(); ++k)
+  {
+    dp    += d_lambda[k] * xi[k];
+    dxi[k] = d_beta[k] / d_generation_time * p - d_lambda[k] * xi[k];
+  }
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of file PointKinetics.cc
+//---------------------------------------------------------------------------//
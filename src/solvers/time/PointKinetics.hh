@@ -0,0 +1,241 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   PointKinetics.hh
+ *  @author robertsj
+ *  @date   Mar 11, 2013
+ *  @brief  PointKinetics class definition.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_POINTKINETICS_HH_
+#define detran_POINTKINETICS_HH_
+
+#include "solvers/solvers_export.hh"
+#include "kinetics/KineticsMaterial.hh"
+#include "transport/State.hh"
+#include "geometry/Mesh.hh"
+#include "utilities/Definitions.hh"
+#include "utilities/SP.hh"
+
+namespace detran
+{
+
+/**
+ *  @class PointKinetics
+ *  @brief Point kinetics with parameters from a steady state
+ *
+ *  The amplitude \f$ p \f$ and precursor amplitudes \f$ \xi_k \f$ satisfy
+ *  @f[
+ *      \frac{dp}{dt} = \frac{\rho(t) - \beta}{\Lambda} p
+ *                     + \sum_k \lambda_k \xi_k \, , \qquad
+ *      \frac{d\xi_k}{dt} = \frac{\beta_k}{\Lambda} p - \lambda_k \xi_k \, ,
+ *  @f]
+ *  starting from \f$ p = 1 \f$ with the precursors at equilibrium.
+ *
+ *  The parameters are computed from a steady state \f$ \phi \f$ with
+ *  eigenvalue \f$ k \f$ and weight \f$ w \f$ as
+ *  @f[
+ *      \Lambda = \frac{\langle w, \phi/v \rangle}{\langle w, F \phi \rangle}
+ *      \, , \qquad
+ *      \beta_k = \frac{\langle w, \chi_{d,k} \beta_k \nu\Sigma_f \phi \rangle}
+ *                     {\langle w, F \phi \rangle} \, ,
+ *  @f]
+ *  where \f$ F = \chi \nu\Sigma_f / k \f$.  The weight should be the
+ *  adjoint scalar flux; if none is given, a unit weight is used, as
+ *  for quasi-static stepping in TimeStepper.
+ *
+ *  The reactivity of a perturbed material is found by first order
+ *  perturbation theory relative to the material of the steady state (see
+ *  reactivity), so reactivity edits need no further transport solves.
+ *  The reactivity during a transient is given as a table that is
+ *  linear in time; repeating a time gives a step.
+ *
+ *  The equations are stiff, since the prompt time constant
+ *  \f$ \Lambda/(\beta - \rho) \f$ is much shorter than the delayed ones.
+ *  They are integrated by TR-BDF2, a trapezoid stage followed by a
+ *  BDF2 stage, which is second order and L-stable, so steps much longer
+ *  than the prompt time constant damp the prompt jump rather than
+ *  ringing.  Each stage is linear, and the precursors are eliminated
+ *  exactly.
+ *
+ *  Many insertions can be evaluated at once with the batch solve,
+ *  which integrates them independently (and concurrently with OpenMP).
+ */
+class SOLVERS_EXPORT PointKinetics
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<PointKinetics>       SP_pointkinetics;
+  typedef KineticsMaterial::SP_material             SP_material;
+  typedef detran_geometry::Mesh::SP_mesh            SP_mesh;
+  typedef State::SP_state                           SP_state;
+  typedef detran_utilities::vec_int                 vec_int;
+  typedef detran_utilities::vec_dbl                 vec_dbl;
+  typedef detran_utilities::vec2_dbl                vec2_dbl;
+  typedef detran_utilities::vec3_dbl                vec3_dbl;
+  typedef detran_utilities::size_t                  size_t;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param material   Material of the steady state
+   *  @param mesh       Mesh
+   *  @param forward    Steady state, with its eigenvalue
+   *  @param adjoint    Adjoint state used as weight (optional)
+   */
+  PointKinetics(SP_material material,
+                SP_mesh     mesh,
+                SP_state    forward,
+                SP_state    adjoint = SP_state());
+
+  /**
+   *  @brief Constructor with given parameters
+   *  @param generation_time    Generation time
+   *  @param beta               Delayed neutron fractions
+   *  @param lambda             Decay constants
+   */
+  PointKinetics(const double    generation_time,
+                const vec_dbl  &beta,
+                const vec_dbl  &lambda);
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Reactivity of a perturbed material
+   *
+   *  The reactivity is relative to the steady state made critical
+   *  by \f$ F \f$, so a perturbation that changes the eigenvalue from
+   *  \f$ k \f$ to \f$ k' \f$ has \f$ \rho \approx 1 - k/k' \f$.
+   *  Changes in the diffusion coefficient are not included.
+   *
+   *  @param perturbed  Material with the same layout as the steady one
+   *  @return           First order reactivity
+   */
+  double reactivity(SP_material perturbed) const;
+
+  /// Set the reactivity table, linear between the given times.
+  void set_reactivity(const vec_dbl &times, const vec_dbl &rho);
+
+  /// Set a constant reactivity, i.e. a step inserted at t = 0.
+  void set_reactivity(const double rho);
+
+  /**
+   *  @brief Solve with the reactivity table
+   *  @param final_time     Final time
+   *  @param number_steps   Number of equal steps
+   */
+  void solve(const double final_time, const size_t number_steps);
+
+  /**
+   *  @brief Solve for many insertions
+   *  @param times          Reactivity table times for each insertion
+   *  @param rho            Reactivity table values for each insertion
+   *  @param final_time     Final time
+   *  @param number_steps   Number of equal steps
+   *  @return               Amplitude at each step for each insertion
+   */
+  vec2_dbl solve(const vec2_dbl &times,
+                 const vec2_dbl &rho,
+                 const double    final_time,
+                 const size_t    number_steps) const;
+
+  /// Amplitude at the end of the last solve
+  double amplitude() const {return d_amplitudes.back();}
+
+  /// Amplitude at each step of the last solve, starting at t = 0
+  const vec_dbl& amplitudes() const {return d_amplitudes;}
+
+  /// Precursor amplitudes at the end of the last solve
+  const vec_dbl& precursors() const {return d_precursors;}
+
+  /// Total delayed neutron fraction
+  double beta_eff() const {return d_beta_eff;}
+
+  /// Delayed neutron fraction of a precursor group
+  double beta(const size_t k) const {return d_beta[k];}
+
+  /// Decay constant of a precursor group
+  double lambda(const size_t k) const {return d_lambda[k];}
+
+  /// Generation time
+  double generation_time() const {return d_generation_time;}
+
+  /// Number of precursor groups
+  size_t number_precursor_groups() const {return d_beta.size();}
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Mesh
+  SP_mesh d_mesh;
+  /// Steady state and weight
+  SP_state d_forward;
+  SP_state d_adjoint;
+  /// Eigenvalue of the steady state
+  double d_keff;
+  /// Weighted production rate of the steady state
+  double d_production;
+  /// Cross sections of the steady state
+  vec2_dbl d_sigma_t;
+  vec2_dbl d_nu_sigma_f;
+  vec2_dbl d_chi;
+  vec3_dbl d_sigma_s;
+  /// Kinetics parameters
+  double d_generation_time;
+  vec_dbl d_beta;
+  vec_dbl d_lambda;
+  double d_beta_eff;
+  /// Reactivity table
+  vec_dbl d_times;
+  vec_dbl d_rho;
+  /// Results of the last solve
+  vec_dbl d_amplitudes;
+  vec_dbl d_precursors;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Integrate one insertion, storing the amplitude at each step.
+  void integrate(const vec_dbl  &times,
+                 const vec_dbl  &rho,
+                 const double    final_time,
+                 const size_t    number_steps,
+                 vec_dbl        &p,
+                 vec_dbl        &xi) const;
+
+  /// Reactivity from a table at a time
+  double interpolate(const vec_dbl &times,
+                     const vec_dbl &rho,
+                     const double   t) const;
+
+  /// Solve y - c * f(y) = b, in which y replaces b.
+  void implicit_solve(const double rho, const double c,
+                      double &p, vec_dbl &xi) const;
+
+  /// Evaluate f(y) at a reactivity.
+  void derivative(const double rho, const double p, const vec_dbl &xi,
+                  double &dp, vec_dbl &dxi) const;
+
+};
+
+} // end namespace detran
+
+#endif // detran_POINTKINETICS_HH_
+
+//---------------------------------------------------------------------------//
+//              end of file PointKinetics.hh
+//---------------------------------------------------------------------------//
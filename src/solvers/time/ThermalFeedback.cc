@@ -0,0 +1,230 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   ThermalFeedback.cc
+ *  @author robertsj
+ *  @date   Mar 4, 2013
+ *  @brief  ThermalFeedback member definitions.
+ */
+//---------------------------------------------------------------------------//
+
+#include "ThermalFeedback.hh"
+#include "kinetics/BDFCoefficients.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class D>
+ThermalFeedback<D>::ThermalFeedback(SP_input    input,
+                                    SP_mesh     mesh,
+                                    SP_material material)
+  : d_mesh(mesh)
+  , d_material(material)
+  , d_power_scale(1.0)
+  , d_power_density(100.0)
+  , d_fuel_heat_capacity(3.0)
+  , d_conductance(0.5)
+  , d_coolant_heat_capacity(4.0)
+  , d_coolant_velocity(300.0)
+  , d_inlet_temperature(565.0)
+  , d_inlet_density(0.74)
+  , d_density_coefficient(-0.0028)
+{
+  Require(input);
+  Require(d_mesh);
+  Require(d_mesh->dimension() == D::dimension);
+  Require(d_material);
+
+  if (input->check("th_power_density"))
+    d_power_density = input->template get<double>("th_power_density");
+  if (input->check("th_fuel_heat_capacity"))
+    d_fuel_heat_capacity = input->template get<double>("th_fuel_heat_capacity");
+  if (input->check("th_conductance"))
+    d_conductance = input->template get<double>("th_conductance");
+  if (input->check("th_coolant_heat_capacity"))
+    d_coolant_heat_capacity =
+      input->template get<double>("th_coolant_heat_capacity");
+  if (input->check("th_coolant_velocity"))
+    d_coolant_velocity = input->template get<double>("th_coolant_velocity");
+  if (input->check("th_inlet_temperature"))
+    d_inlet_temperature = input->template get<double>("th_inlet_temperature");
+  if (input->check("th_inlet_density"))
+    d_inlet_density = input->template get<double>("th_inlet_density");
+  if (input->check("th_density_coefficient"))
+    d_density_coefficient =
+      input->template get<double>("th_density_coefficient");
+  Insist(d_fuel_heat_capacity > 0.0 && d_coolant_heat_capacity > 0.0,
+         "The fuel and coolant heat capacities must be positive.");
+  Insist(d_conductance > 0.0 && d_coolant_velocity > 0.0,
+         "The conductance and coolant velocity must be positive.");
+
+  // Cells are ordered with the last axis slowest, so each plane
+  // normal to the flow is a contiguous block of cells.
+  d_number_planes = d_mesh->number_cells(D::dimension - 1);
+  d_plane_size    = d_mesh->number_cells() / d_number_planes;
+
+  size_t n = d_mesh->number_cells();
+  d_power.assign(n, 0.0);
+  d_physics = new MultiPhysics(END_VARIABLES);
+  d_physics->variable(FUEL_TEMPERATURE).assign(n, d_inlet_temperature);
+  d_physics->variable(COOLANT_TEMPERATURE).assign(n, d_inlet_temperature);
+  d_physics->variable(COOLANT_DENSITY).assign(n, d_inlet_density);
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void ThermalFeedback<D>::initialize(SP_state state)
+{
+  Require(state);
+
+  // Put the material in the state used by the stepper, i.e. with
+  // the fission cross section scaled by the eigenvalue.
+  d_material->update(0.0, 0.0, 1, false);
+
+  d_power_scale = 1.0;
+  compute_power(state);
+  double P = 0.0, V = 0.0;
+  for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+  {
+    if (d_power[i] <= 0.0) continue;
+    P += d_mesh->volume(i) * d_power[i];
+    V += d_mesh->volume(i);
+  }
+  Insist(P > 0.0, "The initial state must have a positive fission rate.");
+  d_power_scale = d_power_density * V / P;
+  for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+    d_power[i] *= d_power_scale;
+
+  // Steady state: each cell passes its power to the coolant.
+  vec_dbl &T_f = d_physics->variable(FUEL_TEMPERATURE);
+  vec_dbl &T_c = d_physics->variable(COOLANT_TEMPERATURE);
+  vec_dbl &rho = d_physics->variable(COOLANT_DENSITY);
+  for (size_t p = 0; p < d_number_planes; ++p)
+  {
+    double dz = d_mesh->width(D::dimension - 1, p);
+    double w  = d_coolant_heat_capacity * d_coolant_velocity / dz;
+    for (size_t r = 0; r < d_plane_size; ++r)
+    {
+      size_t i = p * d_plane_size + r;
+      double T_in = p ? T_c[i - d_plane_size] : d_inlet_temperature;
+      T_c[i] = T_in + d_power[i] / w;
+      T_f[i] = T_c[i] + d_power[i] / d_conductance;
+      rho[i] = density(T_c[i]);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void ThermalFeedback<D>::set_stepper(TimeStepper_T &stepper)
+{
+  stepper.set_multiphysics(d_physics, update_rhs, this);
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void ThermalFeedback<D>::update_rhs(void* data, TimeStepper_T* stepper,
+                                    double /* t */, double dt)
+{
+  Require(data);
+  Require(stepper);
+  ((ThermalFeedback<D>*) data)->update(stepper, dt, stepper->step_order());
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void ThermalFeedback<D>::compute_power(SP_state state)
+{
+  const vec_int &mat_map = d_mesh->mesh_map("MATERIAL");
+  d_power.assign(d_mesh->number_cells(), 0.0);
+  for (size_t g = 0; g < d_material->number_groups(); ++g)
+  {
+    const State::moments_type &phi = state->phi(g);
+    for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+      d_power[i] += d_material->sigma_f(mat_map[i], g) * phi[i];
+  }
+  for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+    d_power[i] *= d_power_scale;
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void ThermalFeedback<D>::update(TimeStepper_T *stepper,
+                                const double   dt,
+                                const size_t   order)
+{
+  Require(dt > 0.0);
+  Require(order >= 1 && order <= 6);
+
+  compute_power(stepper->state());
+
+  const double *a = bdf_coefs[order - 1];
+
+  double C_f = d_fuel_heat_capacity / dt;
+  double C_c = d_coolant_heat_capacity / dt;
+  double H   = d_conductance;
+
+  vec_dbl &T_f = d_physics->variable(FUEL_TEMPERATURE);
+  vec_dbl &T_c = d_physics->variable(COOLANT_TEMPERATURE);
+  vec_dbl &rho = d_physics->variable(COOLANT_DENSITY);
+
+  // History terms of each variable, sum_k a_k * y(n+1-k)
+  vec_dbl h_f(d_mesh->number_cells(), 0.0);
+  vec_dbl h_c(d_mesh->number_cells(), 0.0);
+  vec_dbl h_r(d_mesh->number_cells(), 0.0);
+  for (size_t k = 1; k <= order; ++k)
+  {
+    SP_multiphysics y = stepper->previous_multiphysics(k - 1);
+    const vec_dbl &y_f = y->variable(FUEL_TEMPERATURE);
+    const vec_dbl &y_c = y->variable(COOLANT_TEMPERATURE);
+    const vec_dbl &y_r = y->variable(COOLANT_DENSITY);
+    for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+    {
+      h_f[i] += a[k] * y_f[i];
+      h_c[i] += a[k] * y_c[i];
+      h_r[i] += a[k] * y_r[i];
+    }
+  }
+
+  // March from the inlet.  The cells of a plane are independent, and
+  // each solves the 2x2 system
+  //   (a0 C_f + H) T_f - H T_c          = q + C_f h_f
+  //   -H T_f + (a0 C_c + H + w) T_c     = w T_in + C_c h_c
+  // for its new temperatures.  The right hand side that the stepper
+  // turns back into these values, (a0 y - h) / dt, is stored.
+  vec_dbl T_in(d_plane_size, d_inlet_temperature);
+  for (size_t p = 0; p < d_number_planes; ++p)
+  {
+    double w   = d_coolant_heat_capacity * d_coolant_velocity /
+                 d_mesh->width(D::dimension - 1, p);
+    double A_f = a[0] * C_f + H;
+    double A_c = a[0] * C_c + H + w;
+    double det = A_f * A_c - H * H;
+    size_t i = p * d_plane_size;
+    for (size_t r = 0; r < d_plane_size; ++r, ++i)
+    {
+      double b_f = d_power[i] + C_f * h_f[i];
+      double b_c = w * T_in[r] + C_c * h_c[i];
+      double tf  = (A_c * b_f + H * b_c) / det;
+      double tc  = (A_f * b_c + H * b_f) / det;
+      T_in[r] = tc;
+      T_f[i]  = (a[0] * tf - h_f[i]) / dt;
+      T_c[i]  = (a[0] * tc - h_c[i]) / dt;
+      rho[i]  = (a[0] * density(tc) - h_r[i]) / dt;
+    }
+  }
+}
+
+//---------------------------------------------------------------------------//
+// EXPLICIT INSTANTIATIONS
+//---------------------------------------------------------------------------//
+
+SOLVERS_INSTANTIATE_EXPORT(ThermalFeedback<_1D>)
+SOLVERS_INSTANTIATE_EXPORT(ThermalFeedback<_2D>)
+SOLVERS_INSTANTIATE_EXPORT(ThermalFeedback<_3D>)
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of file ThermalFeedback.cc
+//---------------------------------------------------------------------------//
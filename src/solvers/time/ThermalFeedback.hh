@@ -0,0 +1,202 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   ThermalFeedback.hh
+ *  @author robertsj
+ *  @date   Mar 4, 2013
+ *  @brief  ThermalFeedback class definition.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_THERMALFEEDBACK_HH_
+#define detran_THERMALFEEDBACK_HH_
+
+#include "TimeStepper.hh"
+#include "kinetics/MultiPhysics.hh"
+#include "kinetics/TimeDependentMaterial.hh"
+#include "geometry/Mesh.hh"
+#include "transport/State.hh"
+#include "utilities/InputDB.hh"
+
+namespace detran
+{
+
+/**
+ *  @class ThermalFeedback
+ *  @brief Lumped fuel and coolant thermal hydraulics for kinetics feedback
+ *
+ *  Each cell holds a lumped fuel temperature \f$ T_f \f$ and a coolant
+ *  temperature \f$ T_c \f$.  The coolant flows along the last axis of
+ *  the mesh (x in 1D, y in 2D, and z in 3D), so that each row of cells
+ *  along that axis is a single-phase channel.  Per unit volume,
+ *  @f[
+ *      C_f \frac{dT_f}{dt} = q - H (T_f - T_c) \, ,
+ *  @f]
+ *  @f[
+ *      C_c \frac{dT_c}{dt} = H (T_f - T_c)
+ *                          - C_c v \frac{T_c - T_{c,in}}{\Delta z} \, ,
+ *  @f]
+ *  where \f$ q \f$ is the power density, \f$ H \f$ is the fuel-to-coolant
+ *  conductance, \f$ v \f$ is the coolant velocity, and \f$ T_{c,in} \f$
+ *  is the coolant temperature of the upstream cell (or the inlet).  The
+ *  coolant density is linear in its temperature.  The power density is
+ *  proportional to the fission rate and is normalized to a given average
+ *  over the fissile cells of the initial state.
+ *
+ *  The three variables are kept in a MultiPhysics, which a
+ *  TimeDependentMaterial can read to evaluate its cross sections.  Each
+ *  time the stepper asks for the right hand side, the equations are solved
+ *  implicitly with the stepper's BDF history, one plane of cells at a time
+ *  from the inlet, and the right hand side that reproduces that solution
+ *  is returned.  The feedback is therefore stable for any step size, and
+ *  it needs no user callback.
+ *
+ *  Relevant input database entries (units of cm, s, W, J, K, g):
+ *    - th_power_density (100.0)      average initial power density
+ *    - th_fuel_heat_capacity (3.0)   volumetric heat capacity of fuel
+ *    - th_conductance (0.5)          fuel-to-coolant conductance
+ *    - th_coolant_heat_capacity (4.0) volumetric heat capacity of coolant
+ *    - th_coolant_velocity (300.0)   coolant velocity
+ *    - th_inlet_temperature (565.0)  coolant inlet temperature
+ *    - th_inlet_density (0.74)       coolant density at the inlet
+ *    - th_density_coefficient (-0.0028) change in density per kelvin
+ *
+ *  Typical use:
+ *  @code
+ *    ThermalFeedback<_2D> th(input, mesh, material);
+ *    th.initialize(initial_state);
+ *    th.set_stepper(stepper);
+ *    stepper.solve(initial_state);
+ *  @endcode
+ */
+template <class D>
+class SOLVERS_EXPORT ThermalFeedback
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<ThermalFeedback>     SP_feedback;
+  typedef detran_utilities::InputDB::SP_input       SP_input;
+  typedef detran_geometry::Mesh::SP_mesh            SP_mesh;
+  typedef TimeDependentMaterial::SP_material        SP_material;
+  typedef State::SP_state                           SP_state;
+  typedef MultiPhysics::SP_multiphysics             SP_multiphysics;
+  typedef TimeStepper<D>                            TimeStepper_T;
+  typedef detran_utilities::vec_int                 vec_int;
+  typedef detran_utilities::vec_dbl                 vec_dbl;
+  typedef detran_utilities::size_t                  size_t;
+
+  /// Multiphysics variables
+  enum variables
+  {
+    FUEL_TEMPERATURE, COOLANT_TEMPERATURE, COOLANT_DENSITY, END_VARIABLES
+  };
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param input      Input database
+   *  @param mesh       Mesh, whose last axis is the flow direction
+   *  @param material   Time-dependent material defining the fission rate
+   */
+  ThermalFeedback(SP_input    input,
+                  SP_mesh     mesh,
+                  SP_material material);
+
+  /// SP constructor
+  static SP_feedback Create(SP_input    input,
+                            SP_mesh     mesh,
+                            SP_material material)
+  {
+    SP_feedback p(new ThermalFeedback(input, mesh, material));
+    return p;
+  }
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Normalize the power and set the steady-state temperatures
+   *  @param state  Initial state
+   */
+  void initialize(SP_state state);
+
+  /// Couple the feedback to a time stepper.
+  void set_stepper(TimeStepper_T &stepper);
+
+  /// The fuel and coolant variables, which the material can share.
+  SP_multiphysics physics() {return d_physics;}
+
+  /// Power density in each cell for the last state given
+  const vec_dbl& power() const {return d_power;}
+
+  /// Power per unit fission rate
+  double power_scale() const {return d_power_scale;}
+
+  /// Coolant density at a given temperature
+  double density(const double T) const
+  {
+    return d_inlet_density + d_density_coefficient * (T - d_inlet_temperature);
+  }
+
+  /// Right hand side callback for the time stepper
+  static void update_rhs(void* data, TimeStepper_T* stepper,
+                         double t, double dt);
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Mesh
+  SP_mesh d_mesh;
+  /// Material
+  SP_material d_material;
+  /// Fuel temperature, coolant temperature, and coolant density
+  SP_multiphysics d_physics;
+  /// Power density
+  vec_dbl d_power;
+  /// Power per unit fission rate
+  double d_power_scale;
+  /// Average initial power density over fissile cells
+  double d_power_density;
+  /// Model parameters
+  double d_fuel_heat_capacity;
+  double d_conductance;
+  double d_coolant_heat_capacity;
+  double d_coolant_velocity;
+  double d_inlet_temperature;
+  double d_inlet_density;
+  double d_density_coefficient;
+  /// Number of planes along the flow axis and cells per plane
+  size_t d_number_planes;
+  size_t d_plane_size;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Compute the fission rate density in each cell, scaled by d_power_scale.
+  void compute_power(SP_state state);
+
+  /// Solve the BDF step of the given order and write the equivalent
+  /// right hand side.
+  void update(TimeStepper_T *stepper, const double dt, const size_t order);
+
+};
+
+} // end namespace detran
+
+#endif // detran_THERMALFEEDBACK_HH_
+
+//---------------------------------------------------------------------------//
+//              end of file ThermalFeedback.hh
+//---------------------------------------------------------------------------//
@@ -13,6 +13,7 @@
 #include "kinetics/SyntheticDiscreteSource.hh"
 #include "kinetics/SyntheticMomentSource.hh"
 #include "utilities/MathUtilities.hh"
+#include <algorithm>
 #include <cmath>
 
 namespace detran
@@ -33,8 +34,10 @@ TimeStepper<D>::TimeStepper(SP_input       input,
   , d_dt(1.0)
   , d_step_factor(1.0)
   , d_final_time(10.0)
+  , d_initial_time(0.0)
   , d_number_steps(10)
   , d_scheme(BDF1)
+  , d_step_order(1)
   , d_do_output(false)
   , d_fixup(false)
   , d_no_extrapolation(false)
@@ -44,6 +47,20 @@ TimeStepper<D>::TimeStepper(SP_input       input,
   , d_tolerance(1e-4)
   , d_maximum_iterations(1)
   , d_update_multiphysics_rhs(NULL)
+  , d_adaptive(false)
+  , d_rel_tol(1e-4)
+  , d_abs_tol(1e-8)
+  , d_min_dt(1e-12)
+  , d_max_dt(0.0)
+  , d_number_accepted(0)
+  , d_number_rejected(0)
+  , d_quasistatic(false)
+  , d_number_substeps(100)
+  , d_K_0(0.0)
+  , d_amplitude(1.0)
+  , d_rho(0.0)
+  , d_omega_method(false)
+  , d_anderson_depth(0)
 {
   // Preconditions
   Require(d_input);
@@ -54,7 +71,19 @@ TimeStepper<D>::TimeStepper(SP_input       input,
   // SETUP FIXED SOLVER
   //-------------------------------------------------------------------------//
 
-  d_solver = new Fixed_T(d_input, d_material, d_mesh, d_multiply);
+  // Start the Krylov solves of each iterate from the previous one.  The
+  // fixed source solver gets its own copy of the input so that the
+  // caller's database is left untouched.
+  SP_input fixed_input = d_input;
+  if (d_input->check("ts_warm_start") &&
+      d_input->template get<int>("ts_warm_start"))
+  {
+    fixed_input = new detran_utilities::InputDB(*d_input);
+    fixed_input->template put<int>("inner_warm_start", 1);
+    fixed_input->template put<int>("outer_warm_start", 1);
+  }
+
+  d_solver = new Fixed_T(fixed_input, d_material, d_mesh, d_multiply);
   d_solver->setup();
 
   // Extract the quadrature, state, and fission.  This lets us fill the
@@ -130,14 +159,60 @@ TimeStepper<D>::TimeStepper(SP_input       input,
     d_maximum_iterations = d_input->template get<int>("ts_max_iters");
   if (d_input->check("ts_tolerance"))
     d_tolerance = d_input->template get<double>("ts_tolerance");
+  if (d_input->check("ts_anderson_depth"))
+    d_anderson_depth = d_input->template get<int>("ts_anderson_depth");
+
+  // Get the adaptive stepping parameters.
+  if (d_input->check("ts_adaptive"))
+    d_adaptive = d_input->template get<int>("ts_adaptive");
+  if (d_adaptive)
+  {
+    Insist(d_scheme != IMP, "Adaptive time steps require a BDF scheme.");
+    if (d_input->check("ts_rel_tol"))
+      d_rel_tol = d_input->template get<double>("ts_rel_tol");
+    if (d_input->check("ts_abs_tol"))
+      d_abs_tol = d_input->template get<double>("ts_abs_tol");
+    if (d_input->check("ts_min_step_size"))
+      d_min_dt = d_input->template get<double>("ts_min_step_size");
+    d_max_dt = d_final_time;
+    if (d_input->check("ts_max_step_size"))
+      d_max_dt = d_input->template get<double>("ts_max_step_size");
+    Insist(d_rel_tol > 0.0 || d_abs_tol > 0.0,
+           "Adaptive time steps need a positive tolerance.");
+    Assert(d_min_dt > 0.0 && d_max_dt >= d_min_dt);
+    // The step count is unknown, so only ts_max_steps limits it.
+    d_number_steps = 1000000;
+    if (d_input->check("ts_max_steps"))
+      d_number_steps = d_input->template get<int>("ts_max_steps");
+  }
+
+  // Get the quasi-static parameters.
+  if (d_input->check("ts_quasistatic"))
+    d_quasistatic = d_input->template get<int>("ts_quasistatic");
+  if (d_quasistatic)
+  {
+    Insist(d_multiply, "Quasi-static steps require fission.");
+    Insist(d_scheme != IMP && !d_adaptive,
+           "Quasi-static steps require fixed BDF steps.");
+    if (d_input->check("ts_qs_substeps"))
+      d_number_substeps = d_input->template get<int>("ts_qs_substeps");
+    Assert(d_number_substeps > 0);
+  }
+
+  // Get the frequency transform flag.
+  if (d_input->check("ts_omega"))
+    d_omega_method = d_input->template get<int>("ts_omega");
+  if (d_omega_method) d_omega.assign(d_mesh->number_cells(), 0.0);
 
   //-------------------------------------------------------------------------//
   // SETUP STATE AND PRECURSOR VECTORS
   //-------------------------------------------------------------------------//
 
-  d_states.resize(d_order);
-  if (d_multiply) d_precursors.resize(d_order);
-  for (int i = 0; i < d_order; ++i)
+  // The predictor of the highest order needs one more previous solution.
+  size_t number_history = d_adaptive ? d_order + 1 : d_order;
+  d_states.resize(number_history);
+  if (d_multiply) d_precursors.resize(number_history);
+  for (int i = 0; i < number_history; ++i)
   {
     d_states[i] = new State(d_input, d_mesh, d_quadrature);
     if (d_multiply)
@@ -146,13 +221,28 @@ TimeStepper<D>::TimeStepper(SP_input       input,
                                        d_mesh->number_cells());
     }
   }
-  d_state_0 = new State(d_input, d_mesh, d_quadrature);
+  // Adaptive steps interpolate the history into scratch entries, which
+  // are allocated once.  The latest solution is never interpolated.
+  if (d_adaptive)
+  {
+    d_states_scratch.resize(number_history);
+    if (d_multiply) d_precursors_scratch.resize(number_history);
+    for (int i = 1; i < number_history; ++i)
+    {
+      d_states_scratch[i] = new State(d_input, d_mesh, d_quadrature);
+      if (d_multiply)
+      {
+        d_precursors_scratch[i] =
+          new Precursors(d_material->number_precursor_groups(),
+                         d_mesh->number_cells());
+      }
+    }
+  }
+  d_phi_0 = d_state->all_phi();
   if (d_multiply)
   {
-    d_precursor   = new Precursors(d_material->number_precursor_groups(),
-                                   d_mesh->number_cells());
-    d_precursor_0 = new Precursors(d_material->number_precursor_groups(),
-                                   d_mesh->number_cells());
+    d_precursor = new Precursors(d_material->number_precursor_groups(),
+                                 d_mesh->number_cells());
   }
 
   //-------------------------------------------------------------------------//
@@ -195,14 +285,17 @@ void TimeStepper<D>::solve(SP_state initial_state)
   // Preconditions
   Require(initial_state);
 
-  // Set the state and initialize the precursors if necessary.  For
-  // now, we assume steady state for the first order steps.
+  // Set the state and initialize the precursors if necessary.  Unless
+  // given, the precursors are assumed to be at steady state.
   // Update the material, sources, and solver
-  d_material->update(0.0, 0, 1, false);
+  d_material->update(d_initial_time, 0, 1, false);
   d_state = initial_state;
   *d_solver->state() = *d_state;
 
-  initialize_precursors();
+  if (d_initial_precursor && d_precursor)
+    *d_precursor = *d_initial_precursor;
+  else
+    initialize_precursors();
   *d_states[0] = *d_state;
   if (d_precursors.size()) *d_precursors[0] = *d_precursor;
   if (d_multiphysics) *d_vec_multiphysics[0] = *d_multiphysics;
@@ -211,14 +304,32 @@ void TimeStepper<D>::solve(SP_state initial_state)
   // Output the initial state
   if (d_do_output) d_silooutput->write_time_flux(0, d_state, d_discrete);
 
+  // Store the initial amplitude and kinetics parameters
+  if (d_quasistatic) initialize_quasistatic();
+
+  // The first step has no frequency estimate.
+  if (d_omega_method)
+  {
+    d_omega.assign(d_mesh->number_cells(), 0.0);
+    d_syntheticsource->set_frequency(d_omega);
+  }
+
   // Set the solver
   d_solver->set_solver();
 
   // Call the monitor, if present.  [data, this, step, time, dt, order, conv]
-  if (d_monitor_level) d_monitor(d_monitor_data, this, 0, 0.0, d_dt, 1, true);
+  if (d_monitor_level)
+    d_monitor(d_monitor_data, this, 0, d_initial_time, d_dt, 1, true);
+
+  if (d_adaptive)
+  {
+    solve_adaptive();
+    load_solution();
+    return;
+  }
 
   // Perform time steps
-  double  t = 0.0;
+  double  t = d_initial_time;
   double dt = 0.0;
   for (size_t i = 1; i <= d_number_steps; ++i)
   {
@@ -235,42 +346,325 @@ void TimeStepper<D>::solve(SP_state initial_state)
     //if (d_scheme == IMP) flag = true;
     if (d_scheme == IMP || (order == 1 && d_order > 1)) flag = true;
     if (d_no_extrapolation && !(d_scheme == IMP)) flag = false;
+    if (d_quasistatic) flag = false;
 
     // Set the temporary time step
     dt = d_dt;
     if (flag) dt = 0.5 * d_dt;
 
     // Perform fixed-point iterations
-    size_t iteration = 1;
-    for (; iteration <= d_maximum_iterations; ++iteration)
+    iterate(i, t, dt, order, flag);
+
+    // Correct the predicted flux with the amplitude
+    if (d_quasistatic) correct_amplitude(t, dt, order);
+
+    // Estimate the frequencies for the next step
+    if (d_omega_method) update_frequency(d_dt);
+
+    // Cycle the previous iterates and store the current solution
+    store_solution(order);
+
+    // Output the initial state
+    if (d_do_output) d_silooutput->write_time_flux(i+1, d_states[0], true);
+
+  } // end time steps
+
+  load_solution();
+
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::solve(SP_state       initial_state,
+                           SP_precursors  initial_precursors,
+                           const double   t_0,
+                           const double   t_1)
+{
+  Require(t_1 > t_0);
+
+  // Save the settings for the whole transient.
+  double dt           = d_dt;
+  double final_time   = d_final_time;
+  size_t number_steps = d_number_steps;
+
+  d_initial_time      = t_0;
+  d_final_time        = t_1;
+  d_initial_precursor = initial_precursors;
+  if (!d_adaptive)
+  {
+    d_number_steps = std::ceil((t_1 - t_0) / dt * (1.0 - 1.0e-12));
+    d_dt = (t_1 - t_0) / d_number_steps;
+  }
+  solve(initial_state);
+
+  d_dt                = dt;
+  d_final_time        = final_time;
+  d_number_steps      = number_steps;
+  d_initial_time      = 0.0;
+  d_initial_precursor = SP_precursors();
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::iterate(const size_t i,
+                             const double t,
+                             const double dt,
+                             const size_t order,
+                             const bool   flag)
+{
+  size_t iteration = 1;
+  for (; iteration <= d_maximum_iterations; ++iteration)
+  {
+    // Perform the time step
+    step(t, dt, order, flag);
+
+    // The next iterate uses the frequencies of this step.
+    if (d_omega_method && d_maximum_iterations > 1)
+      update_frequency(flag ? 2.0 * dt : dt);
+
+    bool converged = check_convergence();
+    if (iteration == d_maximum_iterations) converged = true;
+
+    // Accelerate the next iterate.
+    if (!converged && d_anderson_depth) anderson_mix(iteration);
+
+    // Call the monitor, if present.  The full step is reported.
+    if (d_monitor_level)
     {
-      // Perform the time step
-      step(t, dt, order, flag);
+      d_monitor(d_monitor_data, this, i, t, flag ? 2.0 * dt : dt,
+                iteration, converged);
+    }
 
-      bool converged = check_convergence();
-      if (iteration == d_maximum_iterations) converged = true;
+    if (converged) break;
 
-      // Call the monitor, if present.
-      if (d_monitor_level)
-        d_monitor(d_monitor_data, this, i, t, d_dt, iteration, converged);
+  } // end iterations
+}
 
-      if (converged) break;
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::solve_adaptive()
+{
+  // Safety factor and bounds on the change of step size
+  const double safety = 0.9, min_factor = 0.2, max_factor = 2.0;
 
-    } // end iterations
+  // Number of valid previous solutions, which limits the order.
+  size_t number_history = 1;
+  size_t order = 1;
+  double t  = d_initial_time;
+  double dt = std::min(d_dt, d_max_dt);
+  d_number_accepted = 0;
+  d_number_rejected = 0;
 
-    // Cycle the previous iterates and copy the current solution
-    cycle_states_precursors(order);
-    *d_states[0] = *d_state;
-    if (d_multiply) *d_precursors[0] = *d_precursor;
-    if (d_multiphysics) *d_vec_multiphysics[0] = *d_multiphysics;
+  for (size_t i = 1; i <= d_number_steps; ++i)
+  {
+    if (t >= d_final_time * (1.0 - 1.0e-12)) break;
 
-    // Output the initial state
-    if (d_do_output) d_silooutput->write_time_flux(i+1, d_state, true);
+    // Take the step, repeating it with smaller steps until the error
+    // is acceptable.
+    for (;;)
+    {
+      // End exactly at the final time.
+      if (t + dt > d_final_time)
+      {
+        double dt_end = d_final_time - t;
+        interpolate_history(dt_end / dt, std::min(number_history, order + 1));
+        number_history = std::min(number_history, order + 1);
+        dt = dt_end;
+      }
+
+      iterate(i, t + dt, dt, order, false);
+
+      // The first steps of an order can not be estimated.
+      if (number_history < order + 1) break;
+      double error = estimate_error(order);
+      if (error <= 1.0) break;
+
+      // Reject the step, restore the previous solution, and reduce the step.
+      // As between steps, only the scalar flux of the state is needed.
+      ++d_number_rejected;
+      d_state->all_phi() = d_states[0]->all_phi();
+      if (d_multiphysics) *d_multiphysics = *d_vec_multiphysics[0];
+      double factor =
+        std::max(min_factor, safety * std::pow(error, -1.0 / (order + 1)));
+      Insist(dt * factor >= d_min_dt,
+             "The adaptive time step fell below the minimum step size.");
+      interpolate_history(factor, order + 1);
+      number_history = order + 1;
+      dt *= factor;
+    }
+    t += dt;
+    ++d_number_accepted;
+
+    // Select the order and size of the next step.  An order can be
+    // estimated only if its predictor had enough previous solutions.
+    size_t new_order = order;
+    double new_factor = 0.0;
+    size_t q_min = order > 1 ? order - 1 : 1;
+    size_t q_max = std::min(order + 1, d_order);
+    for (size_t q = q_min; q <= q_max; ++q)
+    {
+      if (number_history < q + 1) continue;
+      double error = estimate_error(q);
+      double factor = max_factor;
+      if (error > 0.0)
+      {
+        factor = std::min(max_factor,
+                          safety * std::pow(error, -1.0 / (q + 1)));
+      }
+      if (factor > new_factor)
+      {
+        new_order  = q;
+        new_factor = factor;
+      }
+    }
+    // Keep the step unless it changes appreciably, since every change
+    // requires interpolation.
+    if (new_factor == 0.0 || (new_factor >= 1.0 && new_factor < 1.2))
+      new_factor = 1.0;
+    new_factor = std::max(min_factor, new_factor);
+    if (dt * new_factor > d_max_dt) new_factor = d_max_dt / dt;
+
+    // Estimate the frequencies for the next step
+    if (d_omega_method) update_frequency(dt);
+
+    // Cycle the previous iterates and store the current solution
+    store_solution(order);
+    number_history = std::min(number_history + 1, (size_t)d_states.size());
+
+    if (d_do_output) d_silooutput->write_time_flux(i+1, d_states[0], true);
+
+    order = new_order;
+    if (new_factor != 1.0)
+    {
+      interpolate_history(new_factor, std::min(number_history, order + 1));
+      number_history = std::min(number_history, order + 1);
+      dt *= new_factor;
+    }
 
   } // end time steps
 
 }
 
+//---------------------------------------------------------------------------//
+template <class D>
+double TimeStepper<D>::estimate_error(const size_t order)
+{
+  Require(order + 1 <= d_states.size());
+
+  // Predictor through the previous order + 1 solutions
+  vec_dbl w = lagrange_weights(1.0, order + 1);
+  double error = 0.0;
+  size_t n = 0;
+  for (size_t g = 0; g < d_number_groups; ++g)
+  {
+    const State::moments_type &phi = d_state->phi(g);
+    for (size_t i = 0; i < phi.size(); ++i, ++n)
+    {
+      double predictor = 0.0;
+      for (size_t j = 0; j <= order; ++j)
+        predictor += w[j] * d_states[j]->phi(g)[i];
+      double e = (phi[i] - predictor) /
+                 (d_abs_tol + d_rel_tol * std::abs(phi[i]));
+      error += e * e;
+    }
+  }
+  return std::sqrt(error / n) / (order + 1);
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::interpolate_history(const double ratio, const size_t n)
+{
+  Require(ratio > 0.0);
+  Require(n >= 1 && n <= d_states.size());
+
+  Require(d_states_scratch.size() == d_states.size());
+  Require(d_precursors_scratch.size() == d_precursors.size());
+  Require(d_multiphysics_scratch.size() == d_vec_multiphysics.size());
+
+  // The latest solution is kept.  Each earlier solution j is replaced by
+  // the interpolant at j steps of the new size, which is built in the
+  // scratch entry j and then swapped into the history.
+  for (size_t j = 1; j < d_states.size(); ++j)
+  {
+    vec_dbl w = lagrange_weights(-(double)j * ratio, n);
+
+    State &state = *d_states_scratch[j];
+    for (size_t g = 0; g < d_number_groups; ++g)
+    {
+      State::moments_type &phi = state.phi(g);
+      for (size_t i = 0; i < phi.size(); ++i)
+      {
+        phi[i] = 0.0;
+        for (size_t m = 0; m < n; ++m)
+          phi[i] += w[m] * d_states[m]->phi(g)[i];
+      }
+      if (!d_discrete) continue;
+      for (size_t o = 0; o < d_quadrature->number_octants(); ++o)
+      {
+        for (size_t a = 0; a < d_quadrature->number_angles_octant(); ++a)
+        {
+          State::angular_flux_type &psi = state.psi(g, o, a);
+          for (size_t i = 0; i < psi.size(); ++i)
+          {
+            psi[i] = 0.0;
+            for (size_t m = 0; m < n; ++m)
+              psi[i] += w[m] * d_states[m]->psi(g, o, a)[i];
+          }
+        }
+      }
+    }
+
+    if (d_precursors.size())
+    {
+      for (size_t k = 0; k < d_material->number_precursor_groups(); ++k)
+      {
+        Precursors::vec_dbl &C = d_precursors_scratch[j]->C(k);
+        for (size_t i = 0; i < C.size(); ++i)
+        {
+          C[i] = 0.0;
+          for (size_t m = 0; m < n; ++m)
+            C[i] += w[m] * d_precursors[m]->C(k)[i];
+        }
+      }
+    }
+
+    if (d_vec_multiphysics.size())
+    {
+      MultiPhysics &physics = *d_multiphysics_scratch[j];
+      for (size_t k = 0; k < physics.number_variables(); ++k)
+      {
+        MultiPhysics::vec_dbl &P = physics.variable(k);
+        for (size_t i = 0; i < P.size(); ++i)
+        {
+          P[i] = 0.0;
+          for (size_t m = 0; m < n; ++m)
+            P[i] += w[m] * d_vec_multiphysics[m]->variable(k)[i];
+        }
+      }
+    }
+  }
+  for (size_t j = 1; j < d_states.size(); ++j)
+  {
+    d_states[j]->swap(*d_states_scratch[j]);
+    if (d_precursors.size()) d_precursors[j]->swap(*d_precursors_scratch[j]);
+    if (d_vec_multiphysics.size())
+      d_vec_multiphysics[j]->swap(*d_multiphysics_scratch[j]);
+  }
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+typename TimeStepper<D>::vec_dbl
+TimeStepper<D>::lagrange_weights(const double x, const size_t n)
+{
+  vec_dbl w(n, 1.0);
+  for (size_t m = 0; m < n; ++m)
+    for (size_t l = 0; l < n; ++l)
+      if (l != m) w[m] *= (x + (double)l) / ((double)l - (double)m);
+  return w;
+}
+
 //---------------------------------------------------------------------------//
 template <class D>
 void TimeStepper<D>::step(const double t,
@@ -289,9 +683,8 @@ void TimeStepper<D>::step(const double t,
   update_sources(t_eval, dt, order);
   d_solver->update();
 
-  // Save old state
-  *d_state_0 = *d_state;
-  if (d_multiply) *d_precursor_0 = *d_precursor;
+  // Save the old scalar flux for the convergence check
+  d_phi_0 = d_state->all_phi();
   if (d_multiphysics) *d_multiphysics_0 = *d_multiphysics;
 
   // Solve the MG problem for the new state
@@ -309,6 +702,238 @@ void TimeStepper<D>::step(const double t,
   if (flag) extrapolate();
 }
 
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::initialize_quasistatic()
+{
+  Require(d_state);
+  if (d_weight)
+  {
+    Insist(d_weight->number_groups() == d_number_groups,
+           "The quasi-static weight must have one flux per group.");
+  }
+
+  // The material is at the initial time without synthetic components.
+  size_t number_materials = d_material->number_materials();
+  d_sigma_t_0.assign(d_number_groups, vec_dbl(number_materials, 0.0));
+  d_nu_sigma_f_0.assign(d_number_groups, vec_dbl(number_materials, 0.0));
+  d_chi_0.assign(d_number_groups, vec_dbl(number_materials, 0.0));
+  d_sigma_s_0.assign(d_number_groups, vec2_dbl(d_number_groups,
+                     vec_dbl(number_materials, 0.0)));
+  for (size_t g = 0; g < d_number_groups; ++g)
+  {
+    for (size_t m = 0; m < number_materials; ++m)
+    {
+      d_sigma_t_0[g][m]    = d_material->sigma_t(m, g);
+      d_nu_sigma_f_0[g][m] = d_material->nu_sigma_f(m, g);
+      d_chi_0[g][m]        = d_material->chi(m, g);
+      for (size_t gp = 0; gp < d_number_groups; ++gp)
+        d_sigma_s_0[g][gp][m] = d_material->sigma_s(m, g, gp);
+    }
+  }
+
+  vec_dbl products = kinetics_products(d_state);
+  d_K_0 = products[0];
+  Insist(d_K_0 > 0.0, "The quasi-static weighted density must be positive.");
+  d_amplitude = 1.0;
+  d_rho = products[2] / products[1];
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+typename TimeStepper<D>::vec_dbl
+TimeStepper<D>::kinetics_products(SP_state state)
+{
+  Require(state);
+  const vec_int &mt = d_mesh->mesh_map("MATERIAL");
+  size_t number_precursors = d_material->number_precursor_groups();
+
+  vec_dbl products(3 + number_precursors, 0.0);
+  for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
+  {
+    size_t m = mt[cell];
+    double V = d_mesh->volume(cell);
+
+    // Fission density now and with the initial cross sections
+    double fd = 0.0, fd_0 = 0.0;
+    for (size_t g = 0; g < d_number_groups; ++g)
+    {
+      fd   += d_material->nu_sigma_f(m, g) * state->phi(g)[cell];
+      fd_0 += d_nu_sigma_f_0[g][m] * state->phi(g)[cell];
+    }
+
+    for (size_t g = 0; g < d_number_groups; ++g)
+    {
+      double w = d_weight ? d_weight->phi(g)[cell] * V : V;
+      double phi = state->phi(g)[cell];
+      products[0] += w * phi / d_material->velocity(g);
+      products[1] += w * d_material->chi(m, g) * fd;
+
+      // Change in the net production relative to the initial material
+      double delta = d_material->chi(m, g) * fd - d_chi_0[g][m] * fd_0 -
+                     (d_material->sigma_t(m, g) - d_sigma_t_0[g][m]) * phi;
+      for (size_t gp = 0; gp < d_number_groups; ++gp)
+      {
+        delta += (d_material->sigma_s(m, g, gp) - d_sigma_s_0[g][gp][m]) *
+                 state->phi(gp)[cell];
+      }
+      products[2] += w * delta;
+
+      for (size_t k = 0; k < number_precursors; ++k)
+      {
+        products[3 + k] += w * d_material->chi_d(m, k, g) *
+                           d_material->beta(m, k) * fd;
+      }
+    }
+  }
+  return products;
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::correct_amplitude(const double t,
+                                       const double dt,
+                                       const size_t order)
+{
+  const vec_int &mt = d_mesh->mesh_map("MATERIAL");
+  size_t number_precursors = d_material->number_precursor_groups();
+
+  // Precursor amplitudes at the beginning of the step
+  vec_dbl xi(number_precursors, 0.0);
+  for (size_t k = 0; k < number_precursors; ++k)
+  {
+    for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
+    {
+      size_t m = mt[cell];
+      double chi_d = 0.0;
+      for (size_t g = 0; g < d_number_groups; ++g)
+      {
+        double w = d_weight ? d_weight->phi(g)[cell] : 1.0;
+        chi_d += w * d_material->chi_d(m, k, g);
+      }
+      xi[k] += d_mesh->volume(cell) * chi_d * d_precursors[0]->C(k)[cell];
+    }
+    xi[k] /= d_K_0;
+  }
+
+  // Weighted densities of the shapes at the ends of the step
+  d_material->update(t - dt, dt, order, false);
+  double K_a = kinetics_products(d_states[0])[0];
+  double K_b = kinetics_products(d_state)[0];
+
+  // Integrate the amplitude using the trapezoid rule.  The parameters
+  // at each substep use the material and external sources at that time
+  // and the shape interpolated between the ends of the step.
+  double h = dt / d_number_substeps;
+  double p = d_amplitude;
+  double alpha[2], source[2];
+  vec2_dbl gamma(2, vec_dbl(number_precursors, 0.0));
+  vec_dbl X(number_precursors, 0.0), Y(number_precursors, 0.0);
+  for (size_t n = 0; n <= d_number_substeps; ++n)
+  {
+    // Parameters at the end of the substep
+    double f = double(n) / d_number_substeps;
+    double t_n = t - dt + f * dt;
+    d_material->update(t_n, dt, order, false);
+    vec_dbl products_a = kinetics_products(d_states[0]);
+    vec_dbl products_b = kinetics_products(d_state);
+    vec_dbl products(products_a.size(), 0.0);
+    for (size_t i = 0; i < products.size(); ++i)
+      products[i] = (1.0 - f) * products_a[i] / K_a + f * products_b[i] / K_b;
+    double beta = 0.0;
+    for (size_t k = 0; k < number_precursors; ++k)
+    {
+      gamma[1][k] = products[3 + k] / products[0];
+      beta += products[3 + k];
+    }
+    alpha[1] = (products[2] - beta) / products[0];
+    source[1] = 0.0;
+    for (size_t i = 0; i < d_sources.size(); ++i)
+    {
+      d_sources[i]->set_time(t_n);
+      for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
+      {
+        for (size_t g = 0; g < d_number_groups; ++g)
+        {
+          double w = d_weight ? d_weight->phi(g)[cell] : 1.0;
+          source[1] += w * d_mesh->volume(cell) *
+                       d_sources[i]->source(cell, g) / d_K_0;
+        }
+      }
+    }
+    d_rho = products[2] / products[1];
+
+    if (n > 0)
+    {
+      // Eliminate the new precursor amplitudes, xi_k = X_k + Y_k * p.
+      double lhs = 1.0 - 0.5 * h * alpha[1];
+      double rhs = p * (1.0 + 0.5 * h * alpha[0]) +
+                   0.5 * h * (source[0] + source[1]);
+      for (size_t k = 0; k < number_precursors; ++k)
+      {
+        double lambda = d_material->lambda(k);
+        double den = 1.0 + 0.5 * h * lambda;
+        X[k] = (xi[k] * (1.0 - 0.5 * h * lambda) +
+                0.5 * h * gamma[0][k] * p) / den;
+        Y[k] = 0.5 * h * gamma[1][k] / den;
+        lhs -= 0.5 * h * lambda * Y[k];
+        rhs += 0.5 * h * lambda * (xi[k] + X[k]);
+      }
+      p = rhs / lhs;
+      for (size_t k = 0; k < number_precursors; ++k)
+        xi[k] = X[k] + Y[k] * p;
+    }
+
+    alpha[0]  = alpha[1];
+    source[0] = source[1];
+    gamma[0]  = gamma[1];
+  }
+
+  // Scale the predicted flux to the amplitude.
+  double factor = p * d_K_0 / K_b;
+  for (size_t g = 0; g < d_number_groups; ++g)
+  {
+    detran_utilities::vec_scale(d_state->phi(g), factor);
+    if (!d_discrete) continue;
+    for (size_t o = 0; o < d_quadrature->number_octants(); ++o)
+      for (size_t a = 0; a < d_quadrature->number_angles_octant(); ++a)
+        detran_utilities::vec_scale(d_state->psi(g, o, a), factor);
+  }
+  d_amplitude = p;
+
+  // Recompute the precursors with the corrected flux.
+  update_precursors(t, dt, order);
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::update_frequency(const double dt)
+{
+  Require(dt > 0.0);
+  Require(d_omega.size() == d_mesh->number_cells());
+
+  // The delayed source is smooth through prompt jumps, so it is used
+  // if present.  Otherwise, the total scalar flux is used.
+  size_t np = d_multiply ? d_material->number_precursor_groups() : 0;
+  for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
+  {
+    double y = 0.0, y_0 = 0.0;
+    for (size_t i = 0; i < np; ++i)
+    {
+      y   += d_material->lambda(i) * d_precursor->C(i)[cell];
+      y_0 += d_material->lambda(i) * d_precursors[0]->C(i)[cell];
+    }
+    for (size_t g = 0; g < d_number_groups && !np; ++g)
+    {
+      y   += d_state->phi(g)[cell];
+      y_0 += d_states[0]->phi(g)[cell];
+    }
+    d_omega[cell] = 0.0;
+    if (y > 0.0 && y_0 > 0.0) d_omega[cell] = std::log(y / y_0) / dt;
+  }
+  d_syntheticsource->set_frequency(d_omega);
+}
+
 //---------------------------------------------------------------------------//
 template <class D>
 void TimeStepper<D>::initialize_precursors()
@@ -328,22 +953,27 @@ void TimeStepper<D>::initialize_precursors()
    *  fission source
    */
 
-  d_fissionsource->update();
-  const State::moments_type &fd = d_fissionsource->density();
+  // The fission density is formed directly from the flux and then
+  // given to the fission source, as its update would do.
   const vec_int &mt = d_mesh->mesh_map("MATERIAL");
-
-  for (int i = 0; i < d_material->number_precursor_groups(); ++i)
+  size_t np = d_material->number_precursor_groups();
+  int number_cells = d_mesh->number_cells();
+  d_fission_density.resize(number_cells);
+#ifdef DETRAN_ENABLE_OPENMP
+  #pragma omp parallel for
+#endif
+  for (int cell = 0; cell < number_cells; ++cell)
   {
-    double inv_lambda = 1.0 / d_material->lambda(i);
-    for (int cell = 0; cell < d_mesh->number_cells(); ++cell)
-    {
-      d_precursor->C(i)[cell] =
-        inv_lambda * d_material->beta(mt[cell], i) * fd[cell];
-      //printf("%16.9f %16.9f %16.9f %16.9f \n", fd[cell], inv_lambda, d_material->beta(mt[cell], i), d_precursor->C(i)[cell]);
-    }
+    size_t m = mt[cell];
+    double fd = 0.0;
+    for (size_t g = 0; g < d_number_groups; ++g)
+      fd += d_material->nu_sigma_f(m, g) * d_state->phi(g)[cell];
+    for (size_t i = 0; i < np; ++i)
+      d_precursor->C(i)[cell] = d_material->beta(m, i) * fd /
+                                d_material->lambda(i);
+    d_fission_density[cell] = fd;
   }
-
-
+  d_fissionsource->set_density(d_fission_density);
 }
 
 //---------------------------------------------------------------------------//
@@ -361,11 +991,6 @@ void TimeStepper<D>::update_precursors(const double t,
   // Update the solver
   d_solver->update();
 
-  // Update the fission density.
-  d_fissionsource->update();
-  const State::moments_type &fd = d_fissionsource->density();
-  const vec_int &mt = d_mesh->mesh_map("MATERIAL");
-
   /*
    *  The precursors are defined via
    *    f(t, C_i(t)) =  dC/dt = -lambda_i*C_i + beta_i * sum_g X_ig F_g phi_g
@@ -374,27 +999,48 @@ void TimeStepper<D>::update_precursors(const double t,
    *   (a_j/Delta + lambda)*C_i(n+1) = -(1/Delta) sum_{j=1}^{m} a_J * C_i(n+j+1) + beta_i * sum_g X_ig F_g phi_g
    */
 
-  for (size_t i = 0; i < d_material->number_precursor_groups(); ++i)
+  // Coefficients of the fission density and previous precursors
+  size_t np = d_material->number_precursor_groups();
+  vec_dbl A(np, 0.0);
+  vec2_dbl B(order, vec_dbl(np, 0.0));
+  for (size_t i = 0; i < np; ++i)
   {
     double lambda = d_material->lambda(i);
-    double A = dt / (bdf_coefs[order-1][0]  + dt * lambda);
+    A[i] = dt / (bdf_coefs[order-1][0]  + dt * lambda);
+    for (size_t j = 1; j <= order; ++j)
+      B[j - 1][i] = (A[i] / dt) * bdf_coefs[order-1][j];
+  }
 
-    for (int cell = 0; cell < d_mesh->number_cells(); ++cell)
-    {
-      // Add flux contribution
-      double value = 0.0;
-      value +=  A * d_material->beta(mt[cell], i) * fd[cell];
+  // The cells are independent.  The fission density is formed directly
+  // from the flux, and the material and history factors of a cell are
+  // found once for all precursor groups.
+  const vec_int &mt = d_mesh->mesh_map("MATERIAL");
+  int number_cells = d_mesh->number_cells();
+  d_fission_density.resize(number_cells);
+#ifdef DETRAN_ENABLE_OPENMP
+  #pragma omp parallel for
+#endif
+  for (int cell = 0; cell < number_cells; ++cell)
+  {
+    size_t m = mt[cell];
+    double fd = 0.0;
+    for (size_t g = 0; g < d_number_groups; ++g)
+      fd += d_material->nu_sigma_f(m, g) * d_state->phi(g)[cell];
 
-      // Add previous time step contributions
-      for (size_t j = 1; j <= order; ++j)
-      {
-        //std::cout << " C cont " << d_precursors[j-1]->C(i)[cell] <<  " " << (A / dt) * bdf_coefs[order-1][j] * d_precursors[j-1]->C(i)[cell] << std::endl;
-        value += (A / dt) * bdf_coefs[order-1][j] *
-                 d_precursors[j-1]->C(i)[cell];
-      }
+    double f[6];
+    for (size_t j = 0; j < order; ++j)
+      f[j] = d_syntheticsource->history_factor(cell, j, dt, order);
+
+    for (size_t i = 0; i < np; ++i)
+    {
+      double value = A[i] * d_material->beta(m, i) * fd;
+      for (size_t j = 0; j < order; ++j)
+        value += B[j][i] * f[j] * d_precursors[j]->C(i)[cell];
       d_precursor->C(i)[cell] = value;
     }
+    d_fission_density[cell] = fd;
   }
+  d_fissionsource->set_density(d_fission_density);
 }
 
 //---------------------------------------------------------------------------//
@@ -405,9 +1051,8 @@ void TimeStepper<D>::update_multiphysics(const double t,
 {
   // Update the right hand side.  The result is placed into
   // the working vector d_multiphysics
-  std::cout << " P before = " << d_multiphysics->variable(0)[0] - 300.0 << std::endl;
+  d_step_order = order;
   d_update_multiphysics_rhs(d_multiphysics_data, this, t, dt);
-  std::cout << " P after = " << d_multiphysics->variable(0)[0] << std::endl;
 
   // Loop through and compute
   //  y(n+1) = (1/a0) * ( dt*rhs + sum of bdf terms )
@@ -417,10 +1062,6 @@ void TimeStepper<D>::update_multiphysics(const double t,
     // Reference to P(n+1)
     MultiPhysics::vec_dbl &P   = d_multiphysics->variable(i);
 
-    //std::cout << " Pold[0]=" << P[0] << std::endl;
-    printf("delP = %18.12e \n", P[0]);
-    printf("Pold[0] = %18.12e \n", d_vec_multiphysics[0]->variable(0)[0]);
-
     // Loop over all elements (usually spatial)
     for (int j = 0; j < P.size(); ++j)
     {
@@ -430,7 +1071,6 @@ void TimeStepper<D>::update_multiphysics(const double t,
         v += bdf_coefs[order-1][k] * d_vec_multiphysics[k-1]->variable(i)[j];
       P[j] = v / bdf_coefs[order-1][0];
     } // end element loop
-    std::cout << " Pnew[0]=" << P[0] - 300.0 << std::endl;
   } // end variable loop
 }
 
@@ -439,39 +1079,48 @@ template <class D>
 void TimeStepper<D>::cycle_states_precursors(const size_t order)
 {
   // Preconditions
-  Require(d_states.size() == d_order);
+  Require(d_states.size() >= d_order);
   Require(order <= d_order);
 
-  SP_state        tmp_state;
-  SP_precursors   tmp_precursors;
-  SP_multiphysics tmp_multiphysics;
-
-  // Save the first element.
-  tmp_state = d_states[d_order - 1];
+  // Rotate right by one, so the oldest entry becomes the first.
+  std::rotate(d_states.begin(), d_states.end() - 1, d_states.end());
   if (d_precursors.size())
-    tmp_precursors = d_precursors[d_order - 1];
+  {
+    std::rotate(d_precursors.begin(), d_precursors.end() - 1,
+                d_precursors.end());
+  }
   if (d_vec_multiphysics.size())
-    tmp_multiphysics = d_vec_multiphysics[d_order - 1];
-
-  for (size_t i = 0; i < d_order - 1; ++i)
   {
-    size_t j = d_order - i - 1;
-
-//    std::cout << " j=" << j << " order=" << order
-//              << " dorder=" << d_order << " phi=" << d_states[j]->phi(0)[0] << std::endl;
-
-
-    d_states[j] = d_states[j - 1];
-    if (d_precursors.size())
-      d_precursors[j] = d_precursors[j-1];
-    if (d_vec_multiphysics.size())
-      d_vec_multiphysics[j] = d_vec_multiphysics[j-1];
+    std::rotate(d_vec_multiphysics.begin(), d_vec_multiphysics.end() - 1,
+                d_vec_multiphysics.end());
+  }
+}
 
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::store_solution(const size_t order)
+{
+  cycle_states_precursors(order);
+  d_states[0]->swap(*d_state);
+  d_state->all_phi() = d_states[0]->all_phi();
+  d_state->set_eigenvalue(d_states[0]->eigenvalue());
+  if (d_multiply) d_precursors[0]->swap(*d_precursor);
+  if (d_multiphysics)
+  {
+    // The working vector is shared with the caller, so it keeps the
+    // latest values, like the scalar flux above.
+    d_vec_multiphysics[0]->swap(*d_multiphysics);
+    for (size_t i = 0; i < d_multiphysics->number_variables(); ++i)
+      d_multiphysics->variable(i) = d_vec_multiphysics[0]->variable(i);
   }
-  d_states[0] = tmp_state;
-  if (d_precursors.size()) d_precursors[0] = tmp_precursors;
-  if (d_vec_multiphysics.size()) d_vec_multiphysics[0] = tmp_multiphysics;
+}
 
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::load_solution()
+{
+  *d_state = *d_states[0];
+  if (d_multiply) *d_precursor = *d_precursors[0];
 }
 
 //---------------------------------------------------------------------------//
@@ -512,22 +1161,34 @@ void TimeStepper<D>::extrapolate()
     {
       // Clear the scalar flux.  We'll rebuild it with the extrapolated
       // angular flux.
-      for (size_t i = 0; i < d_mesh->number_cells(); ++i)
-        d_state->phi(g)[i] = 0.0;
+      State::moments_type &phi = d_state->phi(g);
+      for (size_t i = 0; i < phi.size(); ++i)
+        phi[i] = 0.0;
       for (size_t o = 0; o < d_quadrature->number_octants(); ++o)
       {
         for (size_t a = 0; a < d_quadrature->number_angles_octant(); ++a)
         {
-          // Updated flux
+          // Updated flux, extrapolated in place, and previous flux
           State::angular_flux_type &psi  = d_state->psi(g, o, a);
-          // Previous flux
           const State::angular_flux_type &psi0 = d_states[0]->psi(g, o, a);
-          for (size_t i = 0; i < d_mesh->number_cells(); ++i)
+          double w = d_quadrature->weight(a);
+          // The fixup is hoisted so the loops have no branches.
+          if (d_fixup)
           {
-            psi[i] = 2.0 * psi[i] - psi0[i];
-            if (d_fixup && psi[i] < 0.0) psi[i] = 0.0;
-            d_state->phi(g)[i] += d_quadrature->weight(a) * psi[i];
-          } // end cell
+            for (size_t i = 0; i < psi.size(); ++i)
+            {
+              psi[i] = std::max(2.0 * psi[i] - psi0[i], 0.0);
+              phi[i] += w * psi[i];
+            }
+          }
+          else
+          {
+            for (size_t i = 0; i < psi.size(); ++i)
+            {
+              psi[i] = 2.0 * psi[i] - psi0[i];
+              phi[i] += w * psi[i];
+            }
+          }
         } // end angle
       } // end octant
     } // end group
@@ -573,16 +1234,29 @@ void TimeStepper<D>::extrapolate()
 template <class D>
 bool TimeStepper<D>::check_convergence()
 {
-  // Currently, this implementation only checks convergence
-  // based on successive flux iterates.
-
-  double d_residual_norm = 0.0;
+  // The flux change is relative in each cell, while the change of each
+  // multiphysics variable is relative to its norm, since variables
+  // like power may vanish.
+  d_residual_norm = 0.0;
   for (size_t g = 0; g < d_material->number_groups(); ++g)
   {
     double nr_g = detran_utilities::
-      norm_relative_residual(d_state->phi(g), d_state_0->phi(g));
+      norm_relative_residual(d_state->phi(g), d_phi_0[g]);
     d_residual_norm += nr_g * nr_g;
   }
+  for (size_t i = 0; d_multiphysics && i < d_multiphysics->number_variables();
+       ++i)
+  {
+    const vec_dbl &P   = d_multiphysics->variable(i);
+    const vec_dbl &P_0 = d_multiphysics_0->variable(i);
+    double dP = 0.0, norm_P = 0.0;
+    for (size_t j = 0; j < P.size(); ++j)
+    {
+      dP     += (P[j] - P_0[j]) * (P[j] - P_0[j]);
+      norm_P += P[j] * P[j];
+    }
+    if (norm_P > 0.0) d_residual_norm += dP / norm_P;
+  }
   d_residual_norm = std::sqrt(d_residual_norm);
 
   if (d_residual_norm < d_tolerance)
@@ -591,6 +1265,160 @@ bool TimeStepper<D>::check_convergence()
 
 }
 
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::pack(const State::group_moments_type &phi,
+                          SP_multiphysics                  physics,
+                          vec_dbl                         &x) const
+{
+  Require(d_anderson_scale.size() > 0);
+  size_t n = 0;
+  for (size_t g = 0; g < phi.size(); ++g)
+    for (size_t i = 0; i < phi[g].size(); ++i, ++n)
+      x[n] = d_anderson_scale[0] * phi[g][i];
+  for (size_t v = 0; physics && v < physics->number_variables(); ++v)
+  {
+    const vec_dbl &P = physics->variable(v);
+    for (size_t i = 0; i < P.size(); ++i, ++n)
+      x[n] = d_anderson_scale[v + 1] * P[i];
+  }
+  Ensure(n == x.size());
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::unpack(const vec_dbl &x)
+{
+  size_t n = 0;
+  for (size_t g = 0; g < d_number_groups; ++g)
+  {
+    State::moments_type &phi = d_state->phi(g);
+    for (size_t i = 0; i < phi.size(); ++i, ++n)
+      phi[i] = x[n] / d_anderson_scale[0];
+  }
+  for (size_t v = 0; d_multiphysics && v < d_multiphysics->number_variables();
+       ++v)
+  {
+    vec_dbl &P = d_multiphysics->variable(v);
+    for (size_t i = 0; i < P.size(); ++i, ++n)
+      P[i] = x[n] / d_anderson_scale[v + 1];
+  }
+  Ensure(n == x.size());
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+void TimeStepper<D>::anderson_mix(const size_t iteration)
+{
+  Require(iteration > 0);
+
+  // Size of the combined state
+  size_t number_variables = d_multiphysics ?
+                            d_multiphysics->number_variables() : 0;
+  size_t n = d_number_groups * d_state->phi(0).size();
+  for (size_t v = 0; v < number_variables; ++v)
+    n += d_multiphysics->variable(v).size();
+
+  // Scale each part by its norm at the first iterate of the step.
+  if (iteration == 1)
+  {
+    d_anderson_scale.assign(number_variables + 1, 0.0);
+    for (size_t g = 0; g < d_number_groups; ++g)
+      for (size_t i = 0; i < d_state->phi(g).size(); ++i)
+        d_anderson_scale[0] += std::pow(d_state->phi(g)[i], 2);
+    for (size_t v = 0; v < number_variables; ++v)
+    {
+      const vec_dbl &P = d_multiphysics->variable(v);
+      for (size_t i = 0; i < P.size(); ++i)
+        d_anderson_scale[v + 1] += P[i] * P[i];
+    }
+    for (size_t v = 0; v <= number_variables; ++v)
+    {
+      d_anderson_scale[v] = d_anderson_scale[v] > 0.0 ?
+                            1.0 / std::sqrt(d_anderson_scale[v]) : 1.0;
+    }
+    d_anderson_dg.clear();
+    d_anderson_df.clear();
+    d_anderson_g.resize(n);
+    d_anderson_f.resize(n);
+  }
+
+  // Picard image g = G(x) and residual f = G(x) - x of this iterate
+  vec_dbl g(n, 0.0), f(n, 0.0);
+  pack(d_state->all_phi(), d_multiphysics, g);
+  pack(d_phi_0, d_multiphysics_0, f);
+  for (size_t i = 0; i < n; ++i)
+    f[i] = g[i] - f[i];
+
+  // Add the newest differences, dropping the oldest beyond the depth.
+  if (iteration > 1)
+  {
+    if (d_anderson_dg.size() == d_anderson_depth)
+    {
+      d_anderson_dg.erase(d_anderson_dg.begin());
+      d_anderson_df.erase(d_anderson_df.begin());
+    }
+    d_anderson_dg.push_back(g);
+    d_anderson_df.push_back(f);
+    for (size_t i = 0; i < n; ++i)
+    {
+      d_anderson_dg.back()[i] -= d_anderson_g[i];
+      d_anderson_df.back()[i] -= d_anderson_f[i];
+    }
+  }
+  d_anderson_g = g;
+  d_anderson_f = f;
+  size_t m = d_anderson_df.size();
+  if (!m) return;
+
+  // Solve the normal equations (dF' dF) gamma = dF' f by Gaussian
+  // elimination with partial pivoting.  A small shift on the diagonal
+  // guards against nearly dependent differences.
+  vec2_dbl A(m, vec_dbl(m + 1, 0.0));
+  double trace = 0.0;
+  for (size_t i = 0; i < m; ++i)
+  {
+    for (size_t j = 0; j < m; ++j)
+    {
+      for (size_t k = 0; k < n; ++k)
+        A[i][j] += d_anderson_df[i][k] * d_anderson_df[j][k];
+    }
+    for (size_t k = 0; k < n; ++k)
+      A[i][m] += d_anderson_df[i][k] * f[k];
+    trace += A[i][i];
+  }
+  if (trace == 0.0) return;
+  for (size_t i = 0; i < m; ++i)
+    A[i][i] += 1.0e-12 * trace;
+  for (size_t i = 0; i < m; ++i)
+  {
+    size_t p = i;
+    for (size_t j = i + 1; j < m; ++j)
+      if (std::abs(A[j][i]) > std::abs(A[p][i])) p = j;
+    std::swap(A[i], A[p]);
+    for (size_t j = i + 1; j < m; ++j)
+    {
+      double r = A[j][i] / A[i][i];
+      for (size_t k = i; k <= m; ++k)
+        A[j][k] -= r * A[i][k];
+    }
+  }
+  vec_dbl gamma(m, 0.0);
+  for (int i = m - 1; i >= 0; --i)
+  {
+    double v = A[i][m];
+    for (size_t j = i + 1; j < m; ++j)
+      v -= A[i][j] * gamma[j];
+    gamma[i] = v / A[i][i];
+  }
+
+  // Mixed iterate
+  for (size_t i = 0; i < m; ++i)
+    for (size_t k = 0; k < n; ++k)
+      g[k] -= gamma[i] * d_anderson_dg[i][k];
+  unpack(g);
+}
+
 //---------------------------------------------------------------------------//
 template <class D>
 void TimeStepper<D>::
@@ -602,21 +1430,23 @@ set_multiphysics(SP_multiphysics ic,
   Require(ic);
   Require(update_multiphysics_rhs);
 
-  std::cout << " ic T=" << ic->variable(0)[0] << std::endl;
-
   d_multiphysics            = ic;
   d_update_multiphysics_rhs = update_multiphysics_rhs;
   d_multiphysics_data       = multiphysics_data;
 
   // Create previous physics states
-  d_vec_multiphysics.resize(d_order);
+  d_vec_multiphysics.resize(d_states.size());
   d_multiphysics_0 = new MultiPhysics(*ic);
-  for (int i = 0; i < d_order; ++i)
+  for (int i = 0; i < d_vec_multiphysics.size(); ++i)
   {
     d_vec_multiphysics[i] = new MultiPhysics(*ic);
   }
-  std::cout << d_vec_multiphysics[0]->variable(0)[0] << std::endl;
-  std::cout << " ic T=" << d_multiphysics->variable(0)[0] << std::endl;
+  if (d_adaptive)
+  {
+    d_multiphysics_scratch.resize(d_states.size());
+    for (int i = 1; i < d_multiphysics_scratch.size(); ++i)
+      d_multiphysics_scratch[i] = new MultiPhysics(*ic);
+  }
 }
 
 
@@ -634,11 +1464,12 @@ void ts_default_monitor(void* data,
   if (!ts->monitor_level()) return;
   if (step == 0 && it == 1)
   {
-    printf(" step        t       dt   iter \n");
-    printf("-------------------------------\n");
+    printf(" step        t       dt   iter    residual \n");
+    printf("-------------------------------------------\n");
   }
-  //            0   0.1000   0.0500      1
-  printf(" %4i %8.4f %8.4f   %4i \n", step, t, dt, it);
+  //            0   0.1000   0.0500      1   1.000e-05
+  printf(" %4i %8.4f %8.4f   %4i   %9.3e \n", step, t, dt, it,
+         ts->residual_norm());
 }
 
 //---------------------------------------------------------------------------//
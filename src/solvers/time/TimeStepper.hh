@@ -34,6 +34,111 @@ namespace detran
  *  Available time stepping options are the BDF methods of
  *  order 1 through 6 and the implicit midpoint rule.
  *
+ *  With ts_adaptive, the BDF methods select the step size and order
+ *  automatically.  After each step of order \f$ q \f$, the local
+ *  truncation error is estimated from the difference between the
+ *  solution and the polynomial predictor through the previous
+ *  \f$ q+1 \f$ solutions,
+ *  @f[
+ *      \epsilon_q = \frac{\| \phi_{n+1} - \phi^{(0)}_{n+1} \|}{q+1} \, ,
+ *  @f]
+ *  using the weighted RMS norm of the scalar flux with weights
+ *  \f$ 1/(a + r|\phi|) \f$.  A step with \f$ \epsilon_q > 1 \f$ is
+ *  rejected and repeated with a smaller step.  Otherwise, the errors
+ *  of orders \f$ q-1 \f$, \f$ q \f$, and \f$ q+1 \f$ are estimated,
+ *  and the order allowing the largest next step is selected, up to
+ *  the order of ts_scheme.  The BDF coefficients assume equal steps,
+ *  so when the step changes, the previous solutions are interpolated
+ *  to the new step spacing.  The order is increased only after a step
+ *  of constant size.
+ *
+ *  Relevant database parameters for adaptive stepping:
+ *    - ts_adaptive         -- use adaptive steps (default 0)
+ *    - ts_rel_tol          -- relative error tolerance, r (default 1e-4)
+ *    - ts_abs_tol          -- absolute error tolerance, a (default 1e-8)
+ *    - ts_min_step_size    -- smallest step before failing (default 1e-12)
+ *    - ts_max_step_size    -- largest step (default ts_final_time)
+ *  The initial step is ts_step_size, and ts_max_steps limits the
+ *  number of accepted steps.
+ *
+ *  With ts_quasistatic, the predictor-corrector quasi-static (PCQS)
+ *  method is used.  Each step is a predictor solved as usual, after
+ *  which the amplitude \f$ p = \langle w, \phi/v \rangle / K_0 \f$ is
+ *  integrated with the point kinetics equations
+ *  @f[
+ *      \frac{dp}{dt} = \frac{\rho - \beta}{\Lambda} p
+ *                     + \sum_k \lambda_k \xi_k + s \, , \qquad
+ *      \frac{d\xi_k}{dt} = \frac{\beta_k}{\Lambda} p - \lambda_k \xi_k
+ *  @f]
+ *  on ts_qs_substeps substeps using the trapezoid rule.  The parameters
+ *  are weighted by \f$ w \f$ (see set_weight) and are evaluated at each
+ *  substep using the material at that time and the flux shape
+ *  interpolated between the beginning of the step and the predicted
+ *  flux at its end.  The reactivity is computed by first order
+ *  perturbation theory,
+ *  @f[
+ *      \rho = \frac{\langle w, (\delta F - \delta \Sigma_t
+ *                    + \delta \Sigma_s) \phi \rangle}
+ *                   {\langle w, F \phi \rangle} \, ,
+ *  @f]
+ *  relative to the material at the initial time, which is exact if
+ *  the initial state is critical and \f$ w \f$ is its adjoint scalar
+ *  flux.  Changes in the diffusion coefficient are not included.  The
+ *  predicted flux is then scaled to the amplitude, and the precursors
+ *  are recomputed from it.  Because the amplitude captures the fast
+ *  change, the flux shape is solved only on large steps.  Quasi-static
+ *  steps use BDF without extrapolation of the first steps.
+ *
+ *  Relevant database parameters for quasi-static stepping:
+ *    - ts_quasistatic      -- use PCQS (default 0)
+ *    - ts_qs_substeps      -- amplitude steps per step (default 100)
+ *
+ *  With ts_omega, the frequency transform is used to reduce the error
+ *  of BDF steps when the flux changes exponentially.  The frequency of
+ *  each cell is estimated from the step as
+ *  \f$ \omega = \ln(y_{n+1}/y_n)/\Delta \f$, where \f$ y \f$ is
+ *  the delayed source \f$ \sum_i \lambda_i C_i \f$, which is smooth
+ *  through prompt jumps, or the total scalar flux without precursors.
+ *  The previous fluxes and precursors are weighted for it (see
+ *  SyntheticSource), so both are exact for a flux
+ *  \f$ \propto e^{\omega t} \f$, and much larger steps can be taken
+ *  once the prompt transient has passed.  With ts_max_iters > 1, each
+ *  iterate of a step uses the frequency of the previous iterate;
+ *  otherwise, the frequency of the previous step is used.  Cells with
+ *  a nonpositive \f$ y \f$ get \f$ \omega = 0 \f$, as does the
+ *  first step.
+ *
+ *  Relevant database parameters for the frequency transform:
+ *    - ts_omega            -- use the frequency transform (default 0)
+ *
+ *  Each step is a Picard iteration between the flux and any
+ *  multiphysics variables: the material is updated with the current
+ *  iterate, the flux is solved, and the multiphysics variables are
+ *  advanced with the new flux.  The iteration stops when the relative
+ *  change of the combined state is below ts_tolerance or after
+ *  ts_max_iters iterations.  The default of one iteration lags the
+ *  feedback.  With ts_anderson_depth = m > 0, each iterate is
+ *  accelerated with Anderson mixing of the last m + 1 iterates,
+ *  @f[
+ *      x_{k+1} = G(x_k) - \sum_{i} \gamma_i \Delta G_i \, ,
+ *  @f]
+ *  where \f$ x = (\phi, T, \ldots) \f$ is the combined state, each
+ *  part scaled by its norm at the first iterate, \f$ G \f$ is one
+ *  Picard iteration, and \f$ \gamma \f$ minimizes the norm of the
+ *  mixed residual \f$ f_k - \sum_i \gamma_i \Delta f_i \f$ with
+ *  \f$ f = G(x) - x \f$.  The converged step keeps the unmixed
+ *  \f$ G(x_k) \f$, so the flux, precursors, and multiphysics
+ *  variables are consistent.  With ts_warm_start, the Krylov solves
+ *  of each iterate start from the flux of the previous iterate (see
+ *  inner_warm_start and outer_warm_start) rather than from the
+ *  uncollided flux.
+ *
+ *  Relevant database parameters for the nonlinear iteration:
+ *    - ts_max_iters        -- maximum Picard iterations (default 1)
+ *    - ts_tolerance        -- tolerance on the relative change (default 1e-4)
+ *    - ts_anderson_depth   -- number of Anderson differences (default 0)
+ *    - ts_warm_start       -- start Krylov solves from the last iterate
+ *                             (default 0)
  */
 
 template <class D>
@@ -74,6 +179,9 @@ public:
   typedef std::vector<SP_multiphysics>                    vec_multiphysics;
   typedef FissionSource::SP_fissionsource                 SP_fissionsource;
   typedef detran_utilities::vec_int                       vec_int;
+  typedef detran_utilities::vec_dbl                       vec_dbl;
+  typedef detran_utilities::vec2_dbl                      vec2_dbl;
+  typedef detran_utilities::vec3_dbl                      vec3_dbl;
   typedef detran_ioutils::SiloOutput::SP_silooutput       SP_silooutput;
   /// Pointer to callback function for monitoring
   typedef void (*monitor_pointer)
@@ -108,6 +216,24 @@ public:
   /// Solve
   void solve(SP_state initial_state);
 
+  /**
+   *  @brief Solve over one interval of time
+   *
+   *  Starting from the given state and precursors at \f$ t_0 \f$, steps
+   *  no longer than the input step size are taken to reach \f$ t_1 \f$
+   *  exactly.  The scheme starts again at first order.  This lets a
+   *  transient be split into slices, e.g. by Parareal.
+   *
+   *  @param initial_state        State at t_0
+   *  @param initial_precursors   Precursors at t_0 (or NULL for steady)
+   *  @param t_0                  Start time
+   *  @param t_1                  End time
+   */
+  void solve(SP_state       initial_state,
+             SP_precursors  initial_precursors,
+             const double   t_0,
+             const double   t_1);
+
   /// Getters
   SP_state state() {return d_state;}
   SP_mesh mesh() {return d_mesh;}
@@ -116,8 +242,34 @@ public:
   size_t monitor_level() const {return d_monitor_level;}
   SP_precursors precursor() {return d_precursor;}
   SP_multiphysics multiphysics() {return d_multiphysics;}
+  /// Multiphysics solution k + 1 steps back, i.e. k = 0 is the last step
+  SP_multiphysics previous_multiphysics(const size_t k)
+  {
+    Require(k < d_vec_multiphysics.size());
+    return d_vec_multiphysics[k];
+  }
   SP_fissionsource fissionsource() {return d_fissionsource;}
   double residual_norm() {return d_residual_norm;}
+  size_t number_accepted_steps() const {return d_number_accepted;}
+  size_t number_rejected_steps() const {return d_number_rejected;}
+  double amplitude() const {return d_amplitude;}
+  double reactivity() const {return d_rho;}
+  const vec_dbl& frequency() const {return d_omega;}
+  /// BDF order of the step being taken
+  size_t step_order() const {return d_step_order;}
+
+  /**
+   *  @brief Set the weight for quasi-static kinetics parameters
+   *
+   *  This should be the adjoint scalar flux of the initial state.
+   *  If not set, a unit weight is used, which is exact only if
+   *  the adjoint is flat.
+   */
+  void set_weight(SP_state weight)
+  {
+    Require(weight);
+    d_weight = weight;
+  }
 
   /// Set a user-defined monitor function.
   void set_monitor(monitor_pointer monitor, void* monitor_data = NULL)
@@ -165,15 +317,14 @@ private:
   /// Fission source
   SP_fissionsource d_fissionsource;
   /// Working state.  This is initially assigned the initial condition.
+  /// Between steps, only its scalar flux is kept (see store_solution).
   SP_state d_state;
   /// Working precursor vector.
   SP_precursors d_precursor;
   /// Working multiphysics vector
   SP_multiphysics d_multiphysics;
-  /// Previous state iterate.
-  SP_state d_state_0;
-  /// Previous precursor iterate.
-  SP_precursors d_precursor_0;
+  /// Previous scalar flux iterate.
+  State::group_moments_type d_phi_0;
   /// Previous multiphysics iterate
   SP_multiphysics d_multiphysics_0;
   /// Time step size
@@ -182,18 +333,29 @@ private:
   double d_step_factor;
   /// Final time
   double d_final_time;
+  /// Start time of the current solve
+  double d_initial_time;
+  /// Precursors at the start time, if not steady
+  SP_precursors d_initial_precursor;
   /// Number of time steps
   size_t d_number_steps;
   /// Integration scheme
   size_t d_scheme;
   /// Order of method.
   size_t d_order;
-  /// Vector of previous states
+  /// Order of the step being taken, which is lower for the first steps
+  /// and may change between steps in adaptive mode.
+  size_t d_step_order;
+  /// Vector of previous states, most recent first
   vec_states d_states;
   /// Vector of previous precursor concentrations
   vec_precursors d_precursors;
   /// Vector of previous physics iterates
   vec_multiphysics d_vec_multiphysics;
+  /// Scratch entries into which adaptive steps interpolate the history
+  vec_states d_states_scratch;
+  vec_precursors d_precursors_scratch;
+  vec_multiphysics d_multiphysics_scratch;
   /// Flag to write out time-dependent fluxes
   bool d_do_output;
   /// SILO output
@@ -222,6 +384,54 @@ private:
   multiphysics_pointer d_update_multiphysics_rhs;
   /// Multiphysics data
   void* d_multiphysics_data;
+  /// Flag for adaptive step size and order
+  bool d_adaptive;
+  /// Relative tolerance for the local error
+  double d_rel_tol;
+  /// Absolute tolerance for the local error
+  double d_abs_tol;
+  /// Minimum step size
+  double d_min_dt;
+  /// Maximum step size
+  double d_max_dt;
+  /// Number of accepted steps
+  size_t d_number_accepted;
+  /// Number of rejected steps
+  size_t d_number_rejected;
+  /// Flag for quasi-static steps
+  bool d_quasistatic;
+  /// Number of amplitude steps per step
+  size_t d_number_substeps;
+  /// Weight for kinetics parameters
+  SP_state d_weight;
+  /// Initial cross sections for the reactivity [group][material]
+  vec2_dbl d_sigma_t_0;
+  vec2_dbl d_nu_sigma_f_0;
+  vec2_dbl d_chi_0;
+  /// Initial scattering cross sections [group][from group][material]
+  vec3_dbl d_sigma_s_0;
+  /// Initial weighted neutron density
+  double d_K_0;
+  /// Amplitude
+  double d_amplitude;
+  /// Reactivity at the last step
+  double d_rho;
+  /// Flag for the frequency transform
+  bool d_omega_method;
+  /// Frequency of each cell
+  vec_dbl d_omega;
+  /// Fission density of the precursor update
+  vec_dbl d_fission_density;
+  /// Number of Anderson differences
+  size_t d_anderson_depth;
+  /// Scaling of each part of the combined state
+  vec_dbl d_anderson_scale;
+  /// Previous Picard image and residual
+  vec_dbl d_anderson_g;
+  vec_dbl d_anderson_f;
+  /// Differences of the Picard images and residuals [difference][unknown]
+  vec2_dbl d_anderson_dg;
+  vec2_dbl d_anderson_df;
 
   //-------------------------------------------------------------------------//
   // IMPLEMENTATION
@@ -240,10 +450,25 @@ private:
   /**
    *  @brief Cycle the states and precursors.
    *
-   *  The first term gets a copy of the initial state.
+   *  The history is a ring: the pointers are rotated so that the
+   *  oldest entry becomes the first, to be overwritten.
    */
   void cycle_states_precursors(const size_t order);
 
+  /**
+   *  @brief Store the working solution as the most recent in the history.
+   *
+   *  The storage of the working state and precursors is exchanged with
+   *  that of the oldest entry, so nothing is copied except the scalar
+   *  flux, which remains the initial guess of the next step.  The
+   *  angular flux and precursors of the working vectors are overwritten
+   *  by each step, so they need not be kept.
+   */
+  void store_solution(const size_t order);
+
+  /// Copy the most recent solution into the working vectors.
+  void load_solution();
+
   /// Update the synthetic and any external sources
   void update_sources(const double t, const double dt, const size_t order);
 
@@ -259,6 +484,75 @@ private:
   /// Check convergence
   bool check_convergence();
 
+  /// Perform fixed-point iterations for a step
+  void iterate(const size_t i,
+               const double t,
+               const double dt,
+               const size_t order,
+               const bool   flag);
+
+  /// Step with adaptive step size and order
+  void solve_adaptive();
+
+  /**
+   *  @brief Estimate the local error of an order from its predictor.
+   *  @param order  BDF order
+   *  @return       Weighted RMS norm of the error
+   */
+  double estimate_error(const size_t order);
+
+  /**
+   *  @brief Interpolate the previous solutions to a new step size.
+   *  @param ratio  Ratio of the new to the old step size
+   *  @param n      Number of previous solutions to interpolate from
+   */
+  void interpolate_history(const double ratio, const size_t n);
+
+  /**
+   *  @brief Lagrange weights for equally spaced points
+   *  @param x  Abscissa, in steps relative to the latest point
+   *  @param n  Number of points, at 0, -1, ..., -(n-1)
+   */
+  static vec_dbl lagrange_weights(const double x, const size_t n);
+
+  /// Store the initial cross sections and kinetics parameters
+  void initialize_quasistatic();
+
+  /**
+   *  @brief Weighted inner products defining the kinetics parameters
+   *
+   *  For the current material, these are the weighted density
+   *  \f$ \langle w, \phi/v \rangle \f$, the production
+   *  \f$ \langle w, F \phi \rangle \f$, the perturbation of the net
+   *  production, and the delayed production of each precursor group.
+   */
+  vec_dbl kinetics_products(SP_state state);
+
+  /// Integrate the amplitude over a step and correct the predicted flux.
+  void correct_amplitude(const double t, const double dt, const size_t order);
+
+  /// Estimate the frequency of each cell from the step just taken.
+  void update_frequency(const double dt);
+
+  /**
+   *  @brief Combine the flux and multiphysics variables into one vector
+   *  @param phi      Scalar flux
+   *  @param physics  Multiphysics variables (may be null)
+   *  @param x        Scaled combined state
+   */
+  void pack(const State::group_moments_type &phi,
+            SP_multiphysics physics,
+            vec_dbl &x) const;
+
+  /// Set the working flux and multiphysics variables from a combined state.
+  void unpack(const vec_dbl &x);
+
+  /**
+   *  @brief Anderson mixing of a Picard iterate
+   *  @param iteration  Picard iteration within the step, from 1
+   */
+  void anderson_mix(const size_t iteration);
+
 };
 
 /**
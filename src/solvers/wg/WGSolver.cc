@@ -12,6 +12,9 @@
 #include "transport/Sweeper2D.cc"
 #include "transport/Sweeper3D.cc"
 #include "transport/Sweeper2DMOC.cc"
+#include "transport/Sweeper3DMOC.cc"
+#include "transport/Sweeper2DUnstructured.cc"
+#include "transport/Sweeper3DUnstructured.cc"
 #include <iostream>
 
 namespace detran
@@ -120,6 +123,20 @@ inline bool WGSolver<_3D>::set_sweep(std::string equation)
       d_sweepsource);
     return true;
   }
+  else if (equation == "scmoc")
+  {
+    d_sweeper = new Sweeper3DMOC<Equation_SC_MOC>(
+      d_input, d_mesh, d_material, d_quadrature, d_state, d_boundary,
+      d_sweepsource);
+    return true;
+  }
+  else if (equation == "usd")
+  {
+    d_sweeper = new Sweeper3DUnstructured<Equation_SD_Unstructured>(
+      d_input, d_mesh, d_material, d_quadrature, d_state, d_boundary,
+      d_sweepsource);
+    return true;
+  }
   return false;
 }
 
@@ -157,6 +174,20 @@ inline bool WGSolver<_2D>::set_sweep(std::string equation)
       d_sweepsource);
     return true;
   }
+  else if (equation == "lsmoc")
+  {
+    d_sweeper = new Sweeper2DMOC<Equation_LS_MOC>(
+      d_input, d_mesh, d_material, d_quadrature, d_state, d_boundary,
+      d_sweepsource);
+    return true;
+  }
+  else if (equation == "usd")
+  {
+    d_sweeper = new Sweeper2DUnstructured<Equation_SD_Unstructured>(
+      d_input, d_mesh, d_material, d_quadrature, d_state, d_boundary,
+      d_sweepsource);
+    return true;
+  }
 
   return false;
 }
@@ -14,6 +14,9 @@
 #include "angle/MomentToDiscrete.hh"
 #include "transport/Sweeper.hh"
 #include "transport/Sweeper2DMOC.hh"
+#include "transport/Sweeper2DUnstructured.hh"
+#include "transport/Sweeper3DUnstructured.hh"
+#include "transport/Sweeper3DMOC.hh"
 #include "transport/SweepSource.hh"
 #include "utilities/MathUtilities.hh"
 #include <string>
@@ -167,6 +170,7 @@ protected:
   using Base::d_fissionsource;
   using Base::d_maximum_iterations;
   using Base::d_tolerance;
+  using Base::d_relative_tolerance;
   using Base::d_print_level;
   using Base::d_print_interval;
   using Base::d_adjoint;
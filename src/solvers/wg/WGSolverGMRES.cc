@@ -10,6 +10,7 @@
 #include "WGSolverGMRES.hh"
 #include "PC_DSA.hh"
 #include "callow/solver/LinearSolverCreator.hh"
+#include <algorithm>
 
 namespace detran
 {
@@ -25,6 +26,8 @@ WGSolverGMRES<D>::WGSolverGMRES(SP_state                  state,
                                 bool                      multiply)
  : Base(state, material, quadrature, boundary, q_e, q_f, multiply)
  , d_update_boundary_flux(false)
+ , d_solver_relative_tolerance(0.0)
+ , d_warm_start(false)
 {
   Require(d_input);
 
@@ -47,6 +50,7 @@ WGSolverGMRES<D>::WGSolverGMRES(SP_state                  state,
 
   d_solver = callow::LinearSolverCreator::Create(db);
   Assert(d_solver);
+  d_solver_relative_tolerance = d_solver->relative_tolerance();
 
   // Set the transport operator.  Note, no second db argument
   // is given, since that is for setting PC's.  We do that
@@ -63,6 +67,10 @@ WGSolverGMRES<D>::WGSolverGMRES(SP_state                  state,
         d_input->template get<int>("compute_boundary_flux");
     }
   }
+
+  // Check for starting from the current flux.
+  if (d_input->check("inner_warm_start"))
+    d_warm_start = d_input->template get<int>("inner_warm_start");
  // d_operator->compute_explicit("WGTO.out");
   //--------------------------------------------------------------------------//
   // PRECONDITIONER
@@ -104,6 +112,16 @@ WGSolverGMRES<D>::WGSolverGMRES(SP_state                  state,
 
 }
 
+//---------------------------------------------------------------------------//
+template <class D>
+void WGSolverGMRES<D>::set_relative_tolerance(double tol)
+{
+  Base::set_relative_tolerance(tol);
+  d_solver->set_tolerances(d_solver->absolute_tolerance(),
+                           std::max(d_solver_relative_tolerance, tol),
+                           d_solver->maximum_iterations());
+}
+
 //---------------------------------------------------------------------------//
 // EXPLICIT INSTANTIATIONS
 //---------------------------------------------------------------------------//
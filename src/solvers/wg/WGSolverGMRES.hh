@@ -44,6 +44,11 @@ namespace detran
  *  is in some way "similar" to the operator $\f \mathbf{A} \f$, and
  *  applying its inverse $\f \mathbf{M}^{-1} $\f can be done cheaply.
  *
+ *  By default, the initial guess is the uncollided flux.  With
+ *  inner_warm_start, it is the current flux of the state, which is
+ *  better when solving a sequence of similar problems, e.g. the
+ *  iterates of a nonlinear time step.
+ *
  *  @todo Figure out a good way to use extant boundary data in the source
  */
 //---------------------------------------------------------------------------//
@@ -111,6 +116,9 @@ public:
   /// Solve the within group equation.
   void solve(const size_t g);
 
+  /// Reset the relative tolerance, never loosening the user's own.
+  void set_relative_tolerance(double tol);
+
 private:
 
   //-------------------------------------------------------------------------//
@@ -127,6 +135,7 @@ private:
   using Base::d_sweeper;
   using Base::d_sweepsource;
   using Base::d_tolerance;
+  using Base::d_relative_tolerance;
   using Base::d_maximum_iterations;
   using Base::d_print_level;
   using Base::d_print_interval;
@@ -146,6 +155,10 @@ private:
   int d_reflective_solve_iterations;
   /// Flag to update the outgoing fluxes (default: false)
   bool d_update_boundary_flux;
+  /// Relative tolerance requested through the solver database
+  double d_solver_relative_tolerance;
+  /// Flag to start from the current flux (default: false)
+  bool d_warm_start;
 
   //-------------------------------------------------------------------------//
   // IMPLEMENTATION
@@ -46,8 +46,14 @@ inline void WGSolverGMRES<D>::solve(const size_t g)
   // SOLVE THE TRANSPORT EQUATION
   //-------------------------------------------------------------------------//
 
-  // Start with the uncollided flux as the initial guess
+  // Start with the uncollided flux as the initial guess, or with
+  // the current flux if requested.
   d_x->copy(d_b);
+  if (d_warm_start)
+  {
+    memcpy(&(*d_x)[0], &d_state->phi(g)[0],
+           d_state->moments_size()*sizeof(double));
+  }
 
   // Solve
   if (b_norm > 0.0) d_solver->solve(*d_b, *d_x);
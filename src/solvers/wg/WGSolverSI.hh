@@ -99,6 +99,7 @@ private:
   using Base::d_sweeper;
   using Base::d_sweepsource;
   using Base::d_tolerance;
+  using Base::d_relative_tolerance;
   using Base::d_maximum_iterations;
   using Base::d_print_level;
   using Base::d_print_interval;
@@ -46,6 +46,7 @@ void WGSolverSI<D>::solve(const size_t g)
 
   // Iterate.
   double error = 1.0;
+  double error_first = 0.0;
   size_t iteration;
   for (iteration = 1; iteration <= d_maximum_iterations; iteration++)
   {
@@ -58,12 +59,14 @@ void WGSolverSI<D>::solve(const size_t g)
 
     // Flux residual using L-infinity.
     error = norm_residual(phi_old, phi, "Linf");
+    if (iteration == 1) error_first = error;
 
     if (d_print_level > 1 && iteration % d_print_interval == 0)
     {
       printf("    SI Iter: %3i  Error: %12.9f \n", iteration, error);
     }
-    if (error < d_tolerance) break;
+    if (error < std::max(d_tolerance, d_relative_tolerance * error_first))
+      break;
 
     // Construct within group
     d_sweepsource->build_within_group_scatter(g, phi);
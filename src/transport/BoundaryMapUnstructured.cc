@@ -0,0 +1,136 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  BoundaryMapUnstructured.cc
+ *  @brief BoundaryMapUnstructured member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "BoundaryMapUnstructured.hh"
+#include <cmath>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+BoundaryMapUnstructured::BoundaryMapUnstructured(SP_mesh mesh,
+                                                 SP_quadrature quadrature,
+                                                 const vec_bool &reflective)
+  : d_quadrature(quadrature)
+{
+  Require(mesh);
+  Require(d_quadrature);
+  Require(reflective.size() >= 2 * mesh->dimension());
+
+  size_t no = d_quadrature->number_octants();
+  size_t na = d_quadrature->number_angles_octant();
+  size_t nz = mesh->number_layers();
+  d_face.resize(no, vec2_int(na));
+  d_source_octant.resize(no, vec2_int(na));
+  d_source_angle.resize(no, vec2_int(na));
+  d_source_face.resize(no, vec2_int(na));
+
+  // Lateral faces, which are the same in every layer
+  for (size_t f = 0; f < mesh->number_faces(); ++f)
+  {
+    if (!mesh->is_boundary(f)) continue;
+    int side    = mesh->face_side(f);
+    int partner = mesh->face_partner(f);
+    if (partner < 0 && (side < 0 || !reflective[side])) continue;
+    const Point &n = mesh->face_normal(f);
+
+    // Rotation angle carrying this face onto its partner
+    double c = 1.0, s = 0.0;
+    if (partner >= 0)
+    {
+      const Point &m = mesh->face_normal(partner);
+      double t = std::atan2(-m.y(), -m.x()) - std::atan2(n.y(), n.x());
+      c = std::cos(t);
+      s = std::sin(t);
+    }
+
+    for (size_t o = 0; o < no; ++o)
+    {
+      for (size_t a = 0; a < na; ++a)
+      {
+        double mu  = d_quadrature->mu(o, a);
+        double eta = d_quadrature->eta(o, a);
+        double xi  = d_quadrature->xi(o, a);
+        double dot = mu * n.x() + eta * n.y();
+        if (dot >= 0.0) continue;
+        int so, sa;
+        if (partner >= 0)
+          find_angle(c * mu - s * eta, s * mu + c * eta, xi, so, sa);
+        else
+          find_angle(mu - 2.0 * dot * n.x(), eta - 2.0 * dot * n.y(), xi,
+                     so, sa);
+        int g = partner >= 0 ? partner : f;
+        for (size_t k = 0; k < nz; ++k)
+          add(o, a, mesh->lateral_face(f, k), so, sa, mesh->lateral_face(g, k));
+      }
+    }
+  }
+
+  // Axial faces on the bottom and top
+  if (mesh->dimension() < 3) return;
+  for (size_t o = 0; o < no; ++o)
+  {
+    for (size_t a = 0; a < na; ++a)
+    {
+      double xi = d_quadrature->xi(o, a);
+      int side = xi > 0.0 ? detran_geometry::Mesh::BOTTOM
+                          : detran_geometry::Mesh::TOP;
+      if (!reflective[side]) continue;
+      int so, sa;
+      find_angle(d_quadrature->mu(o, a), d_quadrature->eta(o, a), -xi, so, sa);
+      size_t k = xi > 0.0 ? 0 : nz;
+      for (size_t c = 0; c < mesh->number_cells_2d(); ++c)
+      {
+        size_t i = mesh->axial_face(c, k);
+        add(o, a, i, so, sa, i);
+      }
+    }
+  }
+}
+
+//---------------------------------------------------------------------------//
+void BoundaryMapUnstructured::find_angle(const double mu,
+                                         const double eta,
+                                         const double xi,
+                                         int &o,
+                                         int &a) const
+{
+  for (o = 0; o < (int) d_quadrature->number_octants(); ++o)
+  {
+    for (a = 0; a < (int) d_quadrature->number_angles_octant(); ++a)
+    {
+      if (std::abs(d_quadrature->mu(o, a)  - mu)  < 1.0e-9 &&
+          std::abs(d_quadrature->eta(o, a) - eta) < 1.0e-9 &&
+          std::abs(d_quadrature->xi(o, a)  - xi)  < 1.0e-9)
+      {
+        return;
+      }
+    }
+  }
+  THROW("The quadrature is not symmetric under a boundary condition.");
+}
+
+//---------------------------------------------------------------------------//
+void BoundaryMapUnstructured::add(const size_t o,
+                                  const size_t a,
+                                  const size_t face,
+                                  const int    so,
+                                  const int    sa,
+                                  const size_t source_face)
+{
+  d_face[o][a].push_back(face);
+  d_source_octant[o][a].push_back(so);
+  d_source_angle[o][a].push_back(sa);
+  d_source_face[o][a].push_back(source_face);
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of BoundaryMapUnstructured.cc
+//---------------------------------------------------------------------------//
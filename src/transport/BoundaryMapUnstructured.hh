@@ -0,0 +1,148 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  BoundaryMapUnstructured.hh
+ *  @brief BoundaryMapUnstructured class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_BOUNDARYMAPUNSTRUCTURED_HH_
+#define detran_BOUNDARYMAPUNSTRUCTURED_HH_
+
+#include "transport/transport_export.hh"
+#include "angle/Quadrature.hh"
+#include "geometry/MeshUnstructured.hh"
+#include "utilities/DBC.hh"
+#include "utilities/Definitions.hh"
+#include "utilities/SP.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class BoundaryMapUnstructured
+ *  @brief Sources of the incident boundary fluxes on an unstructured mesh.
+ *
+ *  For each angle, the map lists the incident boundary face fluxes that
+ *  come from outgoing face fluxes of the mesh, along with the angle and
+ *  face supplying each.  Three conditions are supported:
+ *    - reflection: a lateral face on a reflective side (or a BOTTOM or
+ *      TOP face) takes the flux of the same face in the direction
+ *      \f$ \Omega - 2 (\Omega \cdot n) n \f$, where the normal need not
+ *      be aligned with an axis;
+ *    - rotation: a lateral face with a partner (see
+ *      MeshUnstructured::face_partner) takes the flux of the partner in
+ *      the direction \f$ R \Omega \f$, where \f$ R \f$ is the rotation
+ *      about z carrying the face onto its partner, i.e. for which
+ *      \f$ R n_f = -n_g \f$;
+ *    - vacuum: any other face, which is not listed.
+ *
+ *  The mapped direction must be in the quadrature, which is checked.
+ *  For example, a 60 degree sector needs a quadrature symmetric under
+ *  rotations by 60 degrees and reflections about the sector edges.
+ */
+//---------------------------------------------------------------------------//
+class TRANSPORT_EXPORT BoundaryMapUnstructured
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<BoundaryMapUnstructured>   SP_map;
+  typedef detran_geometry::MeshUnstructured::SP_mesh      SP_mesh;
+  typedef detran_geometry::MeshUnstructured::Point        Point;
+  typedef detran_angle::Quadrature::SP_quadrature         SP_quadrature;
+  typedef detran_utilities::vec_bool                      vec_bool;
+  typedef detran_utilities::vec_int                       vec_int;
+  typedef detran_utilities::vec2_int                      vec2_int;
+  typedef detran_utilities::vec3_int                      vec3_int;
+  typedef detran_utilities::size_t                        size_t;
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC INTERFACE
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param mesh         Unstructured mesh
+   *  @param quadrature   Angular quadrature
+   *  @param reflective   Whether each side (WEST through TOP) reflects
+   */
+  BoundaryMapUnstructured(SP_mesh mesh,
+                          SP_quadrature quadrature,
+                          const vec_bool &reflective);
+
+  /// Incident face fluxes set for an angle
+  const vec_int& face(const size_t o, const size_t a) const
+  {
+    Require(o < d_face.size());
+    Require(a < d_face[o].size());
+    return d_face[o][a];
+  }
+
+  /// Octants supplying the incident fluxes for an angle
+  const vec_int& source_octant(const size_t o, const size_t a) const
+  {
+    Require(o < d_source_octant.size());
+    Require(a < d_source_octant[o].size());
+    return d_source_octant[o][a];
+  }
+
+  /// Angles supplying the incident fluxes for an angle
+  const vec_int& source_angle(const size_t o, const size_t a) const
+  {
+    Require(o < d_source_angle.size());
+    Require(a < d_source_angle[o].size());
+    return d_source_angle[o][a];
+  }
+
+  /// Face fluxes supplying the incident fluxes for an angle
+  const vec_int& source_face(const size_t o, const size_t a) const
+  {
+    Require(o < d_source_face.size());
+    Require(a < d_source_face[o].size());
+    return d_source_face[o][a];
+  }
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Quadrature
+  SP_quadrature d_quadrature;
+  /// Incident face fluxes [octant][angle][i]
+  vec3_int d_face;
+  /// Source octants [octant][angle][i]
+  vec3_int d_source_octant;
+  /// Source angles [octant][angle][i]
+  vec3_int d_source_angle;
+  /// Source face fluxes [octant][angle][i]
+  vec3_int d_source_face;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Find the octant and angle of a direction.
+  void find_angle(const double mu, const double eta, const double xi,
+                  int &o, int &a) const;
+
+  /// Add an entry to the map.
+  void add(const size_t o, const size_t a, const size_t face,
+           const int so, const int sa, const size_t source_face);
+
+};
+
+} // end namespace detran
+
+#endif /* detran_BOUNDARYMAPUNSTRUCTURED_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of BoundaryMapUnstructured.hh
+//---------------------------------------------------------------------------//
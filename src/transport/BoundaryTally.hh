@@ -131,6 +131,32 @@ public:
                      const size_t d,
                      const double psi) = 0;
 
+  /**
+   *  @brief Add a precomputed contribution at a fine mesh edge
+   *
+   *  Characteristic sweeps do not visit fine mesh edges in a fixed
+   *  order, so the sweeper computes the weighted, surface-integrated
+   *  contribution for each crossing and passes it here.  Along the
+   *  given axis, the index is the fine mesh @e edge index; along the
+   *  remaining axes, the indices are fine mesh cell indices.  Edges
+   *  not on a coarse mesh edge are ignored.
+   *
+   *  @param  i           x mesh index
+   *  @param  j           y mesh index
+   *  @param  k           z mesh index
+   *  @param  g           group index
+   *  @param  axis        axis index of the edge normal
+   *  @param  sense       1 for positive flow (e.g. +x), else 0
+   *  @param  value       contribution to the tally
+   */
+  virtual void tally_edge(const size_t i,
+                          const size_t j,
+                          const size_t k,
+                          const size_t g,
+                          const size_t axis,
+                          const size_t sense,
+                          const double value) = 0;
+
   /// Print all the partial currents (for debugging)
   virtual void display() = 0;
 
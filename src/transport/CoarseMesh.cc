@@ -23,6 +23,8 @@ CoarseMesh::CoarseMesh(SP_mesh fine_mesh, const size_t level)
 {
   // Preconditions
   Require(d_fine_mesh);
+  Insist(d_fine_mesh->is_cartesian(),
+         "Coarse mesh acceleration requires a Cartesian fine mesh.");
 
   using std::cout;
   using std::endl;
@@ -141,6 +141,29 @@ public:
              const size_t d,
              const double psi);
 
+  /**
+   *  @brief Add a partial current contribution at a fine mesh edge
+   *
+   *  This is used by sweepers (e.g. MOC) that compute the weighted
+   *  current directly, i.e.
+   *  \f$ \psi w_n \delta_n \sin\theta_n \f$ for a track crossing.
+   *
+   *  @param  i           x mesh index (edge index if axis = 0)
+   *  @param  j           y mesh index (edge index if axis = 1)
+   *  @param  k           z mesh index (edge index if axis = 2)
+   *  @param  g           group index
+   *  @param  axis        axis index of the edge normal
+   *  @param  sense       1 for positive flow (e.g. +x), else 0
+   *  @param  value       surface-integrated partial current contribution
+   */
+  void tally_edge(const size_t i,
+                  const size_t j,
+                  const size_t k,
+                  const size_t g,
+                  const size_t axis,
+                  const size_t sense,
+                  const double value);
+
   /**
    *  @brief Get the partial current from a surface and sense
    *  @param  i       x mesh index
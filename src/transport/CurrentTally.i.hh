@@ -167,6 +167,40 @@ CurrentTally<D>::tally(const size_t i,
     psi * d_quadrature->cosines(d0)[a] * d_quadrature->weight(a) * area;
 }
 
+//---------------------------------------------------------------------------//
+// Tallying for precomputed edge contributions.
+template <class D>
+inline void
+CurrentTally<D>::tally_edge(const size_t i,
+                            const size_t j,
+                            const size_t k,
+                            const size_t g,
+                            const size_t axis,
+                            const size_t sense,
+                            const double value)
+{
+  Require(axis < D::dimension);
+  Require(g < d_number_groups);
+  Require(sense < 2);
+
+  const size_t dim[] = {i, j, k};
+
+  // Only fine edges that coincide with coarse edges are tallied.
+  int coarse_edge = d_coarsemesh->coarse_edge_flag(dim[axis], axis);
+  if (coarse_edge < 0) return;
+
+  int d1 = d_perpendicular_index[axis][0];
+  int d2 = d_perpendicular_index[axis][1];
+
+  int cdim[3];
+  cdim[axis] = coarse_edge;
+  cdim[d1]   = d_coarsemesh->fine_to_coarse(dim[d1], d1);
+  cdim[d2]   = d_coarsemesh->fine_to_coarse(dim[d2], d2);
+
+  d_partial_current[axis][g][sense][index(cdim[0], cdim[1], cdim[2], axis)]
+    += value;
+}
+
 } // end namespace detran
 
 #endif // detran_CURRENTTALLY_I_HH_ 
@@ -0,0 +1,131 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  Equation_LS_MOC.cc
+ *  @brief Equation_LS_MOC member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "Equation_LS_MOC.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+Equation_LS_MOC::Equation_LS_MOC(SP_mesh       mesh,
+                                 SP_material   material,
+                                 SP_quadrature quadrature,
+                                 const bool    update_psi)
+  : Equation_MOC(mesh, material, quadrature, update_psi)
+  , d_table(ExpTable::table())
+  , d_inv_sin(quadrature->number_polar_octant(), 0.0)
+  , d_phi_x(0)
+  , d_phi_y(0)
+  , d_x(0.0)
+  , d_y(0.0)
+  , d_ux(0.0)
+  , d_uy(0.0)
+  , d_scale(1.0)
+{
+  Insist(mesh->dimension() == 2, "Linear source MOC is implemented in 2D.");
+  Insist(d_tracks->has_centroids(),
+         "Linear source MOC needs the region centroids from the tracks.");
+
+  for (size_t p = 0; p < d_quadrature->number_polar_octant(); ++p)
+    d_inv_sin[p] = 1.0 / d_quadrature->sin_theta(p);
+
+  // Invert the moment matrices.  Regions whose moments are not
+  // resolved by the tracks keep a flat source.
+  size_t nr = d_mesh->number_cells();
+  d_centroid.resize(2 * nr, 0.0);
+  d_inv_moments.resize(3 * nr, 0.0);
+  d_gradient.resize(2 * nr, 0.0);
+  for (size_t r = 0; r < nr; ++r)
+  {
+    d_centroid[2 * r]     = d_tracks->centroid(r).x();
+    d_centroid[2 * r + 1] = d_tracks->centroid(r).y();
+    double cxx = d_tracks->moment(r, 0, 0);
+    double cxy = d_tracks->moment(r, 0, 1);
+    double cyy = d_tracks->moment(r, 1, 1);
+    double det = cxx * cyy - cxy * cxy;
+    if (det <= 1.0e-10 * cxx * cyy) continue;
+    d_inv_moments[3 * r]     =  cyy / det;
+    d_inv_moments[3 * r + 1] = -cxy / det;
+    d_inv_moments[3 * r + 2] =  cxx / det;
+  }
+}
+
+//---------------------------------------------------------------------------//
+void Equation_LS_MOC::setup_group(const size_t g)
+{
+  Require(g < d_material->number_groups());
+  d_g = g;
+}
+
+//---------------------------------------------------------------------------//
+void Equation_LS_MOC::setup_octant(const size_t octant)
+{
+  Require(octant < d_quadrature->number_octants());
+  d_octant = octant;
+}
+
+//---------------------------------------------------------------------------//
+void Equation_LS_MOC::setup_azimuth(const size_t a)
+{
+  Require(a < d_quadrature->number_azimuths_octant());
+  d_azimuth = a;
+  d_spacing = d_tracks->spacing(d_azimuth) * d_axial_spacing;
+}
+
+//---------------------------------------------------------------------------//
+void Equation_LS_MOC::setup_polar(const size_t p)
+{
+  Require(p < d_quadrature->number_polar_octant());
+  d_polar = p;
+  d_angle = d_quadrature->angle(d_azimuth, d_polar);
+}
+
+//---------------------------------------------------------------------------//
+void Equation_LS_MOC::setup_track(SP_track      track,
+                                  const bool    reverse,
+                                  const double *length,
+                                  const int     n)
+{
+  Require(track);
+  Point r0 = reverse ? track->exit()  : track->enter();
+  Point r1 = reverse ? track->enter() : track->exit();
+  double L = distance(r0, r1);
+  Assert(L > 0.0);
+  double total = 0.0;
+  for (int s = 0; s < n; ++s)
+    total += length[s];
+  d_x = r0.x();
+  d_y = r0.y();
+  d_ux = (r1.x() - r0.x()) / L;
+  d_uy = (r1.y() - r0.y()) / L;
+  d_scale = total > 0.0 ? L / total : 1.0;
+}
+
+//---------------------------------------------------------------------------//
+void Equation_LS_MOC::setup_linear_source(const moments_type &source_x,
+                                          const moments_type &source_y,
+                                          moments_type &phi_x,
+                                          moments_type &phi_y)
+{
+  Require(source_x.size() == d_mesh->number_cells());
+  Require(source_y.size() == d_mesh->number_cells());
+  for (size_t r = 0; r < d_mesh->number_cells(); ++r)
+  {
+    const double *c = &d_inv_moments[3 * r];
+    d_gradient[2 * r]     = c[0] * source_x[r] + c[1] * source_y[r];
+    d_gradient[2 * r + 1] = c[1] * source_x[r] + c[2] * source_y[r];
+  }
+  d_phi_x = &phi_x;
+  d_phi_y = &phi_y;
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of file Equation_LS_MOC.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,175 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  Equation_LS_MOC.hh
+ *  @brief Equation_LS_MOC class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_EQUATION_LS_MOC_HH_
+#define detran_EQUATION_LS_MOC_HH_
+
+#include "Equation_MOC.hh"
+#include "ExpTable.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class Equation_LS_MOC
+ *  @brief Linear source discretization for MOC
+ *
+ *  The flat source of Equation_SC_MOC needs fine regions wherever the
+ *  flux varies.  Here, the source in each region varies linearly,
+ *  @f[
+ *      Q(\mathbf{x}) = \bar{Q} + \mathbf{g} \cdot
+ *                      (\mathbf{x} - \bar{\mathbf{x}}) \, ,
+ *  @f]
+ *  where \f$ \bar{\mathbf{x}} \f$ is the region centroid.  The gradient
+ *  follows from the source moments
+ *  \f$ \hat{\mathbf{Q}} = \frac{1}{V} \int_V
+ *      (\mathbf{x} - \bar{\mathbf{x}}) Q dV = C \mathbf{g} \f$,
+ *  where \f$ C \f$ is the region's matrix of second moments (see
+ *  TrackDB::compute_centroids).  Along a segment of length \f$ l \f$
+ *  (in three dimensions) with midpoint \f$ \mathbf{x}_m \f$, the source
+ *  is \f$ q_c + q_1 (s - l/2) \f$, where
+ *  \f$ q_c = Q(\mathbf{x}_m) \f$ and
+ *  \f$ q_1 = \mathbf{g} \cdot \mathbf{\Omega} \f$.  With
+ *  \f$ \tau = \Sigma_t l \f$, the integral of the flux along the
+ *  segment is
+ *  @f[
+ *      \int_0^l \psi ds = l \Big( \psi_{in} E_1 + l q_c G_1
+ *                                 + l^2 q_1 G_2 \Big) \, ,
+ *  @f]
+ *  the outgoing flux follows from the segment balance
+ *  @f[
+ *      \psi_{out} = \psi_{in} + l q_c - \Sigma_t \int_0^l \psi ds \, ,
+ *  @f]
+ *  which thus holds exactly despite the tabulation, and the first
+ *  moment of the flux about the midpoint is
+ *  @f[
+ *      \int_0^l (s - l/2) \psi ds = l^2 \Big( \psi_{in} \tau G_2
+ *                                  - l q_c G_2 + l^2 q_1 G_3 \Big) \, ,
+ *  @f]
+ *  where the functions of \f$ \tau \f$ are tabulated by ExpTable.
+ *  The integrals yield the region average flux and its spatial moments,
+ *  from which SweepSource builds the source moments for the next sweep.
+ *
+ *  Positions are tracked along each track from its entrance point,
+ *  which the sweeper passes to setup_track().  The linear source
+ *  typically permits much coarser regions than the flat source for
+ *  the same accuracy.  A region whose tracking does not resolve its
+ *  moments (i.e. a singular \f$ C \f$) keeps a flat source.
+ *
+ *  @sa Equation_SC_MOC
+ */
+//---------------------------------------------------------------------------//
+
+class TRANSPORT_EXPORT Equation_LS_MOC: public Equation_MOC
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef Equation_MOC                      Base;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /// Constructor
+  Equation_LS_MOC(SP_mesh mesh,
+                  SP_material material,
+                  SP_quadrature quadrature,
+                  const bool update_psi);
+
+  //-------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL MOC EQUATION TYPES MUST IMPLEMENT THESE
+  //-------------------------------------------------------------------------//
+
+  /// Solve for the cell-center and outgoing edge fluxes.
+  inline void solve(const size_t region,
+                    const double length,
+                    moments_type &source,
+                    double &psi_in,
+                    double &psi_out,
+                    moments_type &phi,
+                    angular_flux_type &psi);
+
+  /// Setup the equations for a group.
+  void setup_group(const size_t g);
+
+  /// Setup the equations for an octant.
+  void setup_octant(const size_t o);
+
+  /// Setup the equations for an azimuth.
+  void setup_azimuth(const size_t a);
+
+  /// Setup the equations for a polar angle.
+  void setup_polar(const size_t p);
+
+  //-------------------------------------------------------------------------//
+  // LINEAR SOURCE INTERFACE
+  //-------------------------------------------------------------------------//
+
+  bool is_linear() const { return true; }
+
+  /// Setup the position and direction for a track.
+  void setup_track(SP_track track,
+                   const bool reverse,
+                   const double *length,
+                   const int n);
+
+  /// Setup the source gradients for an angle.
+  void setup_linear_source(const moments_type &source_x,
+                           const moments_type &source_y,
+                           moments_type &phi_x,
+                           moments_type &phi_y);
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Exponential functions
+  const ExpTable &d_table;
+  /// Inverse polar sines
+  detran_utilities::vec_dbl d_inv_sin;
+  /// Region centroids as (x, y) pairs
+  detran_utilities::vec_dbl d_centroid;
+  /// Inverse region moment matrices as (xx, xy, yy) triples
+  detran_utilities::vec_dbl d_inv_moments;
+  /// Source gradients for the current angle as (x, y) pairs
+  detran_utilities::vec_dbl d_gradient;
+  /// Flux moments tallied by the sweep
+  moments_type *d_phi_x;
+  moments_type *d_phi_y;
+  /// Current position along the track
+  double d_x;
+  double d_y;
+  /// Current track direction in the plane
+  double d_ux;
+  double d_uy;
+  /// Ratio of geometric to (normalized) segment length on the track
+  double d_scale;
+
+};
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+// INLINE FUNCTIONS
+//---------------------------------------------------------------------------//
+
+#include "Equation_LS_MOC.i.hh"
+
+#endif /* detran_EQUATION_LS_MOC_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of Equation_LS_MOC.hh
+//---------------------------------------------------------------------------//
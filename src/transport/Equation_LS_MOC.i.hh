@@ -0,0 +1,76 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  Equation_LS_MOC.i.hh
+ *  @brief Equation_LS_MOC inline member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_EQUATION_LS_MOC_I_HH_
+#define detran_EQUATION_LS_MOC_I_HH_
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+inline void Equation_LS_MOC::solve(const size_t region,
+                                   const double length,
+                                   moments_type &source,
+                                   double &psi_in,
+                                   double &psi_out,
+                                   moments_type &phi,
+                                   angular_flux_type &psi)
+{
+  // Preconditions.
+  Require(region < d_mesh->number_cells());
+  Require(d_phi_x && d_phi_y);
+
+  double sigma = d_material->sigma_t(d_mat_map[region], d_g);
+  double sin_theta = 1.0 / d_inv_sin[d_polar];
+  double l = length * d_inv_sin[d_polar];
+  double tau = sigma * l;
+
+  // Segment midpoint relative to the centroid, and the next position.
+  double l_xy = length * d_scale;
+  double dx = d_x + 0.5 * l_xy * d_ux - d_centroid[2 * region];
+  double dy = d_y + 0.5 * l_xy * d_uy - d_centroid[2 * region + 1];
+  d_x += l_xy * d_ux;
+  d_y += l_xy * d_uy;
+
+  // Source at the midpoint and its slope along the characteristic.
+  double gx = d_gradient[2 * region];
+  double gy = d_gradient[2 * region + 1];
+  double q_c = source[region] + gx * dx + gy * dy;
+  double q_1 = (gx * d_ux + gy * d_uy) * sin_theta;
+
+  double f[ExpTable::END_FUNCTIONS];
+  d_table.evaluate(tau, f);
+
+  // Integral of the flux along the segment and the outgoing flux.  The
+  // latter is found from the balance, which the table cannot upset.
+  double psi_int = l * (psi_in * f[ExpTable::E1] +
+                        l * (q_c * f[ExpTable::G1] + l * q_1 * f[ExpTable::G2]));
+  psi_out = psi_in + l * q_c - sigma * psi_int;
+
+  // First moment of the flux about the segment midpoint.
+  double psi_mom = l * l * ((psi_in * tau - q_c * l) * f[ExpTable::G2] +
+                            l * l * q_1 * f[ExpTable::G3]);
+
+  // Contributions to the region average flux and its moments.
+  double factor = d_spacing * sin_theta / d_mesh->volume(region);
+  double w = d_quadrature->weight(d_angle) * factor;
+  phi[region]         += w * psi_int;
+  (*d_phi_x)[region]  += w * (dx * psi_int + d_ux * sin_theta * psi_mom);
+  (*d_phi_y)[region]  += w * (dy * psi_int + d_uy * sin_theta * psi_mom);
+
+  // Store angular flux if needed.
+  if (d_update_psi) psi[region] += factor * psi_int;
+}
+
+} // end namespace detran
+
+#endif /* detran_EQUATION_LS_MOC_I_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of Equation_LS_MOC.i.hh
+//---------------------------------------------------------------------------//
@@ -42,6 +42,8 @@ public:
   typedef detran_material::Material::SP_material        SP_material;
   typedef detran_geometry::MeshMOC::SP_mesh             SP_mesh;
   typedef detran_geometry::TrackDB::SP_trackdb          SP_trackdb;
+  typedef detran_geometry::Track::SP_track              SP_track;
+  typedef detran_geometry::Track::Point                 Point;
   typedef detran_angle::QuadratureMOC::SP_quadrature    SP_quadrature;
   typedef detran_utilities::vec_dbl                     moments_type;
   typedef detran_utilities::vec_dbl                     angular_flux_type;
@@ -62,6 +64,7 @@ public:
     ,  d_tracks(mesh->tracks())
     ,  d_material(material)
     ,  d_quadrature(quadrature)
+    ,  d_axial_spacing(1.0)
     ,  d_update_psi(update_psi)
     ,  d_g(-1)
     ,  d_octant(-1)
@@ -71,6 +74,8 @@ public:
     Require(material);
     Require(quadrature);
     d_mat_map =  mesh->mesh_map("MATERIAL");
+    // Each stacked 3D track also represents an axial width.
+    if (mesh->stack()) d_axial_spacing = mesh->stack()->spacing_z();
     //Ensure(d_mat_map);
   }
 
@@ -123,6 +128,37 @@ public:
    */
   virtual void setup_polar(const size_t p) = 0;
 
+  //-------------------------------------------------------------------------//
+  // OPTIONAL INTERFACE -- FOR SOURCES VARYING WITHIN A REGION
+  //-------------------------------------------------------------------------//
+
+  /// Does the equation use linear sources?  (See Equation_LS_MOC.)
+  virtual bool is_linear() const { return false; }
+
+  /**
+   *  @brief Setup the equations for a track.
+   *  @param track      Current track
+   *  @param reverse    Is the track traversed from its exit?
+   *  @param length     Segment lengths
+   *  @param n          Number of segments
+   */
+  virtual void setup_track(SP_track track,
+                           const bool reverse,
+                           const double *length,
+                           const int n) {}
+
+  /**
+   *  @brief Setup the spatial source moments for an angle.
+   *  @param source_x   x moments of the sweep source
+   *  @param source_y   y moments of the sweep source
+   *  @param phi_x      x moments of the scalar flux, tallied by solve()
+   *  @param phi_y      y moments of the scalar flux, tallied by solve()
+   */
+  virtual void setup_linear_source(const moments_type &source_x,
+                                   const moments_type &source_y,
+                                   moments_type &phi_x,
+                                   moments_type &phi_y) {}
+
 protected:
 
   //-------------------------------------------------------------------------//
@@ -147,6 +183,8 @@ protected:
   double d_spacing;
   /// Inverse of the polar sine
   double d_inv_sin;
+  /// Axial track spacing (unity in 2D)
+  double d_axial_spacing;
   /// Material map
   detran_utilities::vec_int d_mat_map;
   /// Update the angular flux?
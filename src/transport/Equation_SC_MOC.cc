@@ -37,7 +37,7 @@ void Equation_SC_MOC::setup_group(const size_t g)
 //---------------------------------------------------------------------------//
 void Equation_SC_MOC::setup_octant(const size_t octant)
 {
-  Require(octant < 4);
+  Require(octant < d_quadrature->number_octants());
   d_octant = octant;
 }
 
@@ -46,7 +46,7 @@ void Equation_SC_MOC::setup_azimuth(const size_t a)
 {
   Require(a < d_quadrature->number_azimuths_octant());
   d_azimuth = a;
-  d_spacing = d_tracks->spacing(d_azimuth);
+  d_spacing = d_tracks->spacing(d_azimuth) * d_axial_spacing;
   for (size_t p = 0; p < d_quadrature->number_polar_octant(); ++p)
   {
     size_t angle = d_quadrature->angle(a, p);
@@ -0,0 +1,69 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  Equation_SD_Unstructured.cc
+ *  @brief Equation_SD_Unstructured member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "Equation_SD_Unstructured.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+Equation_SD_Unstructured::Equation_SD_Unstructured(SP_mesh mesh,
+                                                   SP_material material,
+                                                   SP_quadrature quadrature,
+                                                   const bool update_psi)
+  : d_mesh(mesh)
+  , d_material(material)
+  , d_quadrature(quadrature)
+  , d_dimension(mesh->dimension())
+  , d_update_psi(update_psi)
+  , d_g(0)
+  , d_octant(0)
+  , d_angle(0)
+  , d_xi(0.0)
+{
+  Require(d_mesh);
+  Require(d_material);
+  Require(d_quadrature);
+  d_mat_map = d_mesh->mesh_map("MATERIAL");
+  d_coef.resize(d_mesh->number_faces(), 0.0);
+}
+
+//---------------------------------------------------------------------------//
+void Equation_SD_Unstructured::setup_group(const size_t g)
+{
+  Require(g < d_material->number_groups());
+  d_g = g;
+}
+
+//---------------------------------------------------------------------------//
+void Equation_SD_Unstructured::setup_octant(const size_t octant)
+{
+  Require(octant < d_quadrature->number_octants());
+  d_octant = octant;
+}
+
+//---------------------------------------------------------------------------//
+void Equation_SD_Unstructured::setup_angle(const size_t angle)
+{
+  Require(angle < d_quadrature->number_angles_octant());
+  d_angle = angle;
+  double mu  = d_quadrature->mu(d_octant, angle);
+  double eta = d_quadrature->eta(d_octant, angle);
+  for (size_t f = 0; f < d_mesh->number_faces(); ++f)
+  {
+    const detran_geometry::MeshUnstructured::Point &n = d_mesh->face_normal(f);
+    d_coef[f] = (mu * n.x() + eta * n.y()) * d_mesh->face_length(f);
+  }
+  if (d_dimension == 3) d_xi = d_quadrature->xi(d_octant, angle);
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of Equation_SD_Unstructured.cc
+//---------------------------------------------------------------------------//
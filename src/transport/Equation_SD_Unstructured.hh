@@ -0,0 +1,145 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  Equation_SD_Unstructured.hh
+ *  @brief Equation_SD_Unstructured class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_EQUATION_SD_UNSTRUCTURED_HH_
+#define detran_EQUATION_SD_UNSTRUCTURED_HH_
+
+#include "transport/transport_export.hh"
+#include "angle/Quadrature.hh"
+#include "geometry/MeshUnstructured.hh"
+#include "material/Material.hh"
+#include "utilities/Definitions.hh"
+#include "utilities/SP.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class Equation_SD_Unstructured
+ *  @brief Step difference discretization on polygons and extruded prisms.
+ *
+ *  Integrating the transport equation over a cell of area \f$ V \f$ and
+ *  taking the flux on each outgoing face to be the cell flux (the step
+ *  approximation) gives
+ *  @f[
+ *      \psi = \frac{ Q V + \sum_{in} |\Omega \cdot n_f| L_f \psi_f }
+ *                  { \Sigma_t V + \sum_{out} \Omega \cdot n_f L_f } \, ,
+ *  @f]
+ *  where the sums are over the incoming and outgoing faces of length
+ *  \f$ L_f \f$ and outward normal \f$ n_f \f$.  The discretization is
+ *  positive and conservative for any polygon, and on rectangles it is
+ *  identical to Equation_SD_2D.  On an extruded mesh, the lateral faces
+ *  have areas \f$ L_f \Delta_z \f$, and the axial faces, with areas
+ *  \f$ V \f$, add \f$ |\xi| V \psi_{in} \f$ and \f$ |\xi| V \f$ to the
+ *  numerator and denominator, where \f$ V \f$ is now the polygon area.
+ *
+ *  Rather than the fixed incident and outgoing edges of the Cartesian
+ *  equations, solve() reads and writes the fluxes of all the faces of
+ *  the mesh for the current angle.
+ */
+//---------------------------------------------------------------------------//
+class TRANSPORT_EXPORT Equation_SD_Unstructured
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_material::Material::SP_material        SP_material;
+  typedef detran_geometry::MeshUnstructured::SP_mesh    SP_mesh;
+  typedef detran_angle::Quadrature::SP_quadrature       SP_quadrature;
+  typedef detran_utilities::vec_dbl                     moments_type;
+  typedef detran_utilities::vec_dbl                     angular_flux_type;
+  typedef detran_utilities::vec_dbl                     face_flux_type;
+  typedef detran_utilities::size_t                      size_t;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /// Constructor
+  Equation_SD_Unstructured(SP_mesh mesh,
+                           SP_material material,
+                           SP_quadrature quadrature,
+                           const bool update_psi);
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC INTERFACE
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Solve for the cell-center and outgoing face fluxes.
+   *  @param  cell      Cell index
+   *  @param  source    Discrete source for this angle
+   *  @param  psi_face  Face fluxes for this angle, indexed as in
+   *                    MeshUnstructured::lateral_face and axial_face
+   *  @param  phi       Flux moments for this group
+   *  @param  psi       Angular flux for this angle
+   */
+  inline void solve(const size_t cell,
+                    const moments_type &source,
+                    face_flux_type &psi_face,
+                    moments_type &phi,
+                    angular_flux_type &psi);
+
+  /// Setup the equations for a group.
+  void setup_group(const size_t g);
+
+  /// Setup the equations for an octant.
+  void setup_octant(const size_t octant);
+
+  /// Setup the equations for an angle.
+  void setup_angle(const size_t angle);
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Unstructured mesh
+  SP_mesh d_mesh;
+  /// Material definitions
+  SP_material d_material;
+  /// Quadrature
+  SP_quadrature d_quadrature;
+  /// Material map
+  detran_utilities::vec_int d_mat_map;
+  /// Mesh dimension
+  size_t d_dimension;
+  /// Update the angular flux?
+  bool d_update_psi;
+  /// Current group
+  size_t d_g;
+  /// Current octant index
+  size_t d_octant;
+  /// Current angle index
+  size_t d_angle;
+  /// Face coefficients \f$ \Omega \cdot n_f L_f \f$ for the owner
+  detran_utilities::vec_dbl d_coef;
+  /// Current axial direction cosine
+  double d_xi;
+
+};
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+// INLINE FUNCTIONS
+//---------------------------------------------------------------------------//
+
+#include "Equation_SD_Unstructured.i.hh"
+
+#endif /* detran_EQUATION_SD_UNSTRUCTURED_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of Equation_SD_Unstructured.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,80 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  Equation_SD_Unstructured.i.hh
+ *  @brief Equation_SD_Unstructured inline member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_EQUATION_SD_UNSTRUCTURED_I_HH_
+#define detran_EQUATION_SD_UNSTRUCTURED_I_HH_
+
+#include <cmath>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+inline void Equation_SD_Unstructured::solve(const size_t cell,
+                                            const moments_type &source,
+                                            face_flux_type &psi_face,
+                                            moments_type &phi,
+                                            angular_flux_type &psi)
+{
+  Require(cell < d_mesh->number_cells());
+  Require(psi_face.size() == d_mesh->number_face_fluxes());
+
+  // Polygon and layer
+  size_t c  = cell % d_mesh->number_cells_2d();
+  size_t k  = cell / d_mesh->number_cells_2d();
+  double dz = d_mesh->dz(k);
+
+  // Sum the incident and outgoing face terms.
+  double volume = d_mesh->cell_area(c) * dz;
+  double in  = source[cell] * volume;
+  double out = d_material->sigma_t(d_mat_map[cell], d_g) * volume;
+  size_t nf = d_mesh->number_cell_faces(c);
+  for (size_t i = 0; i < nf; ++i)
+  {
+    size_t f = d_mesh->cell_face(c, i);
+    double w = d_mesh->cell_face_sign(c, i) * d_coef[f] * dz;
+    if (w < 0.0)
+      in -= w * psi_face[d_mesh->lateral_face(f, k)];
+    else
+      out += w;
+  }
+  size_t axial_in = 0, axial_out = 0;
+  if (d_dimension == 3)
+  {
+    axial_in  = d_mesh->axial_face(c, d_xi > 0.0 ? k : k + 1);
+    axial_out = d_mesh->axial_face(c, d_xi > 0.0 ? k + 1 : k);
+    double w = std::abs(d_xi) * d_mesh->cell_area(c);
+    in  += w * psi_face[axial_in];
+    out += w;
+  }
+  Assert(out > 0.0);
+
+  // Cell-center flux, which is also the outgoing face flux.
+  double psi_center = in / out;
+  for (size_t i = 0; i < nf; ++i)
+  {
+    size_t f = d_mesh->cell_face(c, i);
+    if (d_mesh->cell_face_sign(c, i) * d_coef[f] >= 0.0)
+      psi_face[d_mesh->lateral_face(f, k)] = psi_center;
+  }
+  if (d_dimension == 3) psi_face[axial_out] = psi_center;
+
+  // Compute flux moments.
+  phi[cell] += d_quadrature->weight(d_angle) * psi_center;
+
+  // Store angular flux if needed.
+  if (d_update_psi) psi[cell] = psi_center;
+}
+
+} // end namespace detran
+
+#endif /* detran_EQUATION_SD_UNSTRUCTURED_I_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of Equation_SD_Unstructured.i.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,77 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  ExpTable.cc
+ *  @brief ExpTable member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "ExpTable.hh"
+#include <cmath>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+ExpTable::ExpTable(const double tau_max, const size_t number)
+  : d_tau_max(tau_max)
+  , d_inv_delta(number / tau_max)
+  , d_table(END_FUNCTIONS * (number + 1), 0.0)
+{
+  Require(tau_max > 0.0);
+  Require(number > 0);
+  for (size_t i = 0; i <= number; ++i)
+    exact(i * tau_max / number, &d_table[END_FUNCTIONS * i]);
+}
+
+//---------------------------------------------------------------------------//
+const ExpTable& ExpTable::table()
+{
+  static const ExpTable t;
+  return t;
+}
+
+//---------------------------------------------------------------------------//
+void ExpTable::exact(const double tau, double *f)
+{
+  Require(tau >= 0.0);
+  if (tau > 1.0)
+  {
+    double e = std::exp(-tau);
+    double t2 = tau * tau;
+    f[E1] = (1.0 - e) / tau;
+    f[G1] = (tau - 1.0 + e) / t2;
+    f[G2] = (2.0 - tau - (2.0 + tau) * e) / (2.0 * t2 * tau);
+    f[G3] = (1.0 / 12.0 + f[G2] * (1.0 + 0.5 * tau)) / tau;
+    return;
+  }
+
+  // Taylor series in x = -tau.  With c_m = x^m / m!, the terms are
+  //   E1:  c_m / (m + 1)
+  //   G1:  c_m / ((m + 1)(m + 2))
+  //   G2: -c_m / (2 (m + 2)(m + 3))
+  //   G3: -m (m + 3) c_m / (4 (m + 1)(m + 2)(m + 3)(m + 4))
+  // for m >= 0.  Thirty terms are plenty for tau <= 1.
+  long double x = -tau;
+  long double c = 1.0;
+  long double e1 = 0, g1 = 0, g2 = 0, g3 = 0;
+  for (int m = 0; m < 30; ++m)
+  {
+    long double m1 = m + 1, m2 = m + 2, m3 = m + 3, m4 = m + 4;
+    e1 += c / m1;
+    g1 += c / (m1 * m2);
+    g2 -= c / (2.0 * m2 * m3);
+    g3 -= (m + 3) * m * c / (4.0 * m1 * m2 * m3 * m4);
+    c *= x / m1;
+  }
+  f[E1] = e1;
+  f[G1] = g1;
+  f[G2] = g2;
+  f[G3] = g3;
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of ExpTable.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,121 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  ExpTable.hh
+ *  @brief ExpTable class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_EXPTABLE_HH_
+#define detran_EXPTABLE_HH_
+
+#include "transport/transport_export.hh"
+#include "utilities/DBC.hh"
+#include "utilities/Definitions.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class ExpTable
+ *  @brief Tabulated exponential functions for characteristics.
+ *
+ *  The linear source characteristic solution (see Equation_LS_MOC) needs,
+ *  for each segment of optical length \f$ \tau \f$, the functions
+ *  @f[
+ *      E_1 = \frac{1 - e^{-\tau}}{\tau} \, ,
+ *  @f]
+ *  @f[
+ *      G_1 = \frac{\tau - 1 + e^{-\tau}}{\tau^2} \, , \quad
+ *      G_2 = \frac{2 - \tau - (2 + \tau) e^{-\tau}}{2 \tau^3} \, , \quad
+ *      G_3 = \frac{1}{\tau} \Big( \frac{1}{12} +
+ *                                 G_2 (1 + \tau / 2) \Big ) \, ,
+ *  @f]
+ *  all of which suffer cancellation as \f$ \tau \to 0 \f$.  The functions
+ *  are tabulated on a uniform grid over \f$ [0, \tau_{max}] \f$, with
+ *  small arguments evaluated by their Taylor series, and are then
+ *  linearly interpolated.  Beyond the table, the closed forms are used.
+ *
+ *  A single table is shared by all equations; see table().
+ */
+//---------------------------------------------------------------------------//
+class TRANSPORT_EXPORT ExpTable
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::vec_dbl     vec_dbl;
+  typedef detran_utilities::size_t      size_t;
+
+  /// Number of tabulated functions
+  enum FUNCTIONS
+  {
+    E1, G1, G2, G3, END_FUNCTIONS
+  };
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC INTERFACE
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param tau_max    Largest tabulated optical length
+   *  @param number     Number of table intervals
+   */
+  ExpTable(const double tau_max = 10.0, const size_t number = 10000);
+
+  /// Shared default table
+  static const ExpTable& table();
+
+  /**
+   *  @brief Evaluate all functions at an optical length
+   *  @param tau    Optical length
+   *  @param f      On output, the values indexed by FUNCTIONS
+   */
+  void evaluate(const double tau, double *f) const
+  {
+    Require(tau >= 0.0);
+    if (tau >= d_tau_max)
+    {
+      exact(tau, f);
+      return;
+    }
+    double x = tau * d_inv_delta;
+    size_t i = (size_t) x;
+    double b = x - i;
+    const double *f0 = &d_table[END_FUNCTIONS * i];
+    const double *f1 = f0 + END_FUNCTIONS;
+    for (int n = 0; n < END_FUNCTIONS; ++n)
+      f[n] = f0[n] + b * (f1[n] - f0[n]);
+  }
+
+  /// Evaluate all functions accurately (without the table)
+  static void exact(const double tau, double *f);
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Largest tabulated optical length
+  double d_tau_max;
+  /// Inverse of the table spacing
+  double d_inv_delta;
+  /// Values by [point][function]
+  vec_dbl d_table;
+
+};
+
+} // end namespace detran
+
+#endif /* detran_EXPTABLE_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of ExpTable.hh
+//---------------------------------------------------------------------------//
@@ -8,6 +8,7 @@
 //---------------------------------------------------------------------------//
 
 #include "State.hh"
+#include <algorithm>
 #include <iostream>
 #include <cstdio>
 
@@ -115,6 +116,19 @@ void State::scale(const double f)
   }
 }
 
+//---------------------------------------------------------------------------//
+void State::swap(State &other)
+{
+  Require(d_number_groups == other.d_number_groups);
+  Require(d_moments[0].size() == other.d_moments[0].size());
+  Require(d_store_angular_flux == other.d_store_angular_flux);
+  Require(d_store_current == other.d_store_current);
+  d_moments.swap(other.d_moments);
+  d_angular_flux.swap(other.d_angular_flux);
+  d_current.swap(other.d_current);
+  std::swap(d_eigenvalue, other.d_eigenvalue);
+}
+
 //---------------------------------------------------------------------------//
 void State::display() const
 {
@@ -196,6 +196,14 @@ public:
   /// Scale the state by a constant
   void scale(const double f);
 
+  /**
+   *  @brief Exchange the fluxes and eigenvalue with another state
+   *
+   *  Only the storage is exchanged, so this is much cheaper than
+   *  copying.  The states must have the same sizes.
+   */
+  void swap(State &other);
+
   /// Format display of flux
   void display() const;
 
@@ -0,0 +1,115 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  SweepOrdering.cc
+ *  @brief SweepOrdering member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "SweepOrdering.hh"
+#include <deque>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+SweepOrdering::SweepOrdering(SP_mesh mesh, SP_quadrature quadrature)
+{
+  Require(mesh);
+  Require(quadrature);
+
+  size_t nc = mesh->number_cells_2d();
+  size_t no = quadrature->number_octants();
+  size_t na = quadrature->number_angles_octant();
+  d_order.resize(no, vec2_int(na));
+  d_lagged.resize(no, vec2_int(na));
+
+  vec_int indegree(nc, 0);
+  std::vector<bool> visited(nc, false);
+  std::deque<int> queue;
+
+  for (size_t o = 0; o < no; ++o)
+  {
+    for (size_t a = 0; a < na; ++a)
+    {
+      double mu  = quadrature->mu(o, a);
+      double eta = quadrature->eta(o, a);
+
+      // Count the upwind neighbors of each cell.
+      for (size_t c = 0; c < nc; ++c)
+      {
+        indegree[c] = 0;
+        visited[c]  = false;
+        for (size_t i = 0; i < mesh->number_cell_faces(c); ++i)
+        {
+          if (mesh->cell_neighbor(c, i) < 0) continue;
+          const Point &n = mesh->face_normal(mesh->cell_face(c, i));
+          double dot = mesh->cell_face_sign(c, i) * (mu*n.x() + eta*n.y());
+          if (dot < 0.0) ++indegree[c];
+        }
+        if (!indegree[c]) queue.push_back(c);
+      }
+
+      vec_int &order = d_order[o][a];
+      order.reserve(nc);
+      while (order.size() < nc)
+      {
+        if (queue.empty())
+        {
+          // Break a cycle at the unvisited cell with the fewest unresolved
+          // dependencies, lagging its unresolved incoming faces.
+          int c_min = -1;
+          for (size_t c = 0; c < nc; ++c)
+          {
+            if (visited[c]) continue;
+            if (c_min < 0 || indegree[c] < indegree[c_min]) c_min = c;
+          }
+          Assert(c_min >= 0);
+          for (size_t i = 0; i < mesh->number_cell_faces(c_min); ++i)
+          {
+            int n = mesh->cell_neighbor(c_min, i);
+            if (n < 0 || visited[n]) continue;
+            size_t f = mesh->cell_face(c_min, i);
+            const Point &nf = mesh->face_normal(f);
+            double dot = mesh->cell_face_sign(c_min, i) *
+                         (mu * nf.x() + eta * nf.y());
+            if (dot < 0.0) d_lagged[o][a].push_back(f);
+          }
+          indegree[c_min] = 0;
+          queue.push_back(c_min);
+        }
+
+        // Visit the cell and resolve its downwind neighbors.
+        int c = queue.front();
+        queue.pop_front();
+        visited[c] = true;
+        order.push_back(c);
+        for (size_t i = 0; i < mesh->number_cell_faces(c); ++i)
+        {
+          int n = mesh->cell_neighbor(c, i);
+          if (n < 0 || visited[n]) continue;
+          const Point &nf = mesh->face_normal(mesh->cell_face(c, i));
+          double dot = mesh->cell_face_sign(c, i) * (mu*nf.x() + eta*nf.y());
+          if (dot > 0.0 && --indegree[n] == 0) queue.push_back(n);
+        }
+      }
+      Ensure(queue.empty());
+    }
+  }
+}
+
+//---------------------------------------------------------------------------//
+SweepOrdering::size_t SweepOrdering::number_lagged() const
+{
+  size_t n = 0;
+  for (size_t o = 0; o < d_lagged.size(); ++o)
+    for (size_t a = 0; a < d_lagged[o].size(); ++a)
+      n += d_lagged[o][a].size();
+  return n;
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of SweepOrdering.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,115 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  SweepOrdering.hh
+ *  @brief SweepOrdering class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_SWEEPORDERING_HH_
+#define detran_SWEEPORDERING_HH_
+
+#include "transport/transport_export.hh"
+#include "angle/Quadrature.hh"
+#include "geometry/MeshUnstructured.hh"
+#include "utilities/DBC.hh"
+#include "utilities/Definitions.hh"
+#include "utilities/SP.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class SweepOrdering
+ *  @brief Cell orderings for sweeping an unstructured mesh.
+ *
+ *  For a direction \f$ \Omega \f$, a cell depends on the cells across
+ *  its incoming faces, i.e. those with \f$ \Omega \cdot n < 0 \f$.  A
+ *  valid sweep visits a cell only after all cells on which it depends,
+ *  which is a topological sort of the dependency graph.  Each ordering
+ *  is computed once with Kahn's algorithm: cells with no unresolved
+ *  dependencies are queued, and visiting a cell resolves the
+ *  dependencies of its downwind neighbors.
+ *
+ *  Non-convex cells can yield cyclic dependencies, in which case the
+ *  queue empties before every cell is visited.  The cycle is broken at
+ *  the unvisited cell with the fewest unresolved dependencies (the
+ *  lowest index for ties).  Its unresolved incoming faces are "lagged":
+ *  the sweep uses their fluxes from the previous iteration, which the
+ *  source iteration converges.
+ *
+ *  For an extruded mesh, the lateral dependencies are the same in every
+ *  layer, so the orderings are those of the polygons, and the layers are
+ *  swept in the direction of \f$ \xi \f$.  The octants follow the
+ *  quadrature's convention.
+ */
+//---------------------------------------------------------------------------//
+class TRANSPORT_EXPORT SweepOrdering
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<SweepOrdering>             SP_ordering;
+  typedef detran_geometry::MeshUnstructured::SP_mesh      SP_mesh;
+  typedef detran_geometry::MeshUnstructured::Point        Point;
+  typedef detran_angle::Quadrature::SP_quadrature         SP_quadrature;
+  typedef detran_utilities::vec_int                       vec_int;
+  typedef detran_utilities::vec2_int                      vec2_int;
+  typedef detran_utilities::vec3_int                      vec3_int;
+  typedef detran_utilities::size_t                        size_t;
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC INTERFACE
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param mesh         Unstructured mesh
+   *  @param quadrature   Angular quadrature
+   */
+  SweepOrdering(SP_mesh mesh, SP_quadrature quadrature);
+
+  /// Cells in sweep order for an angle
+  const vec_int& order(const size_t o, const size_t a) const
+  {
+    Require(o < d_order.size());
+    Require(a < d_order[o].size());
+    return d_order[o][a];
+  }
+
+  /// Faces whose incident flux is lagged for an angle
+  const vec_int& lagged(const size_t o, const size_t a) const
+  {
+    Require(o < d_lagged.size());
+    Require(a < d_lagged[o].size());
+    return d_lagged[o][a];
+  }
+
+  /// Total number of lagged faces over all angles
+  size_t number_lagged() const;
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Cell orderings [octant][angle][cell]
+  vec3_int d_order;
+  /// Lagged faces [octant][angle][face]
+  vec3_int d_lagged;
+
+};
+
+} // end namespace detran
+
+#endif /* detran_SWEEPORDERING_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of SweepOrdering.hh
+//---------------------------------------------------------------------------//
@@ -259,6 +259,40 @@ public:
               const size_t a,
               sweep_source_type& s);
 
+  /**
+   *  @brief Store the spatial flux moments of a group.
+   *
+   *  Linear source methods (see Equation_LS_MOC) represent the flux and
+   *  source in each region by an average and its first spatial moments,
+   *  @f$ \hat{\phi}_x = \frac{1}{V}\int_V (x - \bar{x}) \phi dV @f$
+   *  and similarly in y.  The sweeper stores the flux moments after each
+   *  sweep, and the source moments are built from them before the next.
+   *  The flux moments are thus lagged by one sweep, consistent with
+   *  source iteration within groups and Gauss-Seidel over groups.
+   *
+   *  @param g        Group
+   *  @param phi_x    x moments of the scalar flux
+   *  @param phi_y    y moments of the scalar flux
+   */
+  void set_flux_moments(const size_t g,
+                        const moments_type &phi_x,
+                        const moments_type &phi_y);
+
+  /**
+   *  @brief Build the spatial moments of the total group source.
+   *
+   *  The moments include all scattering and, if present, fission.
+   *  External sources are taken to be flat within a region and so
+   *  have no moments.
+   */
+  void build_linear_source(const size_t g);
+
+  /// Fill the spatial moments of a source vector
+  void linear_source(const size_t o,
+                     const size_t a,
+                     sweep_source_type &s_x,
+                     sweep_source_type &s_y);
+
   /// Return the fixed source for the current group
   const moments_type& fixed_group_source() const
   {
@@ -297,6 +331,10 @@ private:
   bool d_implicit_fission;
   /// Scattering source
   SP_scattersource d_scattersource;
+  /// Spatial flux moments by [x or y][group][cell] (for linear sources)
+  std::vector<State::vec_moments_type> d_flux_moments;
+  /// Spatial source moments of the current group by [x or y][cell]
+  std::vector<moments_type> d_source_moments;
 
 };
 
@@ -154,6 +154,63 @@ source(const size_t g, const size_t o, const size_t a, sweep_source_type &s)
 
 }
 
+//---------------------------------------------------------------------------//
+template <class D>
+inline void SweepSource<D>::set_flux_moments(const size_t g,
+                                             const moments_type &phi_x,
+                                             const moments_type &phi_y)
+{
+  Require(g < d_state->number_groups());
+  Require(phi_x.size() == d_mesh->number_cells());
+  Require(phi_y.size() == d_mesh->number_cells());
+  if (d_flux_moments.empty())
+  {
+    d_flux_moments.resize(2,
+      State::vec_moments_type(d_state->number_groups(),
+                              moments_type(d_mesh->number_cells(), 0.0)));
+  }
+  d_flux_moments[0][g] = phi_x;
+  d_flux_moments[1][g] = phi_y;
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+inline void SweepSource<D>::build_linear_source(const size_t g)
+{
+  Require(g < d_state->number_groups());
+  d_source_moments.assign(2, moments_type(d_mesh->number_cells(), 0.0));
+  // Before the first sweep, the source is flat.
+  if (d_flux_moments.empty()) return;
+  for (size_t dim = 0; dim < 2; ++dim)
+  {
+    d_scattersource->build_total_group_source(g, 0, d_flux_moments[dim],
+                                              d_source_moments[dim]);
+    if (d_fissionsource)
+    {
+      d_fissionsource->build_total_group_source(g, d_flux_moments[dim],
+                                                d_source_moments[dim]);
+    }
+  }
+}
+
+//---------------------------------------------------------------------------//
+template <class D>
+inline void SweepSource<D>::linear_source(const size_t o,
+                                          const size_t a,
+                                          sweep_source_type &s_x,
+                                          sweep_source_type &s_y)
+{
+  Require(d_source_moments.size() == 2);
+  double mtod = (*d_MtoD)(o, a, 0, 0);
+  s_x.resize(d_mesh->number_cells());
+  s_y.resize(d_mesh->number_cells());
+  for (size_t cell = 0; cell < d_mesh->number_cells(); ++cell)
+  {
+    s_x[cell] = d_source_moments[0][cell] * mtod;
+    s_y[cell] = d_source_moments[1][cell] * mtod;
+  }
+}
+
 //---------------------------------------------------------------------------//
 template <class D>
 void SweepSource<D>::reset()
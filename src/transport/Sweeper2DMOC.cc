@@ -9,6 +9,7 @@
 
 #include "transport/Sweeper2DMOC.hh"
 #include "transport/Equation_SC_MOC.hh"
+#include "transport/Equation_LS_MOC.hh"
 
 namespace detran
 {
@@ -24,8 +25,18 @@ Sweeper2DMOC<EQ>::Sweeper2DMOC(SP_input input,
                                SP_sweepsource sweepsource)
   : Base(input, mesh, material, quadrature, state, boundary, sweepsource)
   , d_boundary(boundary)
+  , d_linear(false)
 {
     d_tracks = mesh->tracks();
+    Require(d_tracks->is_finalized());
+    // Linear source equations need moments carried between sweeps.
+    d_linear = Equation_T(mesh, material, quadrature, false).is_linear();
+    // Balance the tracks over the threads.
+    int number_threads = 1;
+#ifdef DETRAN_ENABLE_OPENMP
+    number_threads = omp_get_max_threads();
+#endif
+    d_schedule = new TrackSchedule(d_tracks, quadrature, number_threads);
 }
 
 //---------------------------------------------------------------------------//
@@ -49,6 +60,8 @@ Sweeper2DMOC<EQ>::Create(SP_input       input,
 //---------------------------------------------------------------------------//
 
 TRANSPORT_INSTANTIATE_EXPORT(Sweeper2DMOC<Equation_SC_MOC>)
+TRANSPORT_INSTANTIATE_EXPORT(Sweeper2DMOC<Equation_LS_MOC>)
 TRANSPORT_TEMPLATE_EXPORT(detran_utilities::SP<Sweeper2DMOC<Equation_SC_MOC> >)
+TRANSPORT_TEMPLATE_EXPORT(detran_utilities::SP<Sweeper2DMOC<Equation_LS_MOC> >)
 
 } // end namespace detran
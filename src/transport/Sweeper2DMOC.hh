@@ -11,6 +11,7 @@
 #define detran_SWEEPER2DMOC_HH_
 
 #include "transport/Sweeper.hh"
+#include "transport/TrackSchedule.hh"
 #include "angle/QuadratureMOC.hh"
 #include "boundary/BoundaryMOC.hh"
 #include "geometry/MeshMOC.hh"
@@ -23,6 +24,12 @@ namespace detran
 /**
  *  @class Sweeper2DMOC
  *  @brief Sweeper for 2D MOC problems.
+ *
+ *  With OpenMP, the tracks of each octant are divided among the threads
+ *  in blocks of about equal numbers of segments (see TrackSchedule), and
+ *  each thread sweeps its own tracks, so that every outgoing boundary
+ *  flux has a single writer.  The schedule is built for the number of
+ *  threads available when the sweeper is constructed.
  */
 
 template <class EQ>
@@ -54,7 +61,10 @@ public:
   typedef detran_geometry::MeshMOC::SP_mesh             SP_mesh;
   typedef detran_angle::QuadratureMOC::SP_quadrature    SP_quadrature;
   typedef detran_geometry::TrackDB::SP_trackdb          SP_trackdb;
+  typedef detran_geometry::TrackDB::SegmentBuffer       SegmentBuffer;
   typedef detran_geometry::Track::SP_track              SP_track;
+  typedef detran_geometry::Track::Point                 Point;
+  typedef TrackSchedule::SP_schedule                    SP_schedule;
 
   //-------------------------------------------------------------------------//
   // CONSTRUCTOR & DESTRUCTOR
@@ -108,6 +118,45 @@ private:
   SP_boundary d_boundary;
   // Track database
   SP_trackdb d_tracks;
+  // Does the equation use linear sources?
+  bool d_linear;
+  // Assignment of tracks to threads
+  SP_schedule d_schedule;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Index of a fine mesh edge in a sweep's current buffer
+   *
+   *  The buffer holds both senses for the x-directed edges followed
+   *  by those for the y-directed edges.  Each thread fills its own
+   *  buffer, and the buffers are summed into the tally once per sweep.
+   *
+   *  @param  i         x mesh index (edge index if axis = 0)
+   *  @param  j         y mesh index (edge index if axis = 1)
+   *  @param  axis      axis index of the edge normal
+   *  @param  sense     1 for positive flow, else 0
+   */
+  inline size_t edge_index(const size_t i,
+                           const size_t j,
+                           const size_t axis,
+                           const size_t sense) const;
+
+  /**
+   *  @brief Tally the partial current where a track meets the boundary
+   *  @param  p         point on the boundary
+   *  @param  region    fine mesh cell adjacent to the point
+   *  @param  value     weighted angular flux at the point
+   *  @param  incident  true if the track enters the domain at the point
+   *  @param  current   this thread's edge current buffer
+   */
+  inline void tally_boundary(const Point  &p,
+                             const size_t  region,
+                             const double  value,
+                             const bool    incident,
+                             moments_type &current);
 
 };
 
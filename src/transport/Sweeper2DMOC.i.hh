@@ -10,6 +10,8 @@
 #ifndef detran_SWEEPER2DMOC_I_HH_
 #define detran_SWEEPER2DMOC_I_HH_
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #ifdef DETRAN_ENABLE_OPENMP
 #include <omp.h>
@@ -29,13 +31,34 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
   // Reset the flux moments
   phi.assign(phi.size(), 0.0);
 
+  // Reset the current tally for this group.
+  if (d_tally) d_tally->reset(d_g);
+
+  // Spatial flux moments and the source moments built from the last
+  // ones, for linear sources.
+  moments_type phi_x(d_linear ? d_mesh->number_cells() : 0, 0.0);
+  moments_type phi_y(phi_x);
+  if (d_linear) d_sweepsource->build_linear_source(d_g);
+
+  // Partial currents on all fine mesh edges, summed into the tally
+  // after the sweep.
+  size_t nx = d_mesh->number_cells_x();
+  size_t ny = d_mesh->number_cells_y();
+  moments_type current(d_tally ? 2 * ((nx + 1) * ny + nx * (ny + 1)) : 0, 0.0);
+
 #ifdef DETRAN_ENABLE_OPENMP
-  moments_type phi_local;
+  moments_type phi_local, phi_x_local, phi_y_local, current_local;
 #else
   moments_type &phi_local = phi;
+  moments_type &phi_x_local = phi_x;
+  moments_type &phi_y_local = phi_y;
+  moments_type &current_local = current;
 #endif
 
-  #pragma omp parallel default(shared) private(phi_local)
+  #pragma omp parallel default(shared) \
+                       private(phi_local, phi_x_local, phi_y_local, \
+                               current_local) \
+                       num_threads(d_schedule->number_threads())
   {
 
   // Initialize equation and setup for this group.
@@ -44,15 +67,30 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
 
   // Reset the flux moments
   phi_local.resize(d_mesh->number_cells(), 0.0);
+  phi_x_local.resize(phi_x.size(), 0.0);
+  phi_y_local.resize(phi_y.size(), 0.0);
+  current_local.resize(current.size(), 0.0);
 
   // Initialize discrete sweep source vector.
   SweepSource<_2D>::sweep_source_type source(d_mesh->number_cells(), 0.0);
+  SweepSource<_2D>::sweep_source_type source_x, source_y;
+
+  // Scratch space for segments of modular tracks.
+  SegmentBuffer segment_buffer;
 
   double psi_in  = 0;
   double psi_out = 0;
 
   SP_quadrature q = d_quadrature;
 
+  // This thread's share of the tracks (see TrackSchedule).
+  size_t thread = 0;
+  size_t number_threads = 1;
+#ifdef DETRAN_ENABLE_OPENMP
+  thread = omp_get_thread_num();
+  number_threads = omp_get_num_threads();
+#endif
+
   // Sweep over all octants.
   for (size_t oo = 0; oo < 4; oo++)
   {
@@ -62,75 +100,113 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
     // Setup equation for this octant.
     equation.setup_octant(o);
 
-    // Sweep over all angles.
-    #pragma omp for
-    for (size_t a = 0; a < q->number_angles_octant(); ++a)
+    // Update the boundary for all angles before any track is swept.
+    if (d_update_boundary)
     {
-      //cout << "  ANGLE: " << a << endl;
-
-      // Get the azimuth and polar indices within the octant.
-      size_t azimuth = q->azimuth(a);
-      size_t polar   = q->polar(a);
-      //cout << "  AZIMUTH: " << azimuth << endl;
-      //cout << "  POLAR: " << polar << endl;
-
-      // Switch this back to one angle setup.
-      equation.setup_azimuth(azimuth);
-      equation.setup_polar(polar);
-
-      // Switch the azimuth index to correct one for track access.
-      // \todo Adjoint sweeps should probably be controlled here
-      bool track_reverse = false;
-      switch (o)
-      {
-        case 0 :
-          // do nothing
-          break;
-        case 1:
-          azimuth += q->number_azimuths_octant();
-          break;
-        case 2:
-          track_reverse = true;
-          break;
-        case 3:
-          azimuth += q->number_azimuths_octant();
-          track_reverse = true;
-          break;
-        default:
-          THROW("WTF!!!");
-          break;
-      }
-
-      // Get sweep source for this angle.
-      d_sweepsource->source(d_g, o, a, source);
-
-      // Get psi if update requested.
-      State::angular_flux_type psi;
-      if (d_update_psi) psi = d_state->psi(d_g, o, a);
-
-      // Update the boundary for this angle.
-      if (d_update_boundary) d_boundary->update(d_g, o, a);
+      #pragma omp for
+      for (int a = 0; a < (int) q->number_angles_octant(); ++a)
+        d_boundary->update(d_g, o, a);
+    }
 
-      // Sweep over all tracks.
-      for (int t = 0; t < d_tracks->number_tracks_angle(azimuth); t++)
+    // Data for the current angle, set as each new angle is reached.
+    int    angle_last     = -1;
+    size_t azimuth        = 0;
+    bool   track_reverse  = false;
+    double current_weight = 0.0;
+    State::angular_flux_type psi;
+
+    // Sweep over this thread's blocks of tracks, which are ordered by
+    // angle.  A team smaller than the schedule (e.g. a nested sweep or
+    // a thread limit) takes several blocks per thread.
+    for (size_t b = thread; b < d_schedule->number_threads();
+         b += number_threads)
+    {
+      for (size_t i = d_schedule->begin(o, b); i < d_schedule->end(o, b);
+           ++i)
       {
-//        if (!track_reverse)
-//          cout << "    TRACK: " << t << endl;
-//        else
-//          cout << "    TRACK: " << t << " in REVERSE" << endl;
-        // Get track.
-        SP_track track = d_tracks->track(azimuth, t);
+        size_t a = d_schedule->angle(o, i);
+        int    t = d_schedule->track(o, i);
+
+        if ((int) a != angle_last)
+        {
+          angle_last = a;
+          //cout << "  ANGLE: " << a << endl;
+
+          // Get the azimuth and polar indices within the octant.
+          azimuth = q->azimuth(a);
+          size_t polar = q->polar(a);
+
+          // Switch this back to one angle setup.
+          equation.setup_azimuth(azimuth);
+          equation.setup_polar(polar);
+
+          // Switch the azimuth index to correct one for track access.
+          // \todo Adjoint sweeps should probably be controlled here
+          track_reverse = false;
+          switch (o)
+          {
+            case 0 :
+              // do nothing
+              break;
+            case 1:
+              azimuth += q->number_azimuths_octant();
+              break;
+            case 2:
+              track_reverse = true;
+              break;
+            case 3:
+              azimuth += q->number_azimuths_octant();
+              track_reverse = true;
+              break;
+            default:
+              THROW("WTF!!!");
+              break;
+          }
+
+          // Weight for converting a track angular flux into a surface
+          // integrated partial current.  This must use the same in-octant
+          // azimuth as the equation.
+          if (d_tally)
+          {
+            current_weight = q->weight(a) *
+                             d_tracks->spacing(q->azimuth(a)) *
+                             q->sin_theta(polar);
+          }
+
+          // Get sweep source for this angle.
+          d_sweepsource->source(d_g, o, a, source);
+          if (d_linear)
+          {
+            d_sweepsource->linear_source(o, a, source_x, source_y);
+            equation.setup_linear_source(source_x, source_y,
+                                         phi_x_local, phi_y_local);
+          }
+
+          // Get psi if update requested.
+          if (d_update_psi) psi = d_state->psi(d_g, o, a);
+        }
+
+        // Get the segments of this track.
+        const int    *regions = 0;
+        const double *lengths = 0;
+        int number_segments = d_tracks->segments(azimuth, t, regions,
+                                                 lengths, segment_buffer);
+        if (d_linear)
+        {
+          equation.setup_track(d_tracks->track(azimuth, t), track_reverse,
+                               lengths, number_segments);
+        }
 
         // *** LOAD THE BOUNDARY FLUX.
-//        if (o == 0)
-//          psi_out = 1.0 + 4*o + t;
-//        else
+  //        if (o == 0)
+  //          psi_out = 1.0 + 4*o + t;
+  //        else
         psi_out = (*d_boundary)(d_g, o, a, BoundaryMOC<_2D>::IN, t);
 
-//        cout << " OCTANT = " << o << endl;
-//        cout << "   ANGLE = " << a << endl;
-//        cout << "     TRACK = " << t << endl;
-//        cout << "       psi_in = " << psi_out << endl;
+  //        cout << " OCTANT = " << o << endl;
+  //        cout << "   ANGLE = " << a << endl;
+  //        cout << "     TRACK = " << t << endl;
+  //        cout << "       psi_in = " << psi_out << endl;
 
         // SN access
         // boundary_flux_type psi_v = (*d_boundary)
@@ -146,10 +222,11 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
 
         // Sweep all segments on the track.
         int s = 0;
-        for (int ss = 0; ss < track->number_segments(); ss++)
+        int region_last = -1;
+        for (int ss = 0; ss < number_segments; ss++)
         {
           s = ss;
-          if (track_reverse) s = track->number_segments() - ss - 1;
+          if (track_reverse) s = number_segments - ss - 1;
 
           //cout << "      SEGMENT: " << s << endl;
 
@@ -157,29 +234,69 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
           psi_in = psi_out;
 
           // Get segment region.
-          int region = track->segment(s).region();
+          int region = regions[s];
+
+          // Tally the partial current entering the region.
+          if (d_tally)
+          {
+            if (ss == 0)
+            {
+              SP_track track = d_tracks->track(azimuth, t);
+              tally_boundary(track_reverse ? track->exit() : track->enter(),
+                             region, psi_in * current_weight, true,
+                             current_local);
+            }
+            else if (region != region_last)
+            {
+              int i0 = d_mesh->cell_to_i(region_last);
+              int j0 = d_mesh->cell_to_j(region_last);
+              int i1 = d_mesh->cell_to_i(region);
+              int j1 = d_mesh->cell_to_j(region);
+              if (i1 != i0)
+              {
+                current_local[edge_index(std::max(i0, i1), j0, 0, i1 > i0)]
+                  += psi_in * current_weight;
+              }
+              if (j1 != j0)
+              {
+                current_local[edge_index(i1, std::max(j0, j1), 1, j1 > j0)]
+                  += psi_in * current_weight;
+              }
+            }
+            region_last = region;
+          }
 
           // Get segment length.
-          double length = track->segment(s).length();
+          double length = lengths[s];
 
           // Solve.
-          equation.solve(region, length, source, psi_in, psi_out, phi_local, psi);
+          equation.solve(region, length, source, psi_in, psi_out,
+                         phi_local, psi);
 
           //cout << "        PSI_OUT: " << psi_out << endl;
 
         } // end segment
 
+        // Tally the partial current leaving the domain.
+        if (d_tally)
+        {
+          SP_track track = d_tracks->track(azimuth, t);
+          tally_boundary(track_reverse ? track->enter() : track->exit(),
+                         region_last, psi_out * current_weight, false,
+                         current_local);
+        }
+
         // *** UPDATE THE BOUNDARY WITH psi_out
         (*d_boundary)(d_g, o, a, BoundaryMOC<_2D>::OUT, t) = psi_out;
 
         //cout << "      psi_out = " << psi_out << endl;
 
       } // end track
+    } // end block
 
-
-
-    } // end angle loop
-    // end omp do
+    // The next octant's boundary update needs this octant's outgoing
+    // fluxes from all threads.
+    #pragma omp barrier
 
   } // end octant loop
 
@@ -191,11 +308,48 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
     {
       phi[i] += phi_local[i];
     }
+    for (size_t i = 0; i < phi_x.size(); ++i)
+    {
+      phi_x[i] += phi_x_local[i];
+      phi_y[i] += phi_y_local[i];
+    }
+    for (size_t i = 0; i < current.size(); ++i)
+      current[i] += current_local[i];
   }
 #endif
 
   } // end omp parallel
 
+  // Add the edge currents to the tally.
+  if (d_tally)
+  {
+    for (size_t j = 0; j < ny; ++j)
+    {
+      for (size_t i = 0; i <= nx; ++i)
+      {
+        for (size_t sense = 0; sense < 2; ++sense)
+        {
+          d_tally->tally_edge(i, j, 0, d_g, 0, sense,
+                              current[edge_index(i, j, 0, sense)]);
+        }
+      }
+    }
+    for (size_t j = 0; j <= ny; ++j)
+    {
+      for (size_t i = 0; i < nx; ++i)
+      {
+        for (size_t sense = 0; sense < 2; ++sense)
+        {
+          d_tally->tally_edge(i, j, 0, d_g, 1, sense,
+                              current[edge_index(i, j, 1, sense)]);
+        }
+      }
+    }
+  }
+
+  // Keep the flux moments for the next source.
+  if (d_linear) d_sweepsource->set_flux_moments(d_g, phi_x, phi_y);
+
   #pragma omp master
   {
     d_number_sweeps++;
@@ -203,6 +357,82 @@ inline void Sweeper2DMOC<EQ>::sweep(moments_type &phi)
   return;
 }
 
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline typename Sweeper2DMOC<EQ>::size_t
+Sweeper2DMOC<EQ>::edge_index(const size_t i,
+                             const size_t j,
+                             const size_t axis,
+                             const size_t sense) const
+{
+  size_t nx = d_mesh->number_cells_x();
+  size_t ny = d_mesh->number_cells_y();
+  Require(axis < 2);
+  Require(sense < 2);
+  if (axis == 0)
+  {
+    Require(i <= nx && j < ny);
+    return 2 * (i + j * (nx + 1)) + sense;
+  }
+  Require(i < nx && j <= ny);
+  return 2 * ((nx + 1) * ny + i + j * nx) + sense;
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void Sweeper2DMOC<EQ>::tally_boundary(const Point  &p,
+                                             const size_t  region,
+                                             const double  value,
+                                             const bool    incident,
+                                             moments_type &current)
+{
+  // Preconditions
+  Require(d_tally);
+  Require(region < d_mesh->number_cells());
+
+  size_t i = d_mesh->cell_to_i(region);
+  size_t j = d_mesh->cell_to_j(region);
+
+  // Identify the side.  Tracks leaving through a corner are assigned
+  // to the vertical side.
+  double eps = 1.0e-10 * std::max(d_mesh->total_width_x(),
+                                  d_mesh->total_width_y());
+  size_t axis = 0;
+  size_t edge = 0;
+  bool   high = false;
+  if (std::abs(p.x()) < eps)
+  {
+    axis = 0;
+    edge = 0;
+  }
+  else if (std::abs(p.x() - d_mesh->total_width_x()) < eps)
+  {
+    axis = 0;
+    edge = d_mesh->number_cells_x();
+    high = true;
+  }
+  else if (std::abs(p.y()) < eps)
+  {
+    axis = 1;
+    edge = 0;
+  }
+  else
+  {
+    Assert(std::abs(p.y() - d_mesh->total_width_y()) < eps);
+    axis = 1;
+    edge = d_mesh->number_cells_y();
+    high = true;
+  }
+
+  // Flow into the low side or out of the high side is positive.
+  size_t sense = (incident != high) ? 1 : 0;
+
+  if (axis == 0)
+    current[edge_index(edge, j, 0, sense)] += value;
+  else
+    current[edge_index(i, edge, 1, sense)] += value;
+}
+
 } // end namespace detran
 
 #endif /* detran_SWEEPER2DMOC_I_HH_ */
@@ -0,0 +1,73 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  Sweeper2DUnstructured.cc
+ *  @brief Sweeper2DUnstructured member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "transport/Sweeper2DUnstructured.hh"
+#include "transport/Equation_SD_Unstructured.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+Sweeper2DUnstructured<EQ>::Sweeper2DUnstructured(SP_input input,
+                                                 SP_mesh mesh,
+                                                 SP_material material,
+                                                 SP_quadrature quadrature,
+                                                 SP_state state,
+                                                 SP_boundary boundary,
+                                                 SP_sweepsource sweepsource)
+  : Base(input, mesh, material, quadrature, state, boundary, sweepsource)
+  , d_unstructured(mesh)
+{
+  Require(boundary);
+  Insist(d_unstructured, "The unstructured sweeper needs a MeshUnstructured.");
+
+  d_ordering = new SweepOrdering(d_unstructured, d_quadrature);
+
+  size_t na = d_quadrature->number_angles_octant();
+  d_face_flux.resize(d_material->number_groups(),
+                     detran_utilities::vec3_dbl(d_quadrature->number_octants(),
+                     detran_utilities::vec2_dbl(na,
+                     detran_utilities::vec_dbl(
+                       d_unstructured->number_face_fluxes(), 0.0))));
+
+  detran_utilities::vec_bool reflective(4, false);
+  for (int side = 0; side < 4; ++side)
+    reflective[side] = boundary->is_reflective(side);
+  d_boundary_map =
+    new BoundaryMapUnstructured(d_unstructured, d_quadrature, reflective);
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+typename Sweeper2DUnstructured<EQ>::SP_sweeper
+Sweeper2DUnstructured<EQ>::Create(SP_input       input,
+                                  SP_mesh        mesh,
+                                  SP_material    material,
+                                  SP_quadrature  quadrature,
+                                  SP_state       state,
+                                  SP_boundary    boundary,
+                                  SP_sweepsource sweepsource)
+{
+  SP_sweeper p(new Sweeper2DUnstructured(input, mesh, material, quadrature,
+                                         state, boundary, sweepsource));
+  return p;
+}
+
+//---------------------------------------------------------------------------//
+// EXPLICIT INSTANTIATIONS
+//---------------------------------------------------------------------------//
+
+TRANSPORT_INSTANTIATE_EXPORT(Sweeper2DUnstructured<Equation_SD_Unstructured>)
+TRANSPORT_TEMPLATE_EXPORT(detran_utilities::SP<Sweeper2DUnstructured<Equation_SD_Unstructured> >)
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of Sweeper2DUnstructured.cc
+//---------------------------------------------------------------------------//
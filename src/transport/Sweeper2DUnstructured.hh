@@ -0,0 +1,158 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  Sweeper2DUnstructured.hh
+ *  @brief Sweeper2DUnstructured class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_SWEEPER2DUNSTRUCTURED_HH_
+#define detran_SWEEPER2DUNSTRUCTURED_HH_
+
+#include "transport/Sweeper.hh"
+#include "transport/BoundaryMapUnstructured.hh"
+#include "transport/SweepOrdering.hh"
+#include "boundary/BoundarySN.hh"
+#include "geometry/MeshUnstructured.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class Sweeper2DUnstructured
+ *  @brief Sweeper for 2D discrete ordinates problems on polygonal meshes.
+ *
+ *  Each angle is swept cell by cell in the order given by SweepOrdering.
+ *  The face fluxes of every angle are kept between sweeps, which serves
+ *  two purposes.  First, a face lagged to break a dependency cycle
+ *  simply keeps its flux from the previous sweep.  Second, the incident
+ *  boundary faces given by BoundaryMapUnstructured, i.e. those on a
+ *  reflective side or with a rotational partner, take the latest
+ *  outgoing flux of the mapped face and angle, so that neither needs
+ *  separate boundary storage.  Any other boundary face keeps a zero
+ *  incident flux.
+ *
+ *  The SN boundary is used only for its boundary conditions.  Since the
+ *  sweep depends on the previous one, only source iteration within
+ *  groups is supported.
+ */
+//---------------------------------------------------------------------------//
+template <class EQ>
+class Sweeper2DUnstructured: public Sweeper<_2D>
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<Sweeper2DUnstructured>   SP_sweeper;
+  typedef Sweeper<_2D>                                  Base;
+  typedef typename Base::SP_state                       SP_state;
+  typedef typename Base::SP_input                       SP_input;
+  typedef typename Base::SP_material                    SP_material;
+  typedef typename Base::SP_mesh                        SP_mesh;
+  typedef typename Base::SP_quadrature                  SP_quadrature;
+  typedef typename Base::SP_sweepsource                 SP_sweepsource;
+  typedef typename Base::moments_type                   moments_type;
+  typedef typename Base::angular_flux_type              angular_flux_type;
+  typedef typename Base::vec_int                        vec_int;
+  typedef typename Base::vec2_int                       vec2_int;
+  typedef typename Base::vec3_int                       vec3_int;
+  typedef typename Base::size_t                         size_t;
+  typedef EQ                                            Equation_T;
+  typedef BoundarySN<_2D>                               Boundary_T;
+  typedef typename Boundary_T::SP_boundary              SP_boundary;
+  typedef detran_geometry::MeshUnstructured             Mesh_T;
+  typedef SweepOrdering::SP_ordering                    SP_ordering;
+  typedef BoundaryMapUnstructured::SP_map               SP_map;
+  typedef detran_utilities::vec4_dbl                    vec4_dbl;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor.
+   *  @param    input       User input database.
+   *  @param    mesh        Unstructured mesh.
+   *  @param    material    Material database.
+   *  @param    quadrature  Angular quadrature.
+   *  @param    state       State vectors.
+   *  @param    boundary    Boundary giving the boundary conditions.
+   *  @param    sweepsource Sweep source constructor.
+   */
+  Sweeper2DUnstructured(SP_input input,
+                        SP_mesh mesh,
+                        SP_material material,
+                        SP_quadrature quadrature,
+                        SP_state state,
+                        SP_boundary boundary,
+                        SP_sweepsource sweepsource);
+
+  /// Virtual destructor
+  virtual ~Sweeper2DUnstructured(){}
+
+  /// SP Constructor
+  static SP_sweeper
+  Create(SP_input       input,
+         SP_mesh        mesh,
+         SP_material    material,
+         SP_quadrature  quadrature,
+         SP_state       state,
+         SP_boundary    boundary,
+         SP_sweepsource sweepsource);
+
+  //-------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL SWEEPERS MUST IMPLEMENT THESE
+  //-------------------------------------------------------------------------//
+
+  /// Sweep.
+  inline void sweep(moments_type &phi);
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /// Sweep orderings
+  SP_ordering ordering() const { return d_ordering; }
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Unstructured mesh
+  detran_utilities::SP<Mesh_T> d_unstructured;
+  /// Sweep orderings
+  SP_ordering d_ordering;
+  /// Face fluxes [group][octant][angle][face]
+  vec4_dbl d_face_flux;
+  /// Sources of the incident boundary fluxes
+  SP_map d_boundary_map;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Set the incident boundary fluxes for an angle.
+  inline void set_incident(const size_t o, const size_t a);
+
+};
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+// INLINE MEMBER DEFINITIONS
+//---------------------------------------------------------------------------//
+
+#include "Sweeper2DUnstructured.i.hh"
+
+#endif /* detran_SWEEPER2DUNSTRUCTURED_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of Sweeper2DUnstructured.hh
+//---------------------------------------------------------------------------//
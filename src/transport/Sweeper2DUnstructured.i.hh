@@ -0,0 +1,119 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  Sweeper2DUnstructured.i.hh
+ *  @brief Sweeper2DUnstructured inline member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_SWEEPER2DUNSTRUCTURED_I_HH_
+#define detran_SWEEPER2DUNSTRUCTURED_I_HH_
+
+#ifdef DETRAN_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void Sweeper2DUnstructured<EQ>::sweep(moments_type &phi)
+{
+  // Reset the flux moments
+  phi.assign(phi.size(), 0.0);
+
+#ifdef DETRAN_ENABLE_OPENMP
+  moments_type phi_local;
+#else
+  moments_type &phi_local = phi;
+#endif
+
+  #pragma omp parallel default(shared) private(phi_local)
+  {
+
+  // Initialize equation and setup for this group.
+  Equation_T equation(d_unstructured, d_material, d_quadrature, d_update_psi);
+  equation.setup_group(d_g);
+
+  // Reset the flux moments
+  phi_local.resize(d_mesh->number_cells(), 0.0);
+
+  // Initialize discrete sweep source vector.
+  SweepSource<_2D>::sweep_source_type source(d_mesh->number_cells(), 0.0);
+
+  // Sweep over all octants.
+  for (size_t oo = 0; oo < d_quadrature->number_octants(); oo++)
+  {
+    size_t o = d_ordered_octants[oo];
+    equation.setup_octant(o);
+
+    // Set the incident boundary fluxes of the octant before sweeping it,
+    // since a boundary can map one angle of the octant onto another.
+    #pragma omp for
+    for (size_t a = 0; a < d_quadrature->number_angles_octant(); a++)
+      set_incident(o, a);
+
+    #pragma omp for
+    for (size_t a = 0; a < d_quadrature->number_angles_octant(); a++)
+    {
+      // Get sweep source for this angle.
+      d_sweepsource->source(d_g, o, a, source);
+
+      // Setup equation for this angle.
+      equation.setup_angle(a);
+
+      // Get psi if needed.
+      State::angular_flux_type psi;
+      if (d_update_psi) psi = d_state->psi(d_g, o, a);
+
+      // Sweep the cells in order.
+      detran_utilities::vec_dbl &psi_face = d_face_flux[d_g][o][a];
+      const vec_int &order = d_ordering->order(o, a);
+      for (size_t c = 0; c < order.size(); ++c)
+        equation.solve(order[c], source, psi_face, phi_local, psi);
+
+      // Update the angular flux.
+      if (d_update_psi) d_state->psi(d_g, o, a) = psi;
+
+    } // end angle loop
+
+  } // end octant loop
+
+#ifdef DETRAN_ENABLE_OPENMP
+  // Sum local thread fluxes.
+  #pragma omp critical
+  {
+    for (int i = 0; i < d_mesh->number_cells(); i++)
+    {
+      phi[i] += phi_local[i];
+    }
+  }
+#endif
+
+  } // end omp parallel
+
+  d_number_sweeps++;
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void Sweeper2DUnstructured<EQ>::set_incident(const size_t o,
+                                                    const size_t a)
+{
+  detran_utilities::vec_dbl &psi_face = d_face_flux[d_g][o][a];
+  const vec_int &f  = d_boundary_map->face(o, a);
+  const vec_int &so = d_boundary_map->source_octant(o, a);
+  const vec_int &sa = d_boundary_map->source_angle(o, a);
+  const vec_int &sf = d_boundary_map->source_face(o, a);
+  for (size_t i = 0; i < f.size(); ++i)
+    psi_face[f[i]] = d_face_flux[d_g][so[i]][sa[i]][sf[i]];
+}
+
+} // end namespace detran
+
+#endif /* detran_SWEEPER2DUNSTRUCTURED_I_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of Sweeper2DUnstructured.i.hh
+//---------------------------------------------------------------------------//
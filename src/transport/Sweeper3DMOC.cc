@@ -0,0 +1,57 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   Sweeper3DMOC.cc
+ *  @author Jeremy Roberts
+ *  @date   Feb 11, 2013
+ *  @brief  Sweeper3DMOC member definitions.
+ */
+//---------------------------------------------------------------------------//
+
+#include "transport/Sweeper3DMOC.hh"
+#include "transport/Equation_SC_MOC.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+Sweeper3DMOC<EQ>::Sweeper3DMOC(SP_input input,
+                               SP_mesh mesh,
+                               SP_material material,
+                               SP_quadrature quadrature,
+                               SP_state state,
+                               SP_boundary boundary,
+                               SP_sweepsource sweepsource)
+  : Base(input, mesh, material, quadrature, state, boundary, sweepsource)
+  , d_boundary(boundary)
+{
+  d_tracks = mesh->tracks();
+  d_stack  = mesh->stack();
+  Require(d_tracks->is_finalized());
+  Insist(d_stack, "3D MOC requires axially stacked tracks.");
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+typename Sweeper3DMOC<EQ>::SP_sweeper
+Sweeper3DMOC<EQ>::Create(SP_input       input,
+                         SP_mesh        mesh,
+                         SP_material    material,
+                         SP_quadrature  quadrature,
+                         SP_state       state,
+                         SP_boundary    boundary,
+                         SP_sweepsource sweepsource)
+{
+  SP_sweeper p(new Sweeper3DMOC(input, mesh, material, quadrature,
+                                state, boundary, sweepsource));
+  return p;
+}
+
+//---------------------------------------------------------------------------//
+// EXPLICIT INSTANTIATIONS
+//---------------------------------------------------------------------------//
+
+TRANSPORT_INSTANTIATE_EXPORT(Sweeper3DMOC<Equation_SC_MOC>)
+TRANSPORT_TEMPLATE_EXPORT(detran_utilities::SP<Sweeper3DMOC<Equation_SC_MOC> >)
+
+} // end namespace detran
@@ -0,0 +1,133 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   Sweeper3DMOC.hh
+ *  @author Jeremy Roberts
+ *  @date   Feb 11, 2013
+ *  @brief  Sweeper3DMOC class definition.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_SWEEPER3DMOC_HH_
+#define detran_SWEEPER3DMOC_HH_
+
+#include "transport/Sweeper.hh"
+#include "angle/QuadratureMOC.hh"
+#include "boundary/BoundaryMOC.hh"
+#include "geometry/MeshMOC.hh"
+#include "geometry/TrackDB.hh"
+#include "geometry/TrackStack.hh"
+
+namespace detran
+{
+
+/**
+ *  @class Sweeper3DMOC
+ *  @brief Sweeper for 3D MOC problems on axially stacked tracks.
+ *
+ *  The 3D tracks are stacked over the 2D tracks of the xy projection
+ *  (see TrackStack).  For each 2D track, its segments are fetched
+ *  once and then cut at the axial planes for each 3D track of the
+ *  stack, so that the 3D segments are never stored.  Octants 0-3
+ *  sweep the upward tracks and octants 4-7 the downward tracks, with
+ *  the xy directions of the 2D octants as in Sweeper2DMOC.
+ *
+ *  Partial current tallies (and hence coarse mesh acceleration)
+ *  are not supported.
+ */
+
+template <class EQ>
+class Sweeper3DMOC: public Sweeper<_3D>
+{
+
+public:
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<Sweeper3DMOC>            SP_sweeper;
+  typedef Sweeper<_3D>                                  Base;
+  typedef typename Base::SP_state                       SP_state;
+  typedef typename Base::SP_input                       SP_input;
+  typedef typename Base::SP_material                    SP_material;
+  typedef typename Base::Mesh                           Mesh;
+  typedef typename Base::SP_sweepsource                 SP_sweepsource;
+  typedef typename Base::moments_type                   moments_type;
+  typedef typename Base::angular_flux_type              angular_flux_type;
+  typedef typename Base::vec_int                        vec_int;
+  typedef typename Base::size_t                         size_t;
+  typedef EQ                                            Equation_T;
+  typedef BoundaryMOC<_3D>                              Boundary_T;
+  typedef typename Boundary_T::SP_boundary              SP_boundary;
+  typedef detran_geometry::MeshMOC::SP_mesh             SP_mesh;
+  typedef detran_angle::QuadratureMOC::SP_quadrature    SP_quadrature;
+  typedef detran_geometry::TrackDB::SP_trackdb          SP_trackdb;
+  typedef detran_geometry::TrackDB::SegmentBuffer       SegmentBuffer;
+  typedef detran_geometry::TrackStack::SP_trackstack    SP_trackstack;
+  typedef detran_utilities::vec_dbl                     vec_dbl;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor.
+   *  @param    input       User input database.
+   *  @param    mesh        Tracked mesh.
+   *  @param    material    Material database.
+   *  @param    quadrature  Angular quadrature for MOC.
+   *  @param    state       State vectors.
+   *  @param    boundary    Boundary based on tracks.
+   *  @param    sweepsource Sweep source constructor.
+   */
+  Sweeper3DMOC(SP_input input,
+               SP_mesh mesh,
+               SP_material material,
+               SP_quadrature quadrature,
+               SP_state state,
+               SP_boundary boundary,
+               SP_sweepsource sweepsource);
+
+  /// Virtual destructor
+  virtual ~Sweeper3DMOC(){}
+
+  /// SP Constructor
+  static SP_sweeper
+  Create(SP_input       input,
+         SP_mesh        mesh,
+         SP_material    material,
+         SP_quadrature  quadrature,
+         SP_state       state,
+         SP_boundary    boundary,
+         SP_sweepsource sweepsource);
+
+  //-------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL SWEEPERS MUST IMPLEMENT THESE
+  //-------------------------------------------------------------------------//
+
+  /// Sweep.
+  inline void sweep(moments_type &phi);
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  // MOC boundary
+  SP_boundary d_boundary;
+  // Track database of the xy projection
+  SP_trackdb d_tracks;
+  // Axially stacked tracks
+  SP_trackstack d_stack;
+
+};
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+// INLINE MEMBER DEFINITIONS
+//---------------------------------------------------------------------------//
+
+#include "Sweeper3DMOC.i.hh"
+
+#endif /* detran_SWEEPER3DMOC_HH_ */
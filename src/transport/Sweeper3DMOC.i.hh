@@ -0,0 +1,152 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   Sweeper3DMOC.i.hh
+ *  @author Jeremy Roberts
+ *  @date   Feb 11, 2013
+ *  @brief  Sweeper3DMOC inline member definitions.
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_SWEEPER3DMOC_I_HH_
+#define detran_SWEEPER3DMOC_I_HH_
+
+#ifdef DETRAN_ENABLE_OPENMP
+#include <omp.h>
+#endif
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+inline void Sweeper3DMOC<EQ>::sweep(moments_type &phi)
+{
+  // Reset the flux moments
+  phi.assign(phi.size(), 0.0);
+
+#ifdef DETRAN_ENABLE_OPENMP
+  moments_type phi_local;
+#else
+  moments_type &phi_local = phi;
+#endif
+
+  #pragma omp parallel default(shared) private(phi_local)
+  {
+
+  // Initialize equation and setup for this group.
+  Equation_T equation(d_mesh, d_material, d_quadrature, d_update_psi);
+  equation.setup_group(d_g);
+
+  // Reset the flux moments
+  phi_local.resize(d_mesh->number_cells(), 0.0);
+
+  // Initialize discrete sweep source vector.
+  SweepSource<_3D>::sweep_source_type source(d_mesh->number_cells(), 0.0);
+
+  // Scratch space for 2D segments of modular tracks and 3D segments.
+  SegmentBuffer segment_buffer;
+  vec_int region_3d;
+  vec_dbl length_3d;
+
+  double psi_in  = 0;
+  double psi_out = 0;
+
+  SP_quadrature q = d_quadrature;
+
+  // Sweep over all octants.
+  for (size_t oo = 0; oo < 8; oo++)
+  {
+    size_t o = d_ordered_octants[oo];
+
+    // Setup equation for this octant.
+    equation.setup_octant(o);
+
+    // The xy direction is that of a 2D octant, and the z direction
+    // selects the family of stacked tracks.
+    size_t o2D  = o % 4;
+    bool   down = o > 3;
+
+    // Sweep over all angles.
+    #pragma omp for
+    for (size_t a = 0; a < q->number_angles_octant(); ++a)
+    {
+      // Get the azimuth and polar indices within the octant.
+      size_t azimuth = q->azimuth(a);
+      size_t polar   = q->polar(a);
+      equation.setup_azimuth(azimuth);
+      equation.setup_polar(polar);
+
+      // Switch the azimuth index to correct one for track access.
+      if (o2D % 2) azimuth += q->number_azimuths_octant();
+      bool track_reverse = o2D > 1;
+
+      // Get sweep source for this angle.
+      d_sweepsource->source(d_g, o, a, source);
+
+      // Get psi if update requested.
+      State::angular_flux_type psi;
+      if (d_update_psi) psi = d_state->psi(d_g, o, a);
+
+      // Update the boundary for this angle.
+      if (d_update_boundary) d_boundary->update(d_g, o, a);
+
+      // Sweep over all 2D tracks.
+      for (int t = 0; t < d_tracks->number_tracks_angle(azimuth); t++)
+      {
+        const int    *regions = 0;
+        const double *lengths = 0;
+        int number_segments = d_tracks->segments(azimuth, t, regions,
+                                                 lengths, segment_buffer);
+
+        // Sweep over the 3D tracks stacked on this one.
+        size_t offset = d_stack->offset(azimuth, polar, t);
+        for (size_t j = 0; j < d_stack->number_stacked(azimuth, t, polar); j++)
+        {
+          int n = d_stack->segments(azimuth, t, polar, j, down,
+                                    track_reverse, regions, lengths,
+                                    number_segments, region_3d, length_3d);
+
+          psi_out = (*d_boundary)(d_g, o, a, Boundary_T::IN, offset + j);
+
+          // Sweep all segments on the track.
+          for (int s = 0; s < n; s++)
+          {
+            psi_in = psi_out;
+            equation.solve(region_3d[s], length_3d[s], source,
+                           psi_in, psi_out, phi_local, psi);
+          }
+
+          (*d_boundary)(d_g, o, a, Boundary_T::OUT, offset + j) = psi_out;
+
+        } // end 3D track
+
+      } // end 2D track
+
+    } // end angle loop
+    // end omp do
+
+  } // end octant loop
+
+#ifdef DETRAN_ENABLE_OPENMP
+  // Sum local thread fluxes.
+  #pragma omp critical
+  {
+    for (int i = 0; i < d_mesh->number_cells(); i++)
+    {
+      phi[i] += phi_local[i];
+    }
+  }
+#endif
+
+  } // end omp parallel
+
+  #pragma omp master
+  {
+    d_number_sweeps++;
+  }
+  return;
+}
+
+} // end namespace detran
+
+#endif /* detran_SWEEPER3DMOC_I_HH_ */
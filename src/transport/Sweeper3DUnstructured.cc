@@ -0,0 +1,73 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  Sweeper3DUnstructured.cc
+ *  @brief Sweeper3DUnstructured member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "transport/Sweeper3DUnstructured.hh"
+#include "transport/Equation_SD_Unstructured.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+Sweeper3DUnstructured<EQ>::Sweeper3DUnstructured(SP_input input,
+                                                 SP_mesh mesh,
+                                                 SP_material material,
+                                                 SP_quadrature quadrature,
+                                                 SP_state state,
+                                                 SP_boundary boundary,
+                                                 SP_sweepsource sweepsource)
+  : Base(input, mesh, material, quadrature, state, boundary, sweepsource)
+  , d_unstructured(mesh)
+{
+  Require(boundary);
+  Insist(d_unstructured, "The unstructured sweeper needs a MeshUnstructured.");
+
+  d_ordering = new SweepOrdering(d_unstructured, d_quadrature);
+
+  size_t na = d_quadrature->number_angles_octant();
+  d_face_flux.resize(d_material->number_groups(),
+                     detran_utilities::vec3_dbl(d_quadrature->number_octants(),
+                     detran_utilities::vec2_dbl(na,
+                     detran_utilities::vec_dbl(
+                       d_unstructured->number_face_fluxes(), 0.0))));
+
+  detran_utilities::vec_bool reflective(6, false);
+  for (int side = 0; side < 6; ++side)
+    reflective[side] = boundary->is_reflective(side);
+  d_boundary_map =
+    new BoundaryMapUnstructured(d_unstructured, d_quadrature, reflective);
+}
+
+//---------------------------------------------------------------------------//
+template <class EQ>
+typename Sweeper3DUnstructured<EQ>::SP_sweeper
+Sweeper3DUnstructured<EQ>::Create(SP_input       input,
+                                  SP_mesh        mesh,
+                                  SP_material    material,
+                                  SP_quadrature  quadrature,
+                                  SP_state       state,
+                                  SP_boundary    boundary,
+                                  SP_sweepsource sweepsource)
+{
+  SP_sweeper p(new Sweeper3DUnstructured(input, mesh, material, quadrature,
+                                         state, boundary, sweepsource));
+  return p;
+}
+
+//---------------------------------------------------------------------------//
+// EXPLICIT INSTANTIATIONS
+//---------------------------------------------------------------------------//
+
+TRANSPORT_INSTANTIATE_EXPORT(Sweeper3DUnstructured<Equation_SD_Unstructured>)
+TRANSPORT_TEMPLATE_EXPORT(detran_utilities::SP<Sweeper3DUnstructured<Equation_SD_Unstructured> >)
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of Sweeper3DUnstructured.cc
+//---------------------------------------------------------------------------//
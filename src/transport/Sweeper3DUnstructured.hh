@@ -0,0 +1,150 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  Sweeper3DUnstructured.hh
+ *  @brief Sweeper3DUnstructured class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_SWEEPER3DUNSTRUCTURED_HH_
+#define detran_SWEEPER3DUNSTRUCTURED_HH_
+
+#include "transport/Sweeper.hh"
+#include "transport/BoundaryMapUnstructured.hh"
+#include "transport/SweepOrdering.hh"
+#include "boundary/BoundarySN.hh"
+#include "geometry/MeshUnstructured.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class Sweeper3DUnstructured
+ *  @brief Sweeper for 3D discrete ordinates problems on extruded meshes.
+ *
+ *  The prisms of an extruded MeshUnstructured are swept layer by layer
+ *  in the direction of \f$ \xi \f$, and within each layer in the order
+ *  of the polygons given by SweepOrdering.  Otherwise, the face fluxes,
+ *  lagged faces, and boundary conditions (including BOTTOM and TOP) are
+ *  treated as in Sweeper2DUnstructured.
+ */
+//---------------------------------------------------------------------------//
+template <class EQ>
+class Sweeper3DUnstructured: public Sweeper<_3D>
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<Sweeper3DUnstructured>   SP_sweeper;
+  typedef Sweeper<_3D>                                  Base;
+  typedef typename Base::SP_state                       SP_state;
+  typedef typename Base::SP_input                       SP_input;
+  typedef typename Base::SP_material                    SP_material;
+  typedef typename Base::SP_mesh                        SP_mesh;
+  typedef typename Base::SP_quadrature                  SP_quadrature;
+  typedef typename Base::SP_sweepsource                 SP_sweepsource;
+  typedef typename Base::moments_type                   moments_type;
+  typedef typename Base::angular_flux_type              angular_flux_type;
+  typedef typename Base::vec_int                        vec_int;
+  typedef typename Base::vec2_int                       vec2_int;
+  typedef typename Base::vec3_int                       vec3_int;
+  typedef typename Base::size_t                         size_t;
+  typedef EQ                                            Equation_T;
+  typedef BoundarySN<_3D>                               Boundary_T;
+  typedef typename Boundary_T::SP_boundary              SP_boundary;
+  typedef detran_geometry::MeshUnstructured             Mesh_T;
+  typedef SweepOrdering::SP_ordering                    SP_ordering;
+  typedef BoundaryMapUnstructured::SP_map               SP_map;
+  typedef detran_utilities::vec4_dbl                    vec4_dbl;
+
+  //-------------------------------------------------------------------------//
+  // CONSTRUCTOR & DESTRUCTOR
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor.
+   *  @param    input       User input database.
+   *  @param    mesh        Unstructured mesh.
+   *  @param    material    Material database.
+   *  @param    quadrature  Angular quadrature.
+   *  @param    state       State vectors.
+   *  @param    boundary    Boundary giving the boundary conditions.
+   *  @param    sweepsource Sweep source constructor.
+   */
+  Sweeper3DUnstructured(SP_input input,
+                        SP_mesh mesh,
+                        SP_material material,
+                        SP_quadrature quadrature,
+                        SP_state state,
+                        SP_boundary boundary,
+                        SP_sweepsource sweepsource);
+
+  /// Virtual destructor
+  virtual ~Sweeper3DUnstructured(){}
+
+  /// SP Constructor
+  static SP_sweeper
+  Create(SP_input       input,
+         SP_mesh        mesh,
+         SP_material    material,
+         SP_quadrature  quadrature,
+         SP_state       state,
+         SP_boundary    boundary,
+         SP_sweepsource sweepsource);
+
+  //-------------------------------------------------------------------------//
+  // ABSTRACT INTERFACE -- ALL SWEEPERS MUST IMPLEMENT THESE
+  //-------------------------------------------------------------------------//
+
+  /// Sweep.
+  inline void sweep(moments_type &phi);
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC FUNCTIONS
+  //-------------------------------------------------------------------------//
+
+  /// Sweep orderings
+  SP_ordering ordering() const { return d_ordering; }
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Unstructured mesh
+  detran_utilities::SP<Mesh_T> d_unstructured;
+  /// Sweep orderings
+  SP_ordering d_ordering;
+  /// Face fluxes [group][octant][angle][face]
+  vec4_dbl d_face_flux;
+  /// Sources of the incident boundary fluxes
+  SP_map d_boundary_map;
+
+  //-------------------------------------------------------------------------//
+  // IMPLEMENTATION
+  //-------------------------------------------------------------------------//
+
+  /// Set the incident boundary fluxes for an angle.
+  inline void set_incident(const size_t o, const size_t a);
+
+};
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+// INLINE MEMBER DEFINITIONS
+//---------------------------------------------------------------------------//
+
+#include "Sweeper3DUnstructured.i.hh"
+
+#endif /* detran_SWEEPER3DUNSTRUCTURED_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of Sweeper3DUnstructured.hh
+//---------------------------------------------------------------------------//
@@ -0,0 +1,85 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  TrackSchedule.cc
+ *  @brief TrackSchedule member definitions
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#include "TrackSchedule.hh"
+#include <algorithm>
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+TrackSchedule::TrackSchedule(SP_trackdb    tracks,
+                             SP_quadrature quadrature,
+                             const size_t  number_threads)
+  : d_number_threads(number_threads)
+  , d_angle(4)
+  , d_track(4)
+  , d_work(4, vec_int(1, 0))
+  , d_offset(4, vec_int(number_threads + 1, 0))
+{
+  Require(tracks);
+  Require(tracks->is_finalized());
+  Require(quadrature);
+  Require(d_number_threads > 0);
+
+  // Segments per track of each azimuth
+  detran_geometry::TrackDB::SegmentBuffer buffer;
+  vec2_int segments(tracks->number_angles());
+  for (size_t az = 0; az < segments.size(); ++az)
+  {
+    segments[az].resize(tracks->number_tracks_angle(az), 0);
+    for (size_t t = 0; t < segments[az].size(); ++t)
+    {
+      const int    *region = 0;
+      const double *length = 0;
+      segments[az][t] = tracks->segments(az, t, region, length, buffer);
+    }
+  }
+
+  size_t na = quadrature->number_azimuths_octant();
+  for (size_t o = 0; o < 4; ++o)
+  {
+    // List the work items in sweep order.
+    for (size_t a = 0; a < quadrature->number_angles_octant(); ++a)
+    {
+      size_t az = quadrature->azimuth(a) + (o % 2 ? na : 0);
+      for (size_t t = 0; t < segments[az].size(); ++t)
+      {
+        d_angle[o].push_back(a);
+        d_track[o].push_back(t);
+        d_work[o].push_back(d_work[o].back() + segments[az][t]);
+      }
+    }
+
+    // Cut the list where the cumulative work is nearest each thread's
+    // share.
+    double total = d_work[o].back();
+    for (size_t thread = 1; thread < d_number_threads; ++thread)
+    {
+      double share = total * thread / d_number_threads;
+      int i = std::lower_bound(d_work[o].begin(), d_work[o].end(), share) -
+              d_work[o].begin();
+      if (i == (int) d_work[o].size()) --i;
+      if (i > 0 && share - d_work[o][i - 1] < d_work[o][i] - share) --i;
+      d_offset[o][thread] = std::max(i, d_offset[o][thread - 1]);
+    }
+    d_offset[o][d_number_threads] = d_angle[o].size();
+  }
+}
+
+//---------------------------------------------------------------------------//
+int TrackSchedule::work(const size_t o, const size_t thread) const
+{
+  return d_work[o][end(o, thread)] - d_work[o][begin(o, thread)];
+}
+
+} // end namespace detran
+
+//---------------------------------------------------------------------------//
+//              end of TrackSchedule.cc
+//---------------------------------------------------------------------------//
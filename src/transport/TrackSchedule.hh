@@ -0,0 +1,139 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file  TrackSchedule.hh
+ *  @brief TrackSchedule class definition
+ *  @note  Copyright (C) 2013 Jeremy Roberts
+ */
+//---------------------------------------------------------------------------//
+
+#ifndef detran_TRACKSCHEDULE_HH_
+#define detran_TRACKSCHEDULE_HH_
+
+#include "transport/transport_export.hh"
+#include "angle/QuadratureMOC.hh"
+#include "geometry/TrackDB.hh"
+#include "utilities/DBC.hh"
+#include "utilities/Definitions.hh"
+#include "utilities/SP.hh"
+
+namespace detran
+{
+
+//---------------------------------------------------------------------------//
+/**
+ *  @class TrackSchedule
+ *  @brief Assignment of tracks to threads for a 2D MOC sweep.
+ *
+ *  Within an octant, every (angle, track) pair can be swept independently
+ *  once the incident boundary fluxes are known.  Distributing angles
+ *  among threads balances poorly, since there are few angles per octant
+ *  and the number of tracks (and segments) differs between azimuths.
+ *  Instead, the pairs of an octant are ordered by angle and then track,
+ *  and the list is cut into one contiguous block per thread so that each
+ *  block holds about the same number of segments.  Since a block holds
+ *  few angles, the per-angle setup (e.g. the sweep source) is repeated at
+ *  most once per thread, and since each pair belongs to exactly one
+ *  thread, so does its outgoing boundary flux.
+ *
+ *  The octants follow the sweeper's convention: octants 0 and 2 use
+ *  the azimuths of the first quadrant and octants 1 and 3 those of the
+ *  second.
+ */
+//---------------------------------------------------------------------------//
+class TRANSPORT_EXPORT TrackSchedule
+{
+
+public:
+
+  //-------------------------------------------------------------------------//
+  // TYPEDEFS
+  //-------------------------------------------------------------------------//
+
+  typedef detran_utilities::SP<TrackSchedule>           SP_schedule;
+  typedef detran_geometry::TrackDB::SP_trackdb          SP_trackdb;
+  typedef detran_angle::QuadratureMOC::SP_quadrature    SP_quadrature;
+  typedef detran_utilities::vec_int                     vec_int;
+  typedef detran_utilities::vec2_int                    vec2_int;
+  typedef detran_utilities::size_t                      size_t;
+
+  //-------------------------------------------------------------------------//
+  // PUBLIC INTERFACE
+  //-------------------------------------------------------------------------//
+
+  /**
+   *  @brief Constructor
+   *  @param tracks           Track database
+   *  @param quadrature       MOC quadrature
+   *  @param number_threads   Number of threads sharing a sweep
+   */
+  TrackSchedule(SP_trackdb    tracks,
+                SP_quadrature quadrature,
+                const size_t  number_threads);
+
+  /// Number of threads
+  size_t number_threads() const
+  {
+    return d_number_threads;
+  }
+
+  /// First work item of a thread in an octant
+  size_t begin(const size_t o, const size_t thread) const
+  {
+    Require(o < 4);
+    Require(thread < d_number_threads);
+    return d_offset[o][thread];
+  }
+
+  /// One past the last work item of a thread in an octant
+  size_t end(const size_t o, const size_t thread) const
+  {
+    Require(o < 4);
+    Require(thread < d_number_threads);
+    return d_offset[o][thread + 1];
+  }
+
+  /// Angle (within the octant) of a work item
+  size_t angle(const size_t o, const size_t i) const
+  {
+    Require(o < 4);
+    Require(i < d_angle[o].size());
+    return d_angle[o][i];
+  }
+
+  /// Track of a work item
+  size_t track(const size_t o, const size_t i) const
+  {
+    Require(o < 4);
+    Require(i < d_track[o].size());
+    return d_track[o][i];
+  }
+
+  /// Number of segments assigned to a thread in an octant
+  int work(const size_t o, const size_t thread) const;
+
+private:
+
+  //-------------------------------------------------------------------------//
+  // DATA
+  //-------------------------------------------------------------------------//
+
+  /// Number of threads
+  size_t d_number_threads;
+  /// Angle of each work item by [octant][item]
+  vec2_int d_angle;
+  /// Track of each work item by [octant][item]
+  vec2_int d_track;
+  /// Number of segments up to each work item by [octant][item + 1]
+  vec2_int d_work;
+  /// First work item of each thread by [octant][thread + 1]
+  vec2_int d_offset;
+
+};
+
+} // end namespace detran
+
+#endif /* detran_TRACKSCHEDULE_HH_ */
+
+//---------------------------------------------------------------------------//
+//              end of TrackSchedule.hh
+//---------------------------------------------------------------------------//
@@ -9,7 +9,8 @@
 
 // LIST OF TEST FUNCTIONS
 #define TEST_LIST                     \
-        FUNC(test_State_basic)
+        FUNC(test_State_basic)        \
+        FUNC(test_State_swap)
 
 #include "utilities/TestDriver.hh"
 #include "State.hh"
@@ -72,6 +73,36 @@ int test_State_basic(int argc, char *argv[])
   return 0;
 }
 
+int test_State_swap(int argc, char *argv[])
+{
+  SP_mesh mesh          = mesh_2d_fixture();
+  SP_quadrature quad    = quadruplerange_fixture();
+  State::SP_input input(new InputDB());
+  input->put<std::string>("equation", "dd");
+  input->put<int>("number_groups", 2);
+  input->put<int>("store_angular_flux", 1);
+  State a(input, mesh, quad);
+  State b(input, mesh, quad);
+  a.phi(1)[2] = 1.0;
+  a.psi(1, 0, 1)[2] = 2.0;
+  a.set_eigenvalue(1.1);
+  b.phi(1)[2] = 3.0;
+  b.psi(1, 0, 1)[2] = 4.0;
+  b.set_eigenvalue(0.9);
+
+  // The storage itself is exchanged.
+  const double *phi_a = &a.phi(1)[0];
+  a.swap(b);
+  TEST(&b.phi(1)[0] == phi_a);
+  TEST(a.phi(1)[2] == 3.0);
+  TEST(a.psi(1, 0, 1)[2] == 4.0);
+  TEST(a.eigenvalue() == 0.9);
+  TEST(b.phi(1)[2] == 1.0);
+  TEST(b.psi(1, 0, 1)[2] == 2.0);
+  TEST(b.eigenvalue() == 1.1);
+  return 0;
+}
+
 //---------------------------------------------------------------------------//
 //              end of test_State.cc
 //---------------------------------------------------------------------------//
@@ -0,0 +1,112 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_SweepOrdering.cc
+ *  @author Jeremy Roberts
+ *  @date   Feb 22, 2013
+ *  @brief  Test of SweepOrdering class
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                       \
+        FUNC(test_SweepOrdering_grid)   \
+        FUNC(test_SweepOrdering_cycle)
+
+#include "TestDriver.hh"
+#include "transport/SweepOrdering.hh"
+#include "angle/ChebyshevLegendre.hh"
+#include "geometry/test/mesh_fixture.hh"
+#include <algorithm>
+
+using namespace detran;
+using namespace detran_angle;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace detran_test;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  RUN(argc, argv);
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+// On a Cartesian grid, every cell follows its upwind neighbors.
+int test_SweepOrdering_grid(int argc, char *argv[])
+{
+  vec_dbl xe(5, 0.0), ye(4, 0.0);
+  for (int i = 1; i < 5; ++i) xe[i] = xe[i - 1] + 0.5 * i;
+  for (int j = 1; j < 4; ++j) ye[j] = ye[j - 1] + 1.0;
+  MeshUnstructured::SP_mesh mesh = unstructured_grid_fixture(xe, ye,
+                                                             vec_int(12, 0));
+  Quadrature::SP_quadrature quad(new ChebyshevLegendre(2, 2, 2));
+  SweepOrdering ordering(mesh, quad);
+  TEST(ordering.number_lagged() == 0);
+  for (int o = 0; o < 4; ++o)
+  {
+    for (int a = 0; a < quad->number_angles_octant(); ++a)
+    {
+      const vec_int &order = ordering.order(o, a);
+      TEST(order.size() == 12);
+      vec_int position(12, -1);
+      for (int k = 0; k < 12; ++k) position[order[k]] = k;
+      TEST(std::find(position.begin(), position.end(), -1) == position.end());
+      int di = quad->mu(o, a) > 0.0 ? 1 : -1;
+      int dj = quad->eta(o, a) > 0.0 ? 1 : -1;
+      for (int j = 0; j < 3; ++j)
+      {
+        for (int i = 0; i < 4; ++i)
+        {
+          int c = i + 4 * j;
+          if (i - di >= 0 && i - di < 4)
+            TEST(position[c - di] < position[c]);
+          if (j - dj >= 0 && j - dj < 3)
+            TEST(position[c - 4 * dj] < position[c]);
+        }
+      }
+    }
+  }
+  return 0;
+}
+
+// Directions in the first and third quadrants see a cycle.
+int test_SweepOrdering_cycle(int argc, char *argv[])
+{
+  MeshUnstructured::SP_mesh mesh = unstructured_mesh_fixture();
+  Quadrature::SP_quadrature quad(new ChebyshevLegendre(2, 2, 2));
+  SweepOrdering ordering(mesh, quad);
+  for (int o = 0; o < 4; ++o)
+  {
+    for (int a = 0; a < quad->number_angles_octant(); ++a)
+    {
+      vec_int order = ordering.order(o, a);
+      TEST(order.size() == 3);
+      std::sort(order.begin(), order.end());
+      for (int c = 0; c < 3; ++c) TEST(order[c] == c);
+      const vec_int &lagged = ordering.lagged(o, a);
+      if (o == 0 || o == 2)
+      {
+        // The first L cell has one upwind face, which is lagged.  The
+        // second L cell then still depends on the square, so one of
+        // their two faces is lagged.
+        TEST(lagged.size() == 2);
+        TEST(ordering.order(o, a)[0] == (o == 0 ? 0 : 1));
+        for (int i = 0; i < lagged.size(); ++i)
+          TEST(!mesh->is_boundary(lagged[i]));
+      }
+      else
+      {
+        TEST(lagged.size() == 0);
+        TEST(ordering.order(o, a)[1] == 2);
+      }
+    }
+  }
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_SweepOrdering.cc
+//---------------------------------------------------------------------------//
@@ -0,0 +1,92 @@
+//----------------------------------*-C++-*----------------------------------//
+/**
+ *  @file   test_TrackSchedule.cc
+ *  @author Jeremy Roberts
+ *  @date   Feb 20, 2013
+ *  @brief  Test of TrackSchedule class
+ */
+//---------------------------------------------------------------------------//
+
+// LIST OF TEST FUNCTIONS
+#define TEST_LIST                     \
+        FUNC(test_TrackSchedule)
+
+#include "TestDriver.hh"
+#include "transport/TrackSchedule.hh"
+#include "geometry/Mesh2D.hh"
+#include "geometry/Tracker.hh"
+#include "angle/Uniform.hh"
+#include <algorithm>
+
+using namespace detran;
+using namespace detran_angle;
+using namespace detran_geometry;
+using namespace detran_utilities;
+using namespace detran_test;
+using namespace std;
+
+int main(int argc, char *argv[])
+{
+  RUN(argc, argv);
+}
+
+//---------------------------------------------------------------------------//
+// TEST DEFINITIONS
+//---------------------------------------------------------------------------//
+
+int test_TrackSchedule(int argc, char *argv[])
+{
+  // The azimuths have different numbers of tracks and segments.
+  vec_dbl cm(2, 0.0); cm[1] = 3.0;
+  vec_int fm(1, 12);
+  vec_int mat(1, 0);
+  Mesh::SP_mesh mesh(new Mesh2D(fm, fm, cm, cm, mat));
+  QuadratureMOC::SP_quadrature quad(new Uniform(2, 3, 9, 2, "TY"));
+  Tracker tracker(mesh, quad);
+  Tracker::SP_trackdb tracks = tracker.trackdb();
+
+  int na = quad->number_azimuths_octant();
+  for (int n = 1; n <= 7; ++n)
+  {
+    TrackSchedule schedule(tracks, quad, n);
+    TEST(schedule.number_threads() == n);
+    for (int o = 0; o < 4; ++o)
+    {
+      // Every (angle, track) pair is assigned to one thread, in order.
+      int i = 0;
+      int total = 0;
+      int largest = 0;
+      for (int thread = 0; thread < n; ++thread)
+      {
+        TEST(schedule.begin(o, thread) == i);
+        i = schedule.end(o, thread);
+        total += schedule.work(o, thread);
+        largest = std::max(largest, schedule.work(o, thread));
+      }
+      int number = 0;
+      int work = 0;
+      int longest = 0;
+      for (int a = 0; a < quad->number_angles_octant(); ++a)
+      {
+        int az = quad->azimuth(a) + (o % 2 ? na : 0);
+        for (int t = 0; t < tracks->number_tracks_angle(az); ++t, ++number)
+        {
+          TEST(schedule.angle(o, number) == a);
+          TEST(schedule.track(o, number) == t);
+          int ns = tracks->segment_end(az, t) - tracks->segment_begin(az, t);
+          work += ns;
+          longest = std::max(longest, ns);
+        }
+      }
+      TEST(i == number);
+      TEST(total == work);
+      // No thread has more than its share plus one track.
+      TEST(largest <= work / n + longest);
+    }
+  }
+  return 0;
+}
+
+//---------------------------------------------------------------------------//
+//              end of test_TrackSchedule.cc
+//---------------------------------------------------------------------------//